@@ -0,0 +1,17 @@
+# Script mode: cmake -DPLUGIN=<Qt SQLite driver plugin> -DSQLITE=<sqlite3 library> -P CheckQtSystemSqlite.cmake
+# Prints "system" when the plugin loads that same sqlite3 library (Qt was
+# configured with -system-sqlite) and "bundled" when it carries its own copy.
+file(GET_RUNTIME_DEPENDENCIES
+    MODULES ${PLUGIN}
+    RESOLVED_DEPENDENCIES_VAR dependencies
+    UNRESOLVED_DEPENDENCIES_VAR unresolved)
+
+get_filename_component(sqlite ${SQLITE} REALPATH)
+set(result bundled)
+foreach(dependency IN LISTS dependencies)
+    get_filename_component(dependency ${dependency} REALPATH)
+    if(dependency STREQUAL sqlite)
+        set(result system)
+    endif()
+endforeach()
+execute_process(COMMAND ${CMAKE_COMMAND} -E echo ${result})
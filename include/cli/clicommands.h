@@ -0,0 +1,49 @@
+#pragma once
+#include <QStringList>
+#include <QTextStream>
+#include <vector>
+
+class Database;
+class TenantDirectory;
+struct ScheduledInterview;
+
+// Subcommands of the headless campus_cli tool. Every command streams its
+// output row by row so large catalogs never have to fit in memory.
+class CliCommands
+{
+public:
+    explicit CliCommands(Database *db, TenantDirectory *tenantDirectory = nullptr);
+
+    // args excludes the program name; returns the process exit code
+    int run(const QStringList &args);
+    static void printUsage(QTextStream &stream);
+
+private:
+    int importJobs(const QStringList &args);
+    int exportJobs(const QStringList &args);
+    int search(const QStringList &args);
+    int stats(const QStringList &args);
+    int updateDocumentStatuses(const QStringList &args);
+    int calibrateKdf(const QStringList &args);
+    int notifyOpen(const QStringList &args);
+    int exportTable(const QStringList &args);
+    int inspectExport(const QStringList &args);
+    int snapshot(const QStringList &args);
+    int tenants(const QStringList &args);
+    int suggest(const QStringList &args);
+    int compileQuestions(const QStringList &args);
+    int sampleQuestions(const QStringList &args);
+    int parseAvailability(const QStringList &args);
+    int matchApplicants(const QStringList &args);
+    int whoCanWork(const QStringList &args);
+    int setCalendar(const QStringList &args);
+    int scheduleInterviews(const QStringList &args);
+    int cancelInterview(const QStringList &args);
+    int benchCatalog(const QStringList &args);
+    void printInterviews(const std::vector<ScheduledInterview> &interviews);
+
+    Database *database;
+    TenantDirectory *tenantDirectory;
+    QTextStream out;
+    QTextStream err;
+};
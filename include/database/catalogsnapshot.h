@@ -0,0 +1,94 @@
+#pragma once
+#include <QFile>
+#include <QObject>
+#include <QSqlDatabase>
+#include <QString>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include "models/job.h"
+
+class Database;
+
+// Read-only, memory-mapped copy of the listed jobs (".jobcat"): those still
+// taking applications, Open or Closing Soon, as on the jobs page.
+//
+// The writer lays every listed job out in listing order (title, id) as
+// fixed-size records whose text fields are (offset, length) refs into a
+// deduplicated UTF-8 pool, followed by one index per eligibility filter
+// (work study, international, both). The header carries the jobs table
+// version it was written at and the database id; refresh() keeps the
+// mapped file while both still match, and otherwise rewrites it on a worker
+// thread while callers keep reading from SQL. Reading a page is then a
+// lookup into the filter's index plus decoding only the jobs shown, so
+// opening the jobs page costs the same at any catalog size.
+//
+// Layout (little-endian): 72-byte header, job records, index entries,
+// string pool.
+class CatalogSnapshot
+{
+public:
+    // Rows of one eligibility filter
+    enum View
+    {
+        AllJobs,
+        WorkStudy,
+        International,
+        WorkStudyAndInternational,
+        ViewCount
+    };
+
+    CatalogSnapshot();
+
+    static View viewFor(bool workStudyOnly, bool internationalOnly);
+    // "<database>.jobcat"; empty for in-memory databases
+    static QString defaultPath(const QString &databasePath);
+    // Serializes the listed jobs of the database at databasePath through a
+    // private connection, in one read transaction, stamped with its jobs
+    // table version and id; replaces path atomically. Safe on any thread.
+    static bool write(const QString &databasePath, const QString &path, QString *error = nullptr);
+
+    // Maps the default snapshot of db if it is current; false (and closed)
+    // otherwise. With a context, a stale or missing snapshot is rewritten on
+    // the global thread pool and ready is called on the context's thread
+    // once it is on disk; call refresh() again there to map it.
+    bool refresh(Database *db, QObject *context = nullptr, std::function<void()> ready = nullptr);
+    bool open(const QString &path);
+    void close();
+    bool isOpen() const { return data != nullptr; }
+
+    qint64 tableVersion() const { return version; }
+    qint64 databaseId() const { return identity; }
+    int count(View view = AllJobs) const;
+    // Record index of the position-th job in view
+    int recordAt(View view, int position) const;
+
+    // Straight from the mapped record
+    int jobId(int record) const;
+    // Decodes one record into a Job
+    Job job(int record) const;
+
+private:
+    static bool serialize(QSqlDatabase source, const QString &path, QString *error);
+    QString text(const uchar *ref) const;
+
+    QFile file;
+    const uchar *data;
+    qint64 fileSize;
+    qint64 version;
+    qint64 identity;
+    quint32 jobCount;
+    quint32 recordsOffset;
+    quint32 stringsOffset;
+    quint32 stringBytes;
+    quint32 viewOffset[ViewCount];
+    quint32 viewCount[ViewCount];
+
+    // Shared with the writer task, which may outlive this object
+    struct WriteState
+    {
+        std::atomic_bool running{false};
+        std::atomic_bool again{false}; // jobs changed while writing
+    };
+    std::shared_ptr<WriteState> writeState;
+};
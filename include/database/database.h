@@ -3,9 +3,31 @@
 #include <QSqlDatabase>
 #include <QString>
 #include <QDateTime>
+#include <QMap>
+#include <QHash>
+#include <QSharedPointer>
+#include <QThreadPool>
+#include <QVariant>
+#include <atomic>
+#include <functional>
 #include <vector>
 #include "models/job.h"
+#include "models/jobfilter.h"
 #include "models/user.h"
+#include "database/jobresultcache.h"
+#include "database/nativesqlite.h"
+#include "database/snapshotstore.h"
+#include "database/writebatcher.h"
+#include "utils/availability.h"
+
+class CredentialService;
+
+// How catalog reads (getJobs, forEachJob) reach SQLite
+enum class StorageBackend
+{
+    Qt,    // QSqlQuery on the main connection
+    Native // sqlite3 C API on the main connection's own handle
+};
 
 struct Document
 {
@@ -23,20 +45,114 @@ struct Document
           uploadDate(date), status(status) {}
 };
 
+// Keyset cursor for paging through jobs ordered by (title, id): the last
+// row already delivered. A default cursor starts at the beginning.
+struct JobCursor
+{
+    QString title;
+    int id;
+
+    JobCursor() : id(-1) {}
+    bool atStart() const { return id < 0; }
+};
+
+// One scheduled status transition; applied only if the row is still in from
+struct JobStatusChange
+{
+    int jobId;
+    JobStatus from;
+    JobStatus to;
+};
+
+// An "it's open" notice for one subscriber of a job
+struct Notification
+{
+    int interestId = -1;
+    int userId = -1;
+    int jobId = -1;
+    QString recipient;
+    QString recipientName;
+    QString subject;
+    QString body;
+};
+
+// Parsed availability of one job application
+struct ApplicantAvailability
+{
+    int applicationId = -1;
+    int userId = -1;
+    int jobId = -1;
+    Availability availability;
+};
+
+// One booked interview with a job's supervisor
+struct ScheduledInterview
+{
+    int applicationId = -1;
+    QString supervisor;
+    int day = 0;         // 0 = Monday
+    int startMinute = 0; // minutes since midnight
+    int endMinute = 0;
+    int room = 0;        // 1..rooms, numbered per time
+};
+
+// One answered interview practice question
+struct InterviewAttempt
+{
+    int userId = -1;
+    QString topic;          // question mode, e.g. "technical"
+    quint32 questionId = 0; // id within the compiled question bank
+    int difficulty = 0;     // 0 easy .. 2 hard
+    bool correct = false;
+    double ability = 0.0;   // topic ability estimate after this answer
+    QDateTime answeredAt;
+};
+
+// Running ability estimate for one user and topic
+struct TopicMastery
+{
+    QString topic;
+    double ability = 0.0;
+    int attempts = 0;
+};
+
 class Database : public QObject
 {
     Q_OBJECT
 public:
+    // Opens the default database (see defaultDatabasePath) on Qt's default connection
     explicit Database(QObject *parent = nullptr);
+    // Opens databasePath on its own named connection; one per tenant
+    Database(const QString &databasePath, const QString &connectionName, QObject *parent = nullptr);
     ~Database();
 
+    // CAMPUS_DB_PATH, else the "database/path" setting, else campus_jobs.db
+    // in the working directory
+    static QString defaultDatabasePath();
+    QString databasePath() const { return db.databaseName(); }
+    QSqlDatabase connection() const { return db; }
+
     bool connectToDatabase();
+    // Native needs an open connection and a Qt SQLite driver built on the
+    // system sqlite3; otherwise this returns false and reads stay on Qt.
+    // CAMPUS_DB_BACKEND=native selects it on connect.
+    bool setStorageBackend(StorageBackend backend);
+    StorageBackend storageBackend() const { return backend; }
     bool validateLogin(const QString &email, const QString &password);
     bool registerUser(const QString &fullName, const QString &password,
                       const QString &email, const QString &emplid,
                       const QString &major = "", const QString &gpa = "",
                       const QString &gradDate = "");
 
+    // Non-blocking login/registration: the password KDF runs on the
+    // credential worker pool and done is called back on this thread.
+    void validateLoginAsync(const QString &email, const QString &password,
+                            QObject *context, std::function<void(bool)> done);
+    void registerUserAsync(const QString &fullName, const QString &password,
+                           const QString &email, const QString &emplid,
+                           QObject *context, std::function<void(bool)> done);
+    CredentialService *credentials() const { return credentialService; }
+
     bool updateProfile(const QString &email, const QString &major,
                        const QString &gpa, const QString &gradDate);
 
@@ -45,18 +161,27 @@ public:
                            const QString &gpa, const QString &gradDate);
     User getUserDataById(int userId);
     int getUserIdByEmail(const QString &email);
+    bool updateNameAndParsedGpa(int userId, const QString &fullName, const QString &parsedGpa);
+
+    // Session user cache: each user row is read once and shared as an
+    // immutable snapshot. Writes through this class drop the stale entry
+    // so the next read sees fresh data. Returns null for unknown users.
+    QSharedPointer<const User> userSnapshot(int userId);
+    QSharedPointer<const User> userSnapshotByEmail(const QString &email);
+    void clearUserCache();
 
     // Survey and document parsing methods
     bool updateSurveyData(int userId, bool isInternational, const QString &resumePath,
                           const QString &transcriptPath, const QString &parsedResumeData,
                           const QString &parsedGPA, const QString &parsedCourses);
-    bool markSurveyCompleted(int userId, bool completed = true);
-    bool updateInternationalStatus(int userId, bool isInternational);
+    // Queued on the write batcher; done reports when the change is durable
+    void markSurveyCompleted(int userId, bool completed = true, WriteBatcher::Callback done = nullptr);
+    void updateInternationalStatus(int userId, bool isInternational, WriteBatcher::Callback done = nullptr);
 
     // Document management methods
     bool addDocument(int userId, const QString &documentType,
                      const QString &filePath, const QString &status = "Pending");
-    bool updateDocumentStatus(int documentId, const QString &status);
+    void updateDocumentStatus(int documentId, const QString &status, WriteBatcher::Callback done = nullptr);
     bool deleteDocument(int documentId);
     std::vector<Document> getUserDocuments(int userId);
     Document getLatestDocument(int userId, const QString &documentType);
@@ -69,25 +194,172 @@ public:
 
     // Job management methods
     std::vector<Job> getJobs();
+    // One page of jobs matching filter, ordered by title; with a Status term
+    // it runs on idx_jobs_status_title (several statuses search one range
+    // each and sort the rows past the cursor). cursor is advanced past the page.
+    template <typename... Predicates>
+    std::vector<Job> getJobsPage(const JobFilter<Predicates...> &filter, JobCursor &cursor, int limit)
+    {
+        return selectJobsPage(db, filter.whereClause(), filter.bindValues(), cursor, limit);
+    }
+    // Same page on any connection (for worker threads)
+    template <typename... Predicates>
+    static std::vector<Job> getJobsPage(QSqlDatabase connection, const JobFilter<Predicates...> &filter,
+                                        JobCursor &cursor, int limit)
+    {
+        return selectJobsPage(connection, filter.whereClause(), filter.bindValues(), cursor, limit);
+    }
+    template <typename... Predicates>
+    std::vector<Job> findJobs(const JobFilter<Predicates...> &filter, int limit = -1)
+    {
+        return selectJobs(filter.whereClause(), filter.bindValues(), limit);
+    }
     std::vector<Job> getJobsByCategory(const QString &category);
-    std::vector<Job> searchJobs(const QString &keyword, const QString &statusFilter = "",
-                                const QString &categoryFilter = "", bool workStudyOnly = false,
-                                int minHours = 0, int maxHours = 40,
-                                double minPay = 0, double maxPay = 100);
+    // Ordered by status, then title; limit < 0 means no limit. Results are
+    // cached until the jobs table changes (see JobResultCache).
+    std::vector<Job> searchJobs(const JobSearchOptions &options, int limit = -1);
+    JobResultCache::Stats searchCacheStats() const { return jobResultCache.stats(); }
+    void setSearchCacheBytes(qint64 bytes) { jobResultCache.setMaxBytes(bytes); }
+    // Write counter kept by triggers on jobs; -1 on error
+    qint64 jobsTableVersion() { return jobsTableVersion(db); }
+    static qint64 jobsTableVersion(QSqlDatabase connection);
+    // Random non-zero id stamped when the file was created; 0 on error
+    qint64 databaseId() { return databaseId(db); }
+    static qint64 databaseId(QSqlDatabase connection);
+    // Jobs inserted, updated or deleted after sinceVersion (see job_changes)
+    std::vector<int> changedJobIds(qint64 sinceVersion);
     Job getJobById(int jobId);
     int getJobCountByCategory(const QString &category);
+    // Applies the changes in one transaction; returns rows changed or -1
+    int applyJobStatusChanges(const std::vector<JobStatusChange> &changes);
 
     // Job application methods
     bool applyForJob(int userId, int jobId, const QString &resumePath,
                      const QString &coverLetterPath, const QString &whyInterested,
                      const QString &availability, const QString &references);
-    bool expressInterest(int userId, int jobId, const QString &message);
-    bool saveJob(int userId, int jobId);
-    bool unsaveJob(int userId, int jobId);
+    bool expressInterest(int userId, int jobId, const QString &message, bool notify = true);
+    // Availability of every application to jobId
+    std::vector<ApplicantAvailability> getApplicantAvailability(int jobId);
+    // Applications (to jobId, or to any job) free for some of needed, or
+    // for all of it with wholeShift; filtered by day part in SQL first
+    std::vector<ApplicantAvailability> findAvailableApplicants(const Availability &needed, bool wholeShift,
+                                                               int jobId = -1);
+
+    // Interview scheduling: supervisors are named by the jobs'
+    // supervisor_info; calendars are free text parsed into slot words
+    bool setSupervisorCalendar(const QString &supervisor, const QString &calendar);
+    QHash<QString, Availability> getSupervisorCalendars();
+    QHash<int, QString> getJobSupervisors();
+    std::vector<ScheduledInterview> getInterviewSchedule();
+    // Replaces the whole stored schedule in one transaction
+    bool saveInterviewSchedule(const std::vector<ScheduledInterview> &interviews);
+    void saveJob(int userId, int jobId, WriteBatcher::Callback done = nullptr);
+    void unsaveJob(int userId, int jobId, WriteBatcher::Callback done = nullptr);
     std::vector<int> getSavedJobs(int userId);
+    // Counts a search box query (lowercased, whitespace collapsed) for autocomplete
+    bool recordSearchQuery(const QString &text);
     bool isJobSaved(int userId, int jobId);
 
+    // Notification fan-out: subscribers of jobId still waiting for a notice,
+    // in interest-id order after afterInterestId (one index range scan).
+    // The write helpers do not open a transaction; batch them in one.
+    std::vector<Notification> getPendingNotifications(int jobId, int afterInterestId, int limit);
+    bool markInterestsNotified(const std::vector<Notification> &notifications);
+    bool addOutboxNotifications(const std::vector<Notification> &notifications);
+
+    // Interview practice: the mastery rows hold the current estimates so
+    // loading a user never replays the attempt history. Like the
+    // notification helpers, the writes are meant to share one transaction.
+    std::vector<TopicMastery> getInterviewMastery(int userId);
+    bool addInterviewAttempts(const std::vector<InterviewAttempt> &attempts);
+    bool saveInterviewMastery(int userId, const std::vector<TopicMastery> &mastery);
+
+    // Application drafts: one row per (user, job, field), so an autosave
+    // rewrites only the fields that changed. An empty value removes the
+    // field; clear drops the whole draft before fields are written.
+    QHash<QString, QString> getApplicationDraft(int userId, int jobId);
+    bool saveApplicationDraft(int userId, int jobId, const QHash<QString, QString> &fields, bool clear = false);
+    bool deleteApplicationDraft(int userId, int jobId) { return saveApplicationDraft(userId, jobId, {}, true); }
+    // Same write on any connection, in its own transaction (for worker threads)
+    static bool writeApplicationDraft(QSqlDatabase connection, int userId, int jobId,
+                                      const QHash<QString, QString> &fields, bool clear);
+
+    // Small mutations (saved jobs, document status, survey flags) are
+    // group-committed by a WriteBatcher. Readers of those tables, snapshots,
+    // exports and beginTransaction() flush it first, so reads see them.
+    bool flushWrites() { return writeBatcher.flush(); }
+    WriteBatcher::Stats writeBatchStats() const { return writeBatcher.stats(); }
+
+    // Bulk and streaming helpers for batch tools (campus_cli)
+    bool beginTransaction();
+    bool commitTransaction();
+    bool rollbackTransaction();
+    // Visits jobs one row at a time; return false from the visitor to stop
+    bool forEachJob(const std::function<bool(const Job &)> &visitor);
+    // Streams one table (users, jobs, documents, job_applications or
+    // job_interests) into a columnar .chc file with a single forward-only
+    // scan; memory is bounded by one row group. Returns rows written or -1.
+    qint64 exportTable(const QString &table, const QString &path, int rowGroupSize = 65536);
+    static QStringList exportableTables();
+    // Pulls jobs from nextJob until it returns false; one transaction, returns count or -1
+    int importJobs(const std::function<bool(Job &)> &nextJob);
+    // Pulls (documentId, status) pairs; one transaction, returns rows updated or -1
+    int updateDocumentStatuses(const std::function<bool(int &, QString &)> &nextUpdate);
+    QMap<QString, int> getJobCountsByCategory();
+    QMap<QString, int> getJobCountsByStatus();
+    QMap<QString, int> getDocumentCountsByStatus();
+    int getUserCount();
+
+    // Snapshots: a private connection takes a consistent copy while writers
+    // keep going (WAL), then SnapshotStore keeps only the chunks that changed
+    // since earlier snapshots. With the native backend the copy is SQLite's
+    // online backup in page batches with pauses between them, and pages keep
+    // their place, so unchanged chunks deduplicate; without it, VACUUM INTO.
+    // Deduplication happens after the copy, so every snapshot still reads
+    // the whole database and writes a full temporary image of it.
+    QString snapshotDirectory() const;
+    bool createSnapshot(const QString &label, SnapshotInfo *info = nullptr);
+    // Runs on a pool owned by this object (destruction waits for it); done
+    // is called back on this thread. Fails immediately if another snapshot
+    // is still running.
+    void createSnapshotAsync(const QString &label, QObject *context,
+                             std::function<void(bool ok, const SnapshotInfo &info)> done);
+    std::vector<SnapshotInfo> listSnapshots() const;
+    SnapshotInfo snapshotAt(const QDateTime &when) const;
+    bool verifySnapshot(const QString &id) const;
+    // With an empty targetPath the snapshot is staged as "<database>.restore"
+    // and replaces the live file on the next start, once no connection has
+    // it open; the running process keeps the current data until then.
+    bool restoreSnapshot(const QString &id, const QString &targetPath = QString());
+    int pruneSnapshots(int keep);
+
+signals:
+    // Emitted after job rows change status or content
+    void jobsChanged();
+
 private:
     QSqlDatabase db;
+    CredentialService *credentialService;
+    QHash<int, QSharedPointer<const User>> userCache;
+    QHash<QString, int> userIdsByEmail;
+    std::atomic_bool snapshotRunning{false};
+    QThreadPool snapshotPool;
+    JobResultCache jobResultCache;
+    WriteBatcher writeBatcher;
+    StorageBackend backend = StorageBackend::Qt;
+    NativeSqlite::Connection native;
     bool createTables();
+    bool useNativeReads() const { return backend == StorageBackend::Native && native.isAttached(); }
+    // where/binds come from JobFilter, so only placeholders reach the SQL text
+    std::vector<Job> selectJobs(const QString &where, const QVariantList &binds, int limit);
+    static std::vector<Job> selectJobsPage(QSqlDatabase connection, const QString &where,
+                                           const QVariantList &binds, JobCursor &cursor, int limit);
+    QSharedPointer<const User> fetchUser(const QString &column, const QVariant &value);
+    void invalidateUser(int userId);
+    void backfillApplicationAvailability();
+    QString storedPasswordHash(const QString &email);
+    bool updatePasswordHash(const QString &email, const QString &oldHash, const QString &newHash);
+    bool insertUser(const QString &fullName, const QString &hashedPassword,
+                    const QString &email, const QString &emplid,
+                    const QString &major, const QString &gpa, const QString &gradDate);
 };
\ No newline at end of file
@@ -0,0 +1,72 @@
+#pragma once
+#include <QHash>
+#include <QString>
+#include <list>
+#include <vector>
+#include "models/job.h"
+#include "models/jobfilter.h"
+
+// LRU cache of searchJobs results, keyed by the normalized search options.
+//
+// An entry is the ordered list of matching job ids; the Job objects
+// themselves are kept once in a shared, reference-counted pool, so popular
+// searches that overlap do not store a job twice and a hit is served
+// without SQL or row decoding. Every lookup carries the jobs table version
+// (Database keeps it with triggers); a different version drops everything,
+// so a hit is never stale. Entries are evicted least recently used first
+// once the estimated footprint passes maxBytes.
+class JobResultCache
+{
+public:
+    struct Stats
+    {
+        quint64 hits = 0;
+        quint64 misses = 0;
+        quint64 invalidations = 0; // version changes that emptied the cache
+        quint64 evictions = 0;
+        int entries = 0;
+        int pooledJobs = 0;
+        qint64 bytes = 0;
+
+        double hitRate() const { return hits + misses == 0 ? 0.0 : double(hits) / double(hits + misses); }
+    };
+
+    explicit JobResultCache(qint64 maxBytes = 8 * 1024 * 1024);
+
+    static QString keyFor(const JobSearchOptions &options, int limit);
+
+    // True on a hit, with jobs filled in result order
+    bool lookup(const QString &key, qint64 version, std::vector<Job> &jobs);
+    void insert(const QString &key, qint64 version, const std::vector<Job> &jobs);
+    void clear();
+
+    Stats stats() const;
+    void setMaxBytes(qint64 bytes);
+
+private:
+    struct Entry
+    {
+        std::vector<int> jobIds;
+        qint64 bytes;
+        std::list<QString>::iterator recency;
+    };
+    struct PooledJob
+    {
+        Job job;
+        int references;
+        qint64 bytes;
+    };
+
+    static qint64 estimateBytes(const Job &job);
+    void syncVersion(qint64 version);
+    void evict(const QString &key);
+    void trim();
+
+    qint64 maxBytes;
+    qint64 usedBytes;
+    qint64 cachedVersion;
+    QHash<QString, Entry> entries;
+    std::list<QString> recencyOrder; // most recently used first
+    QHash<int, PooledJob> pool;
+    Stats counters;
+};
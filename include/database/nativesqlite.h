@@ -0,0 +1,87 @@
+#pragma once
+#include <QByteArray>
+#include <QString>
+
+class QSqlDatabase;
+struct sqlite3;
+struct sqlite3_stmt;
+
+// Thin RAII layer over the sqlite3 C API for hot read paths.
+//
+// QSqlQuery::value() boxes every field into a QVariant before it is
+// converted; here columns are read straight from the statement: integers
+// and doubles by value, text as a QUtf8StringView into SQLite's own buffer
+// (valid until the next step() or reset()). Statements run on the sqlite3
+// handle of an open QSQLITE connection, never on a second connection, so
+// this is only built (CAMPUS_NATIVE_SQLITE) when Qt's driver uses the same
+// system sqlite3 library; otherwise attach() fails and callers keep using Qt.
+namespace NativeSqlite
+{
+    // False when Qt's SQLite driver does not use the system sqlite3
+    bool isAvailable();
+
+    class Statement
+    {
+    public:
+        Statement() = default;
+        Statement(sqlite3 *db, const char *sql);
+        ~Statement();
+        Statement(Statement &&other) noexcept;
+        Statement &operator=(Statement &&other) noexcept;
+        Statement(const Statement &) = delete;
+        Statement &operator=(const Statement &) = delete;
+
+        bool isValid() const { return stmt != nullptr; }
+
+        // Parameters are 1-based, as in SQL
+        bool bind(int index, qint64 value);
+        bool bind(int index, double value);
+        bool bind(int index, const QByteArray &utf8); // copied by SQLite
+        bool bind(int index, const QString &value) { return bind(index, value.toUtf8()); }
+
+        // True while there is a row; false when done or on error (see failed())
+        bool step();
+        bool reset();
+        bool failed() const { return error; }
+
+        // Columns are 0-based; -1 for an unknown name
+        int columnCount() const;
+        int columnIndex(const char *name) const;
+        bool isNull(int column) const;
+        qint64 int64(int column) const;
+        int integer(int column) const { return static_cast<int>(int64(column)); }
+        double real(int column) const;
+        QUtf8StringView text(int column) const;
+        QString string(int column) const { return text(column).toString(); }
+
+    private:
+        sqlite3_stmt *stmt = nullptr;
+        bool error = false;
+    };
+
+    // Borrows the handle of a QSQLITE connection, sharing its locks, page
+    // cache and open transaction. Detach before the connection closes.
+    class Connection
+    {
+    public:
+        // False unless database is an open QSQLITE connection
+        bool attach(const QSqlDatabase &database);
+        void detach() { db = nullptr; }
+        bool isAttached() const { return db != nullptr; }
+
+        // An invalid statement on error; the message is in lastError()
+        Statement prepare(const char *sql);
+        QString lastError() const;
+
+        // Online backup of the main database into a new file at path,
+        // pagesPerStep pages per step. The source is only locked during a
+        // step; between steps the thread sleeps pauseMs so other connections
+        // get in. Writes from other connections restart the copy, so after
+        // kMaxBackupRestarts the remaining pages are copied in one step.
+        static constexpr int kMaxBackupRestarts = 3;
+        bool backupTo(const QString &path, int pagesPerStep, int pauseMs, QString *error = nullptr);
+
+    private:
+        sqlite3 *db = nullptr;
+    };
+}
@@ -0,0 +1,67 @@
+#pragma once
+#include <QDateTime>
+#include <QString>
+#include <QStringList>
+#include <functional>
+#include <vector>
+
+struct SnapshotInfo
+{
+    QString id; // creation time, "yyyyMMdd-HHmmss-zzz" UTC, sorts chronologically
+    QDateTime created;
+    QString label;
+    qint64 size = 0;
+    QString sha256; // of the whole database image
+    int chunks = 0;
+    int newChunks = 0; // chunks this snapshot had to store (0 when listed)
+};
+
+// Content-addressed store of database snapshots.
+//
+// A snapshot is a consistent database image cut into fixed chunks of
+// kPagesPerChunk SQLite pages. Chunks are stored once under their SHA-256
+// (zlib-compressed, in chunks/<2 hex>/<hash>), and a snapshot is just a
+// manifest listing its chunk hashes plus the hash of the whole image, so
+// successive snapshots only write the chunks that changed. Every chunk and
+// the full image are re-hashed on verify and restore.
+//
+// Layout under the store directory:
+//   manifests/<id>.manifest   text: header lines, then one chunk hash per line
+//   chunks/ab/abcdef...       chunk payloads
+class SnapshotStore
+{
+public:
+    static constexpr int kPagesPerChunk = 16;
+
+    explicit SnapshotStore(const QString &directory);
+
+    // Default store for a database file: "<file>.snapshots"
+    static QString defaultDirectory(const QString &databasePath);
+
+    // Chunks a consistent, closed database image into the store
+    bool addImage(const QString &imagePath, const QString &label, SnapshotInfo &info);
+
+    std::vector<SnapshotInfo> list() const; // oldest first
+    bool find(const QString &id, SnapshotInfo &info) const;
+    // Latest snapshot taken at or before when; empty id if none
+    SnapshotInfo latestAt(const QDateTime &when) const;
+
+    // Re-hashes every chunk and the whole image without writing anything
+    bool verify(const QString &id) const;
+    // Rebuilds the image at targetPath (atomically replaced on success)
+    bool restore(const QString &id, const QString &targetPath) const;
+
+    // Keeps the newest keep snapshots and deletes chunks no longer referenced;
+    // returns snapshots removed or -1
+    int prune(int keep);
+
+    QString directory() const { return root; }
+
+private:
+    QString manifestPath(const QString &id) const;
+    QString chunkPath(const QString &hash) const;
+    bool readManifest(const QString &path, SnapshotInfo &info, QStringList *chunkHashes) const;
+    bool assemble(const QString &id, const std::function<bool(const QByteArray &)> &sink) const;
+
+    QString root;
+};
@@ -0,0 +1,58 @@
+#pragma once
+#include <QHash>
+#include <QObject>
+#include <QSqlDatabase>
+#include <QStringList>
+#include <functional>
+
+class Database;
+class QSqlQuery;
+
+// One SQLite file per campus: <root>/<tenant>.db.
+//
+// tenant() opens a tenant's Database on its own named connection the first
+// time it is asked for and keeps it for the life of the directory, so each
+// campus has isolated data, caches and rollups. Cross-campus reports go
+// through a separate in-memory hub connection that ATTACHes tenant files
+// on demand; SQLite allows kMaxAttached at once, so the least recently used
+// attachment is detached when the hub is full and wider reports run in
+// batches of kMaxAttached tenants, each batch as a single UNION ALL query.
+class TenantDirectory : public QObject
+{
+    Q_OBJECT
+public:
+    static constexpr int kMaxAttached = 10; // SQLITE_MAX_ATTACHED default
+
+    explicit TenantDirectory(const QString &rootDirectory, QObject *parent = nullptr);
+    ~TenantDirectory();
+
+    // CAMPUS_TENANT_DIR, else the "database/tenant_dir" setting, else "tenants"
+    static QString defaultRoot();
+    // Lowercase letters, digits, '-' and '_', at most 32 characters
+    static bool isValidTenantId(const QString &tenantId);
+
+    QString root() const { return rootDirectory; }
+    QString pathFor(const QString &tenantId) const;
+    // Tenants with a database file, sorted
+    QStringList tenantIds() const;
+
+    // Opens (creating the file and schema if needed); nullptr on a bad id or error
+    Database *tenant(const QString &tenantId);
+    void closeTenant(const QString &tenantId);
+
+    // Runs perTenantSelect once per tenant and streams the rows. "%1" in the
+    // SQL stands for the tenant's schema (use it as %1.jobs); every row gets
+    // the tenant id prepended as column 0. Returns false on any SQL error.
+    bool crossTenantQuery(const QString &perTenantSelect, const QStringList &tenantIds,
+                          const std::function<void(const QSqlQuery &)> &visitRow);
+
+private:
+    QString schemaFor(const QString &tenantId) const;
+    bool openHub();
+    bool attach(const QString &tenantId, const QStringList &pinned);
+
+    QString rootDirectory;
+    QHash<QString, Database *> openTenants;
+    QSqlDatabase hub;
+    QStringList attached; // least recently used first
+};
@@ -0,0 +1,59 @@
+#pragma once
+#include <QString>
+#include <QTimer>
+#include <functional>
+#include <vector>
+
+// Group commit for small writes on one connection.
+//
+// Each queued write is a single statement run later inside a shared
+// transaction, so a burst of clicks costs one commit (and one fsync)
+// instead of one per write. A batch is committed when the window after
+// the first queued write ends, when maxBatch writes are waiting, or when
+// flush() is called, e.g. before a read that must see the writes. The
+// window timer needs an event loop; without one writes wait for flush().
+//
+// done is called once the write is durable (true) or known lost (false).
+// A failed statement leaves the others in its batch alone; a failed
+// commit rolls the whole batch back and fails every callback.
+class WriteBatcher
+{
+public:
+    using Write = std::function<bool()>;
+    using Callback = std::function<void(bool committed)>;
+
+    static constexpr int kDefaultWindowMs = 10;
+    static constexpr int kDefaultMaxBatch = 256;
+
+    struct Stats
+    {
+        quint64 writes = 0;
+        quint64 batches = 0;
+        quint64 failedWrites = 0;
+    };
+
+    explicit WriteBatcher(const QString &connectionName);
+
+    void enqueue(Write write, Callback done = nullptr);
+    // Commits whatever is queued; false if any of it failed
+    bool flush();
+
+    bool hasPending() const { return !queue.empty(); }
+    void setWindow(int milliseconds) { timer.setInterval(milliseconds); }
+    void setMaxBatch(int writes) { maxBatch = writes; }
+    Stats stats() const { return totals; }
+
+private:
+    struct Pending
+    {
+        Write write;
+        Callback done;
+    };
+
+    QString connectionName;
+    std::vector<Pending> queue;
+    QTimer timer;
+    int maxBatch;
+    bool flushing;
+    Stats totals;
+};
@@ -33,13 +33,15 @@ public:
         int hoursPerWeek, int positionsAvailable, JobStatus status,
         bool workStudyEligible, bool internationalEligible, const QString &deadline, const QString &requirements = "",
         const QString &duties = "", const QString &skills = "", const QString &supervisorInfo = "",
-        const QString &contactEmail = "", const QString &schedule = "", const QString &requiredDocuments = "")
+        const QString &contactEmail = "", const QString &schedule = "", const QString &requiredDocuments = "",
+        const QString &openDate = "")
         : id(id), title(title), department(department), category(category),
           description(description), payRateMin(payRateMin), payRateMax(payRateMax),
           hoursPerWeek(hoursPerWeek), positionsAvailable(positionsAvailable),
           status(status), workStudyEligible(workStudyEligible), internationalEligible(internationalEligible), deadline(deadline),
           requirements(requirements), duties(duties), skills(skills),
-          supervisorInfo(supervisorInfo), contactEmail(contactEmail), schedule(schedule), requiredDocuments(requiredDocuments) {}
+          supervisorInfo(supervisorInfo), contactEmail(contactEmail), schedule(schedule), requiredDocuments(requiredDocuments),
+          openDate(openDate) {}
 
     // Getters
     int getId() const { return id; }
@@ -62,9 +64,12 @@ public:
     QString getContactEmail() const { return contactEmail; }
     QString getSchedule() const { return schedule; }
     QString getRequiredDocuments() const { return requiredDocuments; }
+    QString getOpenDate() const { return openDate; }
 
     // Helper methods
-    QString getStatusString() const
+    QString getStatusString() const { return statusToString(status); }
+
+    static QString statusToString(JobStatus status)
     {
         switch (status)
         {
@@ -111,4 +116,5 @@ private:
     QString contactEmail;
     QString schedule;
     QString requiredDocuments;
+    QString openDate; // when an Upcoming job starts accepting applications
 };
@@ -0,0 +1,240 @@
+#pragma once
+#include <QString>
+#include <QStringList>
+#include <QVariantList>
+#include <optional>
+#include <tuple>
+#include <utility>
+#include "models/job.h"
+
+// Typed job filters that compile to parameterized SQL and to an in-memory
+// predicate with the same meaning.
+//
+// Each predicate contributes one WHERE term with bound values (never spliced
+// text) and a matches() that evaluates without branching. JobFilter<Ps...>
+// fuses a fixed set of predicates: its operator() is a bitwise AND fold over
+// the predicates, so every combination of filter types gets its own inlined,
+// branch-free instantiation. visitJobFilter() maps runtime search options
+// onto those instantiations for the combinations the UI and CLI use, and
+// falls back to Optional<> terms for anything else.
+namespace JobFilters
+{
+    // One bit per JobStatus, so a Status term can accept several
+    constexpr unsigned statusBit(JobStatus status) { return 1u << static_cast<int>(status); }
+    // Open and Closing Soon jobs still take applications
+    constexpr unsigned kAcceptingApplications = statusBit(JobStatus::Open) | statusBit(JobStatus::ClosingSoon);
+
+    // Status is any of the bits in mask
+    struct Status
+    {
+        unsigned mask;
+
+        void appendSql(QStringList &terms, QVariantList &binds) const
+        {
+            QStringList marks;
+            for (int status = 0; status <= static_cast<int>(JobStatus::Upcoming); ++status)
+            {
+                if (mask & (1u << status))
+                {
+                    marks << "?";
+                    binds << status;
+                }
+            }
+            if (marks.isEmpty())
+                terms << "0";
+            else if (marks.size() == 1)
+                terms << "status = ?";
+            else
+                terms << "status IN (" + marks.join(", ") + ")";
+        }
+        bool matches(const Job &job) const { return (mask >> static_cast<int>(job.getStatus())) & 1u; }
+    };
+
+    struct Category
+    {
+        QString value;
+
+        void appendSql(QStringList &terms, QVariantList &binds) const
+        {
+            terms << "category = ?";
+            binds << value;
+        }
+        bool matches(const Job &job) const { return job.getCategory() == value; }
+    };
+
+    struct WorkStudy
+    {
+        void appendSql(QStringList &terms, QVariantList &) const { terms << "work_study_eligible = 1"; }
+        bool matches(const Job &job) const { return job.isWorkStudyEligible(); }
+    };
+
+    struct International
+    {
+        void appendSql(QStringList &terms, QVariantList &) const { terms << "international_eligible = 1"; }
+        bool matches(const Job &job) const { return job.isInternationalEligible(); }
+    };
+
+    // Inclusive bounds on hours_per_week
+    struct HoursRange
+    {
+        int min;
+        int max;
+
+        void appendSql(QStringList &terms, QVariantList &binds) const
+        {
+            terms << "hours_per_week BETWEEN ? AND ?";
+            binds << min << max;
+        }
+        bool matches(const Job &job) const
+        {
+            const int hours = job.getHoursPerWeek();
+            return (hours >= min) & (hours <= max);
+        }
+    };
+
+    // The whole advertised pay band must fall inside [min, max]
+    struct PayRange
+    {
+        double min;
+        double max;
+
+        void appendSql(QStringList &terms, QVariantList &binds) const
+        {
+            terms << "pay_rate_min >= ? AND pay_rate_max <= ?";
+            binds << min << max;
+        }
+        bool matches(const Job &job) const
+        {
+            return (job.getPayRateMin() >= min) & (job.getPayRateMax() <= max);
+        }
+    };
+
+    // Case-insensitive substring of title, department or description
+    struct Keyword
+    {
+        QString text;
+
+        void appendSql(QStringList &terms, QVariantList &binds) const
+        {
+            QString escaped = text;
+            escaped.replace("\\", "\\\\").replace("%", "\\%").replace("_", "\\_");
+            const QString pattern = "%" + escaped + "%";
+            terms << "(title LIKE ? ESCAPE '\\' OR department LIKE ? ESCAPE '\\' "
+                     "OR description LIKE ? ESCAPE '\\')";
+            binds << pattern << pattern << pattern;
+        }
+        bool matches(const Job &job) const
+        {
+            return job.getTitle().contains(text, Qt::CaseInsensitive) |
+                   job.getDepartment().contains(text, Qt::CaseInsensitive) |
+                   job.getDescription().contains(text, Qt::CaseInsensitive);
+        }
+    };
+
+    // A predicate switched on or off at runtime, for uncommon combinations
+    template <typename Predicate>
+    struct Optional
+    {
+        bool enabled;
+        Predicate predicate;
+
+        void appendSql(QStringList &terms, QVariantList &binds) const
+        {
+            if (enabled)
+                predicate.appendSql(terms, binds);
+        }
+        bool matches(const Job &job) const { return !enabled | predicate.matches(job); }
+    };
+}
+
+template <typename... Predicates>
+class JobFilter
+{
+public:
+    explicit JobFilter(Predicates... predicates) : predicates(std::move(predicates)...) {}
+
+    // "a AND b AND ..." over the predicates, or "1" when there are none
+    QString whereClause() const
+    {
+        QStringList terms;
+        QVariantList binds;
+        collect(terms, binds);
+        return terms.isEmpty() ? QString("1") : terms.join(" AND ");
+    }
+
+    // Values for the '?' placeholders of whereClause(), in order
+    QVariantList bindValues() const
+    {
+        QStringList terms;
+        QVariantList binds;
+        collect(terms, binds);
+        return binds;
+    }
+
+    bool operator()(const Job &job) const
+    {
+        return std::apply([&job](const Predicates &...p)
+                          { return (true & ... & p.matches(job)); },
+                          predicates);
+    }
+
+private:
+    void collect(QStringList &terms, QVariantList &binds) const
+    {
+        std::apply([&](const Predicates &...p)
+                   { (p.appendSql(terms, binds), ...); },
+                   predicates);
+    }
+
+    std::tuple<Predicates...> predicates;
+};
+
+template <typename... Predicates>
+JobFilter<Predicates...> makeJobFilter(Predicates... predicates)
+{
+    return JobFilter<Predicates...>(std::move(predicates)...);
+}
+
+// Runtime description of a search, e.g. from CLI options or UI controls
+struct JobSearchOptions
+{
+    QString keyword;
+    // JobFilters::statusBit() set; 0 leaves status unfiltered
+    unsigned statuses = 0;
+    QString category;
+    bool workStudyOnly = false;
+    bool internationalOnly = false;
+    std::optional<std::pair<int, int>> hours;
+    std::optional<std::pair<double, double>> pay;
+};
+
+// Calls visit(filter) with a JobFilter specialized for the set options.
+// Status plus at most one eligibility flag, and keyword-only searches, get
+// exact instantiations; anything else uses the Optional<> fallback.
+template <typename Visitor>
+auto visitJobFilter(const JobSearchOptions &options, Visitor &&visit)
+{
+    using namespace JobFilters;
+    const bool onlyStatusAndFlags = options.statuses && options.keyword.isEmpty() && options.category.isEmpty() &&
+                                    !options.hours && !options.pay;
+    if (onlyStatusAndFlags && !options.workStudyOnly && !options.internationalOnly)
+        return visit(makeJobFilter(Status{options.statuses}));
+    if (onlyStatusAndFlags && options.workStudyOnly && !options.internationalOnly)
+        return visit(makeJobFilter(Status{options.statuses}, WorkStudy{}));
+    if (onlyStatusAndFlags && !options.workStudyOnly && options.internationalOnly)
+        return visit(makeJobFilter(Status{options.statuses}, International{}));
+    if (!options.statuses && !options.keyword.isEmpty() && options.category.isEmpty() && !options.workStudyOnly &&
+        !options.internationalOnly && !options.hours && !options.pay)
+        return visit(makeJobFilter(Keyword{options.keyword}));
+
+    const auto hours = options.hours.value_or(std::make_pair(0, 0));
+    const auto pay = options.pay.value_or(std::make_pair(0.0, 0.0));
+    return visit(makeJobFilter(
+        Optional<Status>{options.statuses != 0, Status{options.statuses}},
+        Optional<Category>{!options.category.isEmpty(), Category{options.category}},
+        Optional<WorkStudy>{options.workStudyOnly, WorkStudy{}},
+        Optional<International>{options.internationalOnly, International{}},
+        Optional<HoursRange>{options.hours.has_value(), HoursRange{hours.first, hours.second}},
+        Optional<PayRange>{options.pay.has_value(), PayRange{pay.first, pay.second}},
+        Optional<Keyword>{!options.keyword.isEmpty(), Keyword{options.keyword}}));
+}
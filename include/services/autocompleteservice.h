@@ -0,0 +1,52 @@
+#pragma once
+#include <QObject>
+#include <QSqlDatabase>
+#include <QStringList>
+#include <memory>
+#include "database/database.h"
+#include "utils/completiontrie.h"
+
+// Search box suggestions from job titles, departments, skills and past
+// queries (search_history), weighted by how often each term occurs.
+//
+// The CompletionTrie is built on the global thread pool over a private
+// connection and published with an atomic shared_ptr swap, so suggest()
+// never waits for a rebuild and readers keep the trie they loaded until
+// they are done with it. Rebuilds run after job changes and every
+// kHistoryRebuildEvery recorded queries; requests made while one is
+// running are folded into a single follow-up build.
+class AutocompleteService : public QObject
+{
+    Q_OBJECT
+public:
+    static constexpr int kHistoryRebuildEvery = 20;
+
+    explicit AutocompleteService(Database *db, QObject *parent = nullptr);
+
+    // Empty until the first build has finished
+    QStringList suggest(const QString &prefix, int limit = CompletionTrie::kDefaultTopK) const;
+    std::shared_ptr<const CompletionTrie> currentTrie() const;
+
+    // Counts a submitted query and schedules a rebuild now and then
+    void recordQuery(const QString &text);
+
+    // Reads the sources from db; usable from any thread that owns db
+    static std::vector<CompletionTrie::Entry> collectEntries(const QSqlDatabase &db);
+
+public slots:
+    void rebuildAsync();
+    // Builds on the calling thread over the Database's own connection
+    void rebuildNow();
+
+signals:
+    void rebuilt(int entries);
+
+private:
+    void publish(std::shared_ptr<const CompletionTrie> trie);
+
+    Database *database;
+    std::shared_ptr<const CompletionTrie> trie; // std::atomic_load/atomic_store only
+    bool building;
+    bool rebuildPending;
+    int queriesSinceRebuild;
+};
@@ -0,0 +1,102 @@
+#pragma once
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QByteArray>
+#include <QHash>
+#include <QMutex>
+#include <QThreadPool>
+#include <functional>
+#include <list>
+
+// Cost parameters for scrypt. Memory per hash is 128 * r * 2^logN bytes.
+struct KdfParams
+{
+    int logN = 14;
+    int r = 8;
+    int p = 1;
+
+    bool operator==(const KdfParams &other) const
+    {
+        return logN == other.logN && r == other.r && p == other.p;
+    }
+    bool operator!=(const KdfParams &other) const { return !(*this == other); }
+};
+
+// Password hashing and verification off the GUI thread.
+//
+// Hashes are stored as "$scrypt$ln=14,r=8,p=1$<salt>$<hash>" (base64).
+// Rows created before this format hold an unsalted SHA-256 hex digest;
+// those still verify and are reported as needing a rehash so callers can
+// upgrade them on the next successful login.
+//
+// KDF work runs on a private, bounded thread pool. The pool queue is FIFO,
+// so a burst of logins is served in arrival order and the number of
+// 16 MiB scrypt buffers alive at once is capped by the pool size.
+class CredentialService : public QObject
+{
+    Q_OBJECT
+public:
+    explicit CredentialService(QObject *parent = nullptr);
+    ~CredentialService();
+
+    KdfParams params() const { return kdfParams; }
+    void setParams(const KdfParams &params) { kdfParams = params; }
+    void setMaxConcurrentHashes(int count);
+
+    // Blocking primitives, safe to call from any thread
+    static QString hashPassword(const QString &password, const KdfParams &params);
+    static bool verifyPassword(const QString &password, const QString &stored,
+                               const KdfParams &current, bool *needsRehash = nullptr);
+    static bool isLegacyHash(const QString &stored);
+
+    // Verification with the login cache in front of the KDF. An empty
+    // stored hash (unknown user) still costs one KDF run so response time
+    // does not reveal which emails are registered.
+    bool verifyBlocking(const QString &email, const QString &password,
+                        const QString &stored, QString *rehash = nullptr);
+
+    // Asynchronous variants. done runs on the thread that owns this service
+    // and is skipped if context has been destroyed meanwhile. rehash is a
+    // fresh hash when the stored one used the legacy format or old params.
+    void hashAsync(const QString &password, QObject *context,
+                   std::function<void(const QString &hash)> done);
+    void verifyAsync(const QString &email, const QString &password, const QString &stored,
+                     QObject *context, std::function<void(bool ok, const QString &rehash)> done);
+
+    // Drops cached verifications for an account (password changed)
+    void forgetLogin(const QString &email);
+
+    // Largest logN whose hash time stays within targetMs on this machine.
+    // report, if given, receives one "logN=<n> <ms> ms" line per probe.
+    static KdfParams calibrate(int targetMs, const KdfParams &base = KdfParams(),
+                               QStringList *report = nullptr);
+
+    // Reads the calibrated cost from QSettings (security/kdf_log_n)
+    static KdfParams configuredParams();
+    static void saveConfiguredParams(const KdfParams &params);
+
+private:
+    // Small LRU of recent successful logins. Entries hold an HMAC of the
+    // password under a per-process key, never the password itself, and
+    // are only valid while the stored hash is unchanged.
+    struct CachedLogin
+    {
+        QString storedHash;
+        QByteArray passwordTag;
+    };
+
+    QByteArray passwordTag(const QString &password) const;
+    bool cacheLookup(const QString &email, const QString &password, const QString &stored);
+    void cacheInsert(const QString &email, const QString &password, const QString &stored);
+
+    static constexpr int kLoginCacheSize = 256;
+
+    KdfParams kdfParams;
+    QThreadPool pool;
+    QByteArray processKey;
+
+    QMutex cacheMutex;
+    std::list<QString> cacheOrder; // most recent first
+    QHash<QString, std::pair<CachedLogin, std::list<QString>::iterator>> loginCache;
+};
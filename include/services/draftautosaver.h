@@ -0,0 +1,71 @@
+#pragma once
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QObject>
+#include <QSet>
+#include <QString>
+#include <QTimer>
+#include <functional>
+#include <memory>
+#include "database/database.h"
+
+struct DraftWriteQueue;
+
+// Autosave of one user's application draft for one job.
+//
+// Editors call markChanged() on every keystroke, which only restarts a
+// debounce timer. When it fires each changed field is read once and
+// compared with the value last handed to the writer, and only fields that
+// differ are queued. Every autosaver of a draft shares one queue, drained
+// by at most one thread pool task over a private connection; fields queued
+// while a write runs are merged into the next transaction, newest value
+// winning. A draft thus costs at most one small transaction per pause in
+// typing (or per kMaxDelayMs of continuous typing) and the editor never
+// waits on the disk. A failed batch stays queued and is retried with
+// backoff until it lands.
+class DraftAutosaver : public QObject
+{
+    Q_OBJECT
+public:
+    static constexpr int kDebounceMs = 800;
+    static constexpr int kMaxDelayMs = 5000;
+
+    DraftAutosaver(Database *db, int userId, int jobId, QObject *parent = nullptr);
+
+    // reader returns the field's current value; it is only called from
+    // this object's thread, and never from the destructor, so call flush()
+    // while the editors still exist
+    void addField(const QString &name, std::function<QString()> reader);
+
+    // Stored fields overlaid with writes still queued; also becomes the
+    // baseline that later changes are diffed against
+    QHash<QString, QString> restore();
+
+    // Queued changes are not yet on disk (a write runs, waits, or awaits a retry)
+    bool isSaving() const;
+
+public slots:
+    void markChanged(const QString &name);
+    // Queues the unsaved changes now instead of after the debounce
+    void flush();
+    // Drops the draft, e.g. once the application has been submitted
+    void discard();
+
+signals:
+    void saved(const QDateTime &when);
+    void saveFailed();
+
+private:
+    void enqueue(const QHash<QString, QString> &fields, bool clear);
+
+    Database *database;
+    int userId;
+    int jobId;
+    std::shared_ptr<DraftWriteQueue> queue; // null for in-memory databases
+    QHash<QString, std::function<QString()>> readers;
+    QHash<QString, QString> lastQueued;
+    QSet<QString> changed;
+    QTimer debounce;
+    QElapsedTimer firstChange; // started by the oldest unsaved change
+};
@@ -0,0 +1,49 @@
+#pragma once
+#include <QHash>
+#include <QObject>
+#include <vector>
+#include "database/database.h"
+#include "models/job.h"
+#include "utils/trigramindex.h"
+
+// Typo-tolerant job lookup over titles, departments and skills.
+//
+// The catalog is read once into a TrigramIndex plus an in-memory copy of
+// each job, so per-keystroke suggestions never touch SQLite. When the
+// database reports job changes, refresh() re-reads only the rows logged in
+// job_changes since the indexed jobs table version, and re-indexes those
+// whose searchable text changed (status-only updates just swap the stored
+// copy); updateJob()/removeJob() apply a single edit directly.
+class FuzzyJobSearch : public QObject
+{
+    Q_OBJECT
+public:
+    struct Result
+    {
+        Job job;
+        int distance;
+    };
+
+    explicit FuzzyJobSearch(Database *db, QObject *parent = nullptr);
+
+    // Best matches first; builds the index on first use
+    std::vector<Result> search(const QString &query, int limit);
+    int indexedJobs() const { return index.size(); }
+    qint64 indexedPostings() const { return index.postingCount(); }
+
+public slots:
+    void rebuild();
+    void refresh();
+    void updateJob(const Job &job);
+    void removeJob(int jobId);
+
+private:
+    static QStringList searchableFields(const Job &job);
+    void rescan();
+
+    Database *database;
+    TrigramIndex index;
+    QHash<int, Job> jobs;
+    bool built;
+    qint64 indexedVersion; // jobs table version the index reflects
+};
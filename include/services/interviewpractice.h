@@ -0,0 +1,76 @@
+#pragma once
+#include <QHash>
+#include <QSet>
+#include <QString>
+#include <vector>
+#include "database/database.h"
+#include "utils/questionbank.h"
+
+// Adaptive interview practice over a compiled question bank.
+//
+// Each user has an ability estimate per topic (question mode) under a
+// one-parameter (Rasch) model: a question of difficulty b is answered
+// correctly with probability 1 / (1 + e^(b - ability)). The next question
+// comes from the difficulty level with the most Fisher information at the
+// current ability, p * (1 - p), which is the level whose b is closest to
+// it. The bank already groups questions by level, so choosing is a few
+// index lookups no matter how large the bank or the history grows.
+//
+// Answers update the estimate in memory at once. Attempts and the new
+// estimates are written together, kBatchSize at a time, in one transaction;
+// the rest go out on flush(), on a user change and on destruction.
+class InterviewPractice
+{
+public:
+    InterviewPractice(Database *db, const QuestionBank *bank);
+    ~InterviewPractice();
+
+    // Loads the user's estimates; pending attempts of the previous user are flushed first
+    void setUser(int userId, const QString &major);
+    int userId() const { return currentUserId; }
+
+    // Picks the most informative question of topic not yet asked this
+    // session; false if the bank has none
+    bool nextQuestion(const QString &topic, Question &question);
+    // Scores the question returned by the last nextQuestion()
+    void recordAnswer(bool correct);
+
+    double ability(const QString &topic) const;
+    // Chance of answering a medium question of topic correctly
+    double expectedScore(const QString &topic) const;
+
+    bool flush();
+
+private:
+    static constexpr int kBatchSize = 20;
+    static constexpr int kScanLimit = 32; // candidates checked per level
+    static constexpr double kMaxAbility = 4.0;
+
+    struct TopicState
+    {
+        double ability = 0.0;
+        int attempts = 0;
+        bool dirty = false;
+    };
+
+    struct PendingQuestion
+    {
+        bool valid = false;
+        QString topic;
+        quint32 id = 0;
+        int difficulty = 0;
+    };
+
+    static double difficultyParameter(int level);
+    static double probabilityCorrect(double ability, double difficulty);
+    qint64 pickUnasked(const QString &topic, int level);
+
+    Database *database;
+    const QuestionBank *questionBank;
+    int currentUserId;
+    QString currentMajor;
+    QHash<QString, TopicState> topics;
+    QSet<quint32> asked;
+    PendingQuestion pending;
+    std::vector<InterviewAttempt> pendingAttempts;
+};
@@ -0,0 +1,107 @@
+#pragma once
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <vector>
+#include "database/database.h"
+#include "utils/availability.h"
+
+// Assigns interview times to applicants for a hiring week.
+//
+// Interviews are fixed-length windows on a grid starting at 06:00. Every
+// applicant is interviewed by the supervisor of the job applied to, at a
+// window that is free in both calendars. A supervisor holds at most
+// supervisorCapacity interviews per window and at most `rooms` interviews
+// run at any one window. That is a flow network
+//
+//   source -1-> applicant -1-> (supervisor, window) -cap-> window -rooms-> sink
+//
+// and a maximum flow (Dinic) books as many applicants as possible. Arcs
+// are added in time order, so earlier windows are tried first.
+//
+// Cancellations are incremental: the cancelled person's flow is removed
+// and solve() augments the remaining flow, which takes a single Dinic
+// phase or two instead of a full re-solve.
+class InterviewScheduler
+{
+public:
+    explicit InterviewScheduler(int interviewMinutes = 30, int rooms = 1, int supervisorCapacity = 1);
+
+    // Returns the supervisor's index; a known name replaces the calendar
+    int addSupervisor(const QString &name, const Availability &calendar);
+    // Unknown supervisors are ignored (returns false)
+    bool addApplicant(int applicationId, const QString &supervisor, const Availability &availability);
+
+    // Adds every supervisor calendar and each application to a job whose
+    // supervisor has one; returns the number of applicants added
+    int load(Database *db);
+    // Pre-books a saved interview so that solving keeps it where it can;
+    // false if it no longer fits
+    bool book(int applicationId, int day, int startMinute);
+
+    // Books as many applicants as possible; returns how many are booked
+    int solve();
+
+    // Drops an applicant and offers the freed window to the others
+    bool cancelApplicant(int applicationId);
+    // Removes blocked from a supervisor's calendar; displaced applicants are rebooked where possible
+    bool cancelSupervisorTime(const QString &supervisor, const Availability &blocked);
+
+    std::vector<ScheduledInterview> schedule() const;
+    int applicantCount() const { return static_cast<int>(applicants.size()); }
+    int bookedCount() const { return booked; }
+    int windowsPerDay() const { return windowCount; }
+
+private:
+    struct Edge
+    {
+        int to;
+        int capacity; // residual
+    };
+
+    struct Applicant
+    {
+        int applicationId;
+        int supervisor;
+        Availability availability;
+        int sourceEdge = -1;
+        bool cancelled = false;
+    };
+
+    // Node layout: source, sink, applicants, windows, then (supervisor, window) pairs
+    enum
+    {
+        Source = 0,
+        Sink = 1
+    };
+
+    void build();
+    int addEdge(int from, int to, int capacity);
+    int windowNode(int day, int window) const { return 2 + applicantCount() + day * windowCount + window; }
+    quint64 windowMask(int window) const;
+    bool bfs();
+    int dfs(int node, int pushed);
+    // Takes one unit of flow off the applicant's booking (it stays eligible)
+    void unbook(int applicant);
+
+    int windowSlots;   // 15-minute slots per interview
+    int windowCount;   // interview windows per day
+    int rooms;
+    int supervisorCapacity;
+
+    QStringList supervisorNames;
+    QHash<QString, int> supervisorIndex;
+    std::vector<Availability> calendars;
+    std::vector<Applicant> applicants;
+    QHash<int, int> applicantIndex;
+
+    bool built;
+    int booked;
+    std::vector<Edge> edges; // edge ^ 1 is its reverse
+    std::vector<std::vector<int>> graph;
+    std::vector<int> level;
+    std::vector<size_t> nextArc;
+    std::vector<int> supervisorNodes; // (supervisor * 7 + day) * windowCount + window -> node, or -1
+    std::vector<int> nodeSupervisor;  // node -> supervisor for (supervisor, window) nodes, else -1
+    std::vector<int> nodeWindow;      // node -> day * windowCount + window, else -1
+};
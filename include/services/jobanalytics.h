@@ -0,0 +1,66 @@
+#pragma once
+#include <QMap>
+#include <QSqlDatabase>
+#include <QString>
+#include <QStringList>
+#include <vector>
+
+// Headline numbers for dashboards, read from the rollup tables
+struct JobBoardSummary
+{
+    int openJobs = 0;      // Open + Closing Soon
+    int openPositions = 0; // positions_available across open jobs
+    int openApplications = 0;
+    int totalApplications = 0;
+    int totalInterests = 0;
+    int convertedInterests = 0; // interested students who went on to apply
+    int jobsFilled = 0;
+    double averageDaysToFill = 0;
+
+    double applicantsPerOpenPosition() const
+    {
+        return openPositions > 0 ? double(openApplications) / openPositions : 0;
+    }
+    double interestConversionRate() const
+    {
+        return totalInterests > 0 ? double(convertedInterests) / totalInterests : 0;
+    }
+};
+
+struct JobActivity
+{
+    int jobId = -1;
+    QString title;
+    int applications = 0;
+    int interests = 0;
+};
+
+// Incrementally maintained job-board aggregates.
+//
+// SQLite triggers on jobs, job_applications and job_interests keep three
+// rollup tables current as rows change, inside the writer's transaction:
+//   rollup_jobs          (dimension, key, status) -> jobs, positions, applications
+//                        for dimension 'category' and 'department'
+//   rollup_job_activity  job_id -> applications, interests, conversions,
+//                        opened_at, filled_at
+//   rollup_weekly        (week, metric) -> value, week as "YYYY-Www"
+// Readers only touch these small tables, never the raw ones. rebuild()
+// recomputes everything from scratch (install() does it once when the
+// rollups are first created). Every call works on the given connection, so
+// each tenant database keeps its own rollups.
+class JobAnalytics
+{
+public:
+    // Creates rollup tables and triggers; call after the source tables exist
+    static bool install(const QSqlDatabase &db);
+    static bool rebuild(const QSqlDatabase &db);
+
+    static QMap<QString, int> jobCountsBy(const QSqlDatabase &db, const QString &dimension, int status = -1);
+    static QMap<QString, int> openPositionsBy(const QSqlDatabase &db, const QString &dimension);
+    static JobBoardSummary summary(const QSqlDatabase &db);
+    // Most recent weeks first; metric is applications, interests,
+    // jobs_opened, jobs_filled, fill_samples or fill_seconds
+    static std::vector<std::pair<QString, int>> weekly(const QSqlDatabase &db, const QString &metric, int weeks);
+    static std::vector<JobActivity> topJobsByApplications(const QSqlDatabase &db, int limit);
+    static QString currentWeek(const QSqlDatabase &db);
+};
@@ -0,0 +1,66 @@
+#pragma once
+#include <QObject>
+#include <QHash>
+#include <QTimer>
+#include <vector>
+#include "database/database.h"
+#include "models/job.h"
+#include "utils/timerwheel.h"
+
+// Moves jobs between Upcoming, Open, ClosingSoon and Closed as their
+// open_date and deadline pass.
+//
+// start() reads the catalog once and files each job's next transition in
+// a TimerWheel; a single precise timer then sleeps until the wheel's next
+// wake-up. Transitions that fall due together are written in one
+// transaction through Database::applyJobStatusChanges, and the job's
+// following transition (e.g. ClosingSoon -> Closed) is filed right after.
+// Nothing polls or rescans the jobs table while the app runs.
+class JobStatusScheduler : public QObject
+{
+    Q_OBJECT
+public:
+    explicit JobStatusScheduler(Database *db, QObject *parent = nullptr);
+
+    // Days before the deadline at which an open job shows as closing soon
+    void setClosingSoonDays(int days) { closingSoonDays = days; }
+    int pendingTransitions() const { return wheel.size(); }
+
+    void start();
+    // Refiles one job after it was edited or imported
+    void reschedule(int jobId);
+
+    // Deadline is inclusive: a job due "2025-12-20" closes at the start of
+    // 2025-12-21 local time. Both return seconds since epoch, -1 if unparsable.
+    static qint64 parseDeadline(const QString &text);
+    static qint64 parseOpenDate(const QString &text);
+
+signals:
+    void jobStatusChanged(int jobId, JobStatus status);
+
+private slots:
+    void onTimer();
+
+private:
+    struct TrackedJob
+    {
+        JobStatus status = JobStatus::Closed;
+        qint64 opensAt = -1;
+        qint64 closesAt = -1;
+        quint32 generation = 0;
+    };
+
+    JobStatus statusAt(const TrackedJob &job, qint64 when) const;
+    qint64 nextChangeAfter(const TrackedJob &job, qint64 now) const;
+    void track(const Job &job, qint64 now, std::vector<JobStatusChange> &changes);
+    void fileNext(int jobId, qint64 now);
+    void apply(const std::vector<JobStatusChange> &changes);
+    void armTimer();
+
+    Database *database;
+    TimerWheel wheel;
+    QTimer timer;
+    QHash<int, TrackedJob> jobs;
+    quint32 generationCounter;
+    int closingSoonDays;
+};
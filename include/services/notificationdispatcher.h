@@ -0,0 +1,38 @@
+#pragma once
+#include <QObject>
+#include <memory>
+#include "database/database.h"
+#include "models/job.h"
+#include "services/notificationsink.h"
+
+// Sends "notify me when it opens" notices when a job becomes Open.
+//
+// Subscribers come from job_interests rows with notify = 1 that have not
+// been notified yet. They are read in batches of kBatchSize, continuing
+// from the last interest id through a partial index, so fan-out is one
+// indexed range scan however many people subscribed. Each batch is handed
+// to the sink and marked notified in a single transaction, which makes
+// redelivery after a crash at most one batch.
+class NotificationDispatcher : public QObject
+{
+    Q_OBJECT
+public:
+    explicit NotificationDispatcher(Database *db, std::unique_ptr<NotificationSink> notificationSink,
+                                    QObject *parent = nullptr);
+
+    // Notifies every pending subscriber of jobId; returns how many, or -1
+    int dispatchJobOpened(int jobId);
+
+public slots:
+    // Connect to JobStatusScheduler::jobStatusChanged
+    void onJobStatusChanged(int jobId, JobStatus status);
+
+signals:
+    void notificationsSent(int jobId, int count);
+
+private:
+    static constexpr int kBatchSize = 500;
+
+    Database *database;
+    std::unique_ptr<NotificationSink> sink;
+};
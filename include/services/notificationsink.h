@@ -0,0 +1,42 @@
+#pragma once
+#include <QString>
+#include <vector>
+#include "database/database.h"
+
+// Destination for "position is now open" notices. The dispatcher hands a
+// sink one batch at a time; returning false aborts the batch so those
+// subscribers stay pending and are retried on the next dispatch.
+class NotificationSink
+{
+public:
+    virtual ~NotificationSink() = default;
+    virtual QString name() const = 0;
+    virtual bool deliver(const std::vector<Notification> &batch) = 0;
+};
+
+// Queues notices in the notification_outbox table, inside the dispatcher's
+// transaction, for a separate sender to pick up
+class OutboxTableSink : public NotificationSink
+{
+public:
+    explicit OutboxTableSink(Database *db) : database(db) {}
+    QString name() const override { return "outbox"; }
+    bool deliver(const std::vector<Notification> &batch) override;
+
+private:
+    Database *database;
+};
+
+// Writes each batch as one JSON-lines file in a spool directory, the way a
+// mail drop or test harness would consume it. Files appear atomically.
+class FileSpoolSink : public NotificationSink
+{
+public:
+    explicit FileSpoolSink(const QString &directory);
+    QString name() const override { return "spool"; }
+    bool deliver(const std::vector<Notification> &batch) override;
+
+private:
+    QString spoolDirectory;
+    int sequence;
+};
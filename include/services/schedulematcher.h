@@ -0,0 +1,39 @@
+#pragma once
+#include <vector>
+#include "database/database.h"
+#include "models/job.h"
+#include "utils/availability.h"
+
+// How well one application's availability fits a job's shift grid
+struct ShiftMatch
+{
+    int applicationId = -1;
+    int userId = -1;
+    int overlapSlots = 0;   // 15-minute slots of the shift the applicant can work
+    double coverage = 0.0;  // overlapSlots / shift slots
+    bool coversShift = false;
+};
+
+// Matches applicants against a job's shifts on parsed availability.
+//
+// Both sides are weekly slot bitmasks (see Availability), so scoring an
+// applicant is seven AND + popcount pairs; a job's whole applicant list is
+// loaded with one indexed query and ranked in microseconds.
+class ScheduleMatcher
+{
+public:
+    explicit ScheduleMatcher(Database *db);
+
+    // The job's schedule text, parsed; empty when it has none
+    static Availability shiftGrid(const Job &job);
+
+    // Applicants of jobId against shift, or against the job's own schedule
+    // when shift is empty; best fit first
+    std::vector<ShiftMatch> matchJob(int jobId, const Availability &shift = Availability());
+
+    static std::vector<ShiftMatch> rank(const Availability &shift,
+                                        const std::vector<ApplicantAvailability> &applicants);
+
+private:
+    Database *database;
+};
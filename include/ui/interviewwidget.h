@@ -7,14 +7,10 @@
 #include <QVBoxLayout>
 #include <QVector>
 #include <QString>
-
-// Simple structure to hold one interview question
-struct Question
-{
-    QString text;             // The question text
-    QString correctAnswer;    // The correct answer
-    QVector<QString> options; // All answer choices (including correct one)
-};
+#include <memory>
+#include "database/database.h"
+#include "services/interviewpractice.h"
+#include "utils/questionbank.h"
 
 class InterviewWidget : public QWidget
 {
@@ -22,7 +18,12 @@ class InterviewWidget : public QWidget
 
 public:
     // Constructor: takes the student's degree ("Arts" or "Science")
-    explicit InterviewWidget(const QString &degree, QWidget *parent = nullptr);
+    explicit InterviewWidget(Database *db, const QString &degree, QWidget *parent = nullptr);
+
+    // Questions are drawn for this major from the next quiz on
+    void setDegree(const QString &degree);
+    // Practice results are saved for this user; -1 keeps them in memory
+    void setUserId(int userId);
 
 signals:
     void interviewComplete(int finalScore); // Emitted when interview ends
@@ -35,6 +36,8 @@ private slots:
     void backToLanding();           // Go back to landing screen
 
 private:
+    static const int kQuizLength = 5; // Questions per adaptive quiz
+
     // Setup functions
     void setupQuestions();  // Creates all the questions
     void setupLandingUI();  // Creates the landing screen with 2 blocks
@@ -43,15 +46,23 @@ private:
 
     // Helper to get current question list based on mode
     QVector<Question> &getCurrentQuestions();
+    // Switches to adaptive questions from the bank when it covers topic
+    void prepareQuiz(const QString &topic, QVector<Question> &questions);
 
     // Data
+    QString degree;           // Student's major, used to pick questions
     QString currentMode;      // "Behavior Questions" or "Technical Questions"
+    QString currentTopic;     // Bank mode of the quiz: "behavior" or "technical"
+    bool adaptiveQuiz;        // Questions picked one at a time by the practice engine
+    int quizLength;           // Questions in the current quiz
     int currentQuestionIndex; // Which question we're on (0, 1, 2...)
     int score;                // How many questions answered correctly
 
     // Question banks
     QVector<Question> behaviorQuestions;  // Behavior questions
     QVector<Question> technicalQuestions; // Technical questions
+    QuestionBank questionBank;            // Compiled bank; built-in questions if missing
+    std::unique_ptr<InterviewPractice> practice; // Picks questions and tracks mastery
 
     // UI elements
     QWidget *landingWidget;  // Landing screen container
@@ -17,7 +17,10 @@ public:
     explicit LandingPage(Database *db, int userId, QWidget *parent = nullptr);
 
     // Allow updating the user ID after construction
-    void setUserId(int userId) { currentUserId = userId; }
+    void setUserId(int userId);
+
+    // Re-reads the job-board headline numbers from the rollup tables
+    void refreshMetrics();
 
 signals:
     // Signal emitted when user clicks "Let's Get Started"
@@ -34,10 +37,9 @@ signals:
 private:
     // Setup functions
     void setupUI();     // Creates all widgets and layouts
-    void setupStyles(); // Applies styling
 
     // Helper function to create feature boxes
-    QPushButton* createFeatureBox(const QString& title, const QString& description, const QString& bgColor);
+    QPushButton* createFeatureBox(const QString& title, const QString& description);
    
     // Database and user info
     Database *database;
@@ -50,6 +52,7 @@ private:
     QLabel *descriptionLabel;    // Description paragraph
     QPushButton *getStartedBtn;  // Primary action button
     QPushButton *skipBtn;        // Secondary action button
+    QLabel *metricsLabel;        // Open positions / weekly applications strip
     QHBoxLayout *featuresLayout; // Layout holding the 3 feature boxes
 };
 
@@ -13,6 +13,7 @@
 #include "ui/studentsurveydialog.h"
 #include "ui/onboardingpage.h"
 #include "ui/myaccountpage.h"
+#include "ui/pagetransition.h"
 
 class MainWindow : public QMainWindow
 {
@@ -34,14 +35,13 @@ private slots:
 
 private:
     void setupUI();
-    void setupStyles();
     void loadUserData(const QString &username);
-    void applyFadeTransition(QWidget *widget);
     void checkAndShowLandingPage();
 
     Database *database;
     User currentUser;
     QStackedWidget *stackedWidget;
+    PageTransition *pageTransition;
     QToolBar *toolbar;
     MyProfilePage *profilePage;
     MyApplicationPage *applicationPage;
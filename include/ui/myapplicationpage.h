@@ -26,7 +26,6 @@ private slots:
 
 private:
     void setupUI();
-    void setupStyles();
     void loadDocuments();
     void updateDocumentCounts();
 
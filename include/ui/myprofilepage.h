@@ -27,7 +27,6 @@ private slots:
 
 private:
     void setupUI();
-    void setupStyles();
     void loadUser();
 
     Database *database;
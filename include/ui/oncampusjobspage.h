@@ -16,8 +16,14 @@
 #include <QFileDialog>
 #include <QScrollArea>
 #include <QSplitter>
+#include <QCompleter>
+#include <QStringListModel>
+#include "database/catalogsnapshot.h"
 #include "database/database.h"
 #include "models/job.h"
+#include "services/autocompleteservice.h"
+#include "services/draftautosaver.h"
+#include "services/fuzzyjobsearch.h"
 
 class JobApplicationDialog : public QDialog
 {
@@ -25,24 +31,36 @@ class JobApplicationDialog : public QDialog
 public:
     explicit JobApplicationDialog(Database *db, int userId, const Job &job, QWidget *parent = nullptr);
 
+    // Queues the unsaved draft fields however the dialog is closed
+    void done(int result) override;
+
 private slots:
     void browseResume();
     void browseCoverLetter();
     void submitApplication();
     void saveDraft();
+    void updateAvailabilityPreview();
 
 private:
     void setupUI();
+    void setupDraft();
+    // Closes the dialog after "Save Draft" once the write landed, or reports the failure
+    void finishSaveDraft(bool ok);
     Database *database;
     int userId;
     Job currentJob;
+    DraftAutosaver *autosaver;
+    bool closeAfterSave; // "Save Draft" is waiting for its write
 
     QLineEdit *resumePathEdit;
     QLineEdit *coverLetterPathEdit;
     QTextEdit *whyInterestedEdit;
     QTextEdit *availabilityEdit;
+    QLabel *availabilityPreview;
     QTextEdit *referencesEdit;
     QCheckBox *confirmCheckbox;
+    QPushButton *saveBtn;
+    QLabel *draftStatus;
 };
 
 class ExpressInterestDialog : public QDialog
@@ -70,13 +88,19 @@ class OnCampusJobsPage : public QWidget
 public:
     explicit OnCampusJobsPage(Database *db, int userId, QWidget *parent = nullptr);
 
+    // Switches to another student and resets the filters
+    void setUserId(int userId);
+
 signals:
     void jobApplied();
 
 private slots:
     void onJobCardClicked(QListWidgetItem *item);
     void onSearchTextChanged(const QString &text);
+    void onSearchTextEdited(const QString &text);
+    void onSearchSubmitted();
     void onFilterChanged();
+    void onJobListScrolled(int value);
     void applyFilters();
     void clearFilters();
     void applyForJob();
@@ -84,22 +108,45 @@ private slots:
 
 private:
     void setupUI();
-    void setupStyles();
     void loadCategories();
     void loadJobs();
-    void updateJobList(const std::vector<Job> &jobs);
+    void loadNextJobPage();
+    void showEmptyJobList();
+    void showFuzzyResults(const QString &text);
+    JobSearchOptions activeFilterOptions() const;
+    void appendJobCards(const std::vector<Job> &jobs);
+    void updateResultsCount();
     void showJobDetails(const Job &job);
     QString getCategoryIcon(const QString &category);
-    QString getStatusBadge(JobStatus status, int positions = 0);
+    QString getStatusBadge(JobStatus status, int positions = 0, const QString &openDate = QString());
 
     Database *database;
     int currentUserId;
     Job selectedJob;
-    std::vector<Job> currentJobs;
+    std::vector<Job> currentJobs; // pages loaded so far for the active filter
+    JobCursor jobCursor;
+    bool jobsExhausted;
+    static constexpr int kJobPageSize = 50;
+    // Every listed (Open or Closing Soon) job, kept once "All Students" has been paged to the end so
+    // eligibility changes filter in memory; dropped when jobs change
+    std::vector<Job> openJobsSnapshot;
+    bool haveOpenJobsSnapshot;
+    // Memory-mapped open jobs; pages are read from it instead of SQL when
+    // it was mapped as the listing started (file databases). catalogPosition
+    // is the next entry of the active filter's index.
+    CatalogSnapshot catalog;
+    int catalogPosition;
+    bool pagingCatalog;
+    // Typo-tolerant search box results, ranked by the trigram index
+    FuzzyJobSearch *fuzzySearch;
+    static constexpr int kFuzzyResultLimit = 100;
+    AutocompleteService *autocomplete;
     std::vector<int> savedJobIds;
 
     // Left panel - Search & Job List
     QLineEdit *searchEdit;
+    QCompleter *searchCompleter;
+    QStringListModel *suggestionModel;
     QComboBox *eligibilityFilter;
     QPushButton *clearFiltersBtn;
     QRadioButton *allStudentsBtn;
@@ -0,0 +1,41 @@
+#ifndef PAGETRANSITION_H
+#define PAGETRANSITION_H
+
+#include <QPixmap>
+#include <QStackedWidget>
+#include <QVariantAnimation>
+#include <QWidget>
+
+// Cross-fades between the pages of a QStackedWidget.
+//
+// The outgoing and incoming pages are grabbed into pixmaps once, and this
+// overlay paints the blend on top of the stack while the animation runs.
+// No graphics effect is ever attached to a page: when the fade ends the
+// overlay hides, the pixmaps are dropped and the real page paints directly.
+class PageTransition : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit PageTransition(QStackedWidget *stack);
+
+    // Makes page current; fades only when the stack is on screen
+    void switchTo(QWidget *page);
+    void setDuration(int msecs) { animation.setDuration(msecs); }
+    bool isRunning() const { return animation.state() == QAbstractAnimation::Running; }
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
+private:
+    void finish();
+
+    QStackedWidget *stack;
+    QVariantAnimation animation;
+    QPixmap outgoing;
+    QPixmap incoming;
+    qreal progress;
+};
+
+#endif // PAGETRANSITION_H
@@ -0,0 +1,58 @@
+#ifndef THEMEMANAGER_H
+#define THEMEMANAGER_H
+
+#include <QApplication>
+#include <QString>
+#include <QWidget>
+
+// What a widget is for, rather than how it looks; style.qss picks the look
+// per page with [role="..."] selectors
+enum class StyleRole
+{
+    None,
+    Title,
+    Heading,
+    Subtitle,
+    SectionTitle,
+    Body,
+    Emphasis,
+    Caption,
+    Hint,
+    Success,
+    Error,
+    Card,
+    MutedCard,
+    Notice,
+    NoticeTitle,
+    NoticeText,
+    Toolbar,
+    Primary,
+    Secondary,
+    Link,
+    Choice,
+    StatusPending,
+    StatusCompleted,
+    StatusProcessing,
+    Confirm
+};
+
+// Loads the application theme once: the palette and the single stylesheet
+// in resources/styles/style.qss. Widgets no longer carry their own sheets,
+// so Qt parses one sheet at startup instead of one per widget, and a widget
+// picks its look by role instead of by inline QSS.
+class ThemeManager
+{
+public:
+    static const char *defaultStyleSheetPath() { return ":/styles/style.qss"; }
+
+    // Call once, before any window is created
+    static bool install(QApplication &app, const QString &styleSheetPath = defaultStyleSheetPath());
+
+    // Re-polishes only when the widget is already on screen, so setting a
+    // role while building a page costs nothing extra
+    static void setRole(QWidget *widget, StyleRole role);
+    static StyleRole role(const QWidget *widget);
+    static const char *roleName(StyleRole role);
+};
+
+#endif // THEMEMANAGER_H
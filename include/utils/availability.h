@@ -0,0 +1,66 @@
+#pragma once
+#include <QString>
+#include <array>
+
+// A weekly set of 15-minute work slots between 06:00 and 22:00.
+//
+// That window is exactly 64 slots a day, so a week is seven quint64 words
+// (bit 0 of a day is 06:00-06:15). Overlap and coverage are an AND and a
+// popcount per day. In SQL each day is one INTEGER column (the bits
+// reinterpreted as qint64) and blockMask() folds the week into 21 bits,
+// one per morning/afternoon/evening of each day, which is what gets
+// indexed; an exact check on the day words follows the coarse match.
+//
+// parse() reads the free text students and employers write:
+// "Monday-Friday 2pm-6pm, flexible on weekends", "Tue/Thu mornings",
+// "MWF 9-11:30am; Sat noon-4". Days without times mean the whole window;
+// times without days mean every day.
+class Availability
+{
+public:
+    static constexpr int kDays = 7; // Monday first
+    static constexpr int kSlotMinutes = 15;
+    static constexpr int kSlotsPerDay = 64;
+    static constexpr int kFirstMinute = 6 * 60;
+    static constexpr int kLastMinute = kFirstMinute + kSlotsPerDay * kSlotMinutes; // 22:00
+    static constexpr int kBlocksPerDay = 3; // morning, afternoon, evening
+
+    enum Block
+    {
+        Morning,   // 06:00-12:00
+        Afternoon, // 12:00-17:00
+        Evening    // 17:00-22:00
+    };
+
+    Availability() { days.fill(0); }
+
+    // ok is false when nothing in text was recognized
+    static Availability parse(const QString &text, bool *ok = nullptr);
+    // "Mon 14:00-18:00; Tue 14:00-18:00", or "" when empty
+    QString toString() const;
+
+    // Minutes since midnight; clipped to the window, rounded out to whole slots
+    void addRange(int day, int startMinute, int endMinute);
+    void addBlock(int day, Block block);
+    static Availability block(int day, Block block);
+
+    quint64 day(int day) const { return days[day]; }
+    void setDay(int day, quint64 slots) { days[day] = slots; }
+
+    bool isEmpty() const;
+    int slotCount() const;
+    int overlapSlots(const Availability &other) const;
+    bool overlaps(const Availability &other) const;
+    // Every slot of shift is also in this
+    bool covers(const Availability &shift) const;
+    // Share of shift's slots this can work, 0..1 (1 for an empty shift)
+    double coverage(const Availability &shift) const;
+    Availability intersected(const Availability &other) const;
+    Availability &operator|=(const Availability &other);
+
+    // Bit day * kBlocksPerDay + block is set when any slot of it is free
+    quint32 blockMask() const;
+
+private:
+    std::array<quint64, kDays> days;
+};
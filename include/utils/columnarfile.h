@@ -0,0 +1,130 @@
+#pragma once
+#include <QByteArray>
+#include <QFile>
+#include <QHash>
+#include <QSaveFile>
+#include <QString>
+#include <QStringList>
+#include <QVariant>
+#include <vector>
+
+// Compact column-oriented table files (".chc") for bulk exports.
+//
+// Rows are buffered into row groups of rowGroupSize rows; each finished
+// group is written as one compressed chunk per column, so the writer holds
+// at most one group in memory however large the table is. Columns are
+// encoded by type before zlib compression:
+//   Integer  null bitmap + zigzag varint deltas from the previous value
+//   Real     null bitmap + raw little-endian doubles
+//   Text     null bitmap + either a dictionary (distinct values, then varint
+//            indices) or varint-length UTF-8, whichever is smaller
+// The footer records the schema and, per chunk, its offset, size, encoding
+// and min/max/null-count statistics, so readers can skip row groups and
+// columns without decompressing them.
+//
+// Layout: magic, chunks..., footer, quint32 footer size, magic. The file
+// is written through QSaveFile and only appears once finish() succeeds.
+namespace Columnar
+{
+    enum class Type : quint8
+    {
+        Integer = 0,
+        Real = 1,
+        Text = 2
+    };
+
+    enum class Encoding : quint8
+    {
+        Plain = 0,
+        Delta = 1,
+        Dictionary = 2
+    };
+
+    struct ColumnChunk
+    {
+        qint64 offset = 0;
+        quint32 compressedSize = 0;
+        Encoding encoding = Encoding::Plain;
+        qint64 nullCount = 0;
+        QVariant min; // invalid when every value is null
+        QVariant max;
+    };
+
+    struct RowGroup
+    {
+        qint64 rowCount = 0;
+        std::vector<ColumnChunk> columns;
+    };
+}
+
+class ColumnarWriter
+{
+public:
+    ColumnarWriter(const QString &path, const QStringList &columnNames,
+                   const std::vector<Columnar::Type> &columnTypes, int rowGroupSize = 65536);
+
+    bool open();
+    // values holds one entry per column; null QVariants are stored as nulls
+    bool addRow(const std::vector<QVariant> &values);
+    // Flushes the last row group and writes the footer
+    bool finish();
+
+    qint64 rowCount() const { return rowsWritten + bufferedRows; }
+    QString errorString() const { return file.errorString(); }
+
+private:
+    struct ColumnBuffer
+    {
+        Columnar::Type type;
+        QByteArray nulls; // one bit per buffered row, set when null
+        QByteArray plain; // type-specific encoded values
+        qint64 previous = 0;
+        qint64 nullCount = 0;
+        QVariant min;
+        QVariant max;
+        // Text only: dictionary candidate, dropped once it stops paying off
+        bool dictionaryUsable = true;
+        QHash<QString, quint32> dictionary;
+        QByteArray dictionaryValues;
+        QByteArray dictionaryIndices;
+    };
+
+    void appendValue(ColumnBuffer &column, const QVariant &value);
+    bool flushRowGroup();
+    void resetColumn(ColumnBuffer &column);
+
+    QSaveFile file;
+    QStringList names;
+    std::vector<ColumnBuffer> columns;
+    std::vector<Columnar::RowGroup> rowGroups;
+    int groupSize;
+    int bufferedRows;
+    qint64 rowsWritten;
+    bool finished;
+};
+
+class ColumnarReader
+{
+public:
+    explicit ColumnarReader(const QString &path);
+
+    // Maps the file and parses the footer
+    bool open();
+
+    QStringList columnNames() const { return names; }
+    Columnar::Type columnType(int column) const { return types.at(column); }
+    int columnIndex(const QString &name) const { return names.indexOf(name); }
+    qint64 rowCount() const;
+    const std::vector<Columnar::RowGroup> &rowGroups() const { return groups; }
+
+    // Decodes one column of one row group; values.size() == group row count
+    bool readColumn(int rowGroup, int column, std::vector<QVariant> &values) const;
+
+private:
+    QFile file;
+    const uchar *data;
+    qint64 size;
+    QStringList names;
+    std::vector<Columnar::Type> types;
+    std::vector<Columnar::RowGroup> groups;
+};
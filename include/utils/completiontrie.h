@@ -0,0 +1,65 @@
+#pragma once
+#include <QString>
+#include <QStringList>
+#include <vector>
+
+// Immutable radix trie for weighted prefix completion.
+//
+// Keys are lowercased with whitespace collapsed. All keys live in one
+// string pool and every edge label is an (offset, length) slice of it, so
+// a node is a few integers and no per-node strings are allocated. Each
+// node stores the ids of the topK heaviest entries below it, computed once
+// at build time; complete() walks the prefix and copies that list out, so
+// a lookup costs O(prefix length + limit) whatever the trie size.
+//
+// A built trie is never modified and can be read from any thread; to pick
+// up new terms, build another one and swap it in.
+class CompletionTrie
+{
+public:
+    struct Entry
+    {
+        QString key;     // what is matched; normalized by build()
+        QString display; // what is suggested
+        quint32 weight;
+    };
+
+    static constexpr int kDefaultTopK = 8;
+
+    // Entries with the same normalized key are merged: weights add up and
+    // the display of the heaviest one wins
+    static CompletionTrie build(std::vector<Entry> entries, int topK = kDefaultTopK);
+    static QString normalize(const QString &text);
+
+    // Up to limit (at most topK) distinct displays, heaviest first
+    QStringList complete(const QString &prefix, int limit) const;
+
+    int size() const { return static_cast<int>(weights.size()); }
+    int nodeCount() const { return static_cast<int>(nodes.size()); }
+    qint64 memoryBytes() const;
+
+private:
+    struct Node
+    {
+        quint32 labelOffset = 0; // into keyPool
+        quint32 firstChild = 0;  // children are contiguous, sorted by first character
+        quint32 topOffset = 0;   // into topEntries
+        quint16 labelLength = 0;
+        quint16 childCount = 0;
+        quint8 topCount = 0;
+    };
+
+    quint32 buildNode(quint32 node, int lo, int hi, int depth, const std::vector<quint32> &keyOffsets,
+                      const std::vector<int> &keyLengths);
+    int findChild(const Node &node, QChar c) const;
+
+    int topK = kDefaultTopK;
+    QString keyPool;
+    QString displayPool;
+    std::vector<Node> nodes; // nodes[0] is the root
+    std::vector<quint32> topEntries;
+    // Per entry, in key order
+    std::vector<quint32> weights;
+    std::vector<quint32> displayOffsets;
+    std::vector<quint16> displayLengths;
+};
@@ -0,0 +1,7 @@
+#pragma once
+#include <QStringList>
+#include <QTextStream>
+
+// Reads one RFC 4180 record into fields; quoted fields may span lines.
+// Returns false at end of input.
+bool readCsvRecord(QTextStream &in, QStringList &fields);
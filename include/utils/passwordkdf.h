@@ -0,0 +1,25 @@
+#pragma once
+#include <QByteArray>
+
+// Key derivation primitives used for password storage.
+//
+// scrypt (RFC 7914) is memory-hard: one derivation touches 128 * r * 2^logN
+// bytes, so logN = 14, r = 8 needs 16 MiB and cannot be parallelised
+// cheaply on GPUs. All functions are reentrant and safe to call from worker
+// threads.
+class PasswordKdf
+{
+public:
+    static QByteArray pbkdf2Sha256(const QByteArray &password, const QByteArray &salt,
+                                   int iterations, int keyLength);
+
+    // Returns an empty array if the parameters are out of range
+    static QByteArray scrypt(const QByteArray &password, const QByteArray &salt,
+                             int logN, int r, int p, int keyLength);
+
+    static QByteArray randomSalt(int length = 16);
+
+    // Length-independent comparison so verification time does not leak
+    // the position of the first differing byte
+    static bool constantTimeEquals(const QByteArray &a, const QByteArray &b);
+};
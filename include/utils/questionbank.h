@@ -0,0 +1,128 @@
+#pragma once
+#include <QByteArray>
+#include <QFile>
+#include <QRandomGenerator>
+#include <QString>
+#include <QStringList>
+#include <QTextStream>
+#include <QVector>
+#include <vector>
+
+// One multiple-choice interview question
+struct Question
+{
+    QString text;             // The question text
+    QString correctAnswer;    // The correct answer
+    QVector<QString> options; // All answer choices (including correct one)
+};
+
+// Interview question banks (".qbank"), compiled once from JSON or CSV
+// sources and memory-mapped by the app.
+//
+// Questions are tagged with a major, a mode ("behavior", "technical") and a
+// difficulty (easy, medium, hard). The file holds fixed-size records and a
+// deduplicated UTF-8 string pool; for every (major, mode) pair an index
+// lists its question ids grouped by difficulty. Questions without a major
+// are general and the compiler copies them into every major's index, so a
+// lookup is one bucket search. Opening a bank only checks the header;
+// sampling N questions reads N records and decodes only their strings.
+//
+// Layout (little-endian): 68-byte header, question records, option string
+// refs, major and mode names, bucket records, question ids, string pool.
+namespace QuestionBankFormat
+{
+    const int kDifficultyLevels = 3;
+
+    // "easy"/"medium"/"hard" or "1".."3"; -1 if unrecognized
+    int difficultyLevel(const QString &name);
+    QString normalizeTag(const QString &tag);
+}
+
+class QuestionBankWriter
+{
+public:
+    // difficulty is 0..kDifficultyLevels-1; an empty major means general
+    bool addQuestion(const QString &major, const QString &mode, int difficulty, const Question &question,
+                     QString *error = nullptr);
+    // Accepts {"questions": [...]} or a bare array of objects with
+    // major, mode, difficulty, text, answer and options; returns the number
+    // added, or -1 with error set
+    int addJson(const QByteArray &json, QString *error = nullptr);
+    // Header row with mode, question, answer and options ("|"-separated),
+    // optionally major and difficulty; same return as addJson
+    int addCsv(QTextStream &in, QString *error = nullptr);
+
+    bool write(const QString &path, QString *error = nullptr) const;
+
+    int questionCount() const { return static_cast<int>(questions.size()); }
+    int bucketCount() const;
+
+private:
+    struct Entry
+    {
+        QString major;
+        QString mode;
+        int difficulty;
+        Question question;
+    };
+
+    std::vector<Entry> questions;
+};
+
+class QuestionBank
+{
+public:
+    QuestionBank();
+
+    // CAMPUS_QUESTION_BANK, or questions.qbank next to the executable
+    static QString defaultPath();
+
+    bool open(const QString &path);
+    void close();
+    bool isOpen() const { return data != nullptr; }
+
+    int size() const { return questionCount; }
+    QStringList majors() const;
+    QStringList modes() const;
+
+    // Questions available for major and mode; difficulty -1 counts all
+    // levels. An unknown major falls back to the general questions.
+    int count(const QString &major, const QString &mode, int difficulty = -1) const;
+
+    // Up to n distinct questions in random order, reading only those n
+    QVector<Question> sample(const QString &major, const QString &mode, int n, int difficulty = -1,
+                             QRandomGenerator *random = QRandomGenerator::global()) const;
+    Question question(quint32 id) const;
+    // Id of the index-th question counted by count(major, mode, difficulty),
+    // or -1 when index is out of range
+    qint64 questionId(const QString &major, const QString &mode, int difficulty, int index) const;
+
+private:
+    struct Range
+    {
+        quint32 first = 0;
+        quint32 count = 0;
+    };
+
+    int findTag(quint32 tableOffset, quint32 tagCount, const QString &tag) const;
+    Range findRange(const QString &major, const QString &mode, int difficulty) const;
+    bool readString(const uchar *ref, QString &text) const;
+
+    QFile file;
+    const uchar *data;
+    qint64 fileSize;
+    quint32 questionCount;
+    quint32 optionCount;
+    quint32 majorCount;
+    quint32 modeCount;
+    quint32 bucketCount;
+    quint32 idCount;
+    quint32 stringBytes;
+    quint32 questionsOffset;
+    quint32 optionsOffset;
+    quint32 majorsOffset;
+    quint32 modesOffset;
+    quint32 bucketsOffset;
+    quint32 idsOffset;
+    quint32 stringsOffset;
+};
@@ -0,0 +1,54 @@
+#pragma once
+#include <QtGlobal>
+#include <array>
+#include <vector>
+
+// Hierarchical timing wheel with one-second ticks.
+//
+// Five levels of 64 slots each cover 64^5 seconds (about 34 years); a slot
+// on level L spans 64^L seconds. Timers are filed by how far away they are
+// and cascade down a level as their slot comes up, so inserting and firing
+// are O(1) and the wheel never scans timers that are not close to due.
+// Per-level occupancy bitmaps let nextWakeTick() find the next tick worth
+// waking up for without walking empty slots.
+class TimerWheel
+{
+public:
+    struct Timer
+    {
+        qint64 expiry;   // absolute tick (seconds since epoch)
+        quint64 payload; // caller data, returned untouched when the timer fires
+    };
+
+    explicit TimerWheel(qint64 startTick = 0);
+
+    qint64 currentTick() const { return current; }
+    int size() const { return count; }
+    bool isEmpty() const { return count == 0; }
+
+    // Timers at or before the current tick are returned by the next advance().
+    // Returns false if expiry is too far in the future to be represented.
+    bool insert(qint64 expiry, quint64 payload);
+
+    // Moves the wheel to tick and appends every timer that is now due
+    void advance(qint64 tick, std::vector<Timer> &due);
+
+    // Earliest tick at which advance() can produce timers or must cascade
+    // a slot; -1 when the wheel is empty
+    qint64 nextWakeTick() const;
+
+private:
+    static constexpr int kLevels = 5;
+    static constexpr int kSlotBits = 6;
+    static constexpr int kSlots = 1 << kSlotBits;
+
+    int slotIndex(qint64 tick, int level) const;
+    void place(const Timer &timer);
+    void cascade(int level);
+
+    qint64 current;
+    int count;
+    std::vector<Timer> overdue;
+    std::array<std::array<std::vector<Timer>, kSlots>, kLevels> slots;
+    std::array<quint64, kLevels> occupied;
+};
@@ -0,0 +1,79 @@
+#pragma once
+#include <QString>
+#include <QtGlobal>
+#include <atomic>
+
+// Lightweight scoped-span tracer.
+//
+// Spans are recorded into per-thread buffers and dumped as Chrome
+// trace-event JSON, which can be opened in https://ui.perfetto.dev or
+// chrome://tracing. Tracing is off by default; run the app with
+// CAMPUS_TRACE=<file.json> to record a session. When disabled a span
+// costs one relaxed atomic load.
+class Tracer
+{
+public:
+    static Tracer &instance();
+
+    static bool isEnabled() { return enabledFlag.load(std::memory_order_relaxed); }
+    void setEnabled(bool enabled);
+
+    // Enables tracing if CAMPUS_TRACE is set; returns true when enabled
+    bool enableFromEnvironment();
+    QString outputPath() const { return tracePath; }
+    void setOutputPath(const QString &path) { tracePath = path; }
+
+    // Microseconds since the tracer clock started
+    static qint64 nowMicros();
+
+    // category and name must be string literals (they are stored by pointer)
+    void record(const char *category, const char *name, qint64 startUs, qint64 durationUs);
+
+    bool writeChromeTrace(const QString &path) const;
+    bool writeChromeTrace() const { return writeChromeTrace(tracePath); }
+    void clear();
+
+private:
+    Tracer() = default;
+
+    static std::atomic<bool> enabledFlag;
+    QString tracePath;
+};
+
+// Records the lifetime of the enclosing scope as one "complete" event
+class TraceSpan
+{
+public:
+    TraceSpan(const char *category, const char *name)
+        : category(category), name(name),
+          startUs(Tracer::isEnabled() ? Tracer::nowMicros() : -1) {}
+
+    ~TraceSpan()
+    {
+        if (startUs >= 0)
+        {
+            Tracer::instance().record(category, name, startUs, Tracer::nowMicros() - startUs);
+        }
+    }
+
+    TraceSpan(const TraceSpan &) = delete;
+    TraceSpan &operator=(const TraceSpan &) = delete;
+
+private:
+    const char *category;
+    const char *name;
+    qint64 startUs;
+};
+
+#define CAMPUS_TRACE_CONCAT_INNER(a, b) a##b
+#define CAMPUS_TRACE_CONCAT(a, b) CAMPUS_TRACE_CONCAT_INNER(a, b)
+
+#ifdef CAMPUS_DISABLE_TRACING
+#define TRACE_SCOPE(category, name) \
+    do                              \
+    {                               \
+    } while (false)
+#else
+#define TRACE_SCOPE(category, name) \
+    TraceSpan CAMPUS_TRACE_CONCAT(traceSpan_, __LINE__)(category, name)
+#endif
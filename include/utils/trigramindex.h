@@ -0,0 +1,65 @@
+#pragma once
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <vector>
+
+// In-memory trigram inverted index for typo-tolerant lookups.
+//
+// Text is lowercased and split into words; each word contributes its
+// padded trigrams ("  l", " li", "lib", ...) to a posting list of document
+// slots kept sorted, so upsert/remove touch only that document's postings.
+// A search counts trigram overlap across the query's posting lists
+// (candidate generation), keeps the best-overlapping candidates and ranks
+// them by a bounded edit distance between each query word and the closest
+// word (or word prefix, for as-you-type queries) of the document.
+//
+// search() reuses scratch buffers and is not reentrant; use one index per
+// thread or guard it externally.
+class TrigramIndex
+{
+public:
+    struct Match
+    {
+        int id;
+        int distance; // total edits over the query words
+        int overlap;  // shared trigrams
+    };
+
+    void upsert(int id, const QStringList &fields);
+    void remove(int id);
+    bool contains(int id) const { return slotById.contains(id); }
+    int size() const { return slotById.size(); }
+    qint64 postingCount() const { return postings; }
+    void clear();
+
+    std::vector<Match> search(const QString &query, int limit) const;
+
+    // Lowercased words of text, punctuation dropped
+    static QStringList words(const QString &text);
+    // Levenshtein distance, or bound + 1 as soon as it must exceed bound.
+    // With prefixOfB, the distance from a to the closest prefix of b.
+    static int boundedDistance(const QString &a, const QString &b, int bound, bool prefixOfB = false);
+
+private:
+    struct Document
+    {
+        int id = -1;
+        std::vector<quint64> trigrams;
+        QStringList words;
+    };
+
+    // Edits tolerated for a query word of this length
+    static int editBudget(int length);
+    static void appendTrigrams(const QString &word, std::vector<quint64> &out);
+
+    std::vector<Document> documents; // by slot
+    std::vector<int> freeSlots;
+    QHash<int, int> slotById;
+    QHash<quint64, std::vector<int>> postingLists; // sorted slots
+    qint64 postings = 0;
+
+    // search() scratch: per-slot overlap counts, reset after every query
+    mutable std::vector<quint16> overlapBySlot;
+    mutable std::vector<int> touchedSlots;
+};
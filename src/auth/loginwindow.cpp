@@ -1,5 +1,6 @@
 #include "auth/loginwindow.h"
 #include "database/database.h"
+#include "ui/thememanager.h"
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QMessageBox>
@@ -59,7 +60,7 @@ void LoginWindow::setupUI()
 
     // Error label
     errorLabel = new QLabel(this);
-    errorLabel->setStyleSheet("color: red;");
+    ThemeManager::setRole(errorLabel, StyleRole::Error);
     errorLabel->hide();
     mainLayout->addWidget(errorLabel);
 
@@ -92,58 +93,8 @@ void LoginWindow::setupUI()
 
 void LoginWindow::setupStyles()
 {
-    setStyleSheet(
-        "QWidget { "
-        "   background: qlineargradient(x1:0, y1:0, x2:1, y2:1,"
-        "       stop:0 #f5f7fa, stop:1 #c3cfe2);"
-        "   font-family: 'Segoe UI', Arial, sans-serif;"
-        "}"
-        "QLabel { font-size: 16px; color: #424242; }"
-        "QLineEdit { "
-        "   padding: 12px; "
-        "   border: 2px solid #E0E0E0; "
-        "   border-radius: 8px; "
-        "   margin: 5px 0; "
-        "   font-size: 14px; "
-        "   background: white;"
-        "   min-height: 40px;"
-        "}"
-        "QLineEdit:focus { "
-        "   border: 2px solid #2196F3; "
-        "   background: #f8fcff;"
-        "}"
-        "QPushButton { "
-        "   padding: 12px; "
-        "   background: qlineargradient(x1:0, y1:0, x2:0, y2:1,"
-        "       stop:0 #2196F3, stop:1 #1976D2);"
-        "   color: white; "
-        "   border: none; "
-        "   border-radius: 8px; "
-        "   font-size: 14px; "
-        "   font-weight: bold;"
-        "   min-height: 44px;"
-        "}"
-        "QPushButton:hover { "
-        "   background: qlineargradient(x1:0, y1:0, x2:0, y2:1,"
-        "       stop:0 #1976D2, stop:1 #0D47A1);"
-        "}");
-
-    titleLabel->setStyleSheet(
-        "font-size: 28px; "
-        "font-weight: bold; "
-        "color: #1976D2; "
-        "margin: 20px 0;"
-        "background: transparent;");
-    registerButton->setStyleSheet(
-        "QPushButton { "
-        "   background: qlineargradient(x1:0, y1:0, x2:0, y2:1,"
-        "       stop:0 #4CAF50, stop:1 #388E3C);"
-        "   min-height: 44px;"
-        "}"
-        "QPushButton:hover { "
-        "   background: qlineargradient(x1:0, y1:0, x2:0, y2:1,"
-        "       stop:0 #388E3C, stop:1 #2E7D32);"
-        "}");
+    ThemeManager::setRole(titleLabel, StyleRole::Title);
+    ThemeManager::setRole(registerButton, StyleRole::Success);
 }
 
 void LoginWindow::handleLogin()
@@ -158,15 +109,25 @@ void LoginWindow::handleLogin()
         return;
     }
 
-    if (database->validateLogin(username, password))
-    {
-        emit loginSuccessful();
-    }
-    else
-    {
-        errorLabel->setText("Invalid username or password");
-        errorLabel->show();
-    }
+    // Password verification runs on a worker thread; keep the window responsive
+    loginButton->setEnabled(false);
+    loginButton->setText("Signing in...");
+    errorLabel->hide();
+
+    database->validateLoginAsync(username, password, this, [this](bool valid)
+                                 {
+        loginButton->setEnabled(true);
+        loginButton->setText("Login");
+
+        if (valid)
+        {
+            emit loginSuccessful();
+        }
+        else
+        {
+            errorLabel->setText("Invalid username or password");
+            errorLabel->show();
+        } });
 }
 
 void LoginWindow::onRegisterClicked()
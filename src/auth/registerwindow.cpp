@@ -5,6 +5,7 @@
 // #include <QRegularExpression>
 
 #include "auth/registerwindow.h"
+#include "ui/thememanager.h"
 #include <QVBoxLayout>
 #include <QMessageBox>
 
@@ -37,7 +38,7 @@ void RegisterWindow::setupUI()
     emailEdit->setMinimumHeight(40);
     mainLayout->addWidget(emailEdit);
     QLabel *emailHint = new QLabel("Use your BMCC email (@stu.bmcc.cuny.edu)", this);
-    emailHint->setStyleSheet("color: #666666; font-size: 12px;");
+    ThemeManager::setRole(emailHint, StyleRole::Hint);
     mainLayout->addWidget(emailHint);
 
     // EMPLID
@@ -46,7 +47,7 @@ void RegisterWindow::setupUI()
     emplidEdit->setMinimumHeight(40);
     mainLayout->addWidget(emplidEdit);
     QLabel *emplidHint = new QLabel("Your 8-digit BMCC Student ID", this);
-    emplidHint->setStyleSheet("color: #666666; font-size: 12px;");
+    ThemeManager::setRole(emplidHint, StyleRole::Hint);
     mainLayout->addWidget(emplidHint);
 
     // Password
@@ -65,7 +66,7 @@ void RegisterWindow::setupUI()
 
     // Error label
     errorLabel = new QLabel(this);
-    errorLabel->setStyleSheet("color: #D32F2F;");
+    ThemeManager::setRole(errorLabel, StyleRole::Error);
     errorLabel->setWordWrap(true);
     errorLabel->hide();
     mainLayout->addWidget(errorLabel);
@@ -91,59 +92,8 @@ void RegisterWindow::setupUI()
 
 void RegisterWindow::setupStyles()
 {
-    setStyleSheet(
-        "QWidget { "
-        "   background: qlineargradient(x1:0, y1:0, x2:1, y2:1,"
-        "       stop:0 #f5f7fa, stop:1 #c3cfe2);"
-        "   font-family: 'Segoe UI', Arial, sans-serif;"
-        "}"
-        "QLabel { color: #424242; font-size: 14px; }"
-        "QLineEdit { "
-        "   padding: 12px; "
-        "   border: 2px solid #E0E0E0; "
-        "   border-radius: 8px; "
-        "   background: white; "
-        "   color: #333333; "
-        "   font-size: 14px;"
-        "   min-height: 40px;"
-        "}"
-        "QLineEdit:focus { "
-        "   border: 2px solid #2196F3; "
-        "   background: #f8fcff;"
-        "}"
-        "QPushButton { "
-        "   background: qlineargradient(x1:0, y1:0, x2:0, y2:1,"
-        "       stop:0 #0D47A1, stop:1 #1565C0);"
-        "   color: white; "
-        "   border: none; "
-        "   border-radius: 8px; "
-        "   font-weight: bold; "
-        "   font-size: 14px;"
-        "   min-height: 44px;"
-        "   padding: 12px;"
-        "}"
-        "QPushButton:hover { "
-        "   background: qlineargradient(x1:0, y1:0, x2:0, y2:1,"
-        "       stop:0 #1565C0, stop:1 #0D47A1);"
-        "}");
-
-    titleLabel->setStyleSheet(
-        "font-size: 28px; "
-        "font-weight: bold; "
-        "color: #0D47A1; "
-        "margin: 20px 0;"
-        "background: transparent;");
-    loginButton->setStyleSheet(
-        "QPushButton { "
-        "   background: transparent; "
-        "   color: #2196F3; "
-        "   font-weight: bold;"
-        "   min-height: 40px;"
-        "}"
-        "QPushButton:hover { "
-        "   color: #1565C0; "
-        "   text-decoration: underline; "
-        "}");
+    ThemeManager::setRole(titleLabel, StyleRole::Title);
+    ThemeManager::setRole(loginButton, StyleRole::Link);
 }
 
 void RegisterWindow::handleRegistration()
@@ -190,18 +140,26 @@ void RegisterWindow::handleRegistration()
         return;
     }
 
-    // Try to register
-    if (database->registerUser(email, password, email, fullName, emplid))
-    {
-        QMessageBox::information(this, "Success", "Registration successful!");
-        emit registrationSuccessful();
-        emit switchToLogin();
-    }
-    else
-    {
-        errorLabel->setText("Registration failed. Email might already exist.");
-        errorLabel->show();
-    }
+    // Try to register; hashing the password runs on a worker thread
+    registerButton->setEnabled(false);
+    registerButton->setText("Creating account...");
+
+    database->registerUserAsync(fullName, password, email, emplid, this, [this](bool registered)
+                                {
+        registerButton->setEnabled(true);
+        registerButton->setText("Register");
+
+        if (registered)
+        {
+            QMessageBox::information(this, "Success", "Registration successful!");
+            emit registrationSuccessful();
+            emit switchToLogin();
+        }
+        else
+        {
+            errorLabel->setText("Registration failed. Email might already exist.");
+            errorLabel->show();
+        } });
 }
 
 void RegisterWindow::onLoginClicked()
@@ -0,0 +1,92 @@
+#include <QApplication>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QTemporaryDir>
+#include <QTextStream>
+#include <functional>
+#include "auth/loginwindow.h"
+#include "auth/registerwindow.h"
+#include "ui/mainwindow.h"
+#include "ui/interviewwidget.h"
+#include "ui/landingpage.h"
+#include "ui/myaccountpage.h"
+#include "ui/myapplicationpage.h"
+#include "ui/myprofilepage.h"
+#include "ui/onboardingpage.h"
+#include "ui/oncampusjobspage.h"
+#include "ui/studentsurveydialog.h"
+#include "ui/thememanager.h"
+#include "database/database.h"
+
+namespace
+{
+    // Builds each page `rounds` times and reports the average time spent
+    // constructing it and polishing its widget tree against the theme
+    int runThemeBenchmark(Database *db, int rounds)
+    {
+        const std::vector<std::pair<QString, std::function<QWidget *()>>> pages = {
+            {"LoginWindow", [db]() { return new LoginWindow(db); }},
+            {"RegisterWindow", [db]() { return new RegisterWindow(db); }},
+            {"LandingPage", [db]() { return new LandingPage(db, 0); }},
+            {"OnCampusJobsPage", [db]() { return new OnCampusJobsPage(db, 0); }},
+            {"InterviewWidget", []() { return new InterviewWidget(QString()); }},
+            {"OnboardingPage", []() { return new OnboardingPage(false); }},
+            {"MyProfilePage", [db]() { return new MyProfilePage(db); }},
+            {"MyApplicationPage", [db]() { return new MyApplicationPage(db); }},
+            {"MyAccountPage", [db]() { return new MyAccountPage(db); }},
+            {"StudentSurveyDialog", [db]() { return new StudentSurveyDialog(db, 0); }},
+            {"MainWindow", [db]() { return new MainWindow(db, QString()); }},
+        };
+
+        QTextStream out(stdout);
+        out << "page\twidgets\tconstruct_us\tpolish_us\n";
+        for (const auto &page : pages)
+        {
+            qint64 constructNs = 0;
+            qint64 polishNs = 0;
+            int widgets = 0;
+            for (int round = 0; round < rounds; ++round)
+            {
+                QElapsedTimer timer;
+                timer.start();
+                QWidget *widget = page.second();
+                constructNs += timer.nsecsElapsed();
+
+                timer.restart();
+                widget->ensurePolished();
+                polishNs += timer.nsecsElapsed();
+
+                widgets = widget->findChildren<QWidget *>().size() + 1;
+                delete widget;
+            }
+            out << page.first << '\t' << widgets << '\t' << constructNs / rounds / 1000 << '\t'
+                << polishNs / rounds / 1000 << "\n";
+        }
+        return 0;
+    }
+}
+
+// Per-page construction and polish times under the app theme:
+// campus_theme_bench [ROUNDS]. Pages are built against a fresh database in
+// a temporary directory, never the user's own.
+int main(int argc, char *argv[])
+{
+    QApplication app(argc, argv);
+    ThemeManager::install(app);
+
+    QTemporaryDir directory;
+    if (!directory.isValid())
+    {
+        qDebug() << "Cannot create a temporary directory:" << directory.errorString();
+        return 1;
+    }
+    Database db(directory.filePath("bench.db"), QSqlDatabase::defaultConnection);
+    if (!db.connectToDatabase())
+    {
+        qDebug() << "Failed to create the benchmark database";
+        return 1;
+    }
+
+    const int rounds = app.arguments().value(1).toInt();
+    return runThemeBenchmark(&db, rounds > 0 ? rounds : 20);
+}
@@ -0,0 +1,1229 @@
+#include "cli/clicommands.h"
+#include "database/database.h"
+#include "database/tenantdirectory.h"
+#include "models/job.h"
+#include "services/autocompleteservice.h"
+#include "services/credentialservice.h"
+#include "services/fuzzyjobsearch.h"
+#include "services/interviewscheduler.h"
+#include "services/jobanalytics.h"
+#include "services/notificationdispatcher.h"
+#include "services/schedulematcher.h"
+#include "utils/availability.h"
+#include "utils/columnarfile.h"
+#include "utils/csvreader.h"
+#include "utils/questionbank.h"
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QSqlQuery>
+
+namespace
+{
+    // Options are written as --name=value, flags as --name
+    QString optionValue(const QStringList &args, const QString &name, const QString &fallback = QString())
+    {
+        const QString prefix = "--" + name + "=";
+        for (const QString &arg : args)
+        {
+            if (arg.startsWith(prefix))
+            {
+                return arg.mid(prefix.size());
+            }
+        }
+        return fallback;
+    }
+
+    bool hasFlag(const QStringList &args, const QString &name)
+    {
+        return args.contains("--" + name);
+    }
+
+    QStringList positionalArgs(const QStringList &args)
+    {
+        QStringList result;
+        for (const QString &arg : args)
+        {
+            if (!arg.startsWith("--"))
+            {
+                result << arg;
+            }
+        }
+        return result;
+    }
+
+    // Opens a path for reading, "-" meaning stdin
+    bool openInput(QFile &file, const QString &path)
+    {
+        if (path == "-")
+        {
+            return file.open(stdin, QIODevice::ReadOnly | QIODevice::Text);
+        }
+        file.setFileName(path);
+        return file.open(QIODevice::ReadOnly | QIODevice::Text);
+    }
+
+    bool openOutput(QFile &file, const QString &path)
+    {
+        if (path.isEmpty() || path == "-")
+        {
+            return file.open(stdout, QIODevice::WriteOnly | QIODevice::Text);
+        }
+        file.setFileName(path);
+        return file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text);
+    }
+
+    QString csvField(const QString &value)
+    {
+        if (value.contains(',') || value.contains('"') || value.contains('\n'))
+        {
+            QString escaped = value;
+            escaped.replace("\"", "\"\"");
+            return "\"" + escaped + "\"";
+        }
+        return value;
+    }
+
+    JobStatus parseStatus(const QString &text)
+    {
+        bool isNumber = false;
+        int value = text.toInt(&isNumber);
+        if (isNumber && value >= 0 && value <= static_cast<int>(JobStatus::Upcoming))
+        {
+            return static_cast<JobStatus>(value);
+        }
+
+        const QString upper = text.trimmed().toUpper().replace('_', ' ');
+        if (upper == "OPEN")
+            return JobStatus::Open;
+        if (upper == "CLOSING SOON")
+            return JobStatus::ClosingSoon;
+        if (upper == "UPCOMING")
+            return JobStatus::Upcoming;
+        return JobStatus::Closed;
+    }
+
+    bool parseBool(const QString &text)
+    {
+        const QString lower = text.trimmed().toLower();
+        return lower == "1" || lower == "true" || lower == "yes";
+    }
+
+    const QStringList kJobColumns = {
+        "id", "title", "department", "category", "description", "pay_rate_min", "pay_rate_max",
+        "hours_per_week", "positions_available", "status", "work_study_eligible",
+        "international_eligible", "deadline", "requirements", "duties", "skills",
+        "supervisor_info", "contact_email", "schedule", "required_documents", "open_date"};
+}
+
+CliCommands::CliCommands(Database *db, TenantDirectory *tenantDirectory)
+    : database(db), tenantDirectory(tenantDirectory), out(stdout), err(stderr)
+{
+}
+
+void CliCommands::printUsage(QTextStream &stream)
+{
+    stream << "Usage: campus_cli [--db=FILE | --tenant=ID] [--tenant-dir=DIR] [--backend=qt|native] <command> [options]\n"
+              "\n"
+              "  --db=FILE        Database file (default: CAMPUS_DB_PATH or campus_jobs.db)\n"
+              "  --tenant=ID      Use campus ID's database, DIR/ID.db\n"
+              "  --tenant-dir=DIR Tenant databases (default: CAMPUS_TENANT_DIR or ./tenants)\n"
+              "  --backend=B      Catalog reads via Qt SQL (qt) or the sqlite3 C API (native)\n"
+              "\n"
+              "Commands:\n"
+              "  import-jobs <file.csv|->           Insert jobs from CSV (header row required)\n"
+              "  export-jobs [file.csv|-]           Stream all jobs as CSV\n"
+              "  search <keyword> [--category=C] [--status=OPEN] [--work-study] [--international]\n"
+              "         [--hours=MIN-MAX] [--pay=MIN-MAX] [--fuzzy[=LIMIT]]\n"
+              "                                     Print matching jobs, one per line\n"
+              "                                     (--fuzzy tolerates typos in title/department/skills)\n"
+              "  stats [--rebuild]                  Print catalog, activity and document counts\n"
+              "                                     (--rebuild recomputes the rollup tables first)\n"
+              "  update-doc-status <file.csv|->     Apply \"document_id,status\" rows in one transaction\n"
+              "  calibrate-kdf [--target-ms=250] [--save]\n"
+              "                                     Time password hashing and pick the scrypt cost\n"
+              "  notify-open <job-id> [--spool=DIR] Send pending \"it's open\" notices for a job\n"
+              "                                     (outbox table by default)\n"
+              "  export-table <table|all> <file.chc|dir> [--row-group=65536]\n"
+              "                                     Stream a table to a compressed columnar file\n"
+              "  inspect-export <file.chc> [--rows=N] Print schema, row-group stats and first N rows\n"
+              "  snapshot create [--label=L]        Take a deduplicated, hash-verified snapshot\n"
+              "  snapshot list                      List snapshots, oldest first\n"
+              "  snapshot verify <id>               Re-hash every chunk of a snapshot\n"
+              "  snapshot restore <id>|--at=ISO-TIME [--to=FILE]\n"
+              "                                     Restore a snapshot (latest at or before --at);\n"
+              "                                     without --to it replaces the live database\n"
+              "  snapshot prune --keep=N            Keep the newest N snapshots\n"
+              "  tenants [ID...]                    Cross-campus report over attached tenant databases\n"
+              "  suggest <prefix> [--limit=8]       Autocomplete suggestions for the search box\n"
+              "  compile-questions <source.json|source.csv>... <out.qbank>\n"
+              "                                     Compile interview questions into a question bank\n"
+              "  sample-questions <bank.qbank> <major> <mode> [--count=5] [--difficulty=easy]\n"
+              "                                     Draw random questions from a compiled bank\n"
+              "  availability <text>                Show how availability text is understood\n"
+              "  match-applicants <job id> [--shift=TEXT]\n"
+              "                                     Rank a job's applicants against its shifts\n"
+              "  who-can-work <text> [--job=ID] [--whole]\n"
+              "                                     Applicants free for some (or all) of a time\n"
+              "  set-calendar <supervisor> <free time>\n"
+              "                                     Set when a supervisor can interview\n"
+              "  schedule-interviews [--length=30] [--rooms=1] [--per-supervisor=1] [--fresh] [--dry-run]\n"
+              "                                     Book interviews for all applications\n"
+              "  cancel-interview <application id> | --supervisor=NAME <time>\n"
+              "                                     Cancel and rebook the affected interviews\n"
+              "  bench-catalog [--iterations=20]    Time full catalog loads on the Qt and native backends\n"
+              "\n"
+              "Set CAMPUS_TRACE=<file.json> to record a Chrome trace of the run.\n";
+    stream.flush();
+}
+
+int CliCommands::run(const QStringList &args)
+{
+    const QString command = args.first();
+    const QStringList rest = args.mid(1);
+
+    int exitCode = 1;
+    if (command == "import-jobs")
+        exitCode = importJobs(rest);
+    else if (command == "export-jobs")
+        exitCode = exportJobs(rest);
+    else if (command == "search")
+        exitCode = search(rest);
+    else if (command == "stats")
+        exitCode = stats(rest);
+    else if (command == "update-doc-status")
+        exitCode = updateDocumentStatuses(rest);
+    else if (command == "calibrate-kdf")
+        exitCode = calibrateKdf(rest);
+    else if (command == "notify-open")
+        exitCode = notifyOpen(rest);
+    else if (command == "export-table")
+        exitCode = exportTable(rest);
+    else if (command == "inspect-export")
+        exitCode = inspectExport(rest);
+    else if (command == "snapshot")
+        exitCode = snapshot(rest);
+    else if (command == "tenants")
+        exitCode = tenants(rest);
+    else if (command == "suggest")
+        exitCode = suggest(rest);
+    else if (command == "compile-questions")
+        exitCode = compileQuestions(rest);
+    else if (command == "sample-questions")
+        exitCode = sampleQuestions(rest);
+    else if (command == "availability")
+        exitCode = parseAvailability(rest);
+    else if (command == "match-applicants")
+        exitCode = matchApplicants(rest);
+    else if (command == "who-can-work")
+        exitCode = whoCanWork(rest);
+    else if (command == "set-calendar")
+        exitCode = setCalendar(rest);
+    else if (command == "schedule-interviews")
+        exitCode = scheduleInterviews(rest);
+    else if (command == "cancel-interview")
+        exitCode = cancelInterview(rest);
+    else if (command == "bench-catalog")
+        exitCode = benchCatalog(rest);
+    else
+    {
+        err << "Unknown command: " << command << "\n";
+        printUsage(err);
+    }
+
+    out.flush();
+    err.flush();
+    return exitCode;
+}
+
+int CliCommands::importJobs(const QStringList &args)
+{
+    const QStringList files = positionalArgs(args);
+    if (files.isEmpty())
+    {
+        err << "import-jobs: missing input file (use - for stdin)\n";
+        return 1;
+    }
+
+    QFile file;
+    if (!openInput(file, files.first()))
+    {
+        err << "import-jobs: cannot open " << files.first() << "\n";
+        return 1;
+    }
+    QTextStream in(&file);
+
+    QStringList header;
+    if (!readCsvRecord(in, header))
+    {
+        err << "import-jobs: empty input\n";
+        return 1;
+    }
+    QHash<QString, int> columnIndex;
+    for (int i = 0; i < header.size(); ++i)
+    {
+        columnIndex.insert(header.at(i).trimmed().toLower(), i);
+    }
+    if (!columnIndex.contains("title") || !columnIndex.contains("department"))
+    {
+        err << "import-jobs: header must include at least title and department\n";
+        return 1;
+    }
+
+    QStringList fields;
+    int lineNumber = 1;
+    int skipped = 0;
+    auto nextJob = [&](Job &job) -> bool
+    {
+        while (readCsvRecord(in, fields))
+        {
+            ++lineNumber;
+            auto value = [&](const QString &column) -> QString
+            {
+                int index = columnIndex.value(column, -1);
+                return (index >= 0 && index < fields.size()) ? fields.at(index).trimmed() : QString();
+            };
+
+            if (value("title").isEmpty())
+            {
+                err << "import-jobs: line " << lineNumber << " has no title, skipped\n";
+                ++skipped;
+                continue;
+            }
+
+            job = Job(-1, value("title"), value("department"), value("category"), value("description"),
+                      value("pay_rate_min").toDouble(), value("pay_rate_max").toDouble(),
+                      value("hours_per_week").toInt(), value("positions_available").toInt(),
+                      parseStatus(value("status")), parseBool(value("work_study_eligible")),
+                      parseBool(value("international_eligible")), value("deadline"),
+                      value("requirements"), value("duties"), value("skills"),
+                      value("supervisor_info"), value("contact_email"), value("schedule"),
+                      value("required_documents"), value("open_date"));
+            return true;
+        }
+        return false;
+    };
+
+    int imported = database->importJobs(nextJob);
+    if (imported < 0)
+    {
+        err << "import-jobs: import failed, no rows were written\n";
+        return 2;
+    }
+    out << "Imported " << imported << " job(s)";
+    if (skipped > 0)
+    {
+        out << ", skipped " << skipped;
+    }
+    out << "\n";
+    return 0;
+}
+
+int CliCommands::exportJobs(const QStringList &args)
+{
+    const QStringList files = positionalArgs(args);
+    QFile file;
+    if (!openOutput(file, files.value(0)))
+    {
+        err << "export-jobs: cannot open " << files.value(0) << "\n";
+        return 1;
+    }
+    QTextStream stream(&file);
+
+    stream << kJobColumns.join(',') << "\n";
+    bool ok = database->forEachJob([&stream](const Job &job)
+                                   {
+        stream << job.getId() << ','
+               << csvField(job.getTitle()) << ','
+               << csvField(job.getDepartment()) << ','
+               << csvField(job.getCategory()) << ','
+               << csvField(job.getDescription()) << ','
+               << job.getPayRateMin() << ','
+               << job.getPayRateMax() << ','
+               << job.getHoursPerWeek() << ','
+               << job.getPositionsAvailable() << ','
+               << csvField(job.getStatusString()) << ','
+               << (job.isWorkStudyEligible() ? 1 : 0) << ','
+               << (job.isInternationalEligible() ? 1 : 0) << ','
+               << csvField(job.getDeadline()) << ','
+               << csvField(job.getRequirements()) << ','
+               << csvField(job.getDuties()) << ','
+               << csvField(job.getSkills()) << ','
+               << csvField(job.getSupervisorInfo()) << ','
+               << csvField(job.getContactEmail()) << ','
+               << csvField(job.getSchedule()) << ','
+               << csvField(job.getRequiredDocuments()) << ','
+               << csvField(job.getOpenDate()) << '\n';
+        return stream.status() == QTextStream::Ok; });
+
+    stream.flush();
+    return ok ? 0 : 2;
+}
+
+int CliCommands::search(const QStringList &args)
+{
+    JobSearchOptions options;
+    options.keyword = positionalArgs(args).join(' ');
+    options.category = optionValue(args, "category");
+    options.workStudyOnly = hasFlag(args, "work-study");
+    options.internationalOnly = hasFlag(args, "international");
+
+    const QString statusText = optionValue(args, "status");
+    if (!statusText.isEmpty())
+    {
+        options.statuses = JobFilters::statusBit(parseStatus(statusText));
+    }
+    // Ranges are written MIN-MAX
+    const QStringList hours = optionValue(args, "hours").split('-');
+    if (hours.size() == 2)
+    {
+        options.hours = std::make_pair(hours.at(0).toInt(), hours.at(1).toInt());
+    }
+    const QStringList pay = optionValue(args, "pay").split('-');
+    if (pay.size() == 2)
+    {
+        options.pay = std::make_pair(pay.at(0).toDouble(), pay.at(1).toDouble());
+    }
+
+    std::vector<Job> jobs;
+    if (hasFlag(args, "fuzzy") || !optionValue(args, "fuzzy").isEmpty())
+    {
+        // Rank by the trigram index, then keep the rows the other options allow
+        const int limit = optionValue(args, "fuzzy", "20").toInt();
+        const QString text = options.keyword;
+        options.keyword.clear();
+
+        FuzzyJobSearch fuzzy(database);
+        fuzzy.rebuild();
+        QElapsedTimer timer;
+        timer.start();
+        const auto results = fuzzy.search(text, limit);
+        const qint64 elapsedNs = timer.nsecsElapsed();
+
+        visitJobFilter(options, [&](const auto &filter)
+                       {
+            for (const auto &result : results)
+            {
+                if (filter(result.job))
+                    jobs.push_back(result.job);
+            }
+            return 0; });
+        err << "fuzzy lookup over " << fuzzy.indexedJobs() << " jobs (" << fuzzy.indexedPostings()
+            << " postings) took " << elapsedNs / 1000 << " us\n";
+    }
+    else
+    {
+        jobs = database->searchJobs(options);
+    }
+    for (const auto &job : jobs)
+    {
+        out << job.getId() << '\t'
+            << job.getStatusString() << '\t'
+            << job.getTitle() << '\t'
+            << job.getDepartment() << '\t'
+            << job.getPayRateString() << '\n';
+    }
+    err << jobs.size() << " job(s) found\n";
+    return 0;
+}
+
+int CliCommands::stats(const QStringList &args)
+{
+    if (hasFlag(args, "rebuild") && !JobAnalytics::rebuild(database->connection()))
+    {
+        err << "Could not rebuild rollup tables\n";
+        return 1;
+    }
+
+    out << "users\t" << database->getUserCount() << "\n";
+
+    const auto byStatus = database->getJobCountsByStatus();
+    for (auto it = byStatus.constBegin(); it != byStatus.constEnd(); ++it)
+    {
+        out << "jobs.status\t" << it.key() << '\t' << it.value() << "\n";
+    }
+
+    const auto byCategory = database->getJobCountsByCategory();
+    for (auto it = byCategory.constBegin(); it != byCategory.constEnd(); ++it)
+    {
+        out << "jobs.category\t" << (it.key().isEmpty() ? QString("(none)") : it.key()) << '\t' << it.value() << "\n";
+    }
+
+    const auto positions = JobAnalytics::openPositionsBy(database->connection(), "department");
+    for (auto it = positions.constBegin(); it != positions.constEnd(); ++it)
+    {
+        out << "positions.department\t" << it.key() << '\t' << it.value() << "\n";
+    }
+
+    const JobBoardSummary summary = JobAnalytics::summary(database->connection());
+    out << "applications.total\t" << summary.totalApplications << "\n";
+    out << "applications.per_open_position\t" << QString::number(summary.applicantsPerOpenPosition(), 'f', 2) << "\n";
+    out << "interests.total\t" << summary.totalInterests << "\n";
+    out << "interests.conversion_rate\t" << QString::number(summary.interestConversionRate(), 'f', 3) << "\n";
+    out << "jobs.filled\t" << summary.jobsFilled << "\n";
+    out << "jobs.avg_days_to_fill\t" << QString::number(summary.averageDaysToFill, 'f', 1) << "\n";
+    for (const auto &week : JobAnalytics::weekly(database->connection(), "applications", 8))
+    {
+        out << "applications.week\t" << week.first << '\t' << week.second << "\n";
+    }
+    for (const JobActivity &activity : JobAnalytics::topJobsByApplications(database->connection(), 5))
+    {
+        out << "jobs.top\t" << activity.jobId << '\t' << activity.title << '\t' << activity.applications << "\n";
+    }
+
+    const auto documents = database->getDocumentCountsByStatus();
+    for (auto it = documents.constBegin(); it != documents.constEnd(); ++it)
+    {
+        out << "documents.status\t" << it.key() << '\t' << it.value() << "\n";
+    }
+    return 0;
+}
+
+int CliCommands::updateDocumentStatuses(const QStringList &args)
+{
+    const QStringList files = positionalArgs(args);
+    if (files.isEmpty())
+    {
+        err << "update-doc-status: missing input file (use - for stdin)\n";
+        return 1;
+    }
+
+    QFile file;
+    if (!openInput(file, files.first()))
+    {
+        err << "update-doc-status: cannot open " << files.first() << "\n";
+        return 1;
+    }
+    QTextStream in(&file);
+
+    QStringList fields;
+    int lineNumber = 0;
+    auto nextUpdate = [&](int &documentId, QString &status) -> bool
+    {
+        while (readCsvRecord(in, fields))
+        {
+            ++lineNumber;
+            bool isNumber = false;
+            documentId = fields.value(0).trimmed().toInt(&isNumber);
+            if (!isNumber || fields.size() < 2)
+            {
+                // Header rows and blank lines are skipped silently
+                if (lineNumber > 1 && !fields.value(0).trimmed().isEmpty())
+                {
+                    err << "update-doc-status: line " << lineNumber << " is not \"id,status\", skipped\n";
+                }
+                continue;
+            }
+            status = fields.at(1).trimmed();
+            return true;
+        }
+        return false;
+    };
+
+    int updated = database->updateDocumentStatuses(nextUpdate);
+    if (updated < 0)
+    {
+        err << "update-doc-status: update failed, no rows were changed\n";
+        return 2;
+    }
+    out << "Updated " << updated << " document(s)\n";
+    return 0;
+}
+
+int CliCommands::calibrateKdf(const QStringList &args)
+{
+    bool ok = false;
+    const int targetMs = optionValue(args, "target-ms", "250").toInt(&ok);
+    if (!ok || targetMs <= 0)
+    {
+        err << "calibrate-kdf: --target-ms must be a positive number\n";
+        return 1;
+    }
+
+    QStringList report;
+    const KdfParams chosen = CredentialService::calibrate(targetMs, KdfParams(), &report);
+    for (const QString &line : report)
+    {
+        out << line << "\n";
+    }
+
+    const KdfParams current = CredentialService::configuredParams();
+    out << "Recommended logN=" << chosen.logN << " (r=" << chosen.r << ", p=" << chosen.p
+        << ", " << (128LL * chosen.r << chosen.logN) / (1024 * 1024) << " MiB per hash)"
+        << ", currently " << current.logN << "\n";
+
+    if (hasFlag(args, "save"))
+    {
+        CredentialService::saveConfiguredParams(chosen);
+        out << "Saved; existing passwords are rehashed on their next login\n";
+    }
+    return 0;
+}
+
+int CliCommands::notifyOpen(const QStringList &args)
+{
+    bool ok = false;
+    const int jobId = positionalArgs(args).value(0).toInt(&ok);
+    if (!ok)
+    {
+        err << "notify-open: missing job id\n";
+        return 1;
+    }
+
+    const QString spoolDir = optionValue(args, "spool");
+    std::unique_ptr<NotificationSink> sink;
+    if (spoolDir.isEmpty())
+        sink.reset(new OutboxTableSink(database));
+    else
+        sink.reset(new FileSpoolSink(spoolDir));
+
+    NotificationDispatcher dispatcher(database, std::move(sink));
+    const int sent = dispatcher.dispatchJobOpened(jobId);
+    if (sent < 0)
+    {
+        err << "notify-open: job " << jobId << " not found or delivery failed\n";
+        return 1;
+    }
+    out << "Notified " << sent << " subscriber(s)\n";
+    return 0;
+}
+
+int CliCommands::exportTable(const QStringList &args)
+{
+    const QStringList positional = positionalArgs(args);
+    if (positional.size() < 2)
+    {
+        err << "export-table: usage export-table <table|all> <file.chc|dir>\n";
+        return 1;
+    }
+    const int rowGroupSize = optionValue(args, "row-group", "65536").toInt();
+
+    // "all" writes <dir>/<table>.chc for every exportable table
+    QStringList tables;
+    QStringList paths;
+    if (positional.at(0) == "all")
+    {
+        QDir dir(positional.at(1));
+        dir.mkpath(".");
+        tables = Database::exportableTables();
+        for (const QString &table : tables)
+        {
+            paths << dir.filePath(table + ".chc");
+        }
+    }
+    else
+    {
+        tables << positional.at(0);
+        paths << positional.at(1);
+    }
+
+    for (int i = 0; i < tables.size(); ++i)
+    {
+        QElapsedTimer timer;
+        timer.start();
+        const qint64 rows = database->exportTable(tables.at(i), paths.at(i), rowGroupSize);
+        if (rows < 0)
+        {
+            err << "export-table: failed to export " << tables.at(i) << "\n";
+            return 1;
+        }
+        err << tables.at(i) << ": " << rows << " row(s) -> " << paths.at(i)
+            << " in " << timer.elapsed() << " ms\n";
+    }
+    return 0;
+}
+
+int CliCommands::inspectExport(const QStringList &args)
+{
+    const QString path = positionalArgs(args).value(0);
+    ColumnarReader reader(path);
+    if (path.isEmpty() || !reader.open())
+    {
+        err << "inspect-export: cannot read " << path << "\n";
+        return 1;
+    }
+
+    const QStringList columns = reader.columnNames();
+    const char *const typeNames[] = {"integer", "real", "text"};
+    const char *const encodingNames[] = {"plain", "delta", "dictionary"};
+    out << "rows\t" << reader.rowCount() << "\n";
+    for (int c = 0; c < columns.size(); ++c)
+    {
+        out << "column\t" << columns.at(c) << '\t' << typeNames[int(reader.columnType(c))] << "\n";
+    }
+
+    const auto &groups = reader.rowGroups();
+    for (size_t g = 0; g < groups.size(); ++g)
+    {
+        for (int c = 0; c < columns.size(); ++c)
+        {
+            const Columnar::ColumnChunk &chunk = groups[g].columns[c];
+            out << "group\t" << g << '\t' << columns.at(c) << '\t'
+                << groups[g].rowCount << " rows\t"
+                << chunk.compressedSize << " bytes\t"
+                << encodingNames[int(chunk.encoding)] << '\t'
+                << "nulls=" << chunk.nullCount << '\t'
+                << "min=" << chunk.min.toString() << '\t'
+                << "max=" << chunk.max.toString() << "\n";
+        }
+    }
+
+    // Rows are rebuilt column by column, one row group at a time
+    qint64 remaining = optionValue(args, "rows", "0").toLongLong();
+    std::vector<std::vector<QVariant>> groupColumns(columns.size());
+    for (size_t g = 0; g < groups.size() && remaining > 0; ++g)
+    {
+        for (int c = 0; c < columns.size(); ++c)
+        {
+            if (!reader.readColumn(int(g), c, groupColumns[c]))
+            {
+                err << "inspect-export: corrupt column " << columns.at(c) << " in row group " << g << "\n";
+                return 1;
+            }
+        }
+        for (qint64 row = 0; row < groups[g].rowCount && remaining > 0; ++row, --remaining)
+        {
+            for (int c = 0; c < columns.size(); ++c)
+            {
+                out << (c ? "\t" : "") << groupColumns[c][row].toString();
+            }
+            out << "\n";
+        }
+    }
+    return 0;
+}
+
+int CliCommands::snapshot(const QStringList &args)
+{
+    const QStringList positional = positionalArgs(args);
+    const QString action = positional.value(0);
+
+    if (action == "create")
+    {
+        QElapsedTimer timer;
+        timer.start();
+        SnapshotInfo info;
+        if (!database->createSnapshot(optionValue(args, "label"), &info))
+        {
+            err << "snapshot: create failed\n";
+            return 1;
+        }
+        out << info.id << "\n";
+        err << info.size << " bytes, " << info.chunks << " chunk(s), " << info.newChunks
+            << " new, in " << timer.elapsed() << " ms\n";
+        return 0;
+    }
+
+    if (action == "list")
+    {
+        for (const SnapshotInfo &info : database->listSnapshots())
+        {
+            out << info.id << '\t'
+                << info.created.toString(Qt::ISODate) << '\t'
+                << info.size << '\t'
+                << info.sha256.left(16) << '\t'
+                << info.label << "\n";
+        }
+        return 0;
+    }
+
+    if (action == "verify")
+    {
+        const QString id = positional.value(1);
+        if (id.isEmpty() || !database->verifySnapshot(id))
+        {
+            err << "snapshot: " << (id.isEmpty() ? QString("missing id") : id + " failed verification") << "\n";
+            return 1;
+        }
+        out << id << " OK\n";
+        return 0;
+    }
+
+    if (action == "restore")
+    {
+        QString id = positional.value(1);
+        const QString at = optionValue(args, "at");
+        if (id.isEmpty() && !at.isEmpty())
+        {
+            const QDateTime when = QDateTime::fromString(at, Qt::ISODate);
+            if (!when.isValid())
+            {
+                err << "snapshot: bad --at time " << at << "\n";
+                return 1;
+            }
+            id = database->snapshotAt(when).id;
+        }
+        if (id.isEmpty())
+        {
+            err << "snapshot: no snapshot to restore\n";
+            return 1;
+        }
+        const QString target = optionValue(args, "to");
+        if (!database->restoreSnapshot(id, target))
+        {
+            err << "snapshot: restore of " << id << " failed\n";
+            return 1;
+        }
+        if (target.isEmpty())
+            out << "Staged " << id << "; it replaces the database on the next start\n";
+        else
+            out << "Restored " << id << "\n";
+        return 0;
+    }
+
+    if (action == "prune")
+    {
+        bool ok = false;
+        const int keep = optionValue(args, "keep").toInt(&ok);
+        const int removed = ok ? database->pruneSnapshots(keep) : -1;
+        if (removed < 0)
+        {
+            err << "snapshot: prune needs --keep=N and no running snapshot\n";
+            return 1;
+        }
+        out << "Removed " << removed << " snapshot(s)\n";
+        return 0;
+    }
+
+    err << "snapshot: unknown action " << action << "\n";
+    return 1;
+}
+
+int CliCommands::tenants(const QStringList &args)
+{
+    if (!tenantDirectory)
+    {
+        err << "tenants: no tenant directory\n";
+        return 1;
+    }
+    QStringList ids = positionalArgs(args);
+    if (ids.isEmpty())
+    {
+        ids = tenantDirectory->tenantIds();
+    }
+
+    // One UNION ALL over the attached campus files instead of opening each one
+    out << "tenant\tusers\tjobs\topen_jobs\topen_positions\tapplications\n";
+    const bool ok = tenantDirectory->crossTenantQuery(
+        "SELECT (SELECT COUNT(*) FROM %1.users), "
+        "(SELECT COUNT(*) FROM %1.jobs), "
+        "(SELECT COUNT(*) FROM %1.jobs WHERE status IN (0, 1)), "
+        "(SELECT COALESCE(SUM(positions_available), 0) FROM %1.jobs WHERE status IN (0, 1)), "
+        "(SELECT COUNT(*) FROM %1.job_applications)",
+        ids,
+        [this](const QSqlQuery &row)
+        {
+            for (int column = 0; column < 6; ++column)
+            {
+                out << (column ? "\t" : "") << row.value(column).toString();
+            }
+            out << "\n";
+        });
+    if (!ok)
+    {
+        err << "tenants: report failed\n";
+        return 1;
+    }
+    return 0;
+}
+
+int CliCommands::suggest(const QStringList &args)
+{
+    const QString prefix = positionalArgs(args).join(' ');
+    const int limit = optionValue(args, "limit", "8").toInt();
+
+    QElapsedTimer timer;
+    timer.start();
+    const CompletionTrie trie = CompletionTrie::build(AutocompleteService::collectEntries(database->connection()));
+    const qint64 buildMs = timer.elapsed();
+
+    timer.restart();
+    const QStringList suggestions = trie.complete(prefix, limit);
+    const qint64 lookupNs = timer.nsecsElapsed();
+
+    for (const QString &suggestion : suggestions)
+    {
+        out << suggestion << "\n";
+    }
+    err << trie.size() << " terms, " << trie.nodeCount() << " nodes, " << trie.memoryBytes() / 1024
+        << " KiB; built in " << buildMs << " ms, lookup " << lookupNs / 1000 << " us\n";
+    return 0;
+}
+
+int CliCommands::compileQuestions(const QStringList &args)
+{
+    const QStringList files = positionalArgs(args);
+    if (files.size() < 2)
+    {
+        err << "compile-questions: need at least one source and an output file\n";
+        return 1;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    QuestionBankWriter writer;
+    for (const QString &source : files.mid(0, files.size() - 1))
+    {
+        QFile file;
+        if (!openInput(file, source))
+        {
+            err << "compile-questions: cannot open " << source << "\n";
+            return 1;
+        }
+
+        QString error;
+        int added;
+        if (source.endsWith(".json", Qt::CaseInsensitive))
+        {
+            added = writer.addJson(file.readAll(), &error);
+        }
+        else
+        {
+            QTextStream in(&file);
+            added = writer.addCsv(in, &error);
+        }
+        if (added < 0)
+        {
+            err << "compile-questions: " << source << ": " << error << "\n";
+            return 1;
+        }
+    }
+
+    QString error;
+    if (!writer.write(files.last(), &error))
+    {
+        err << "compile-questions: cannot write " << files.last() << ": " << error << "\n";
+        return 1;
+    }
+    out << "Compiled " << writer.questionCount() << " question(s) into " << writer.bucketCount()
+        << " index bucket(s), " << QFileInfo(files.last()).size() << " bytes\n";
+    err << "in " << timer.elapsed() << " ms\n";
+    return 0;
+}
+
+int CliCommands::sampleQuestions(const QStringList &args)
+{
+    const QStringList positional = positionalArgs(args);
+    if (positional.size() < 3)
+    {
+        err << "sample-questions: usage: sample-questions <bank.qbank> <major> <mode>\n";
+        return 1;
+    }
+    const int count = optionValue(args, "count", "5").toInt();
+    const QString difficultyName = optionValue(args, "difficulty");
+    const int difficulty = difficultyName.isEmpty() ? -1 : QuestionBankFormat::difficultyLevel(difficultyName);
+    if (!difficultyName.isEmpty() && difficulty < 0)
+    {
+        err << "sample-questions: unknown difficulty " << difficultyName << "\n";
+        return 1;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    QuestionBank bank;
+    if (!bank.open(positional.at(0)))
+    {
+        err << "sample-questions: cannot open " << positional.at(0) << "\n";
+        return 1;
+    }
+    const qint64 openNs = timer.nsecsElapsed();
+
+    timer.restart();
+    const QVector<Question> questions = bank.sample(positional.at(1), positional.at(2), count, difficulty);
+    const qint64 sampleNs = timer.nsecsElapsed();
+
+    for (const Question &question : questions)
+    {
+        out << question.text << '\t' << question.correctAnswer << '\t' << question.options.join(" | ") << "\n";
+    }
+    err << bank.count(positional.at(1), positional.at(2), difficulty) << " of " << bank.size()
+        << " question(s) match; open " << openNs / 1000 << " us, sample " << sampleNs / 1000 << " us\n";
+    return 0;
+}
+
+int CliCommands::parseAvailability(const QStringList &args)
+{
+    const QString text = positionalArgs(args).join(' ');
+    bool ok = false;
+    const Availability availability = Availability::parse(text, &ok);
+    if (!ok)
+    {
+        err << "availability: no days or times recognized in \"" << text << "\"\n";
+        return 1;
+    }
+    out << availability.toString() << "\n";
+    err << availability.slotCount() * Availability::kSlotMinutes / 60.0 << " hours/week, blocks 0x"
+        << QString::number(availability.blockMask(), 16) << "\n";
+    return 0;
+}
+
+int CliCommands::matchApplicants(const QStringList &args)
+{
+    const QStringList positional = positionalArgs(args);
+    if (positional.isEmpty())
+    {
+        err << "match-applicants: usage: match-applicants <job id> [--shift=TEXT]\n";
+        return 1;
+    }
+    const int jobId = positional.first().toInt();
+    const Job job = database->getJobById(jobId);
+    if (job.getId() < 0)
+    {
+        err << "match-applicants: no job " << jobId << "\n";
+        return 1;
+    }
+    const QString shiftText = optionValue(args, "shift", job.getSchedule());
+    const Availability shift = Availability::parse(shiftText);
+
+    QElapsedTimer timer;
+    timer.start();
+    const std::vector<ApplicantAvailability> applicants = database->getApplicantAvailability(jobId);
+    const qint64 loadUs = timer.nsecsElapsed() / 1000;
+
+    timer.restart();
+    const std::vector<ShiftMatch> matches = ScheduleMatcher::rank(shift, applicants);
+    const qint64 rankNs = timer.nsecsElapsed();
+
+    out << "application\tuser\thours\tcoverage\tcovers\n";
+    for (const ShiftMatch &match : matches)
+    {
+        out << match.applicationId << '\t' << match.userId << '\t'
+            << match.overlapSlots * Availability::kSlotMinutes / 60.0 << '\t'
+            << QString::number(match.coverage * 100.0, 'f', 0) << "%\t" << (match.coversShift ? "yes" : "no") << "\n";
+    }
+    err << "shift: " << (shift.isEmpty() ? QString("any time") : shift.toString()) << "\n"
+        << matches.size() << " applicant(s); loaded in " << loadUs << " us, ranked in " << rankNs / 1000.0
+        << " us\n";
+    return 0;
+}
+
+int CliCommands::whoCanWork(const QStringList &args)
+{
+    const QString text = positionalArgs(args).join(' ');
+    bool ok = false;
+    const Availability needed = Availability::parse(text, &ok);
+    if (!ok || needed.isEmpty())
+    {
+        err << "who-can-work: no days or times recognized in \"" << text << "\"\n";
+        return 1;
+    }
+    const int jobId = optionValue(args, "job", "-1").toInt();
+
+    QElapsedTimer timer;
+    timer.start();
+    const std::vector<ApplicantAvailability> applicants =
+        database->findAvailableApplicants(needed, hasFlag(args, "whole"), jobId);
+    const qint64 queryUs = timer.nsecsElapsed() / 1000;
+
+    out << "application\tuser\tjob\tcoverage\n";
+    for (const ApplicantAvailability &applicant : applicants)
+    {
+        out << applicant.applicationId << '\t' << applicant.userId << '\t' << applicant.jobId << '\t'
+            << QString::number(applicant.availability.coverage(needed) * 100.0, 'f', 0) << "%\n";
+    }
+    err << "needed: " << needed.toString() << "\n"
+        << applicants.size() << " application(s) in " << queryUs << " us\n";
+    return 0;
+}
+
+int CliCommands::setCalendar(const QStringList &args)
+{
+    const QStringList positional = positionalArgs(args);
+    if (positional.size() < 2)
+    {
+        err << "set-calendar: usage: set-calendar <supervisor> <free time>\n";
+        return 1;
+    }
+    const QString calendar = positional.mid(1).join(' ');
+    bool ok = false;
+    const Availability availability = Availability::parse(calendar, &ok);
+    if (!ok || availability.isEmpty())
+    {
+        err << "set-calendar: no days or times recognized in \"" << calendar << "\"\n";
+        return 1;
+    }
+    if (!database->setSupervisorCalendar(positional.first(), calendar))
+    {
+        return 2;
+    }
+    out << positional.first() << ": " << availability.toString() << "\n";
+    return 0;
+}
+
+int CliCommands::scheduleInterviews(const QStringList &args)
+{
+    QElapsedTimer timer;
+    timer.start();
+    InterviewScheduler scheduler(optionValue(args, "length", "30").toInt(), optionValue(args, "rooms", "1").toInt(),
+                                 optionValue(args, "per-supervisor", "1").toInt());
+    scheduler.load(database);
+    int kept = 0;
+    if (!hasFlag(args, "fresh"))
+    {
+        for (const ScheduledInterview &interview : database->getInterviewSchedule())
+        {
+            kept += scheduler.book(interview.applicationId, interview.day, interview.startMinute) ? 1 : 0;
+        }
+    }
+    const qint64 loadMs = timer.elapsed();
+
+    timer.restart();
+    const int booked = scheduler.solve();
+    const qint64 solveUs = timer.nsecsElapsed() / 1000;
+
+    const std::vector<ScheduledInterview> interviews = scheduler.schedule();
+    printInterviews(interviews);
+    if (!hasFlag(args, "dry-run") && !database->saveInterviewSchedule(interviews))
+    {
+        return 2;
+    }
+    err << booked << " of " << scheduler.applicantCount() << " applicant(s) booked (" << kept
+        << " kept from the saved schedule); loaded in " << loadMs << " ms, solved in " << solveUs << " us\n";
+    return 0;
+}
+
+int CliCommands::cancelInterview(const QStringList &args)
+{
+    const QStringList positional = positionalArgs(args);
+    const QString supervisor = optionValue(args, "supervisor");
+    if (positional.isEmpty())
+    {
+        err << "cancel-interview: usage: cancel-interview <application id>\n"
+               "                        cancel-interview --supervisor=NAME <time>\n";
+        return 1;
+    }
+
+    InterviewScheduler scheduler(optionValue(args, "length", "30").toInt(), optionValue(args, "rooms", "1").toInt(),
+                                 optionValue(args, "per-supervisor", "1").toInt());
+    scheduler.load(database);
+    const std::vector<ScheduledInterview> before = database->getInterviewSchedule();
+    for (const ScheduledInterview &interview : before)
+    {
+        scheduler.book(interview.applicationId, interview.day, interview.startMinute);
+    }
+    scheduler.solve();
+
+    QElapsedTimer timer;
+    timer.start();
+    bool cancelled = false;
+    if (supervisor.isEmpty())
+    {
+        cancelled = scheduler.cancelApplicant(positional.first().toInt());
+    }
+    else
+    {
+        const Availability blocked = Availability::parse(positional.join(' '));
+        cancelled = !blocked.isEmpty() && scheduler.cancelSupervisorTime(supervisor, blocked);
+    }
+    const qint64 resolveUs = timer.nsecsElapsed() / 1000;
+    if (!cancelled)
+    {
+        err << "cancel-interview: nothing to cancel\n";
+        return 1;
+    }
+
+    // Report only the bookings that changed
+    QHash<int, ScheduledInterview> previous;
+    for (const ScheduledInterview &interview : before)
+    {
+        previous.insert(interview.applicationId, interview);
+    }
+    const std::vector<ScheduledInterview> after = scheduler.schedule();
+    std::vector<ScheduledInterview> changed;
+    for (const ScheduledInterview &interview : after)
+    {
+        const ScheduledInterview old = previous.take(interview.applicationId);
+        if (old.applicationId < 0 || old.day != interview.day || old.startMinute != interview.startMinute)
+        {
+            changed.push_back(interview);
+        }
+    }
+    printInterviews(changed);
+    for (const ScheduledInterview &interview : previous)
+    {
+        out << interview.applicationId << "\tunbooked\n";
+    }
+
+    if (!database->saveInterviewSchedule(after))
+    {
+        return 2;
+    }
+    err << changed.size() << " booking(s) added or moved, " << previous.size() << " dropped; re-solved in "
+        << resolveUs << " us\n";
+    return 0;
+}
+
+void CliCommands::printInterviews(const std::vector<ScheduledInterview> &interviews)
+{
+    static const char *const days[] = {"Mon", "Tue", "Wed", "Thu", "Fri", "Sat", "Sun"};
+    auto clock = [](int minutes)
+    { return QString("%1:%2").arg(minutes / 60, 2, 10, QChar('0')).arg(minutes % 60, 2, 10, QChar('0')); };
+    for (const ScheduledInterview &interview : interviews)
+    {
+        out << interview.applicationId << '\t' << interview.supervisor << '\t' << days[interview.day] << ' '
+            << clock(interview.startMinute) << '-' << clock(interview.endMinute) << "\troom " << interview.room << "\n";
+    }
+}
+
+int CliCommands::benchCatalog(const QStringList &args)
+{
+    const int iterations = qMax(1, optionValue(args, "iterations", "20").toInt());
+    const StorageBackend previous = database->storageBackend();
+
+    out << "backend\tjobs\tavg_ms\tmin_ms\tjobs_per_s\n";
+    std::vector<Job> reference;
+    int exitCode = 0;
+    for (const StorageBackend backend : {StorageBackend::Qt, StorageBackend::Native})
+    {
+        const QString name = backend == StorageBackend::Qt ? "qt" : "native";
+        if (!database->setStorageBackend(backend))
+        {
+            err << "bench-catalog: " << name << " backend unavailable\n";
+            exitCode = 1;
+            continue;
+        }
+
+        std::vector<Job> jobs = database->getJobs(); // warm the page cache
+        qint64 totalNs = 0;
+        qint64 bestNs = -1;
+        for (int i = 0; i < iterations; ++i)
+        {
+            QElapsedTimer timer;
+            timer.start();
+            jobs = database->getJobs();
+            const qint64 elapsedNs = timer.nsecsElapsed();
+            totalNs += elapsedNs;
+            bestNs = bestNs < 0 ? elapsedNs : qMin(bestNs, elapsedNs);
+        }
+
+        const double averageMs = totalNs / 1e6 / iterations;
+        out << name << '\t' << jobs.size() << '\t' << QString::number(averageMs, 'f', 3) << '\t'
+            << QString::number(bestNs / 1e6, 'f', 3) << '\t'
+            << QString::number(averageMs > 0 ? jobs.size() / (averageMs / 1000.0) : 0.0, 'f', 0) << "\n";
+
+        // Both backends must decode the same catalog
+        if (backend == StorageBackend::Qt)
+        {
+            reference = std::move(jobs);
+            continue;
+        }
+        bool same = jobs.size() == reference.size();
+        for (size_t i = 0; same && i < jobs.size(); ++i)
+        {
+            same = jobs[i].getId() == reference[i].getId() && jobs[i].getTitle() == reference[i].getTitle() &&
+                   jobs[i].getDescription() == reference[i].getDescription() &&
+                   jobs[i].getPayRateMax() == reference[i].getPayRateMax();
+        }
+        if (!same)
+        {
+            err << "bench-catalog: native rows differ from Qt rows\n";
+            exitCode = 2;
+        }
+    }
+
+    database->setStorageBackend(previous);
+    err << iterations << " load(s) per backend\n";
+    return exitCode;
+}
@@ -0,0 +1,99 @@
+#include <QCoreApplication>
+#include <QTextStream>
+#include "cli/clicommands.h"
+#include "database/database.h"
+#include "database/tenantdirectory.h"
+#include <memory>
+#include "utils/tracer.h"
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("campus_cli");
+
+    QStringList args = app.arguments();
+    args.removeFirst();
+
+    if (args.isEmpty() || args.first() == "help" || args.first() == "--help")
+    {
+        QTextStream out(stdout);
+        CliCommands::printUsage(out);
+        return args.isEmpty() ? 1 : 0;
+    }
+
+    // Global options come before the command
+    QString databasePath = Database::defaultDatabasePath();
+    QString tenantId;
+    QString tenantRoot = TenantDirectory::defaultRoot();
+    QString backend;
+    while (!args.isEmpty() && args.first().startsWith("--"))
+    {
+        const QString option = args.takeFirst();
+        if (option.startsWith("--db="))
+            databasePath = option.mid(5);
+        else if (option.startsWith("--tenant="))
+            tenantId = option.mid(9);
+        else if (option.startsWith("--tenant-dir="))
+            tenantRoot = option.mid(13);
+        else if (option.startsWith("--backend="))
+            backend = option.mid(10);
+        else
+        {
+            QTextStream err(stderr);
+            err << "Unknown option: " << option << "\n";
+            CliCommands::printUsage(err);
+            return 1;
+        }
+    }
+    if (args.isEmpty())
+    {
+        QTextStream err(stderr);
+        CliCommands::printUsage(err);
+        return 1;
+    }
+
+    Tracer::instance().enableFromEnvironment();
+
+    TenantDirectory tenants(tenantRoot);
+    std::unique_ptr<Database> ownDatabase;
+    Database *db = nullptr;
+    if (!tenantId.isEmpty())
+    {
+        db = tenants.tenant(tenantId);
+    }
+    else
+    {
+        ownDatabase.reset(new Database(databasePath, QSqlDatabase::defaultConnection));
+        if (ownDatabase->connectToDatabase())
+        {
+            db = ownDatabase.get();
+        }
+    }
+    if (!db)
+    {
+        QTextStream(stderr) << "Failed to connect to database\n";
+        return 2;
+    }
+    if (!backend.isEmpty() && backend != "qt" && backend != "native")
+    {
+        QTextStream(stderr) << "Unknown backend: " << backend << "\n";
+        return 1;
+    }
+    if (backend == "native" && !db->setStorageBackend(StorageBackend::Native))
+    {
+        QTextStream(stderr) << "Native backend unavailable, using Qt\n";
+    }
+    else if (backend == "qt")
+    {
+        db->setStorageBackend(StorageBackend::Qt);
+    }
+
+    CliCommands commands(db, &tenants);
+    int exitCode = commands.run(args);
+
+    if (Tracer::isEnabled())
+    {
+        Tracer::instance().writeChromeTrace();
+    }
+    return exitCode;
+}
@@ -0,0 +1,57 @@
+#include <QCoreApplication>
+#include <QFile>
+#include <QTextStream>
+#include "utils/questionbank.h"
+
+// Build-time question bank compiler: the same sources as
+// "campus_cli compile-questions", without a database or QtSql
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("question_compiler");
+
+    QStringList files = app.arguments();
+    files.removeFirst();
+    QTextStream err(stderr);
+    if (files.size() < 2)
+    {
+        err << "usage: question_compiler <source.json|source.csv>... <out.qbank>\n";
+        return 1;
+    }
+
+    QuestionBankWriter writer;
+    for (const QString &source : files.mid(0, files.size() - 1))
+    {
+        QFile file(source);
+        if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+        {
+            err << "question_compiler: cannot open " << source << "\n";
+            return 1;
+        }
+
+        QString error;
+        int added;
+        if (source.endsWith(".json", Qt::CaseInsensitive))
+        {
+            added = writer.addJson(file.readAll(), &error);
+        }
+        else
+        {
+            QTextStream in(&file);
+            added = writer.addCsv(in, &error);
+        }
+        if (added < 0)
+        {
+            err << "question_compiler: " << source << ": " << error << "\n";
+            return 1;
+        }
+    }
+
+    QString error;
+    if (!writer.write(files.last(), &error))
+    {
+        err << "question_compiler: cannot write " << files.last() << ": " << error << "\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,454 @@
+#include "database/catalogsnapshot.h"
+#include "database/database.h"
+#include "models/jobfilter.h"
+#include "utils/tracer.h"
+#include <QCoreApplication>
+#include <QDebug>
+#include <QHash>
+#include <QPointer>
+#include <QSaveFile>
+#include <QSqlError>
+#include <QThreadPool>
+#include <QtEndian>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+    const char kMagic[8] = {'C', 'H', 'J', 'O', 'B', 'C', 'A', 'T'};
+    // 3: Closing Soon jobs are included (earlier files hold Open jobs only)
+    const quint32 kFormatVersion = 3;
+
+    const quint32 kHeaderSize = 72;   // magic, format, job count, i64 table version, records,
+                                      // strings, string bytes, (offset, count) per filtered view,
+                                      // i64 database id
+    const quint32 kStringRefSize = 8; // u32 offset, u32 length
+    const int kTextFields = 13;
+    const quint32 kRecordSize = 40 + kTextFields * kStringRefSize; // u32 id, status, hours, positions,
+                                                                   // flags, reserved; f64 pay min, max
+    const int kPageSize = 500;
+
+    std::atomic_int catalogConnectionCounter{0};
+
+    enum Flag
+    {
+        WorkStudyFlag = 1,
+        InternationalFlag = 2
+    };
+
+    quint32 u32(const uchar *p)
+    {
+        return qFromLittleEndian<quint32>(p);
+    }
+
+    double f64(const uchar *p)
+    {
+        const quint64 bits = qFromLittleEndian<quint64>(p);
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    void putU32(QByteArray &out, quint32 value)
+    {
+        uchar bytes[4];
+        qToLittleEndian(value, bytes);
+        out.append(reinterpret_cast<const char *>(bytes), 4);
+    }
+
+    void putU64(QByteArray &out, quint64 value)
+    {
+        uchar bytes[8];
+        qToLittleEndian(value, bytes);
+        out.append(reinterpret_cast<const char *>(bytes), 8);
+    }
+
+    void putF64(QByteArray &out, double value)
+    {
+        quint64 bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        putU64(out, bits);
+    }
+
+    // Departments, categories and boilerplate repeat across jobs; store them once
+    class StringPool
+    {
+    public:
+        void addRef(QByteArray &out, const QString &text)
+        {
+            const QByteArray utf8 = text.toUtf8();
+            auto it = offsets.constFind(utf8);
+            quint32 offset;
+            if (it != offsets.constEnd())
+            {
+                offset = *it;
+            }
+            else
+            {
+                offset = static_cast<quint32>(pool.size());
+                pool += utf8;
+                offsets.insert(utf8, offset);
+            }
+            putU32(out, offset);
+            putU32(out, static_cast<quint32>(utf8.size()));
+        }
+
+        QByteArray pool;
+
+    private:
+        QHash<QByteArray, quint32> offsets;
+    };
+
+    bool fail(QString *error, const QString &message)
+    {
+        if (error)
+        {
+            *error = message;
+        }
+        return false;
+    }
+}
+
+CatalogSnapshot::CatalogSnapshot()
+    : data(nullptr), fileSize(0), version(-1), identity(0), jobCount(0), recordsOffset(0), stringsOffset(0), stringBytes(0),
+      viewOffset{}, viewCount{}, writeState(std::make_shared<WriteState>())
+{
+}
+
+CatalogSnapshot::View CatalogSnapshot::viewFor(bool workStudyOnly, bool internationalOnly)
+{
+    if (workStudyOnly && internationalOnly)
+        return WorkStudyAndInternational;
+    if (workStudyOnly)
+        return WorkStudy;
+    if (internationalOnly)
+        return International;
+    return AllJobs;
+}
+
+QString CatalogSnapshot::defaultPath(const QString &databasePath)
+{
+    if (databasePath.isEmpty() || databasePath == ":memory:")
+    {
+        return QString();
+    }
+    return databasePath + ".jobcat";
+}
+
+bool CatalogSnapshot::write(const QString &databasePath, const QString &path, QString *error)
+{
+    TRACE_SCOPE("db", "CatalogSnapshot::write");
+    const QString connection = QString("catalog-%1").arg(++catalogConnectionCounter);
+    bool ok = false;
+    {
+        QSqlDatabase source = QSqlDatabase::addDatabase("QSQLITE", connection);
+        source.setDatabaseName(databasePath);
+        source.setConnectOptions("QSQLITE_BUSY_TIMEOUT=5000");
+        if (!source.open())
+        {
+            fail(error, source.lastError().text());
+        }
+        else
+        {
+            // One read transaction, so the stamped version matches the rows
+            source.transaction();
+            ok = serialize(source, path, error);
+            source.rollback();
+            source.close();
+        }
+    }
+    QSqlDatabase::removeDatabase(connection);
+    return ok;
+}
+
+bool CatalogSnapshot::serialize(QSqlDatabase source, const QString &path, QString *error)
+{
+    const qint64 tableVersion = Database::jobsTableVersion(source);
+    const qint64 databaseId = Database::databaseId(source);
+    if (tableVersion < 0 || databaseId == 0)
+    {
+        return fail(error, "cannot read the jobs table version or database id");
+    }
+
+    QByteArray records;
+    StringPool strings;
+    std::vector<quint32> views[ViewCount];
+
+    // Same filter and order as the jobs page queries, one page at a time
+    const auto listedJobs = makeJobFilter(JobFilters::Status{JobFilters::kAcceptingApplications});
+    JobCursor cursor;
+    quint32 record = 0;
+    for (;;)
+    {
+        const std::vector<Job> page = Database::getJobsPage(source, listedJobs, cursor, kPageSize);
+        for (const Job &job : page)
+        {
+            const quint32 flags = (job.isWorkStudyEligible() ? WorkStudyFlag : 0) |
+                                  (job.isInternationalEligible() ? InternationalFlag : 0);
+            putU32(records, static_cast<quint32>(job.getId()));
+            putU32(records, static_cast<quint32>(job.getStatus()));
+            putU32(records, static_cast<quint32>(job.getHoursPerWeek()));
+            putU32(records, static_cast<quint32>(job.getPositionsAvailable()));
+            putU32(records, flags);
+            putU32(records, 0);
+            putF64(records, job.getPayRateMin());
+            putF64(records, job.getPayRateMax());
+            for (const QString &text : {job.getTitle(), job.getDepartment(), job.getCategory(),
+                                        job.getDescription(), job.getDeadline(), job.getRequirements(),
+                                        job.getDuties(), job.getSkills(), job.getSupervisorInfo(),
+                                        job.getContactEmail(), job.getSchedule(), job.getRequiredDocuments(),
+                                        job.getOpenDate()})
+            {
+                strings.addRef(records, text);
+            }
+
+            if (flags & WorkStudyFlag)
+                views[WorkStudy].push_back(record);
+            if (flags & InternationalFlag)
+                views[International].push_back(record);
+            if (flags == (WorkStudyFlag | InternationalFlag))
+                views[WorkStudyAndInternational].push_back(record);
+            ++record;
+        }
+        if (static_cast<int>(page.size()) < kPageSize)
+        {
+            break;
+        }
+    }
+
+    QByteArray indexes;
+    quint32 offsets[ViewCount] = {};
+    quint32 offset = kHeaderSize + static_cast<quint32>(records.size());
+    for (int view = WorkStudy; view < ViewCount; ++view)
+    {
+        offsets[view] = offset;
+        for (quint32 index : views[view])
+        {
+            putU32(indexes, index);
+        }
+        offset += static_cast<quint32>(views[view].size() * 4);
+    }
+
+    QByteArray header(kMagic, sizeof(kMagic));
+    putU32(header, kFormatVersion);
+    putU32(header, record);
+    putU64(header, static_cast<quint64>(tableVersion));
+    putU32(header, kHeaderSize);
+    putU32(header, offset);
+    putU32(header, static_cast<quint32>(strings.pool.size()));
+    for (int view = WorkStudy; view < ViewCount; ++view)
+    {
+        putU32(header, offsets[view]);
+        putU32(header, static_cast<quint32>(views[view].size()));
+    }
+    putU64(header, static_cast<quint64>(databaseId));
+    header.append(QByteArray(kHeaderSize - header.size(), '\0'));
+
+    // Readers keep their mapping of the old file until they reopen
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly))
+        return fail(error, file.errorString());
+    for (const QByteArray *section : {&header, &records, &indexes, &strings.pool})
+    {
+        if (file.write(*section) != section->size())
+            return fail(error, file.errorString());
+    }
+    if (!file.commit())
+        return fail(error, file.errorString());
+    return true;
+}
+
+bool CatalogSnapshot::refresh(Database *db, QObject *context, std::function<void()> ready)
+{
+    TRACE_SCOPE("db", "CatalogSnapshot::refresh");
+    const qint64 current = db->jobsTableVersion();
+    const qint64 databaseId = db->databaseId();
+    const QString path = defaultPath(db->databasePath());
+    if (current < 0 || databaseId == 0 || path.isEmpty())
+    {
+        close();
+        return false;
+    }
+    // A re-created or copied-in database can reach the same version
+    if (isOpen() && version == current && identity == databaseId)
+    {
+        return true;
+    }
+
+    close();
+    if (open(path) && version == current && identity == databaseId)
+    {
+        return true;
+    }
+    close();
+    if (!context)
+    {
+        return false;
+    }
+
+    // Writing reads every open job, so it stays off the caller's thread
+    std::shared_ptr<WriteState> state = writeState;
+    state->again = true;
+    if (state->running.exchange(true))
+    {
+        return false; // the running task picks up "again" before it finishes
+    }
+    const QString databasePath = db->databasePath();
+    QPointer<QObject> guard(context);
+    QThreadPool::globalInstance()->start([state, databasePath, path, guard, ready]()
+                                         {
+        bool written = false;
+        for (;;)
+        {
+            while (state->again.exchange(false))
+            {
+                QString error;
+                written = write(databasePath, path, &error);
+                if (!written)
+                {
+                    qDebug() << "Cannot write job catalog snapshot" << path << ":" << error;
+                }
+            }
+            state->running = false;
+            // A refresh that saw running just before it was cleared left "again" set
+            if (!state->again || state->running.exchange(true))
+            {
+                break;
+            }
+        }
+        if (!written || !ready)
+        {
+            return;
+        }
+        // guard is only dereferenced back on the thread that owns it
+        QMetaObject::invokeMethod(QCoreApplication::instance(), [guard, ready]()
+                                  {
+            if (guard)
+            {
+                ready();
+            } }, Qt::QueuedConnection); });
+    return false;
+}
+
+bool CatalogSnapshot::open(const QString &path)
+{
+    close();
+    file.setFileName(path);
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        return false; // not written yet
+    }
+    fileSize = file.size();
+    const uchar *mapped = fileSize >= kHeaderSize ? file.map(0, fileSize) : nullptr;
+    if (!mapped || std::memcmp(mapped, kMagic, sizeof(kMagic)) != 0 || u32(mapped + 8) != kFormatVersion)
+    {
+        qDebug() << "Not a job catalog snapshot:" << path;
+        close();
+        return false;
+    }
+
+    jobCount = u32(mapped + 12);
+    version = static_cast<qint64>(qFromLittleEndian<quint64>(mapped + 16));
+    recordsOffset = u32(mapped + 24);
+    stringsOffset = u32(mapped + 28);
+    stringBytes = u32(mapped + 32);
+    viewOffset[AllJobs] = recordsOffset;
+    viewCount[AllJobs] = jobCount;
+    for (int view = WorkStudy; view < ViewCount; ++view)
+    {
+        viewOffset[view] = u32(mapped + 36 + (view - 1) * 8);
+        viewCount[view] = u32(mapped + 40 + (view - 1) * 8);
+    }
+    identity = static_cast<qint64>(qFromLittleEndian<quint64>(mapped + 60));
+
+    // Section bounds are checked once here, so opening does not depend on
+    // the catalog size; index entries are range-checked when read
+    auto fits = [this](quint32 offset, quint32 count, quint32 size)
+    { return quint64(offset) + quint64(count) * size <= quint64(fileSize); };
+    bool valid = fits(recordsOffset, jobCount, kRecordSize) && fits(stringsOffset, stringBytes, 1);
+    for (int view = WorkStudy; view < ViewCount; ++view)
+    {
+        valid = valid && viewCount[view] <= jobCount && fits(viewOffset[view], viewCount[view], 4);
+    }
+    if (!valid)
+    {
+        qDebug() << "Truncated job catalog snapshot:" << path;
+        close();
+        return false;
+    }
+    data = mapped;
+    return true;
+}
+
+void CatalogSnapshot::close()
+{
+    if (file.isOpen())
+    {
+        file.close(); // also unmaps
+    }
+    data = nullptr;
+    fileSize = 0;
+    version = -1;
+    identity = 0;
+    jobCount = recordsOffset = stringsOffset = stringBytes = 0;
+    for (int view = 0; view < ViewCount; ++view)
+    {
+        viewOffset[view] = viewCount[view] = 0;
+    }
+}
+
+int CatalogSnapshot::count(View view) const
+{
+    return static_cast<int>(viewCount[view]);
+}
+
+int CatalogSnapshot::recordAt(View view, int position) const
+{
+    if (!data || position < 0 || quint32(position) >= viewCount[view])
+    {
+        return -1;
+    }
+    if (view == AllJobs)
+    {
+        return position;
+    }
+    const quint32 record = u32(data + viewOffset[view] + quint32(position) * 4);
+    return record < jobCount ? static_cast<int>(record) : -1;
+}
+
+int CatalogSnapshot::jobId(int record) const
+{
+    if (!data || record < 0 || quint32(record) >= jobCount)
+    {
+        return -1;
+    }
+    return static_cast<int>(u32(data + recordsOffset + quint32(record) * kRecordSize));
+}
+
+QString CatalogSnapshot::text(const uchar *ref) const
+{
+    const quint32 offset = u32(ref);
+    const quint32 length = u32(ref + 4);
+    if (quint64(offset) + length > stringBytes)
+    {
+        return QString();
+    }
+    return QString::fromUtf8(reinterpret_cast<const char *>(data + stringsOffset + offset), length);
+}
+
+Job CatalogSnapshot::job(int record) const
+{
+    if (!data || record < 0 || quint32(record) >= jobCount)
+    {
+        return Job();
+    }
+    const uchar *p = data + recordsOffset + quint32(record) * kRecordSize;
+    const uchar *refs = p + 40;
+    auto field = [this, refs](int index)
+    { return text(refs + index * kStringRefSize); };
+    const quint32 flags = u32(p + 16);
+    return Job(static_cast<int>(u32(p)), field(0), field(1), field(2), field(3), f64(p + 24), f64(p + 32),
+               static_cast<int>(u32(p + 8)), static_cast<int>(u32(p + 12)), static_cast<JobStatus>(u32(p + 4)),
+               (flags & WorkStudyFlag) != 0, (flags & InternationalFlag) != 0, field(4), field(5), field(6),
+               field(7), field(8), field(9), field(10), field(11), field(12));
+}
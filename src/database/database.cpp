@@ -2,38 +2,319 @@
 #include <QSqlQuery>
 #include <QSqlError>
 #include <QDebug>
-#include <QCryptographicHash>
 #include <QDateTime>
 #include <QVariant>
+#include <QDir>
+#include <QFile>
+#include <QPointer>
+#include <QSettings>
+#include <QThreadPool>
+#include <utility>
+#include "database/catalogsnapshot.h"
+#include "services/credentialservice.h"
+#include "services/jobanalytics.h"
+#include "utils/columnarfile.h"
+#include "utils/tracer.h"
+
+namespace
+{
+    // Builds a Job from the current row of a "SELECT * FROM jobs" query
+    Job jobFromQuery(const QSqlQuery &query)
+    {
+        JobStatus status = static_cast<JobStatus>(query.value("status").toInt());
+        return Job(
+            query.value("id").toInt(),
+            query.value("title").toString(),
+            query.value("department").toString(),
+            query.value("category").toString(),
+            query.value("description").toString(),
+            query.value("pay_rate_min").toDouble(),
+            query.value("pay_rate_max").toDouble(),
+            query.value("hours_per_week").toInt(),
+            query.value("positions_available").toInt(),
+            status,
+            query.value("work_study_eligible").toBool(),
+            query.value("international_eligible").toBool(),
+            query.value("deadline").toString(),
+            query.value("requirements").toString(),
+            query.value("duties").toString(),
+            query.value("skills").toString(),
+            query.value("supervisor_info").toString(),
+            query.value("contact_email").toString(),
+            query.value("schedule").toString(),
+            query.value("required_documents").toString(),
+            query.value("open_date").toString());
+    }
+
+    // Column positions of "SELECT * FROM jobs", looked up once per statement
+    struct JobColumns
+    {
+        explicit JobColumns(const NativeSqlite::Statement &query)
+            : id(query.columnIndex("id")), title(query.columnIndex("title")),
+              department(query.columnIndex("department")), category(query.columnIndex("category")),
+              description(query.columnIndex("description")), payRateMin(query.columnIndex("pay_rate_min")),
+              payRateMax(query.columnIndex("pay_rate_max")), hoursPerWeek(query.columnIndex("hours_per_week")),
+              positions(query.columnIndex("positions_available")), status(query.columnIndex("status")),
+              workStudy(query.columnIndex("work_study_eligible")),
+              international(query.columnIndex("international_eligible")), deadline(query.columnIndex("deadline")),
+              requirements(query.columnIndex("requirements")), duties(query.columnIndex("duties")),
+              skills(query.columnIndex("skills")), supervisor(query.columnIndex("supervisor_info")),
+              contactEmail(query.columnIndex("contact_email")), schedule(query.columnIndex("schedule")),
+              requiredDocuments(query.columnIndex("required_documents")), openDate(query.columnIndex("open_date"))
+        {
+        }
+
+        int id, title, department, category, description, payRateMin, payRateMax, hoursPerWeek, positions,
+            status, workStudy, international, deadline, requirements, duties, skills, supervisor, contactEmail,
+            schedule, requiredDocuments, openDate;
+    };
+
+    // jobFromQuery without QVariant: typed reads straight off the statement
+    Job jobFromStatement(const NativeSqlite::Statement &query, const JobColumns &column)
+    {
+        return Job(
+            query.integer(column.id),
+            query.string(column.title),
+            query.string(column.department),
+            query.string(column.category),
+            query.string(column.description),
+            query.real(column.payRateMin),
+            query.real(column.payRateMax),
+            query.integer(column.hoursPerWeek),
+            query.integer(column.positions),
+            static_cast<JobStatus>(query.integer(column.status)),
+            query.int64(column.workStudy) != 0,
+            query.int64(column.international) != 0,
+            query.string(column.deadline),
+            query.string(column.requirements),
+            query.string(column.duties),
+            query.string(column.skills),
+            query.string(column.supervisor),
+            query.string(column.contactEmail),
+            query.string(column.schedule),
+            query.string(column.requiredDocuments),
+            query.string(column.openDate));
+    }
+
+    const char *const kUserColumns =
+        "id, email, full_name, emplid, major, gpa, grad_date, is_international_student, "
+        "survey_completed, resume_path, transcript_path, parsed_resume_data, parsed_gpa, parsed_courses";
+
+    User userFromQuery(const QSqlQuery &query)
+    {
+        return User(
+            query.value("id").toInt(),
+            query.value("email").toString(),
+            query.value("full_name").toString(),
+            query.value("emplid").toString(),
+            query.value("major").toString(),
+            query.value("gpa").toString(),
+            query.value("grad_date").toString(),
+            query.value("is_international_student").toBool(),
+            query.value("survey_completed").toBool(),
+            query.value("resume_path").toString(),
+            query.value("transcript_path").toString(),
+            query.value("parsed_resume_data").toString(),
+            query.value("parsed_gpa").toString(),
+            query.value("parsed_courses").toString());
+    }
+
+    // availability_mon .. availability_sun, one slot word per day
+    const QString kAvailabilityColumns = QStringLiteral(
+        "availability_mon, availability_tue, availability_wed, availability_thu, "
+        "availability_fri, availability_sat, availability_sun");
+
+    void bindAvailability(QSqlQuery &query, const Availability &availability)
+    {
+        for (int day = 0; day < Availability::kDays; ++day)
+        {
+            query.addBindValue(static_cast<qint64>(availability.day(day)));
+        }
+        query.addBindValue(availability.blockMask());
+    }
+
+    // Reads kAvailabilityColumns starting at column first
+    Availability availabilityFromQuery(const QSqlQuery &query, int first)
+    {
+        Availability availability;
+        for (int day = 0; day < Availability::kDays; ++day)
+        {
+            availability.setDay(day, static_cast<quint64>(query.value(first + day).toLongLong()));
+        }
+        return availability;
+    }
+
+    std::atomic_int snapshotConnectionCounter{0};
+
+    // An in-place restore is staged here and swapped in at the next connect
+    QString stagedRestorePath(const QString &databasePath)
+    {
+        return databasePath + ".restore";
+    }
+
+    // Under WAL every open connection keeps a shared lock on the file, so an
+    // exclusive-mode probe fails at once if any other connection, in this
+    // process or another, still has it open
+    bool isDatabaseIdle(const QString &databasePath)
+    {
+        const QString connection = QString("snapshot-%1").arg(++snapshotConnectionCounter);
+        bool idle = false;
+        {
+            QSqlDatabase probe = QSqlDatabase::addDatabase("QSQLITE", connection);
+            probe.setDatabaseName(databasePath);
+            probe.setConnectOptions("QSQLITE_BUSY_TIMEOUT=0");
+            if (probe.open())
+            {
+                QSqlQuery query(probe);
+                idle = query.exec("PRAGMA locking_mode=EXCLUSIVE") && query.exec("BEGIN EXCLUSIVE") &&
+                       query.exec("SELECT count(*) FROM sqlite_master") && query.exec("COMMIT");
+                probe.close();
+            }
+        }
+        QSqlDatabase::removeDatabase(connection);
+        return idle;
+    }
+
+    // Replaces the live file with a staged restore while nothing has it open
+    void applyStagedRestore(const QString &databasePath)
+    {
+        const QString staged = stagedRestorePath(databasePath);
+        if (!QFile::exists(staged))
+        {
+            return;
+        }
+        if (QFile::exists(databasePath) && !isDatabaseIdle(databasePath))
+        {
+            qDebug() << "Restore staged for" << databasePath << "but the database is in use; it applies on the"
+                     << "next start once other instances have closed it";
+            return;
+        }
+        QFile::remove(databasePath + "-wal");
+        QFile::remove(databasePath + "-shm");
+        // The restored jobs table may reuse the version the catalog was stamped with
+        QFile::remove(CatalogSnapshot::defaultPath(databasePath));
+        if (QFile::exists(databasePath) && !QFile::remove(databasePath))
+        {
+            qDebug() << "Cannot replace" << databasePath << "with staged restore";
+            return;
+        }
+        if (!QFile::rename(staged, databasePath))
+        {
+            qDebug() << "Cannot move staged restore into place:" << staged;
+        }
+    }
+
+    // Double-quotes an SQL identifier so keywords like "references" can be selected
+    QString quoteIdentifier(const QString &name)
+    {
+        return '"' + QString(name).replace('"', "\"\"") + '"';
+    }
+}
 
 Database::Database(QObject *parent)
-    : QObject(parent)
+    : Database(defaultDatabasePath(), QSqlDatabase::defaultConnection, parent)
 {
-    db = QSqlDatabase::addDatabase("QSQLITE");
-    db.setDatabaseName("campus_jobs.db");
+}
+
+Database::Database(const QString &databasePath, const QString &connectionName, QObject *parent)
+    : QObject(parent), credentialService(new CredentialService(this)), writeBatcher(connectionName)
+{
+    db = QSqlDatabase::addDatabase("QSQLITE", connectionName);
+    db.setDatabaseName(databasePath);
+    db.setConnectOptions("QSQLITE_BUSY_TIMEOUT=5000");
+    snapshotPool.setMaxThreadCount(1);
 }
 
 Database::~Database()
 {
+    // A background snapshot still reads the file through its own connection
+    snapshotPool.waitForDone();
+    writeBatcher.flush();
+    const WriteBatcher::Stats writes = writeBatcher.stats();
+    if (writes.batches > 0)
+    {
+        qDebug() << "Write batcher:" << writes.writes << "writes in" << writes.batches << "commits,"
+                 << writes.failedWrites << "failed";
+    }
+    const JobResultCache::Stats cache = jobResultCache.stats();
+    if (cache.hits + cache.misses > 0)
+    {
+        qDebug() << "Search cache:" << cache.hits << "hits," << cache.misses << "misses"
+                 << QString("(%1%),").arg(cache.hitRate() * 100.0, 0, 'f', 1)
+                 << cache.invalidations << "invalidations," << cache.evictions << "evictions";
+    }
+    const QString connectionName = db.connectionName();
+    native.detach();
     if (db.isOpen())
     {
         db.close();
     }
+    // Drop our handle first so the connection can actually be removed
+    db = QSqlDatabase();
+    QSqlDatabase::removeDatabase(connectionName);
+}
+
+QString Database::defaultDatabasePath()
+{
+    const QString fromEnvironment = qEnvironmentVariable("CAMPUS_DB_PATH");
+    if (!fromEnvironment.isEmpty())
+    {
+        return fromEnvironment;
+    }
+    QSettings settings("BMCC", "CampusHire");
+    return settings.value("database/path", "campus_jobs.db").toString();
 }
 
 bool Database::connectToDatabase()
 {
+    TRACE_SCOPE("db", "Database::connectToDatabase");
+    const QString path = db.databaseName();
+    if (!db.isOpen() && !path.isEmpty() && path != ":memory:")
+    {
+        applyStagedRestore(path);
+    }
     if (!db.open())
     {
         qDebug() << "Error connecting to database:" << db.lastError().text();
         return false;
     }
-    return createTables();
+    // WAL lets snapshot readers and the UI's writes proceed side by side
+    QSqlQuery pragma(db);
+    pragma.exec("PRAGMA journal_mode=WAL");
+    // A (re)opened file may carry any version number
+    jobResultCache.clear();
+    if (!createTables())
+    {
+        return false;
+    }
+    // Native reads borrow the handle of the connection just opened
+    if (backend == StorageBackend::Native || qEnvironmentVariable("CAMPUS_DB_BACKEND") == "native")
+    {
+        setStorageBackend(StorageBackend::Native);
+    }
+    return true;
+}
+
+bool Database::setStorageBackend(StorageBackend requested)
+{
+    native.detach();
+    backend = StorageBackend::Qt;
+    if (requested == StorageBackend::Qt)
+    {
+        return true;
+    }
+    if (!native.attach(db))
+    {
+        return false;
+    }
+    backend = StorageBackend::Native;
+    return true;
 }
 
 bool Database::createTables()
 {
-    QSqlQuery query;
+    TRACE_SCOPE("db", "Database::createTables");
+    QSqlQuery query(db);
 
     // Create users table with new fields
     bool success = query.exec(
@@ -64,7 +345,7 @@ bool Database::createTables()
 
     // Add new columns if upgrading from old schema
     {
-        QSqlQuery pragma;
+        QSqlQuery pragma(db);
         QStringList existingColumns;
         if (pragma.exec("PRAGMA table_info(users)"))
         {
@@ -145,7 +426,8 @@ bool Database::createTables()
         "supervisor_info TEXT DEFAULT '',"
         "contact_email TEXT DEFAULT '',"
         "schedule TEXT DEFAULT '',"
-        "required_documents TEXT DEFAULT ''"
+        "required_documents TEXT DEFAULT '',"
+        "open_date TEXT DEFAULT ''"
         ")");
     if (!success)
     {
@@ -153,26 +435,281 @@ bool Database::createTables()
         return false;
     }
 
-    // Add international_eligible column if missing (for upgrades)
+    // Add columns introduced after the first release if missing (for upgrades)
     {
-        QSqlQuery pragma;
-        bool hasIntl = false;
+        QSqlQuery pragma(db);
+        QStringList columns;
         if (pragma.exec("PRAGMA table_info(jobs)"))
         {
             while (pragma.next())
             {
-                if (pragma.value(1).toString() == "international_eligible")
-                {
-                    hasIntl = true;
-                    break;
-                }
+                columns << pragma.value(1).toString();
             }
         }
-        if (!hasIntl)
+        QSqlQuery alter(db);
+        if (!columns.contains("international_eligible"))
         {
-            QSqlQuery alter;
             alter.exec("ALTER TABLE jobs ADD COLUMN international_eligible INTEGER DEFAULT 0");
         }
+        if (!columns.contains("open_date"))
+        {
+            alter.exec("ALTER TABLE jobs ADD COLUMN open_date TEXT DEFAULT ''");
+        }
+    }
+
+    // Keyset paging seeks on (status, title); id breaks ties via the rowid
+    query.exec("CREATE INDEX IF NOT EXISTS idx_jobs_status_title ON jobs(status, title)");
+
+    // Bumped by triggers on every jobs write from any connection or process,
+    // so cached search results can be checked with one primary-key lookup
+    success = query.exec(
+        "CREATE TABLE IF NOT EXISTS table_versions ("
+        "name TEXT PRIMARY KEY,"
+        "version INTEGER NOT NULL DEFAULT 0"
+        ") WITHOUT ROWID");
+    if (!success)
+    {
+        qDebug() << "Error creating table_versions table:" << query.lastError().text();
+        return false;
+    }
+    query.exec("INSERT OR IGNORE INTO table_versions (name, version) VALUES ('jobs', 0)");
+
+    // Random id fixed when the file is created, so files derived from it
+    // (the job catalog) can tell a re-created or swapped database from the
+    // one they were written for even when its counters match
+    success = query.exec(
+        "CREATE TABLE IF NOT EXISTS database_info ("
+        "name TEXT PRIMARY KEY,"
+        "value INTEGER NOT NULL"
+        ") WITHOUT ROWID");
+    if (!success)
+    {
+        qDebug() << "Error creating database_info table:" << query.lastError().text();
+        return false;
+    }
+    query.exec("INSERT OR IGNORE INTO database_info (name, value) VALUES ('id', random() | 1)");
+
+    // Last version at which each job row changed, so in-memory copies of the
+    // catalog can catch up by re-reading only those rows
+    success = query.exec(
+        "CREATE TABLE IF NOT EXISTS job_changes ("
+        "job_id INTEGER PRIMARY KEY,"
+        "version INTEGER NOT NULL"
+        ")");
+    if (!success)
+    {
+        qDebug() << "Error creating job_changes table:" << query.lastError().text();
+        return false;
+    }
+    query.exec("CREATE INDEX IF NOT EXISTS idx_job_changes_version ON job_changes(version)");
+
+    // One trigger per event both bumps the version and logs the row under it
+    for (const char *event : {"INSERT", "UPDATE", "DELETE"})
+    {
+        const QString name = QString(event).toLower();
+        query.exec(QString("DROP TRIGGER IF EXISTS trg_jobs_version_%1").arg(name));
+        query.exec(QString("CREATE TRIGGER IF NOT EXISTS trg_jobs_changes_%1 AFTER %2 ON jobs BEGIN "
+                           "UPDATE table_versions SET version = version + 1 WHERE name = 'jobs'; "
+                           "INSERT OR REPLACE INTO job_changes (job_id, version) "
+                           "SELECT %3.id, version FROM table_versions WHERE name = 'jobs'; END")
+                       .arg(name, QString(event), QString(name == "delete" ? "OLD" : "NEW")));
+    }
+
+    // Applications, interests and bookmarks written by the jobs page
+    success = query.exec(
+        "CREATE TABLE IF NOT EXISTS job_applications ("
+        "id INTEGER PRIMARY KEY AUTOINCREMENT,"
+        "user_id INTEGER NOT NULL,"
+        "job_id INTEGER NOT NULL,"
+        "resume_path TEXT,"
+        "cover_letter_path TEXT,"
+        "why_interested TEXT,"
+        "availability TEXT,"
+        "\"references\" TEXT,"
+        "status TEXT DEFAULT 'Pending',"
+        "applied_date TEXT,"
+        "FOREIGN KEY (user_id) REFERENCES users(id) ON DELETE CASCADE,"
+        "FOREIGN KEY (job_id) REFERENCES jobs(id) ON DELETE CASCADE"
+        ")");
+    if (!success)
+    {
+        qDebug() << "Error creating job_applications table:" << query.lastError().text();
+        return false;
+    }
+
+    // Parsed availability: 15-minute slot words per day plus a coarse
+    // day-part mask that employer queries filter on first
+    {
+        QSqlQuery pragma(db);
+        QStringList columns;
+        if (pragma.exec("PRAGMA table_info(job_applications)"))
+        {
+            while (pragma.next())
+            {
+                columns << pragma.value(1).toString();
+            }
+        }
+        if (!columns.contains("availability_blocks"))
+        {
+            QSqlQuery alter(db);
+            for (const QString &column : kAvailabilityColumns.split(", "))
+            {
+                alter.exec(QString("ALTER TABLE job_applications ADD COLUMN %1 INTEGER DEFAULT 0").arg(column));
+            }
+            alter.exec("ALTER TABLE job_applications ADD COLUMN availability_blocks INTEGER DEFAULT 0");
+            backfillApplicationAvailability();
+        }
+    }
+    query.exec("CREATE INDEX IF NOT EXISTS idx_job_applications_availability "
+               "ON job_applications(job_id, availability_blocks)");
+
+    success = query.exec(
+        "CREATE TABLE IF NOT EXISTS job_interests ("
+        "id INTEGER PRIMARY KEY AUTOINCREMENT,"
+        "user_id INTEGER NOT NULL,"
+        "job_id INTEGER NOT NULL,"
+        "message TEXT,"
+        "date TEXT,"
+        "notify INTEGER DEFAULT 1,"
+        "notified_at TEXT,"
+        "FOREIGN KEY (user_id) REFERENCES users(id) ON DELETE CASCADE,"
+        "FOREIGN KEY (job_id) REFERENCES jobs(id) ON DELETE CASCADE"
+        ")");
+    if (!success)
+    {
+        qDebug() << "Error creating job_interests table:" << query.lastError().text();
+        return false;
+    }
+    // Partial index: only subscribers still waiting for an "it's open" notice,
+    // so fan-out for a job is one range scan over job_id
+    query.exec("CREATE INDEX IF NOT EXISTS idx_job_interests_pending ON job_interests(job_id) "
+               "WHERE notify = 1 AND notified_at IS NULL");
+
+    success = query.exec(
+        "CREATE TABLE IF NOT EXISTS saved_jobs ("
+        "user_id INTEGER NOT NULL,"
+        "job_id INTEGER NOT NULL,"
+        "saved_date TEXT,"
+        "PRIMARY KEY (user_id, job_id)"
+        ")");
+    if (!success)
+    {
+        qDebug() << "Error creating saved_jobs table:" << query.lastError().text();
+        return false;
+    }
+
+    // Local outbox standing in for email; a sender process drains unsent rows
+    success = query.exec(
+        "CREATE TABLE IF NOT EXISTS notification_outbox ("
+        "id INTEGER PRIMARY KEY AUTOINCREMENT,"
+        "user_id INTEGER NOT NULL,"
+        "job_id INTEGER NOT NULL,"
+        "recipient TEXT NOT NULL,"
+        "subject TEXT NOT NULL,"
+        "body TEXT NOT NULL,"
+        "created_at TEXT DEFAULT CURRENT_TIMESTAMP,"
+        "sent_at TEXT"
+        ")");
+    if (!success)
+    {
+        qDebug() << "Error creating notification_outbox table:" << query.lastError().text();
+        return false;
+    }
+
+    // Normalized search box queries, weighted into autocomplete suggestions
+    success = query.exec(
+        "CREATE TABLE IF NOT EXISTS search_history ("
+        "query TEXT PRIMARY KEY,"
+        "uses INTEGER NOT NULL DEFAULT 1,"
+        "last_used TEXT DEFAULT CURRENT_TIMESTAMP"
+        ") WITHOUT ROWID");
+    if (!success)
+    {
+        qDebug() << "Error creating search_history table:" << query.lastError().text();
+        return false;
+    }
+
+    // Free time of each supervisor for interviews, keyed like jobs.supervisor_info
+    success = query.exec(
+        QString("CREATE TABLE IF NOT EXISTS supervisor_calendars ("
+                "supervisor TEXT PRIMARY KEY,"
+                "calendar TEXT NOT NULL,"
+                "%1 INTEGER DEFAULT 0,"
+                "updated_at TEXT DEFAULT CURRENT_TIMESTAMP"
+                ") WITHOUT ROWID")
+            .arg(kAvailabilityColumns.split(", ").join(" INTEGER DEFAULT 0,")));
+    if (!success)
+    {
+        qDebug() << "Error creating supervisor_calendars table:" << query.lastError().text();
+        return false;
+    }
+
+    success = query.exec(
+        "CREATE TABLE IF NOT EXISTS interviews ("
+        "application_id INTEGER PRIMARY KEY,"
+        "supervisor TEXT NOT NULL,"
+        "day INTEGER NOT NULL,"
+        "start_minute INTEGER NOT NULL,"
+        "end_minute INTEGER NOT NULL,"
+        "room INTEGER NOT NULL,"
+        "scheduled_at TEXT DEFAULT CURRENT_TIMESTAMP,"
+        "FOREIGN KEY (application_id) REFERENCES job_applications(id) ON DELETE CASCADE"
+        ")");
+    if (!success)
+    {
+        qDebug() << "Error creating interviews table:" << query.lastError().text();
+        return false;
+    }
+
+    // Interview practice history, appended in batches
+    success = query.exec(
+        "CREATE TABLE IF NOT EXISTS interview_attempts ("
+        "id INTEGER PRIMARY KEY AUTOINCREMENT,"
+        "user_id INTEGER NOT NULL,"
+        "topic TEXT NOT NULL,"
+        "question_id INTEGER NOT NULL,"
+        "difficulty INTEGER NOT NULL,"
+        "correct INTEGER NOT NULL,"
+        "ability REAL NOT NULL,"
+        "answered_at TEXT NOT NULL"
+        ")");
+    if (!success)
+    {
+        qDebug() << "Error creating interview_attempts table:" << query.lastError().text();
+        return false;
+    }
+    query.exec("CREATE INDEX IF NOT EXISTS idx_interview_attempts_user ON interview_attempts(user_id, topic)");
+
+    // Current ability per user and topic, updated with every attempt batch
+    success = query.exec(
+        "CREATE TABLE IF NOT EXISTS interview_mastery ("
+        "user_id INTEGER NOT NULL,"
+        "topic TEXT NOT NULL,"
+        "ability REAL NOT NULL DEFAULT 0,"
+        "attempts INTEGER NOT NULL DEFAULT 0,"
+        "updated_at TEXT DEFAULT CURRENT_TIMESTAMP,"
+        "PRIMARY KEY (user_id, topic)"
+        ") WITHOUT ROWID");
+    if (!success)
+    {
+        qDebug() << "Error creating interview_mastery table:" << query.lastError().text();
+        return false;
+    }
+
+    // Unsubmitted application fields, written field by field by the autosaver
+    success = query.exec(
+        "CREATE TABLE IF NOT EXISTS application_drafts ("
+        "user_id INTEGER NOT NULL,"
+        "job_id INTEGER NOT NULL,"
+        "field TEXT NOT NULL,"
+        "value TEXT NOT NULL,"
+        "updated_at TEXT DEFAULT CURRENT_TIMESTAMP,"
+        "PRIMARY KEY (user_id, job_id, field)"
+        ") WITHOUT ROWID");
+    if (!success)
+    {
+        qDebug() << "Error creating application_drafts table:" << query.lastError().text();
+        return false;
     }
 
     // Insert test user if users table is empty
@@ -208,150 +745,267 @@ bool Database::createTables()
         }
     }
 
-    return true;
+    // Rollups last: their triggers reference every table above
+    return JobAnalytics::install(db);
 }
 
-bool Database::validateLogin(const QString &email, const QString &password)
+QString Database::storedPasswordHash(const QString &email)
 {
-    QSqlQuery query;
+    QSqlQuery query(db);
     query.prepare("SELECT password FROM users WHERE email = ?");
     query.addBindValue(email);
 
-    if (!query.exec() || !query.next())
+    if (query.exec() && query.next())
     {
-        return false;
+        return query.value(0).toString();
     }
-
-    QString hashedPassword = QString(QCryptographicHash::hash(
-                                         password.toUtf8(), QCryptographicHash::Sha256)
-                                         .toHex());
-    return query.value(0).toString() == hashedPassword;
+    return QString();
 }
 
-bool Database::registerUser(const QString &fullName, const QString &password,
-                            const QString &email, const QString &emplid,
-                            const QString &major, const QString &gpa,
-                            const QString &gradDate)
+bool Database::updatePasswordHash(const QString &email, const QString &oldHash, const QString &newHash)
 {
-    QString hashedPassword = QString(QCryptographicHash::hash(
-                                         password.toUtf8(), QCryptographicHash::Sha256)
-                                         .toHex());
-
-    QSqlQuery query;
-    query.prepare("INSERT INTO users (full_name, email, password, emplid, major, gpa, grad_date) "
-                  "VALUES (?, ?, ?, ?, ?, ?, ?)");
-    query.addBindValue(fullName);
+    TRACE_SCOPE("db", "Database::updatePasswordHash");
+    // Compare-and-swap so a concurrent password change is never overwritten
+    QSqlQuery query(db);
+    query.prepare("UPDATE users SET password = ? WHERE email = ? AND password = ?");
+    query.addBindValue(newHash);
     query.addBindValue(email);
-    query.addBindValue(hashedPassword);
-    query.addBindValue(emplid);
-    query.addBindValue(major);
-    query.addBindValue(gpa);
-    query.addBindValue(gradDate);
+    query.addBindValue(oldHash);
 
     bool success = query.exec();
     if (!success)
     {
-        qDebug() << "Error registering user:" << query.lastError().text();
+        qDebug() << "Error upgrading password hash:" << query.lastError().text();
     }
     return success;
 }
 
-std::vector<Job> Database::getJobs()
+bool Database::validateLogin(const QString &email, const QString &password)
+{
+    TRACE_SCOPE("db", "Database::validateLogin");
+    const QString stored = storedPasswordHash(email);
+
+    QString rehash;
+    bool valid = credentialService->verifyBlocking(email, password, stored, &rehash);
+    if (valid && !rehash.isEmpty())
+    {
+        updatePasswordHash(email, stored, rehash);
+    }
+    return valid;
+}
+
+void Database::validateLoginAsync(const QString &email, const QString &password,
+                                  QObject *context, std::function<void(bool)> done)
+{
+    TRACE_SCOPE("db", "Database::validateLoginAsync");
+    const QString stored = storedPasswordHash(email);
+
+    credentialService->verifyAsync(email, password, stored, context,
+                                   [this, email, stored, done](bool valid, const QString &rehash)
+                                   {
+                                       // Legacy SHA-256 rows are upgraded on first successful login
+                                       if (valid && !rehash.isEmpty())
+                                       {
+                                           updatePasswordHash(email, stored, rehash);
+                                       }
+                                       done(valid);
+                                   });
+}
+
+bool Database::registerUser(const QString &fullName, const QString &password,
+                            const QString &email, const QString &emplid,
+                            const QString &major, const QString &gpa,
+                            const QString &gradDate)
+{
+    TRACE_SCOPE("db", "Database::registerUser");
+    QString hashedPassword = CredentialService::hashPassword(password, credentialService->params());
+    return insertUser(fullName, hashedPassword, email, emplid, major, gpa, gradDate);
+}
+
+void Database::registerUserAsync(const QString &fullName, const QString &password,
+                                 const QString &email, const QString &emplid,
+                                 QObject *context, std::function<void(bool)> done)
+{
+    credentialService->hashAsync(password, context,
+                                 [this, fullName, email, emplid, done](const QString &hashedPassword)
+                                 {
+                                     done(insertUser(fullName, hashedPassword, email, emplid, "", "", ""));
+                                 });
+}
+
+bool Database::insertUser(const QString &fullName, const QString &hashedPassword,
+                          const QString &email, const QString &emplid,
+                          const QString &major, const QString &gpa, const QString &gradDate)
+{
+    QSqlQuery query(db);
+    query.prepare("INSERT INTO users (full_name, email, password, emplid, major, gpa, grad_date) "
+                  "VALUES (?, ?, ?, ?, ?, ?, ?)");
+    query.addBindValue(fullName);
+    query.addBindValue(email);
+    query.addBindValue(hashedPassword);
+    query.addBindValue(emplid);
+    query.addBindValue(major);
+    query.addBindValue(gpa);
+    query.addBindValue(gradDate);
+
+    bool success = query.exec();
+    if (!success)
+    {
+        qDebug() << "Error registering user:" << query.lastError().text();
+    }
+    return success;
+}
+
+std::vector<Job> Database::getJobs()
 {
+    TRACE_SCOPE("db", "Database::getJobs");
     std::vector<Job> jobs;
-    QSqlQuery query;
+    if (useNativeReads())
+    {
+        NativeSqlite::Statement statement = native.prepare("SELECT * FROM jobs ORDER BY status, title");
+        const JobColumns columns(statement);
+        while (statement.step())
+        {
+            jobs.push_back(jobFromStatement(statement, columns));
+        }
+        if (!statement.failed())
+        {
+            return jobs;
+        }
+        jobs.clear(); // fall back to Qt
+    }
+
+    QSqlQuery query(db);
 
     if (query.exec("SELECT * FROM jobs ORDER BY status, title"))
     {
         while (query.next())
         {
-            JobStatus status = static_cast<JobStatus>(query.value("status").toInt());
-            jobs.emplace_back(
-                query.value("id").toInt(),
-                query.value("title").toString(),
-                query.value("department").toString(),
-                query.value("category").toString(),
-                query.value("description").toString(),
-                query.value("pay_rate_min").toDouble(),
-                query.value("pay_rate_max").toDouble(),
-                query.value("hours_per_week").toInt(),
-                query.value("positions_available").toInt(),
-                status,
-                query.value("work_study_eligible").toBool(),
-                query.value("international_eligible").toBool(),
-                query.value("deadline").toString(),
-                query.value("requirements").toString(),
-                query.value("duties").toString(),
-                query.value("skills").toString(),
-                query.value("supervisor_info").toString(),
-                query.value("contact_email").toString(),
-                query.value("schedule").toString(),
-                query.value("required_documents").toString());
+            jobs.push_back(jobFromQuery(query));
         }
     }
 
     return jobs;
 }
 
-User Database::getUserData(const QString &email)
+std::vector<Job> Database::selectJobsPage(QSqlDatabase connection, const QString &where,
+                                          const QVariantList &binds, JobCursor &cursor, int limit)
 {
-    QSqlQuery query;
-    query.prepare("SELECT * FROM users WHERE email = ?");
-    query.addBindValue(email);
+    TRACE_SCOPE("db", "Database::getJobsPage");
+    std::vector<Job> jobs;
 
-    if (query.exec() && query.next())
+    QString sql = "SELECT * FROM jobs WHERE " + where;
+    if (!cursor.atStart())
+        sql += " AND (title, id) > (?, ?)";
+    sql += " ORDER BY title, id LIMIT ?";
+
+    QSqlQuery query(connection);
+    query.setForwardOnly(true);
+    query.prepare(sql);
+    for (const QVariant &value : binds)
     {
-        return User(
-            query.value("id").toInt(),
-            query.value("email").toString(),
-            query.value("full_name").toString(),
-            query.value("emplid").toString(),
-            query.value("major").toString(),
-            query.value("gpa").toString(),
-            query.value("grad_date").toString(),
-            query.value("is_international_student").toBool(),
-            query.value("survey_completed").toBool(),
-            query.value("resume_path").toString(),
-            query.value("transcript_path").toString(),
-            query.value("parsed_resume_data").toString(),
-            query.value("parsed_gpa").toString(),
-            query.value("parsed_courses").toString());
+        query.addBindValue(value);
+    }
+    if (!cursor.atStart())
+    {
+        query.addBindValue(cursor.title);
+        query.addBindValue(cursor.id);
+    }
+    query.addBindValue(limit);
+
+    if (!query.exec())
+    {
+        qDebug() << "Error fetching jobs page:" << query.lastError().text();
+        return jobs;
+    }
+
+    jobs.reserve(limit);
+    while (query.next())
+    {
+        jobs.push_back(jobFromQuery(query));
     }
 
-    return User();
+    if (!jobs.empty())
+    {
+        cursor.title = jobs.back().getTitle();
+        cursor.id = jobs.back().getId();
+    }
+    return jobs;
 }
 
-User Database::getUserDataById(int userId)
+QSharedPointer<const User> Database::fetchUser(const QString &column, const QVariant &value)
 {
-    QSqlQuery query;
-    query.prepare("SELECT * FROM users WHERE id = ?");
-    query.addBindValue(userId);
+    TRACE_SCOPE("db", "Database::fetchUser");
+    QSqlQuery query(db);
+    query.prepare(QString("SELECT %1 FROM users WHERE %2 = ?").arg(kUserColumns, column));
+    query.addBindValue(value);
 
-    if (query.exec() && query.next())
+    if (!query.exec() || !query.next())
     {
-        return User(
-            query.value("id").toInt(),
-            query.value("email").toString(),
-            query.value("full_name").toString(),
-            query.value("emplid").toString(),
-            query.value("major").toString(),
-            query.value("gpa").toString(),
-            query.value("grad_date").toString(),
-            query.value("is_international_student").toBool(),
-            query.value("survey_completed").toBool(),
-            query.value("resume_path").toString(),
-            query.value("transcript_path").toString(),
-            query.value("parsed_resume_data").toString(),
-            query.value("parsed_gpa").toString(),
-            query.value("parsed_courses").toString());
+        return QSharedPointer<const User>();
+    }
+
+    QSharedPointer<const User> user(new User(userFromQuery(query)));
+    userCache.insert(user->getId(), user);
+    userIdsByEmail.insert(user->getEmail(), user->getId());
+    return user;
+}
+
+QSharedPointer<const User> Database::userSnapshot(int userId)
+{
+    writeBatcher.flush(); // queued survey flags drop the cached snapshot
+    auto it = userCache.constFind(userId);
+    if (it != userCache.constEnd())
+    {
+        return it.value();
     }
+    return fetchUser("id", userId);
+}
+
+QSharedPointer<const User> Database::userSnapshotByEmail(const QString &email)
+{
+    writeBatcher.flush();
+    auto it = userIdsByEmail.constFind(email);
+    if (it != userIdsByEmail.constEnd() && userCache.contains(it.value()))
+    {
+        return userCache.value(it.value());
+    }
+    return fetchUser("email", email);
+}
+
+void Database::invalidateUser(int userId)
+{
+    userCache.remove(userId);
+}
+
+void Database::clearUserCache()
+{
+    userCache.clear();
+    userIdsByEmail.clear();
+}
+
+User Database::getUserData(const QString &email)
+{
+    QSharedPointer<const User> user = userSnapshotByEmail(email);
+    return user ? *user : User();
+}
 
-    return User();
+User Database::getUserDataById(int userId)
+{
+    QSharedPointer<const User> user = userSnapshot(userId);
+    return user ? *user : User();
 }
 
 int Database::getUserIdByEmail(const QString &email)
 {
-    QSqlQuery query;
+    TRACE_SCOPE("db", "Database::getUserIdByEmail");
+    auto cached = userIdsByEmail.constFind(email);
+    if (cached != userIdsByEmail.constEnd())
+    {
+        return cached.value();
+    }
+
+    QSqlQuery query(db);
     query.prepare("SELECT id FROM users WHERE email = ?");
     query.addBindValue(email);
 
@@ -366,7 +1020,8 @@ int Database::getUserIdByEmail(const QString &email)
 bool Database::updateProfile(const QString &email, const QString &major,
                              const QString &gpa, const QString &gradDate)
 {
-    QSqlQuery query;
+    TRACE_SCOPE("db", "Database::updateProfile");
+    QSqlQuery query(db);
     query.prepare("UPDATE users SET major = ?, gpa = ?, grad_date = ? WHERE email = ?");
     query.addBindValue(major);
     query.addBindValue(gpa);
@@ -378,13 +1033,18 @@ bool Database::updateProfile(const QString &email, const QString &major,
     {
         qDebug() << "Error updating profile:" << query.lastError().text();
     }
+    else if (userIdsByEmail.contains(email))
+    {
+        invalidateUser(userIdsByEmail.value(email));
+    }
     return success;
 }
 
 bool Database::updateProfileById(int userId, const QString &major,
                                  const QString &gpa, const QString &gradDate)
 {
-    QSqlQuery query;
+    TRACE_SCOPE("db", "Database::updateProfileById");
+    QSqlQuery query(db);
     query.prepare("UPDATE users SET major = ?, gpa = ?, grad_date = ? WHERE id = ?");
     query.addBindValue(major);
     query.addBindValue(gpa);
@@ -396,6 +1056,25 @@ bool Database::updateProfileById(int userId, const QString &major,
     {
         qDebug() << "Error updating profile by ID:" << query.lastError().text();
     }
+    invalidateUser(userId);
+    return success;
+}
+
+bool Database::updateNameAndParsedGpa(int userId, const QString &fullName, const QString &parsedGpa)
+{
+    TRACE_SCOPE("db", "Database::updateNameAndParsedGpa");
+    QSqlQuery query(db);
+    query.prepare("UPDATE users SET full_name = ?, parsed_gpa = ? WHERE id = ?");
+    query.addBindValue(fullName);
+    query.addBindValue(parsedGpa);
+    query.addBindValue(userId);
+
+    bool success = query.exec();
+    if (!success)
+    {
+        qDebug() << "Error updating name:" << query.lastError().text();
+    }
+    invalidateUser(userId);
     return success;
 }
 
@@ -404,7 +1083,8 @@ bool Database::updateProfileById(int userId, const QString &major,
 bool Database::addDocument(int userId, const QString &documentType,
                            const QString &filePath, const QString &status)
 {
-    QSqlQuery query;
+    TRACE_SCOPE("db", "Database::addDocument");
+    QSqlQuery query(db);
     query.prepare(
         "INSERT INTO documents (user_id, document_type, file_path, upload_date, status) "
         "VALUES (?, ?, ?, ?, ?)");
@@ -422,24 +1102,28 @@ bool Database::addDocument(int userId, const QString &documentType,
     return success;
 }
 
-bool Database::updateDocumentStatus(int documentId, const QString &status)
+void Database::updateDocumentStatus(int documentId, const QString &status, WriteBatcher::Callback done)
 {
-    QSqlQuery query;
-    query.prepare("UPDATE documents SET status = ? WHERE id = ?");
-    query.addBindValue(status);
-    query.addBindValue(documentId);
-
-    bool success = query.exec();
-    if (!success)
-    {
-        qDebug() << "Error updating document status:" << query.lastError().text();
-    }
-    return success;
+    writeBatcher.enqueue([this, documentId, status]()
+                         {
+        TRACE_SCOPE("db", "Database::updateDocumentStatus");
+        QSqlQuery query(db);
+        query.prepare("UPDATE documents SET status = ? WHERE id = ?");
+        query.addBindValue(status);
+        query.addBindValue(documentId);
+
+        bool success = query.exec();
+        if (!success)
+        {
+            qDebug() << "Error updating document status:" << query.lastError().text();
+        }
+        return success; }, std::move(done));
 }
 
 bool Database::deleteDocument(int documentId)
 {
-    QSqlQuery query;
+    TRACE_SCOPE("db", "Database::deleteDocument");
+    QSqlQuery query(db);
     query.prepare("DELETE FROM documents WHERE id = ?");
     query.addBindValue(documentId);
 
@@ -453,8 +1137,10 @@ bool Database::deleteDocument(int documentId)
 
 std::vector<Document> Database::getUserDocuments(int userId)
 {
+    TRACE_SCOPE("db", "Database::getUserDocuments");
+    writeBatcher.flush();
     std::vector<Document> documents;
-    QSqlQuery query;
+    QSqlQuery query(db);
 
     query.prepare(
         "SELECT id, user_id, document_type, file_path, upload_date, status "
@@ -484,7 +1170,9 @@ std::vector<Document> Database::getUserDocuments(int userId)
 
 Document Database::getLatestDocument(int userId, const QString &documentType)
 {
-    QSqlQuery query;
+    TRACE_SCOPE("db", "Database::getLatestDocument");
+    writeBatcher.flush();
+    QSqlQuery query(db);
     query.prepare(
         "SELECT id, user_id, document_type, file_path, upload_date, status "
         "FROM documents WHERE user_id = ? AND document_type = ? "
@@ -508,7 +1196,9 @@ Document Database::getLatestDocument(int userId, const QString &documentType)
 
 int Database::getDocumentCountByStatus(int userId, const QString &status)
 {
-    QSqlQuery query;
+    TRACE_SCOPE("db", "Database::getDocumentCountByStatus");
+    writeBatcher.flush();
+    QSqlQuery query(db);
     query.prepare("SELECT COUNT(*) FROM documents WHERE user_id = ? AND status = ?");
     query.addBindValue(userId);
     query.addBindValue(status);
@@ -523,7 +1213,9 @@ int Database::getDocumentCountByStatus(int userId, const QString &status)
 
 bool Database::hasDocument(int userId, const QString &documentType)
 {
-    QSqlQuery query;
+    TRACE_SCOPE("db", "Database::hasDocument");
+    writeBatcher.flush();
+    QSqlQuery query(db);
     query.prepare(
         "SELECT COUNT(*) FROM documents WHERE user_id = ? AND document_type = ? "
         "AND status != 'Deleted'");
@@ -541,8 +1233,9 @@ bool Database::hasDocument(int userId, const QString &documentType)
 // Job management methods
 std::vector<Job> Database::getJobsByCategory(const QString &category)
 {
+    TRACE_SCOPE("db", "Database::getJobsByCategory");
     std::vector<Job> jobs;
-    QSqlQuery query;
+    QSqlQuery query(db);
     query.prepare("SELECT * FROM jobs WHERE category = ? ORDER BY title");
     query.addBindValue(category);
 
@@ -550,136 +1243,119 @@ std::vector<Job> Database::getJobsByCategory(const QString &category)
     {
         while (query.next())
         {
-            JobStatus status = static_cast<JobStatus>(query.value("status").toInt());
-            jobs.emplace_back(
-                query.value("id").toInt(),
-                query.value("title").toString(),
-                query.value("department").toString(),
-                query.value("category").toString(),
-                query.value("description").toString(),
-                query.value("pay_rate_min").toDouble(),
-                query.value("pay_rate_max").toDouble(),
-                query.value("hours_per_week").toInt(),
-                query.value("positions_available").toInt(),
-                status,
-                query.value("work_study_eligible").toBool(),
-                query.value("international_eligible").toBool(),
-                query.value("deadline").toString(),
-                query.value("requirements").toString(),
-                query.value("duties").toString(),
-                query.value("skills").toString(),
-                query.value("supervisor_info").toString(),
-                query.value("contact_email").toString(),
-                query.value("schedule").toString(),
-                query.value("required_documents").toString());
+            jobs.push_back(jobFromQuery(query));
         }
     }
     return jobs;
 }
 
-std::vector<Job> Database::searchJobs(const QString &keyword, const QString &statusFilter,
-                                      const QString &categoryFilter, bool workStudyOnly,
-                                      int minHours, int maxHours, double minPay, double maxPay)
+std::vector<Job> Database::searchJobs(const JobSearchOptions &options, int limit)
 {
+    TRACE_SCOPE("db", "Database::searchJobs");
+    const qint64 version = jobsTableVersion();
+    const QString key = JobResultCache::keyFor(options, limit);
     std::vector<Job> jobs;
-    QString queryStr = "SELECT * FROM jobs WHERE 1=1";
-
-    if (!keyword.isEmpty())
+    if (version >= 0 && jobResultCache.lookup(key, version, jobs))
     {
-        queryStr += " AND (title LIKE '%" + keyword + "%' OR department LIKE '%" + keyword + "%' OR description LIKE '%" + keyword + "%')";
+        return jobs;
     }
-    if (!statusFilter.isEmpty())
+
+    // The version was read first, so a write racing this query only makes
+    // the entry look older than it is
+    jobs = visitJobFilter(options, [this, limit](const auto &filter)
+                          { return findJobs(filter, limit); });
+    if (version >= 0)
     {
-        queryStr += " AND status = " + statusFilter;
+        jobResultCache.insert(key, version, jobs);
     }
-    if (!categoryFilter.isEmpty())
+    return jobs;
+}
+
+qint64 Database::jobsTableVersion(QSqlDatabase connection)
+{
+    QSqlQuery query(connection);
+    if (!query.exec("SELECT version FROM table_versions WHERE name = 'jobs'") || !query.next())
     {
-        queryStr += " AND category = '" + categoryFilter + "'";
+        qDebug() << "Error reading jobs version:" << query.lastError().text();
+        return -1;
     }
-    if (workStudyOnly)
+    return query.value(0).toLongLong();
+}
+
+qint64 Database::databaseId(QSqlDatabase connection)
+{
+    QSqlQuery query(connection);
+    if (!query.exec("SELECT value FROM database_info WHERE name = 'id'") || !query.next())
     {
-        queryStr += " AND work_study_eligible = 1";
+        qDebug() << "Error reading database id:" << query.lastError().text();
+        return 0;
     }
-    if (minHours > 0 || maxHours < 40)
+    return query.value(0).toLongLong();
+}
+
+std::vector<int> Database::changedJobIds(qint64 sinceVersion)
+{
+    TRACE_SCOPE("db", "Database::changedJobIds");
+    std::vector<int> ids;
+    QSqlQuery query(db);
+    query.setForwardOnly(true);
+    query.prepare("SELECT job_id FROM job_changes WHERE version > ?");
+    query.addBindValue(sinceVersion);
+    if (!query.exec())
     {
-        queryStr += QString(" AND hours_per_week >= %1 AND hours_per_week <= %2").arg(minHours).arg(maxHours);
+        qDebug() << "Error reading job changes:" << query.lastError().text();
+        return ids;
     }
-    if (minPay > 0 || maxPay < 100)
+    while (query.next())
     {
-        queryStr += QString(" AND pay_rate_min >= %1 AND pay_rate_max <= %2").arg(minPay).arg(maxPay);
+        ids.push_back(query.value(0).toInt());
     }
+    return ids;
+}
 
-    queryStr += " ORDER BY status, title";
+std::vector<Job> Database::selectJobs(const QString &where, const QVariantList &binds, int limit)
+{
+    std::vector<Job> jobs;
+    QSqlQuery query(db);
+    query.setForwardOnly(true);
+    query.prepare("SELECT * FROM jobs WHERE " + where + " ORDER BY status, title LIMIT ?");
+    for (const QVariant &value : binds)
+    {
+        query.addBindValue(value);
+    }
+    query.addBindValue(limit);
 
-    QSqlQuery query;
-    if (query.exec(queryStr))
+    if (!query.exec())
     {
-        while (query.next())
-        {
-            JobStatus status = static_cast<JobStatus>(query.value("status").toInt());
-            jobs.emplace_back(
-                query.value("id").toInt(),
-                query.value("title").toString(),
-                query.value("department").toString(),
-                query.value("category").toString(),
-                query.value("description").toString(),
-                query.value("pay_rate_min").toDouble(),
-                query.value("pay_rate_max").toDouble(),
-                query.value("hours_per_week").toInt(),
-                query.value("positions_available").toInt(),
-                status,
-                query.value("work_study_eligible").toBool(),
-                query.value("international_eligible").toBool(),
-                query.value("deadline").toString(),
-                query.value("requirements").toString(),
-                query.value("duties").toString(),
-                query.value("skills").toString(),
-                query.value("supervisor_info").toString(),
-                query.value("contact_email").toString(),
-                query.value("schedule").toString(),
-                query.value("required_documents").toString());
-        }
+        qDebug() << "Error searching jobs:" << query.lastError().text();
+        return jobs;
+    }
+    while (query.next())
+    {
+        jobs.push_back(jobFromQuery(query));
     }
     return jobs;
 }
 
 Job Database::getJobById(int jobId)
 {
-    QSqlQuery query;
+    TRACE_SCOPE("db", "Database::getJobById");
+    QSqlQuery query(db);
     query.prepare("SELECT * FROM jobs WHERE id = ?");
     query.addBindValue(jobId);
 
     if (query.exec() && query.next())
     {
-        JobStatus status = static_cast<JobStatus>(query.value("status").toInt());
-        return Job(
-            query.value("id").toInt(),
-            query.value("title").toString(),
-            query.value("department").toString(),
-            query.value("category").toString(),
-            query.value("description").toString(),
-            query.value("pay_rate_min").toDouble(),
-            query.value("pay_rate_max").toDouble(),
-            query.value("hours_per_week").toInt(),
-            query.value("positions_available").toInt(),
-            status,
-            query.value("work_study_eligible").toBool(),
-            query.value("international_eligible").toBool(),
-            query.value("deadline").toString(),
-            query.value("requirements").toString(),
-            query.value("duties").toString(),
-            query.value("skills").toString(),
-            query.value("supervisor_info").toString(),
-            query.value("contact_email").toString(),
-            query.value("schedule").toString());
+        return jobFromQuery(query);
     }
     return Job();
 }
 
 int Database::getJobCountByCategory(const QString &category)
 {
-    QSqlQuery query;
-    query.prepare("SELECT COUNT(*) FROM jobs WHERE category = ?");
+    TRACE_SCOPE("db", "Database::getJobCountByCategory");
+    QSqlQuery query(db);
+    query.prepare("SELECT COALESCE(SUM(jobs), 0) FROM rollup_jobs WHERE dimension = 'category' AND key = ?");
     query.addBindValue(category);
 
     if (query.exec() && query.next())
@@ -689,15 +1365,62 @@ int Database::getJobCountByCategory(const QString &category)
     return 0;
 }
 
+int Database::applyJobStatusChanges(const std::vector<JobStatusChange> &changes)
+{
+    TRACE_SCOPE("db", "Database::applyJobStatusChanges");
+    if (changes.empty())
+    {
+        return 0;
+    }
+    if (!beginTransaction())
+    {
+        qDebug() << "Error starting status transaction:" << db.lastError().text();
+        return -1;
+    }
+
+    QSqlQuery query(db);
+    query.prepare("UPDATE jobs SET status = ? WHERE id = ? AND status = ?");
+
+    int changed = 0;
+    for (const JobStatusChange &change : changes)
+    {
+        query.addBindValue(static_cast<int>(change.to));
+        query.addBindValue(change.jobId);
+        query.addBindValue(static_cast<int>(change.from));
+        if (!query.exec())
+        {
+            qDebug() << "Error updating job status" << change.jobId << ":" << query.lastError().text();
+            rollbackTransaction();
+            return -1;
+        }
+        changed += query.numRowsAffected();
+    }
+
+    if (!commitTransaction())
+    {
+        qDebug() << "Error committing job statuses:" << db.lastError().text();
+        rollbackTransaction();
+        return -1;
+    }
+
+    if (changed > 0)
+    {
+        emit jobsChanged();
+    }
+    return changed;
+}
+
 bool Database::applyForJob(int userId, int jobId, const QString &resumePath,
                            const QString &coverLetterPath, const QString &whyInterested,
                            const QString &availability, const QString &references)
 {
-    QSqlQuery query;
+    TRACE_SCOPE("db", "Database::applyForJob");
+    QSqlQuery query(db);
     query.prepare(
-        "INSERT INTO job_applications (user_id, job_id, resume_path, cover_letter_path, "
-        "why_interested, availability, references, status, applied_date) "
-        "VALUES (?, ?, ?, ?, ?, ?, ?, 'Pending', datetime('now'))");
+        QString("INSERT INTO job_applications (user_id, job_id, resume_path, cover_letter_path, "
+                "why_interested, availability, \"references\", status, applied_date, %1, availability_blocks) "
+                "VALUES (?, ?, ?, ?, ?, ?, ?, 'Pending', datetime('now'), ?, ?, ?, ?, ?, ?, ?, ?)")
+            .arg(kAvailabilityColumns));
     query.addBindValue(userId);
     query.addBindValue(jobId);
     query.addBindValue(resumePath);
@@ -705,68 +1428,546 @@ bool Database::applyForJob(int userId, int jobId, const QString &resumePath,
     query.addBindValue(whyInterested);
     query.addBindValue(availability);
     query.addBindValue(references);
+    bindAvailability(query, Availability::parse(availability));
 
     return query.exec();
 }
 
-bool Database::expressInterest(int userId, int jobId, const QString &message)
-{
-    QSqlQuery query;
-    query.prepare(
-        "INSERT INTO job_interests (user_id, job_id, message, date) "
-        "VALUES (?, ?, ?, datetime('now'))");
-    query.addBindValue(userId);
-    query.addBindValue(jobId);
-    query.addBindValue(message);
-
-    return query.exec();
-}
-
-bool Database::saveJob(int userId, int jobId)
-{
-    QSqlQuery query;
-    query.prepare(
-        "INSERT OR IGNORE INTO saved_jobs (user_id, job_id, saved_date) "
-        "VALUES (?, ?, datetime('now'))");
-    query.addBindValue(userId);
-    query.addBindValue(jobId);
-
-    return query.exec();
-}
-
-bool Database::unsaveJob(int userId, int jobId)
+std::vector<ApplicantAvailability> Database::getApplicantAvailability(int jobId)
 {
-    QSqlQuery query;
-    query.prepare("DELETE FROM saved_jobs WHERE user_id = ? AND job_id = ?");
-    query.addBindValue(userId);
-    query.addBindValue(jobId);
-
-    return query.exec();
+    return findAvailableApplicants(Availability(), false, jobId);
 }
 
-std::vector<int> Database::getSavedJobs(int userId)
+std::vector<ApplicantAvailability> Database::findAvailableApplicants(const Availability &needed, bool wholeShift,
+                                                                     int jobId)
 {
-    std::vector<int> jobIds;
-    QSqlQuery query;
-    query.prepare("SELECT job_id FROM saved_jobs WHERE user_id = ?");
-    query.addBindValue(userId);
+    TRACE_SCOPE("db", "Database::findAvailableApplicants");
+    std::vector<ApplicantAvailability> applicants;
+    const quint32 blocks = needed.blockMask();
+
+    // Coarse day-part filter in SQL, exact slot check on the rows it keeps
+    QString where = "1";
+    QVariantList binds;
+    if (jobId >= 0)
+    {
+        where += " AND job_id = ?";
+        binds << jobId;
+    }
+    if (blocks && wholeShift)
+    {
+        where += " AND (availability_blocks & ?) = ?";
+        binds << blocks << blocks;
+    }
+    else if (blocks)
+    {
+        where += " AND (availability_blocks & ?) != 0";
+        binds << blocks;
+    }
 
-    if (query.exec())
+    QSqlQuery query(db);
+    query.setForwardOnly(true);
+    query.prepare(QString("SELECT id, user_id, job_id, %1 FROM job_applications WHERE %2 ORDER BY id")
+                      .arg(kAvailabilityColumns, where));
+    for (const QVariant &bind : binds)
     {
-        while (query.next())
+        query.addBindValue(bind);
+    }
+    if (!query.exec())
+    {
+        qDebug() << "Error reading applicant availability:" << query.lastError().text();
+        return applicants;
+    }
+    while (query.next())
+    {
+        ApplicantAvailability applicant;
+        applicant.applicationId = query.value(0).toInt();
+        applicant.userId = query.value(1).toInt();
+        applicant.jobId = query.value(2).toInt();
+        applicant.availability = availabilityFromQuery(query, 3);
+        if (!needed.isEmpty() &&
+            !(wholeShift ? applicant.availability.covers(needed) : applicant.availability.overlaps(needed)))
         {
-            jobIds.push_back(query.value(0).toInt());
+            continue;
         }
+        applicants.push_back(applicant);
     }
-    return jobIds;
+    return applicants;
 }
 
-bool Database::isJobSaved(int userId, int jobId)
+bool Database::setSupervisorCalendar(const QString &supervisor, const QString &calendar)
 {
-    QSqlQuery query;
-    query.prepare("SELECT COUNT(*) FROM saved_jobs WHERE user_id = ? AND job_id = ?");
-    query.addBindValue(userId);
-    query.addBindValue(jobId);
+    TRACE_SCOPE("db", "Database::setSupervisorCalendar");
+    QSqlQuery query(db);
+    query.prepare(QString("INSERT OR REPLACE INTO supervisor_calendars (supervisor, calendar, %1, updated_at) "
+                          "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, datetime('now'))")
+                      .arg(kAvailabilityColumns));
+    query.addBindValue(supervisor);
+    query.addBindValue(calendar);
+    const Availability availability = Availability::parse(calendar);
+    for (int day = 0; day < Availability::kDays; ++day)
+    {
+        query.addBindValue(static_cast<qint64>(availability.day(day)));
+    }
+    if (!query.exec())
+    {
+        qDebug() << "Error saving supervisor calendar:" << query.lastError().text();
+        return false;
+    }
+    return true;
+}
+
+QHash<QString, Availability> Database::getSupervisorCalendars()
+{
+    TRACE_SCOPE("db", "Database::getSupervisorCalendars");
+    QHash<QString, Availability> calendars;
+    QSqlQuery query(db);
+    query.setForwardOnly(true);
+    if (!query.exec(QString("SELECT supervisor, %1 FROM supervisor_calendars").arg(kAvailabilityColumns)))
+    {
+        qDebug() << "Error reading supervisor calendars:" << query.lastError().text();
+        return calendars;
+    }
+    while (query.next())
+    {
+        calendars.insert(query.value(0).toString(), availabilityFromQuery(query, 1));
+    }
+    return calendars;
+}
+
+QHash<int, QString> Database::getJobSupervisors()
+{
+    QHash<int, QString> supervisors;
+    QSqlQuery query(db);
+    query.setForwardOnly(true);
+    if (!query.exec("SELECT id, supervisor_info FROM jobs WHERE supervisor_info != ''"))
+    {
+        qDebug() << "Error reading job supervisors:" << query.lastError().text();
+        return supervisors;
+    }
+    while (query.next())
+    {
+        supervisors.insert(query.value(0).toInt(), query.value(1).toString());
+    }
+    return supervisors;
+}
+
+std::vector<ScheduledInterview> Database::getInterviewSchedule()
+{
+    TRACE_SCOPE("db", "Database::getInterviewSchedule");
+    std::vector<ScheduledInterview> interviews;
+    QSqlQuery query(db);
+    query.setForwardOnly(true);
+    if (!query.exec("SELECT application_id, supervisor, day, start_minute, end_minute, room FROM interviews "
+                    "ORDER BY day, start_minute, room"))
+    {
+        qDebug() << "Error reading interview schedule:" << query.lastError().text();
+        return interviews;
+    }
+    while (query.next())
+    {
+        ScheduledInterview interview;
+        interview.applicationId = query.value(0).toInt();
+        interview.supervisor = query.value(1).toString();
+        interview.day = query.value(2).toInt();
+        interview.startMinute = query.value(3).toInt();
+        interview.endMinute = query.value(4).toInt();
+        interview.room = query.value(5).toInt();
+        interviews.push_back(interview);
+    }
+    return interviews;
+}
+
+bool Database::saveInterviewSchedule(const std::vector<ScheduledInterview> &interviews)
+{
+    TRACE_SCOPE("db", "Database::saveInterviewSchedule");
+    // Without the transaction a failed insert would leave the schedule half cleared
+    if (!beginTransaction())
+    {
+        qDebug() << "Error starting interview schedule transaction:" << db.lastError().text();
+        return false;
+    }
+    QSqlQuery query(db);
+    if (!query.exec("DELETE FROM interviews"))
+    {
+        qDebug() << "Error clearing interview schedule:" << query.lastError().text();
+        rollbackTransaction();
+        return false;
+    }
+    query.prepare("INSERT INTO interviews (application_id, supervisor, day, start_minute, end_minute, room) "
+                  "VALUES (?, ?, ?, ?, ?, ?)");
+    for (const ScheduledInterview &interview : interviews)
+    {
+        query.addBindValue(interview.applicationId);
+        query.addBindValue(interview.supervisor);
+        query.addBindValue(interview.day);
+        query.addBindValue(interview.startMinute);
+        query.addBindValue(interview.endMinute);
+        query.addBindValue(interview.room);
+        if (!query.exec())
+        {
+            qDebug() << "Error saving interview:" << query.lastError().text();
+            rollbackTransaction();
+            return false;
+        }
+    }
+    if (!commitTransaction())
+    {
+        qDebug() << "Error committing interview schedule:" << db.lastError().text();
+        rollbackTransaction();
+        return false;
+    }
+    return true;
+}
+
+void Database::backfillApplicationAvailability()
+{
+    TRACE_SCOPE("db", "Database::backfillApplicationAvailability");
+    QSqlQuery select(db);
+    select.setForwardOnly(true);
+    if (!select.exec("SELECT id, availability FROM job_applications"))
+    {
+        return;
+    }
+    std::vector<std::pair<int, QString>> rows;
+    while (select.next())
+    {
+        rows.emplace_back(select.value(0).toInt(), select.value(1).toString());
+    }
+
+    beginTransaction();
+    QSqlQuery update(db);
+    update.prepare(QString("UPDATE job_applications SET (%1, availability_blocks) = (?, ?, ?, ?, ?, ?, ?, ?) "
+                           "WHERE id = ?")
+                       .arg(kAvailabilityColumns));
+    for (const auto &row : rows)
+    {
+        bindAvailability(update, Availability::parse(row.second));
+        update.addBindValue(row.first);
+        if (!update.exec())
+        {
+            qDebug() << "Error backfilling availability:" << update.lastError().text();
+            rollbackTransaction();
+            return;
+        }
+    }
+    commitTransaction();
+}
+
+bool Database::expressInterest(int userId, int jobId, const QString &message, bool notify)
+{
+    TRACE_SCOPE("db", "Database::expressInterest");
+    QSqlQuery query(db);
+    query.prepare(
+        "INSERT INTO job_interests (user_id, job_id, message, date, notify) "
+        "VALUES (?, ?, ?, datetime('now'), ?)");
+    query.addBindValue(userId);
+    query.addBindValue(jobId);
+    query.addBindValue(message);
+    query.addBindValue(notify ? 1 : 0);
+
+    return query.exec();
+}
+
+std::vector<Notification> Database::getPendingNotifications(int jobId, int afterInterestId, int limit)
+{
+    TRACE_SCOPE("db", "Database::getPendingNotifications");
+    std::vector<Notification> pending;
+    QSqlQuery query(db);
+    query.setForwardOnly(true);
+    // Matches idx_job_interests_pending; rowid order continues from the last batch
+    query.prepare(
+        "SELECT ji.id, ji.user_id, u.email, u.full_name FROM job_interests ji "
+        "JOIN users u ON u.id = ji.user_id "
+        "WHERE ji.job_id = ? AND ji.notify = 1 AND ji.notified_at IS NULL AND ji.id > ? "
+        "ORDER BY ji.id LIMIT ?");
+    query.addBindValue(jobId);
+    query.addBindValue(afterInterestId);
+    query.addBindValue(limit);
+
+    if (!query.exec())
+    {
+        qDebug() << "Error reading pending notifications:" << query.lastError().text();
+        return pending;
+    }
+
+    while (query.next())
+    {
+        Notification notification;
+        notification.interestId = query.value(0).toInt();
+        notification.userId = query.value(1).toInt();
+        notification.jobId = jobId;
+        notification.recipient = query.value(2).toString();
+        notification.recipientName = query.value(3).toString();
+        pending.push_back(notification);
+    }
+    return pending;
+}
+
+bool Database::markInterestsNotified(const std::vector<Notification> &notifications)
+{
+    TRACE_SCOPE("db", "Database::markInterestsNotified");
+    QSqlQuery query(db);
+    query.prepare("UPDATE job_interests SET notified_at = datetime('now') WHERE id = ?");
+    for (const Notification &notification : notifications)
+    {
+        query.addBindValue(notification.interestId);
+        if (!query.exec())
+        {
+            qDebug() << "Error marking interest notified:" << query.lastError().text();
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Database::addOutboxNotifications(const std::vector<Notification> &notifications)
+{
+    TRACE_SCOPE("db", "Database::addOutboxNotifications");
+    QSqlQuery query(db);
+    query.prepare("INSERT INTO notification_outbox (user_id, job_id, recipient, subject, body) "
+                  "VALUES (?, ?, ?, ?, ?)");
+    for (const Notification &notification : notifications)
+    {
+        query.addBindValue(notification.userId);
+        query.addBindValue(notification.jobId);
+        query.addBindValue(notification.recipient);
+        query.addBindValue(notification.subject);
+        query.addBindValue(notification.body);
+        if (!query.exec())
+        {
+            qDebug() << "Error queueing notification:" << query.lastError().text();
+            return false;
+        }
+    }
+    return true;
+}
+
+std::vector<TopicMastery> Database::getInterviewMastery(int userId)
+{
+    TRACE_SCOPE("db", "Database::getInterviewMastery");
+    std::vector<TopicMastery> mastery;
+    QSqlQuery query(db);
+    query.setForwardOnly(true);
+    query.prepare("SELECT topic, ability, attempts FROM interview_mastery WHERE user_id = ?");
+    query.addBindValue(userId);
+    if (!query.exec())
+    {
+        qDebug() << "Error loading interview mastery:" << query.lastError().text();
+        return mastery;
+    }
+    while (query.next())
+    {
+        TopicMastery topic;
+        topic.topic = query.value(0).toString();
+        topic.ability = query.value(1).toDouble();
+        topic.attempts = query.value(2).toInt();
+        mastery.push_back(topic);
+    }
+    return mastery;
+}
+
+bool Database::addInterviewAttempts(const std::vector<InterviewAttempt> &attempts)
+{
+    TRACE_SCOPE("db", "Database::addInterviewAttempts");
+    QSqlQuery query(db);
+    query.prepare("INSERT INTO interview_attempts "
+                  "(user_id, topic, question_id, difficulty, correct, ability, answered_at) "
+                  "VALUES (?, ?, ?, ?, ?, ?, ?)");
+    for (const InterviewAttempt &attempt : attempts)
+    {
+        query.addBindValue(attempt.userId);
+        query.addBindValue(attempt.topic);
+        query.addBindValue(attempt.questionId);
+        query.addBindValue(attempt.difficulty);
+        query.addBindValue(attempt.correct ? 1 : 0);
+        query.addBindValue(attempt.ability);
+        query.addBindValue(attempt.answeredAt.toString(Qt::ISODate));
+        if (!query.exec())
+        {
+            qDebug() << "Error recording interview attempt:" << query.lastError().text();
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Database::saveInterviewMastery(int userId, const std::vector<TopicMastery> &mastery)
+{
+    TRACE_SCOPE("db", "Database::saveInterviewMastery");
+    QSqlQuery query(db);
+    query.prepare("INSERT OR REPLACE INTO interview_mastery (user_id, topic, ability, attempts, updated_at) "
+                  "VALUES (?, ?, ?, ?, datetime('now'))");
+    for (const TopicMastery &topic : mastery)
+    {
+        query.addBindValue(userId);
+        query.addBindValue(topic.topic);
+        query.addBindValue(topic.ability);
+        query.addBindValue(topic.attempts);
+        if (!query.exec())
+        {
+            qDebug() << "Error saving interview mastery:" << query.lastError().text();
+            return false;
+        }
+    }
+    return true;
+}
+
+QHash<QString, QString> Database::getApplicationDraft(int userId, int jobId)
+{
+    TRACE_SCOPE("db", "Database::getApplicationDraft");
+    QHash<QString, QString> fields;
+    QSqlQuery query(db);
+    query.setForwardOnly(true);
+    query.prepare("SELECT field, value FROM application_drafts WHERE user_id = ? AND job_id = ?");
+    query.addBindValue(userId);
+    query.addBindValue(jobId);
+    if (!query.exec())
+    {
+        qDebug() << "Error loading application draft:" << query.lastError().text();
+        return fields;
+    }
+    while (query.next())
+    {
+        fields.insert(query.value(0).toString(), query.value(1).toString());
+    }
+    return fields;
+}
+
+bool Database::saveApplicationDraft(int userId, int jobId, const QHash<QString, QString> &fields, bool clear)
+{
+    return writeApplicationDraft(db, userId, jobId, fields, clear);
+}
+
+bool Database::writeApplicationDraft(QSqlDatabase connection, int userId, int jobId,
+                                     const QHash<QString, QString> &fields, bool clear)
+{
+    TRACE_SCOPE("db", "Database::writeApplicationDraft");
+    if (!connection.transaction())
+    {
+        qDebug() << "Error starting draft transaction:" << connection.lastError().text();
+        return false;
+    }
+
+    QString error;
+    if (clear)
+    {
+        QSqlQuery query(connection);
+        query.prepare("DELETE FROM application_drafts WHERE user_id = ? AND job_id = ?");
+        query.addBindValue(userId);
+        query.addBindValue(jobId);
+        if (!query.exec())
+        {
+            error = query.lastError().text();
+        }
+    }
+
+    QSqlQuery upsert(connection);
+    QSqlQuery remove(connection);
+    upsert.prepare("INSERT OR REPLACE INTO application_drafts (user_id, job_id, field, value, updated_at) "
+                   "VALUES (?, ?, ?, ?, datetime('now'))");
+    remove.prepare("DELETE FROM application_drafts WHERE user_id = ? AND job_id = ? AND field = ?");
+    for (auto it = fields.constBegin(); error.isEmpty() && it != fields.constEnd(); ++it)
+    {
+        QSqlQuery &write = it.value().isEmpty() ? remove : upsert;
+        write.addBindValue(userId);
+        write.addBindValue(jobId);
+        write.addBindValue(it.key());
+        if (!it.value().isEmpty())
+        {
+            write.addBindValue(it.value());
+        }
+        if (!write.exec())
+        {
+            error = write.lastError().text();
+        }
+    }
+
+    if (!error.isEmpty())
+    {
+        qDebug() << "Error saving application draft:" << error;
+        connection.rollback();
+        return false;
+    }
+    return connection.commit();
+}
+
+void Database::saveJob(int userId, int jobId, WriteBatcher::Callback done)
+{
+    writeBatcher.enqueue([this, userId, jobId]()
+                         {
+        TRACE_SCOPE("db", "Database::saveJob");
+        QSqlQuery query(db);
+        query.prepare(
+            "INSERT OR IGNORE INTO saved_jobs (user_id, job_id, saved_date) "
+            "VALUES (?, ?, datetime('now'))");
+        query.addBindValue(userId);
+        query.addBindValue(jobId);
+
+        return query.exec(); }, std::move(done));
+}
+
+void Database::unsaveJob(int userId, int jobId, WriteBatcher::Callback done)
+{
+    writeBatcher.enqueue([this, userId, jobId]()
+                         {
+        TRACE_SCOPE("db", "Database::unsaveJob");
+        QSqlQuery query(db);
+        query.prepare("DELETE FROM saved_jobs WHERE user_id = ? AND job_id = ?");
+        query.addBindValue(userId);
+        query.addBindValue(jobId);
+
+        return query.exec(); }, std::move(done));
+}
+
+bool Database::recordSearchQuery(const QString &text)
+{
+    const QString normalized = text.simplified().toLower();
+    if (normalized.isEmpty())
+    {
+        return false;
+    }
+
+    TRACE_SCOPE("db", "Database::recordSearchQuery");
+    QSqlQuery query(db);
+    query.prepare(
+        "INSERT INTO search_history (query) VALUES (?) "
+        "ON CONFLICT(query) DO UPDATE SET uses = uses + 1, last_used = CURRENT_TIMESTAMP");
+    query.addBindValue(normalized);
+    if (!query.exec())
+    {
+        qDebug() << "Error recording search query:" << query.lastError().text();
+        return false;
+    }
+    return true;
+}
+
+std::vector<int> Database::getSavedJobs(int userId)
+{
+    TRACE_SCOPE("db", "Database::getSavedJobs");
+    writeBatcher.flush();
+    std::vector<int> jobIds;
+    QSqlQuery query(db);
+    query.prepare("SELECT job_id FROM saved_jobs WHERE user_id = ?");
+    query.addBindValue(userId);
+
+    if (query.exec())
+    {
+        while (query.next())
+        {
+            jobIds.push_back(query.value(0).toInt());
+        }
+    }
+    return jobIds;
+}
+
+bool Database::isJobSaved(int userId, int jobId)
+{
+    TRACE_SCOPE("db", "Database::isJobSaved");
+    writeBatcher.flush();
+    QSqlQuery query(db);
+    query.prepare("SELECT COUNT(*) FROM saved_jobs WHERE user_id = ? AND job_id = ?");
+    query.addBindValue(userId);
+    query.addBindValue(jobId);
 
     if (query.exec() && query.next())
     {
@@ -780,7 +1981,8 @@ bool Database::updateSurveyData(int userId, bool isInternational, const QString
                                 const QString &transcriptPath, const QString &parsedResumeData,
                                 const QString &parsedGPA, const QString &parsedCourses)
 {
-    QSqlQuery query;
+    TRACE_SCOPE("db", "Database::updateSurveyData");
+    QSqlQuery query(db);
     query.prepare("UPDATE users SET is_international_student = ?, resume_path = ?, "
                   "transcript_path = ?, parsed_resume_data = ?, parsed_gpa = ?, "
                   "parsed_courses = ?, survey_completed = 1 WHERE id = ?");
@@ -797,25 +1999,500 @@ bool Database::updateSurveyData(int userId, bool isInternational, const QString
     {
         qDebug() << "Error updating survey data:" << query.lastError().text();
     }
+    invalidateUser(userId);
     return success;
 }
 
-bool Database::markSurveyCompleted(int userId, bool completed)
+void Database::markSurveyCompleted(int userId, bool completed, WriteBatcher::Callback done)
 {
-    QSqlQuery query;
-    query.prepare("UPDATE users SET survey_completed = ? WHERE id = ?");
-    query.addBindValue(completed ? 1 : 0);
-    query.addBindValue(userId);
+    writeBatcher.enqueue([this, userId, completed]()
+                         {
+        TRACE_SCOPE("db", "Database::markSurveyCompleted");
+        QSqlQuery query(db);
+        query.prepare("UPDATE users SET survey_completed = ? WHERE id = ?");
+        query.addBindValue(completed ? 1 : 0);
+        query.addBindValue(userId);
+
+        bool success = query.exec();
+        invalidateUser(userId);
+        return success; }, std::move(done));
+}
 
-    return query.exec();
+void Database::updateInternationalStatus(int userId, bool isInternational, WriteBatcher::Callback done)
+{
+    writeBatcher.enqueue([this, userId, isInternational]()
+                         {
+        TRACE_SCOPE("db", "Database::updateInternationalStatus");
+        QSqlQuery query(db);
+        query.prepare("UPDATE users SET is_international_student = ? WHERE id = ?");
+        query.addBindValue(isInternational ? 1 : 0);
+        query.addBindValue(userId);
+
+        bool success = query.exec();
+        invalidateUser(userId);
+        return success; }, std::move(done));
 }
 
-bool Database::updateInternationalStatus(int userId, bool isInternational)
+// Bulk and streaming helpers (used by campus_cli)
+
+bool Database::beginTransaction()
 {
-    QSqlQuery query;
-    query.prepare("UPDATE users SET is_international_student = ? WHERE id = ?");
-    query.addBindValue(isInternational ? 1 : 0);
-    query.addBindValue(userId);
+    writeBatcher.flush();
+    return db.transaction();
+}
 
-    return query.exec();
-}
\ No newline at end of file
+bool Database::commitTransaction()
+{
+    return db.commit();
+}
+
+bool Database::rollbackTransaction()
+{
+    return db.rollback();
+}
+
+bool Database::forEachJob(const std::function<bool(const Job &)> &visitor)
+{
+    TRACE_SCOPE("db", "Database::forEachJob");
+    if (useNativeReads())
+    {
+        NativeSqlite::Statement statement = native.prepare("SELECT * FROM jobs ORDER BY id");
+        if (statement.isValid())
+        {
+            const JobColumns columns(statement);
+            while (statement.step())
+            {
+                if (!visitor(jobFromStatement(statement, columns)))
+                {
+                    return true;
+                }
+            }
+            return !statement.failed();
+        }
+    }
+
+    QSqlQuery query(db);
+    query.setForwardOnly(true);
+
+    if (!query.exec("SELECT * FROM jobs ORDER BY id"))
+    {
+        qDebug() << "Error streaming jobs:" << query.lastError().text();
+        return false;
+    }
+    while (query.next())
+    {
+        if (!visitor(jobFromQuery(query)))
+        {
+            break;
+        }
+    }
+    return true;
+}
+
+QStringList Database::exportableTables()
+{
+    return {"users", "jobs", "documents", "job_applications", "job_interests"};
+}
+
+qint64 Database::exportTable(const QString &table, const QString &path, int rowGroupSize)
+{
+    TRACE_SCOPE("db", "Database::exportTable");
+    writeBatcher.flush();
+    if (!exportableTables().contains(table))
+    {
+        qDebug() << "Table is not exportable:" << table;
+        return -1;
+    }
+
+    // Column list and storage type from the live schema; password hashes never leave the database
+    QStringList columns;
+    QStringList quotedColumns;
+    std::vector<Columnar::Type> types;
+    QSqlQuery pragma(db);
+    if (!pragma.exec(QString("PRAGMA table_info(%1)").arg(quoteIdentifier(table))))
+    {
+        qDebug() << "Error reading schema of" << table << ":" << pragma.lastError().text();
+        return -1;
+    }
+    while (pragma.next())
+    {
+        const QString name = pragma.value(1).toString();
+        const QString declared = pragma.value(2).toString().toUpper();
+        if (table == "users" && name == "password")
+        {
+            continue;
+        }
+        columns.append(name);
+        quotedColumns.append(quoteIdentifier(name));
+        if (declared.contains("INT"))
+            types.push_back(Columnar::Type::Integer);
+        else if (declared.contains("REAL") || declared.contains("FLOA") || declared.contains("DOUB"))
+            types.push_back(Columnar::Type::Real);
+        else
+            types.push_back(Columnar::Type::Text);
+    }
+
+    ColumnarWriter writer(path, columns, types, rowGroupSize);
+    if (!writer.open())
+    {
+        return -1;
+    }
+
+    QSqlQuery query(db);
+    query.setForwardOnly(true);
+    if (!query.exec(QString("SELECT %1 FROM %2 ORDER BY rowid").arg(quotedColumns.join(", "), quoteIdentifier(table))))
+    {
+        qDebug() << "Error streaming" << table << ":" << query.lastError().text();
+        return -1;
+    }
+
+    std::vector<QVariant> row(columns.size());
+    while (query.next())
+    {
+        for (int i = 0; i < columns.size(); ++i)
+        {
+            row[i] = query.value(i);
+        }
+        if (!writer.addRow(row))
+        {
+            qDebug() << "Error writing export of" << table << ":" << writer.errorString();
+            return -1;
+        }
+    }
+
+    if (!writer.finish())
+    {
+        qDebug() << "Error finishing export of" << table << ":" << writer.errorString();
+        return -1;
+    }
+    return writer.rowCount();
+}
+
+int Database::importJobs(const std::function<bool(Job &)> &nextJob)
+{
+    TRACE_SCOPE("db", "Database::importJobs");
+    if (!beginTransaction())
+    {
+        qDebug() << "Error starting import transaction:" << db.lastError().text();
+        return -1;
+    }
+
+    QSqlQuery query(db);
+    query.prepare(
+        "INSERT INTO jobs (title, department, category, description, pay_rate_min, pay_rate_max, "
+        "hours_per_week, positions_available, status, work_study_eligible, international_eligible, "
+        "deadline, requirements, duties, skills, supervisor_info, contact_email, schedule, required_documents, "
+        "open_date) VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)");
+
+    int imported = 0;
+    Job job;
+    while (nextJob(job))
+    {
+        query.addBindValue(job.getTitle());
+        query.addBindValue(job.getDepartment());
+        query.addBindValue(job.getCategory());
+        query.addBindValue(job.getDescription());
+        query.addBindValue(job.getPayRateMin());
+        query.addBindValue(job.getPayRateMax());
+        query.addBindValue(job.getHoursPerWeek());
+        query.addBindValue(job.getPositionsAvailable());
+        query.addBindValue(static_cast<int>(job.getStatus()));
+        query.addBindValue(job.isWorkStudyEligible() ? 1 : 0);
+        query.addBindValue(job.isInternationalEligible() ? 1 : 0);
+        query.addBindValue(job.getDeadline());
+        query.addBindValue(job.getRequirements());
+        query.addBindValue(job.getDuties());
+        query.addBindValue(job.getSkills());
+        query.addBindValue(job.getSupervisorInfo());
+        query.addBindValue(job.getContactEmail());
+        query.addBindValue(job.getSchedule());
+        query.addBindValue(job.getRequiredDocuments());
+        query.addBindValue(job.getOpenDate());
+
+        if (!query.exec())
+        {
+            qDebug() << "Error importing job" << job.getTitle() << ":" << query.lastError().text();
+            rollbackTransaction();
+            return -1;
+        }
+        ++imported;
+    }
+
+    if (!commitTransaction())
+    {
+        qDebug() << "Error committing job import:" << db.lastError().text();
+        rollbackTransaction();
+        return -1;
+    }
+    return imported;
+}
+
+int Database::updateDocumentStatuses(const std::function<bool(int &, QString &)> &nextUpdate)
+{
+    TRACE_SCOPE("db", "Database::updateDocumentStatuses");
+    if (!beginTransaction())
+    {
+        qDebug() << "Error starting status update transaction:" << db.lastError().text();
+        return -1;
+    }
+
+    QSqlQuery query(db);
+    query.prepare("UPDATE documents SET status = ? WHERE id = ?");
+
+    int updated = 0;
+    int documentId = -1;
+    QString status;
+    while (nextUpdate(documentId, status))
+    {
+        query.addBindValue(status);
+        query.addBindValue(documentId);
+        if (!query.exec())
+        {
+            qDebug() << "Error updating document" << documentId << ":" << query.lastError().text();
+            rollbackTransaction();
+            return -1;
+        }
+        updated += query.numRowsAffected();
+    }
+
+    if (!commitTransaction())
+    {
+        qDebug() << "Error committing status updates:" << db.lastError().text();
+        rollbackTransaction();
+        return -1;
+    }
+    return updated;
+}
+
+QMap<QString, int> Database::getJobCountsByCategory()
+{
+    TRACE_SCOPE("db", "Database::getJobCountsByCategory");
+    return JobAnalytics::jobCountsBy(db, "category");
+}
+
+QMap<QString, int> Database::getJobCountsByStatus()
+{
+    TRACE_SCOPE("db", "Database::getJobCountsByStatus");
+    QMap<QString, int> counts;
+    QSqlQuery query(db);
+    if (query.exec("SELECT status, SUM(jobs) FROM rollup_jobs WHERE dimension = 'category' "
+                   "GROUP BY status HAVING SUM(jobs) > 0"))
+    {
+        while (query.next())
+        {
+            JobStatus status = static_cast<JobStatus>(query.value(0).toInt());
+            counts.insert(Job::statusToString(status), query.value(1).toInt());
+        }
+    }
+    return counts;
+}
+
+QMap<QString, int> Database::getDocumentCountsByStatus()
+{
+    TRACE_SCOPE("db", "Database::getDocumentCountsByStatus");
+    QMap<QString, int> counts;
+    QSqlQuery query(db);
+    if (query.exec("SELECT status, COUNT(*) FROM documents GROUP BY status"))
+    {
+        while (query.next())
+        {
+            counts.insert(query.value(0).toString(), query.value(1).toInt());
+        }
+    }
+    return counts;
+}
+
+int Database::getUserCount()
+{
+    TRACE_SCOPE("db", "Database::getUserCount");
+    QSqlQuery query(db);
+    if (query.exec("SELECT COUNT(*) FROM users") && query.next())
+    {
+        return query.value(0).toInt();
+    }
+    return 0;
+}
+
+namespace
+{
+    // Online backup batches: 256 pages (1 MiB at 4 KiB pages) per step,
+    // then a pause so the copy never holds the database for long
+    constexpr int kSnapshotPagesPerStep = 256;
+    constexpr int kSnapshotPauseMs = 10;
+
+    // Consistent copy of a live database through a private connection, so it
+    // can run on any thread. With the native backend this is SQLite's online
+    // backup, page batches with yields in between; otherwise Qt's bundled
+    // SQLite cannot be reached and VACUUM INTO copies it in one statement.
+    bool copyDatabaseImage(const QString &databasePath, const QString &imagePath)
+    {
+        const QString connection = QString("snapshot-%1").arg(++snapshotConnectionCounter);
+        bool ok = false;
+        {
+            QSqlDatabase source = QSqlDatabase::addDatabase("QSQLITE", connection);
+            source.setDatabaseName(databasePath);
+            source.setConnectOptions("QSQLITE_BUSY_TIMEOUT=5000");
+            if (source.open())
+            {
+                NativeSqlite::Connection native;
+                if (NativeSqlite::isAvailable() && native.attach(source))
+                {
+                    QString error;
+                    ok = native.backupTo(imagePath, kSnapshotPagesPerStep, kSnapshotPauseMs, &error);
+                    if (!ok)
+                    {
+                        qDebug() << "Error backing up database for snapshot:" << error;
+                    }
+                    native.detach();
+                }
+                else
+                {
+                    QSqlQuery query(source);
+                    ok = query.exec(QString("VACUUM INTO '%1'").arg(QString(imagePath).replace("'", "''")));
+                    if (!ok)
+                    {
+                        qDebug() << "Error copying database for snapshot:" << query.lastError().text();
+                    }
+                }
+                source.close();
+            }
+            else
+            {
+                qDebug() << "Error opening snapshot connection:" << source.lastError().text();
+            }
+        }
+        QSqlDatabase::removeDatabase(connection);
+        return ok;
+    }
+
+    bool snapshotDatabase(const QString &databasePath, const QString &storeDirectory,
+                          const QString &label, SnapshotInfo &info)
+    {
+        TRACE_SCOPE("db", "Database::snapshot");
+        QDir().mkpath(storeDirectory);
+        const QString image = QDir(storeDirectory).filePath(
+            QString("image-%1.tmp").arg(QDateTime::currentMSecsSinceEpoch()));
+        QFile::remove(image);
+
+        const bool ok = copyDatabaseImage(databasePath, image) &&
+                        SnapshotStore(storeDirectory).addImage(image, label, info);
+        QFile::remove(image);
+        return ok;
+    }
+}
+
+QString Database::snapshotDirectory() const
+{
+    return SnapshotStore::defaultDirectory(db.databaseName());
+}
+
+bool Database::createSnapshot(const QString &label, SnapshotInfo *info)
+{
+    writeBatcher.flush();
+    if (snapshotRunning.exchange(true))
+    {
+        qDebug() << "A snapshot is already running";
+        return false;
+    }
+    SnapshotInfo result;
+    const bool ok = snapshotDatabase(db.databaseName(), snapshotDirectory(), label, result);
+    snapshotRunning = false;
+    if (ok && info)
+    {
+        *info = result;
+    }
+    return ok;
+}
+
+void Database::createSnapshotAsync(const QString &label, QObject *context,
+                                   std::function<void(bool ok, const SnapshotInfo &info)> done)
+{
+    QPointer<QObject> guard(context);
+    writeBatcher.flush();
+    if (snapshotRunning.exchange(true))
+    {
+        QMetaObject::invokeMethod(this, [guard, done]()
+                                  {
+            if (guard)
+            {
+                done(false, SnapshotInfo());
+            } }, Qt::QueuedConnection);
+        return;
+    }
+
+    const QString databasePath = db.databaseName();
+    const QString storeDirectory = snapshotDirectory();
+    // ~Database waits for snapshotPool, so the task may use this; the
+    // result event is dropped if this is deleted before it is delivered
+    snapshotPool.start([this, databasePath, storeDirectory, label, guard, done]()
+                       {
+        SnapshotInfo info;
+        const bool ok = snapshotDatabase(databasePath, storeDirectory, label, info);
+        snapshotRunning = false;
+        QMetaObject::invokeMethod(this, [guard, done, ok, info]()
+                                  {
+            if (guard)
+            {
+                done(ok, info);
+            } }, Qt::QueuedConnection); });
+}
+
+std::vector<SnapshotInfo> Database::listSnapshots() const
+{
+    return SnapshotStore(snapshotDirectory()).list();
+}
+
+SnapshotInfo Database::snapshotAt(const QDateTime &when) const
+{
+    return SnapshotStore(snapshotDirectory()).latestAt(when);
+}
+
+bool Database::verifySnapshot(const QString &id) const
+{
+    TRACE_SCOPE("db", "Database::verifySnapshot");
+    return SnapshotStore(snapshotDirectory()).verify(id);
+}
+
+bool Database::restoreSnapshot(const QString &id, const QString &targetPath)
+{
+    TRACE_SCOPE("db", "Database::restoreSnapshot");
+    const SnapshotStore store(snapshotDirectory());
+    if (!targetPath.isEmpty())
+    {
+        return store.restore(id, targetPath);
+    }
+
+    // Autocomplete rebuilds, draft writers, tenant hubs and other processes
+    // may have the live file open, and renaming it under them would corrupt
+    // their view. The image is staged beside it instead and replaces it at
+    // the next connectToDatabase() that finds the file idle.
+    const QString livePath = db.databaseName();
+    if (livePath.isEmpty() || livePath == ":memory:")
+    {
+        qDebug() << "Cannot restore over an in-memory database";
+        return false;
+    }
+    // Writes queued before the request reach the live file, not after it
+    writeBatcher.flush();
+    // Chunks must not be pruned while they are read
+    if (snapshotRunning.exchange(true))
+    {
+        qDebug() << "Cannot restore while a snapshot is running";
+        return false;
+    }
+    const bool staged = store.verify(id) && store.restore(id, stagedRestorePath(livePath));
+    snapshotRunning = false;
+    return staged;
+}
+
+int Database::pruneSnapshots(int keep)
+{
+    if (snapshotRunning.exchange(true))
+    {
+        qDebug() << "Cannot prune while a snapshot is running";
+        return -1;
+    }
+    const int removed = SnapshotStore(snapshotDirectory()).prune(keep);
+    snapshotRunning = false;
+    return removed;
+}
@@ -0,0 +1,194 @@
+#include "database/jobresultcache.h"
+
+namespace
+{
+    // Rough per-object overheads for the footprint estimate
+    const qint64 kEntryOverhead = 96;
+    const qint64 kPooledJobOverhead = 64;
+
+    bool isAscii(const QString &text)
+    {
+        for (QChar c : text)
+        {
+            if (c.unicode() > 0x7f)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+JobResultCache::JobResultCache(qint64 maxBytes)
+    : maxBytes(maxBytes), usedBytes(0), cachedVersion(-1)
+{
+}
+
+QString JobResultCache::keyFor(const JobSearchOptions &options, int limit)
+{
+    // LIKE folds ASCII case only, so only ASCII keywords can be folded here
+    const QString keyword = isAscii(options.keyword) ? options.keyword.toLower() : options.keyword;
+    const QString status = options.statuses ? QString::number(options.statuses) : QString();
+    const QString hours = options.hours ? QString("%1-%2").arg(options.hours->first).arg(options.hours->second)
+                                        : QString();
+    const QString pay = options.pay ? QString("%1-%2").arg(options.pay->first).arg(options.pay->second) : QString();
+    // Unit separators keep free text from colliding with the other fields
+    return QStringList{keyword, status, options.category, options.workStudyOnly ? "1" : "0",
+                       options.internationalOnly ? "1" : "0", hours, pay, QString::number(limit < 0 ? -1 : limit)}
+        .join(QChar(0x1f));
+}
+
+qint64 JobResultCache::estimateBytes(const Job &job)
+{
+    const qint64 characters = job.getTitle().size() + job.getDepartment().size() + job.getCategory().size() +
+                              job.getDescription().size() + job.getDeadline().size() +
+                              job.getRequirements().size() + job.getDuties().size() + job.getSkills().size() +
+                              job.getSupervisorInfo().size() + job.getContactEmail().size() +
+                              job.getSchedule().size() + job.getRequiredDocuments().size() +
+                              job.getOpenDate().size();
+    return qint64(sizeof(Job)) + kPooledJobOverhead + characters * qint64(sizeof(QChar));
+}
+
+void JobResultCache::syncVersion(qint64 version)
+{
+    if (version == cachedVersion)
+    {
+        return;
+    }
+    if (!entries.isEmpty())
+    {
+        ++counters.invalidations;
+    }
+    entries.clear();
+    recencyOrder.clear();
+    pool.clear();
+    usedBytes = 0;
+    cachedVersion = version;
+}
+
+bool JobResultCache::lookup(const QString &key, qint64 version, std::vector<Job> &jobs)
+{
+    syncVersion(version);
+    auto it = entries.find(key);
+    if (it == entries.end())
+    {
+        ++counters.misses;
+        return false;
+    }
+
+    ++counters.hits;
+    recencyOrder.splice(recencyOrder.begin(), recencyOrder, it->recency);
+    jobs.clear();
+    jobs.reserve(it->jobIds.size());
+    for (int jobId : it->jobIds)
+    {
+        jobs.push_back(pool.constFind(jobId)->job);
+    }
+    return true;
+}
+
+void JobResultCache::insert(const QString &key, qint64 version, const std::vector<Job> &jobs)
+{
+    syncVersion(version);
+    if (entries.contains(key))
+    {
+        evict(key);
+    }
+
+    Entry entry;
+    entry.jobIds.reserve(jobs.size());
+    entry.bytes = kEntryOverhead + key.size() * qint64(sizeof(QChar)) + qint64(jobs.size() * sizeof(int));
+    qint64 addedBytes = entry.bytes;
+    for (const Job &job : jobs)
+    {
+        entry.jobIds.push_back(job.getId());
+        auto pooled = pool.find(job.getId());
+        if (pooled == pool.end())
+        {
+            const qint64 bytes = estimateBytes(job);
+            pool.insert(job.getId(), PooledJob{job, 1, bytes});
+            usedBytes += bytes;
+            addedBytes += bytes;
+        }
+        else
+        {
+            ++pooled->references;
+        }
+    }
+    if (addedBytes > maxBytes)
+    {
+        // Too big to keep; give back the pool references just taken
+        for (int jobId : entry.jobIds)
+        {
+            auto pooled = pool.find(jobId);
+            if (--pooled->references == 0)
+            {
+                usedBytes -= pooled->bytes;
+                pool.erase(pooled);
+            }
+        }
+        return;
+    }
+
+    usedBytes += entry.bytes;
+    recencyOrder.push_front(key);
+    entry.recency = recencyOrder.begin();
+    entries.insert(key, std::move(entry));
+    trim();
+}
+
+void JobResultCache::evict(const QString &key)
+{
+    auto it = entries.find(key);
+    if (it == entries.end())
+    {
+        return;
+    }
+    for (int jobId : it->jobIds)
+    {
+        auto pooled = pool.find(jobId);
+        if (pooled != pool.end() && --pooled->references == 0)
+        {
+            usedBytes -= pooled->bytes;
+            pool.erase(pooled);
+        }
+    }
+    usedBytes -= it->bytes;
+    recencyOrder.erase(it->recency);
+    entries.erase(it);
+}
+
+void JobResultCache::trim()
+{
+    // Never evicts the entry just added
+    while (usedBytes > maxBytes && entries.size() > 1)
+    {
+        const QString oldest = recencyOrder.back();
+        evict(oldest);
+        ++counters.evictions;
+    }
+}
+
+void JobResultCache::clear()
+{
+    entries.clear();
+    recencyOrder.clear();
+    pool.clear();
+    usedBytes = 0;
+    cachedVersion = -1;
+}
+
+void JobResultCache::setMaxBytes(qint64 bytes)
+{
+    maxBytes = bytes;
+    trim();
+}
+
+JobResultCache::Stats JobResultCache::stats() const
+{
+    Stats result = counters;
+    result.entries = entries.size();
+    result.pooledJobs = pool.size();
+    result.bytes = usedBytes;
+    return result;
+}
@@ -0,0 +1,267 @@
+#include "database/nativesqlite.h"
+#include <QDebug>
+#include <QSqlDatabase>
+#include <QSqlDriver>
+#include <QVariant>
+#include <utility>
+
+#ifdef CAMPUS_NATIVE_SQLITE
+#include <sqlite3.h>
+#endif
+
+namespace NativeSqlite
+{
+#ifdef CAMPUS_NATIVE_SQLITE
+
+    bool isAvailable()
+    {
+        return true;
+    }
+
+    Statement::Statement(sqlite3 *db, const char *sql)
+    {
+        if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK)
+        {
+            qDebug() << "Error preparing native statement:" << sqlite3_errmsg(db);
+            sqlite3_finalize(stmt);
+            stmt = nullptr;
+        }
+    }
+
+    Statement::~Statement()
+    {
+        sqlite3_finalize(stmt);
+    }
+
+    Statement::Statement(Statement &&other) noexcept
+        : stmt(std::exchange(other.stmt, nullptr)), error(other.error)
+    {
+    }
+
+    Statement &Statement::operator=(Statement &&other) noexcept
+    {
+        if (this != &other)
+        {
+            sqlite3_finalize(stmt);
+            stmt = std::exchange(other.stmt, nullptr);
+            error = other.error;
+        }
+        return *this;
+    }
+
+    bool Statement::bind(int index, qint64 value)
+    {
+        return stmt && sqlite3_bind_int64(stmt, index, value) == SQLITE_OK;
+    }
+
+    bool Statement::bind(int index, double value)
+    {
+        return stmt && sqlite3_bind_double(stmt, index, value) == SQLITE_OK;
+    }
+
+    bool Statement::bind(int index, const QByteArray &utf8)
+    {
+        return stmt && sqlite3_bind_text(stmt, index, utf8.constData(), static_cast<int>(utf8.size()),
+                                         SQLITE_TRANSIENT) == SQLITE_OK;
+    }
+
+    bool Statement::step()
+    {
+        if (!stmt)
+        {
+            error = true;
+            return false;
+        }
+        const int rc = sqlite3_step(stmt);
+        if (rc == SQLITE_ROW)
+        {
+            return true;
+        }
+        if (rc != SQLITE_DONE)
+        {
+            error = true;
+            qDebug() << "Error stepping native statement:" << sqlite3_errmsg(sqlite3_db_handle(stmt));
+        }
+        return false;
+    }
+
+    bool Statement::reset()
+    {
+        error = false;
+        return stmt && sqlite3_reset(stmt) == SQLITE_OK;
+    }
+
+    int Statement::columnCount() const
+    {
+        return stmt ? sqlite3_column_count(stmt) : 0;
+    }
+
+    int Statement::columnIndex(const char *name) const
+    {
+        const int count = columnCount();
+        for (int i = 0; i < count; ++i)
+        {
+            if (sqlite3_stricmp(sqlite3_column_name(stmt, i), name) == 0)
+            {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    bool Statement::isNull(int column) const
+    {
+        return column < 0 || sqlite3_column_type(stmt, column) == SQLITE_NULL;
+    }
+
+    qint64 Statement::int64(int column) const
+    {
+        return column < 0 ? 0 : sqlite3_column_int64(stmt, column);
+    }
+
+    double Statement::real(int column) const
+    {
+        return column < 0 ? 0.0 : sqlite3_column_double(stmt, column);
+    }
+
+    QUtf8StringView Statement::text(int column) const
+    {
+        if (column < 0)
+        {
+            return QUtf8StringView();
+        }
+        // Text first, then its length, as the SQLite docs require
+        const auto *data = reinterpret_cast<const char *>(sqlite3_column_text(stmt, column));
+        return QUtf8StringView(data, sqlite3_column_bytes(stmt, column));
+    }
+
+    bool Connection::attach(const QSqlDatabase &database)
+    {
+        detach();
+        // The QSQLITE driver hands out its connection as "sqlite3*"
+        const QVariant handle = database.isOpen() ? database.driver()->handle() : QVariant();
+        if (!handle.isValid() || qstrcmp(handle.typeName(), "sqlite3*") != 0)
+        {
+            qDebug() << "Native backend needs an open QSQLITE connection";
+            return false;
+        }
+        db = *static_cast<sqlite3 *const *>(handle.constData());
+        return db != nullptr;
+    }
+
+    Statement Connection::prepare(const char *sql)
+    {
+        return db ? Statement(db, sql) : Statement();
+    }
+
+    QString Connection::lastError() const
+    {
+        return db ? QString::fromUtf8(sqlite3_errmsg(db)) : QString("not attached");
+    }
+
+    bool Connection::backupTo(const QString &path, int pagesPerStep, int pauseMs, QString *error)
+    {
+        if (!db)
+        {
+            if (error)
+                *error = "not attached";
+            return false;
+        }
+
+        sqlite3 *target = nullptr;
+        if (sqlite3_open_v2(path.toUtf8().constData(), &target, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE,
+                            nullptr) != SQLITE_OK)
+        {
+            if (error)
+                *error = QString::fromUtf8(sqlite3_errmsg(target));
+            sqlite3_close(target);
+            return false;
+        }
+
+        sqlite3_backup *backup = sqlite3_backup_init(target, "main", db, "main");
+        if (!backup)
+        {
+            if (error)
+                *error = QString::fromUtf8(sqlite3_errmsg(target));
+            sqlite3_close(target);
+            return false;
+        }
+
+        int rc = SQLITE_OK;
+        int restarts = 0;
+        int remaining = -1;
+        for (;;)
+        {
+            // A copy that keeps restarting under writers finishes in one step
+            rc = sqlite3_backup_step(backup, restarts < kMaxBackupRestarts ? pagesPerStep : -1);
+            if (rc != SQLITE_OK && rc != SQLITE_BUSY && rc != SQLITE_LOCKED)
+            {
+                break;
+            }
+            // A step that made no progress started over from the first page
+            const int left = sqlite3_backup_remaining(backup);
+            if (rc == SQLITE_OK && remaining >= 0 && left >= remaining)
+            {
+                ++restarts;
+            }
+            remaining = left;
+            sqlite3_sleep(pauseMs);
+        }
+        sqlite3_backup_finish(backup);
+
+        const bool ok = rc == SQLITE_DONE;
+        if (!ok && error)
+        {
+            *error = QString::fromUtf8(sqlite3_errstr(rc));
+        }
+        sqlite3_close(target);
+        return ok;
+    }
+
+#else
+
+    bool isAvailable()
+    {
+        return false;
+    }
+
+    Statement::Statement(sqlite3 *, const char *) {}
+    Statement::~Statement() {}
+    Statement::Statement(Statement &&other) noexcept : stmt(nullptr), error(other.error) {}
+    Statement &Statement::operator=(Statement &&other) noexcept
+    {
+        error = other.error;
+        return *this;
+    }
+    bool Statement::bind(int, qint64) { return false; }
+    bool Statement::bind(int, double) { return false; }
+    bool Statement::bind(int, const QByteArray &) { return false; }
+    bool Statement::step()
+    {
+        error = true;
+        return false;
+    }
+    bool Statement::reset() { return false; }
+    int Statement::columnCount() const { return 0; }
+    int Statement::columnIndex(const char *) const { return -1; }
+    bool Statement::isNull(int) const { return true; }
+    qint64 Statement::int64(int) const { return 0; }
+    double Statement::real(int) const { return 0.0; }
+    QUtf8StringView Statement::text(int) const { return QUtf8StringView(); }
+
+    bool Connection::attach(const QSqlDatabase &)
+    {
+        qDebug() << "Native SQLite backend not built (Qt's SQLite driver does not use the system sqlite3)";
+        return false;
+    }
+    Statement Connection::prepare(const char *) { return Statement(); }
+    QString Connection::lastError() const { return QString("native SQLite backend not built"); }
+    bool Connection::backupTo(const QString &, int, int, QString *error)
+    {
+        if (error)
+            *error = "native SQLite backend not built";
+        return false;
+    }
+
+#endif
+}
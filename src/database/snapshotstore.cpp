@@ -0,0 +1,330 @@
+#include "database/snapshotstore.h"
+#include <QCryptographicHash>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QSet>
+#include <QTextStream>
+#include <QtEndian>
+
+namespace
+{
+    const char *const kManifestMagic = "campus-snapshot 1";
+    const int kCompressionLevel = 6;
+
+    // Page size from the SQLite file header (offset 16, big-endian; 1 means 65536)
+    int imagePageSize(QFile &image)
+    {
+        char header[18];
+        if (image.peek(header, sizeof(header)) != qint64(sizeof(header)) ||
+            QByteArray(header, 16) != QByteArray("SQLite format 3\0", 16))
+        {
+            return -1;
+        }
+        const int pageSize = qFromBigEndian<quint16>(header + 16);
+        return pageSize == 1 ? 65536 : pageSize;
+    }
+
+    QString hexSha256(const QByteArray &data)
+    {
+        return QString::fromLatin1(QCryptographicHash::hash(data, QCryptographicHash::Sha256).toHex());
+    }
+}
+
+SnapshotStore::SnapshotStore(const QString &directory)
+    : root(directory)
+{
+}
+
+QString SnapshotStore::defaultDirectory(const QString &databasePath)
+{
+    return databasePath + ".snapshots";
+}
+
+QString SnapshotStore::manifestPath(const QString &id) const
+{
+    return QDir(root).filePath("manifests/" + id + ".manifest");
+}
+
+QString SnapshotStore::chunkPath(const QString &hash) const
+{
+    return QDir(root).filePath("chunks/" + hash.left(2) + "/" + hash);
+}
+
+bool SnapshotStore::addImage(const QString &imagePath, const QString &label, SnapshotInfo &info)
+{
+    QFile image(imagePath);
+    if (!image.open(QIODevice::ReadOnly))
+    {
+        qDebug() << "Cannot open snapshot image" << imagePath << ":" << image.errorString();
+        return false;
+    }
+    const int pageSize = imagePageSize(image);
+    if (pageSize <= 0)
+    {
+        qDebug() << "Not an SQLite database image:" << imagePath;
+        return false;
+    }
+
+    const QDateTime created = QDateTime::currentDateTimeUtc();
+    info = SnapshotInfo();
+    info.id = created.toString("yyyyMMdd-HHmmss-zzz");
+    info.created = created;
+    info.label = label;
+    if (QFile::exists(manifestPath(info.id)))
+    {
+        qDebug() << "Snapshot" << info.id << "already exists";
+        return false;
+    }
+
+    QCryptographicHash whole(QCryptographicHash::Sha256);
+    QStringList hashes;
+    const qint64 chunkSize = qint64(pageSize) * kPagesPerChunk;
+    while (!image.atEnd())
+    {
+        const QByteArray chunk = image.read(chunkSize);
+        if (chunk.isEmpty())
+        {
+            qDebug() << "Error reading snapshot image:" << image.errorString();
+            return false;
+        }
+        whole.addData(chunk);
+        info.size += chunk.size();
+
+        const QString hash = hexSha256(chunk);
+        hashes << hash;
+        const QString path = chunkPath(hash);
+        if (QFile::exists(path))
+        {
+            continue;
+        }
+
+        QDir().mkpath(QFileInfo(path).path());
+        QSaveFile out(path);
+        if (!out.open(QIODevice::WriteOnly) || out.write(qCompress(chunk, kCompressionLevel)) < 0 || !out.commit())
+        {
+            qDebug() << "Error writing snapshot chunk" << path << ":" << out.errorString();
+            return false;
+        }
+        ++info.newChunks;
+    }
+    info.sha256 = QString::fromLatin1(whole.result().toHex());
+    info.chunks = hashes.size();
+
+    // The manifest is written last: a snapshot exists only once all its chunks do
+    QDir().mkpath(QDir(root).filePath("manifests"));
+    QSaveFile manifest(manifestPath(info.id));
+    if (!manifest.open(QIODevice::WriteOnly | QIODevice::Text))
+    {
+        qDebug() << "Error writing snapshot manifest:" << manifest.errorString();
+        return false;
+    }
+    QTextStream stream(&manifest);
+    stream << kManifestMagic << "\n"
+           << "created " << created.toString(Qt::ISODateWithMs) << "\n"
+           << "label " << QString(label).replace('\n', ' ') << "\n"
+           << "page_size " << pageSize << "\n"
+           << "size " << info.size << "\n"
+           << "sha256 " << info.sha256 << "\n"
+           << "chunks " << info.chunks << "\n";
+    for (const QString &hash : hashes)
+    {
+        stream << hash << "\n";
+    }
+    stream.flush();
+    return manifest.commit();
+}
+
+bool SnapshotStore::readManifest(const QString &path, SnapshotInfo &info, QStringList *chunkHashes) const
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+        return false;
+    }
+    QTextStream stream(&file);
+    if (stream.readLine() != kManifestMagic)
+    {
+        qDebug() << "Not a snapshot manifest:" << path;
+        return false;
+    }
+
+    info = SnapshotInfo();
+    info.id = QFileInfo(path).completeBaseName();
+    QString line;
+    while (stream.readLineInto(&line) && !line.startsWith("chunks "))
+    {
+        const QString key = line.section(' ', 0, 0);
+        const QString value = line.section(' ', 1);
+        if (key == "created")
+            info.created = QDateTime::fromString(value, Qt::ISODateWithMs);
+        else if (key == "label")
+            info.label = value;
+        else if (key == "size")
+            info.size = value.toLongLong();
+        else if (key == "sha256")
+            info.sha256 = value;
+    }
+    info.chunks = line.section(' ', 1).toInt();
+
+    if (chunkHashes)
+    {
+        chunkHashes->clear();
+        while (stream.readLineInto(&line))
+        {
+            *chunkHashes << line;
+        }
+        if (chunkHashes->size() != info.chunks)
+        {
+            qDebug() << "Truncated snapshot manifest:" << path;
+            return false;
+        }
+    }
+    return info.created.isValid() && !info.sha256.isEmpty();
+}
+
+std::vector<SnapshotInfo> SnapshotStore::list() const
+{
+    std::vector<SnapshotInfo> snapshots;
+    const QDir manifests(QDir(root).filePath("manifests"));
+    for (const QString &name : manifests.entryList({"*.manifest"}, QDir::Files, QDir::Name))
+    {
+        SnapshotInfo info;
+        if (readManifest(manifests.filePath(name), info, nullptr))
+        {
+            snapshots.push_back(info);
+        }
+    }
+    return snapshots;
+}
+
+bool SnapshotStore::find(const QString &id, SnapshotInfo &info) const
+{
+    return readManifest(manifestPath(id), info, nullptr);
+}
+
+SnapshotInfo SnapshotStore::latestAt(const QDateTime &when) const
+{
+    SnapshotInfo latest;
+    for (const SnapshotInfo &info : list())
+    {
+        if (info.created <= when)
+        {
+            latest = info;
+        }
+    }
+    return latest;
+}
+
+bool SnapshotStore::assemble(const QString &id, const std::function<bool(const QByteArray &)> &sink) const
+{
+    SnapshotInfo info;
+    QStringList hashes;
+    if (!readManifest(manifestPath(id), info, &hashes))
+    {
+        qDebug() << "Unknown or damaged snapshot" << id;
+        return false;
+    }
+
+    QCryptographicHash whole(QCryptographicHash::Sha256);
+    for (const QString &hash : hashes)
+    {
+        QFile file(chunkPath(hash));
+        if (!file.open(QIODevice::ReadOnly))
+        {
+            qDebug() << "Snapshot" << id << "is missing chunk" << hash;
+            return false;
+        }
+        const QByteArray chunk = qUncompress(file.readAll());
+        if (hexSha256(chunk) != hash)
+        {
+            qDebug() << "Snapshot" << id << "has a corrupt chunk" << hash;
+            return false;
+        }
+        whole.addData(chunk);
+        if (!sink(chunk))
+        {
+            return false;
+        }
+    }
+
+    if (QString::fromLatin1(whole.result().toHex()) != info.sha256)
+    {
+        qDebug() << "Snapshot" << id << "does not match its recorded hash";
+        return false;
+    }
+    return true;
+}
+
+bool SnapshotStore::verify(const QString &id) const
+{
+    return assemble(id, [](const QByteArray &)
+                    { return true; });
+}
+
+bool SnapshotStore::restore(const QString &id, const QString &targetPath) const
+{
+    QSaveFile target(targetPath);
+    if (!target.open(QIODevice::WriteOnly))
+    {
+        qDebug() << "Cannot open restore target" << targetPath << ":" << target.errorString();
+        return false;
+    }
+
+    const bool ok = assemble(id, [&target](const QByteArray &chunk)
+                             { return target.write(chunk) == chunk.size(); });
+    if (!ok)
+    {
+        target.cancelWriting();
+        return false;
+    }
+    return target.commit();
+}
+
+int SnapshotStore::prune(int keep)
+{
+    const std::vector<SnapshotInfo> snapshots = list();
+    const int remove = qMax(0, int(snapshots.size()) - qMax(keep, 0));
+    if (remove == 0)
+    {
+        return 0;
+    }
+
+    for (int i = 0; i < remove; ++i)
+    {
+        QFile::remove(manifestPath(snapshots[i].id));
+    }
+
+    // Collect chunks still referenced by the remaining manifests
+    QSet<QString> live;
+    for (size_t i = remove; i < snapshots.size(); ++i)
+    {
+        SnapshotInfo info;
+        QStringList hashes;
+        if (!readManifest(manifestPath(snapshots[i].id), info, &hashes))
+        {
+            // Never delete chunks on the strength of an unreadable manifest
+            return -1;
+        }
+        for (const QString &hash : hashes)
+        {
+            live.insert(hash);
+        }
+    }
+
+    const QDir chunks(QDir(root).filePath("chunks"));
+    for (const QString &prefix : chunks.entryList(QDir::Dirs | QDir::NoDotAndDotDot))
+    {
+        QDir bucket(chunks.filePath(prefix));
+        for (const QString &hash : bucket.entryList(QDir::Files))
+        {
+            if (!live.contains(hash))
+            {
+                bucket.remove(hash);
+            }
+        }
+    }
+    return remove;
+}
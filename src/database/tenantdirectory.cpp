@@ -0,0 +1,193 @@
+#include "database/tenantdirectory.h"
+#include "database/database.h"
+#include "utils/tracer.h"
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QRegularExpression>
+#include <QSettings>
+#include <QSqlError>
+#include <QSqlQuery>
+
+TenantDirectory::TenantDirectory(const QString &rootDirectory, QObject *parent)
+    : QObject(parent), rootDirectory(rootDirectory)
+{
+}
+
+TenantDirectory::~TenantDirectory()
+{
+    if (hub.isValid())
+    {
+        const QString connectionName = hub.connectionName();
+        hub.close();
+        hub = QSqlDatabase();
+        QSqlDatabase::removeDatabase(connectionName);
+    }
+}
+
+QString TenantDirectory::defaultRoot()
+{
+    const QString fromEnvironment = qEnvironmentVariable("CAMPUS_TENANT_DIR");
+    if (!fromEnvironment.isEmpty())
+    {
+        return fromEnvironment;
+    }
+    QSettings settings("BMCC", "CampusHire");
+    return settings.value("database/tenant_dir", "tenants").toString();
+}
+
+bool TenantDirectory::isValidTenantId(const QString &tenantId)
+{
+    static const QRegularExpression pattern("^[a-z0-9_-]{1,32}$");
+    return pattern.match(tenantId).hasMatch();
+}
+
+QString TenantDirectory::pathFor(const QString &tenantId) const
+{
+    return QDir(rootDirectory).filePath(tenantId + ".db");
+}
+
+QStringList TenantDirectory::tenantIds() const
+{
+    QStringList ids;
+    for (const QFileInfo &file : QDir(rootDirectory).entryInfoList({"*.db"}, QDir::Files, QDir::Name))
+    {
+        if (isValidTenantId(file.completeBaseName()))
+        {
+            ids << file.completeBaseName();
+        }
+    }
+    return ids;
+}
+
+Database *TenantDirectory::tenant(const QString &tenantId)
+{
+    if (!isValidTenantId(tenantId))
+    {
+        qDebug() << "Invalid tenant id:" << tenantId;
+        return nullptr;
+    }
+    auto it = openTenants.constFind(tenantId);
+    if (it != openTenants.constEnd())
+    {
+        return it.value();
+    }
+
+    TRACE_SCOPE("db", "TenantDirectory::tenant");
+    QDir().mkpath(rootDirectory);
+    const QString connectionName = QString("tenant-%1@%2").arg(tenantId, QDir(rootDirectory).absolutePath());
+    auto *database = new Database(pathFor(tenantId), connectionName, this);
+    if (!database->connectToDatabase())
+    {
+        qDebug() << "Failed to open tenant" << tenantId;
+        delete database;
+        return nullptr;
+    }
+    openTenants.insert(tenantId, database);
+    return database;
+}
+
+void TenantDirectory::closeTenant(const QString &tenantId)
+{
+    delete openTenants.take(tenantId);
+}
+
+QString TenantDirectory::schemaFor(const QString &tenantId) const
+{
+    // Ids are validated, so quoting is enough to allow '-'
+    return "\"t_" + tenantId + "\"";
+}
+
+bool TenantDirectory::openHub()
+{
+    if (hub.isOpen())
+    {
+        return true;
+    }
+    hub = QSqlDatabase::addDatabase("QSQLITE", QString("tenant-hub@%1").arg(QDir(rootDirectory).absolutePath()));
+    hub.setDatabaseName(":memory:");
+    if (!hub.open())
+    {
+        qDebug() << "Error opening tenant report connection:" << hub.lastError().text();
+        return false;
+    }
+    return true;
+}
+
+bool TenantDirectory::attach(const QString &tenantId, const QStringList &pinned)
+{
+    const int index = attached.indexOf(tenantId);
+    if (index >= 0)
+    {
+        attached.move(index, attached.size() - 1);
+        return true;
+    }
+
+    QSqlQuery query(hub);
+    if (attached.size() >= kMaxAttached)
+    {
+        for (int i = 0; i < attached.size(); ++i)
+        {
+            if (!pinned.contains(attached.at(i)))
+            {
+                query.exec("DETACH DATABASE " + schemaFor(attached.at(i)));
+                attached.removeAt(i);
+                break;
+            }
+        }
+    }
+
+    query.prepare("ATTACH DATABASE ? AS " + schemaFor(tenantId));
+    query.addBindValue(pathFor(tenantId));
+    if (!query.exec())
+    {
+        qDebug() << "Error attaching tenant" << tenantId << ":" << query.lastError().text();
+        return false;
+    }
+    attached << tenantId;
+    return true;
+}
+
+bool TenantDirectory::crossTenantQuery(const QString &perTenantSelect, const QStringList &tenantIds,
+                                       const std::function<void(const QSqlQuery &)> &visitRow)
+{
+    TRACE_SCOPE("db", "TenantDirectory::crossTenantQuery");
+    if (!openHub())
+    {
+        return false;
+    }
+
+    for (int start = 0; start < tenantIds.size(); start += kMaxAttached)
+    {
+        const QStringList batch = tenantIds.mid(start, kMaxAttached);
+        QStringList selects;
+        for (const QString &tenantId : batch)
+        {
+            if (!isValidTenantId(tenantId) || !QFile::exists(pathFor(tenantId)) || !attach(tenantId, batch))
+            {
+                qDebug() << "Skipping unknown tenant" << tenantId;
+                continue;
+            }
+            selects << QString("SELECT '%1' AS tenant, * FROM (%2)")
+                           .arg(tenantId, QString(perTenantSelect).arg(schemaFor(tenantId)));
+        }
+        if (selects.isEmpty())
+        {
+            continue;
+        }
+
+        QSqlQuery query(hub);
+        query.setForwardOnly(true);
+        if (!query.exec(selects.join(" UNION ALL ")))
+        {
+            qDebug() << "Cross-tenant query failed:" << query.lastError().text();
+            return false;
+        }
+        while (query.next())
+        {
+            visitRow(query);
+        }
+    }
+    return true;
+}
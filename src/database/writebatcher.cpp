@@ -0,0 +1,86 @@
+#include "database/writebatcher.h"
+#include "utils/tracer.h"
+#include <QDebug>
+#include <QSqlDatabase>
+#include <QSqlError>
+#include <utility>
+
+WriteBatcher::WriteBatcher(const QString &connectionName)
+    : connectionName(connectionName), maxBatch(kDefaultMaxBatch), flushing(false)
+{
+    timer.setSingleShot(true);
+    timer.setInterval(kDefaultWindowMs);
+    QObject::connect(&timer, &QTimer::timeout, [this]()
+                     { flush(); });
+}
+
+void WriteBatcher::enqueue(Write write, Callback done)
+{
+    queue.push_back({std::move(write), std::move(done)});
+    if (static_cast<int>(queue.size()) >= maxBatch)
+    {
+        flush();
+    }
+    else if (!timer.isActive())
+    {
+        timer.start();
+    }
+}
+
+bool WriteBatcher::flush()
+{
+    timer.stop();
+    // Reads made by a write land here again; they see its own transaction
+    if (queue.empty() || flushing)
+    {
+        return true;
+    }
+
+    TRACE_SCOPE("db", "WriteBatcher::flush");
+    QSqlDatabase db = QSqlDatabase::database(connectionName, false);
+    if (!db.transaction())
+    {
+        // Someone else's transaction is open; try again after it
+        qDebug() << "Write batch postponed:" << db.lastError().text();
+        timer.start();
+        return false;
+    }
+
+    flushing = true;
+    std::vector<Pending> batch;
+    batch.swap(queue);
+    std::vector<char> written(batch.size());
+    for (size_t i = 0; i < batch.size(); ++i)
+    {
+        written[i] = batch[i].write() ? 1 : 0;
+    }
+    const bool committed = db.commit();
+    if (!committed)
+    {
+        qDebug() << "Error committing write batch:" << db.lastError().text();
+        db.rollback();
+    }
+    flushing = false;
+    if (!queue.empty())
+    {
+        timer.start(); // queued by the writes themselves
+    }
+
+    bool ok = committed;
+    totals.batches++;
+    totals.writes += batch.size();
+    for (size_t i = 0; i < batch.size(); ++i)
+    {
+        const bool durable = committed && written[i];
+        ok = ok && durable;
+        if (!durable)
+        {
+            totals.failedWrites++;
+        }
+        if (batch[i].done)
+        {
+            batch[i].done(durable);
+        }
+    }
+    return ok;
+}
@@ -1,23 +1,89 @@
 #include <QApplication>
 #include <QDebug>
+#include <QDir>
 #include <QSharedPointer>
+#include <QTimer>
 #include "auth/loginwindow.h"
 #include "auth/registerwindow.h"
 #include "ui/mainwindow.h"
+#include "ui/thememanager.h"
 #include "database/database.h"
+#include "database/tenantdirectory.h"
+#include "services/jobstatusscheduler.h"
+#include "services/notificationdispatcher.h"
+#include "utils/tracer.h"
 
 int main(int argc, char *argv[])
 {
     QApplication a(argc, argv);
 
+    // One palette and one style sheet for every window
+    ThemeManager::install(a);
+
+    // CAMPUS_TRACE=<file.json> records UI/DB spans for Perfetto
+    if (Tracer::instance().enableFromEnvironment())
+    {
+        QObject::connect(&a, &QCoreApplication::aboutToQuit, []()
+                         { Tracer::instance().writeChromeTrace(); });
+    }
+
+    // CAMPUS_TENANT=<campus> runs against that campus's file in the tenant
+    // directory; otherwise the configured single database is used
+    QString databasePath = Database::defaultDatabasePath();
+    const QString tenantId = qEnvironmentVariable("CAMPUS_TENANT");
+    if (!tenantId.isEmpty())
+    {
+        if (!TenantDirectory::isValidTenantId(tenantId))
+        {
+            qDebug() << "Invalid CAMPUS_TENANT" << tenantId;
+            return -1;
+        }
+        const TenantDirectory tenants(TenantDirectory::defaultRoot());
+        QDir().mkpath(tenants.root());
+        databasePath = tenants.pathFor(tenantId);
+    }
+
     // Initialize database with shared pointer for better memory management
-    QSharedPointer<Database> db(new Database());
+    QSharedPointer<Database> db(new Database(databasePath, QSqlDatabase::defaultConnection));
     if (!db->connectToDatabase())
     {
         qDebug() << "Failed to connect to database";
         return -1;
     }
 
+    // "Notify me when it opens" goes to the outbox table, or to a spool
+    // directory when CAMPUS_NOTIFY_SPOOL is set
+    const QString spoolDir = qEnvironmentVariable("CAMPUS_NOTIFY_SPOOL");
+    std::unique_ptr<NotificationSink> sink;
+    if (spoolDir.isEmpty())
+        sink.reset(new OutboxTableSink(db.data()));
+    else
+        sink.reset(new FileSpoolSink(spoolDir));
+    NotificationDispatcher notifier(db.data(), std::move(sink));
+
+    // Opens and closes jobs as their open dates and deadlines pass
+    JobStatusScheduler statusScheduler(db.data());
+    QObject::connect(&statusScheduler, &JobStatusScheduler::jobStatusChanged,
+                     &notifier, &NotificationDispatcher::onJobStatusChanged);
+    statusScheduler.start();
+
+    // CAMPUS_SNAPSHOT_MINUTES=<n> takes a background snapshot every n minutes
+    QTimer snapshotTimer;
+    const int snapshotMinutes = qEnvironmentVariableIntValue("CAMPUS_SNAPSHOT_MINUTES");
+    if (snapshotMinutes > 0)
+    {
+        auto logSnapshot = [](bool ok, const SnapshotInfo &info)
+        {
+            if (ok)
+                qDebug() << "Snapshot" << info.id << "stored" << info.newChunks << "new chunk(s)";
+            else
+                qDebug() << "Scheduled snapshot failed";
+        };
+        QObject::connect(&snapshotTimer, &QTimer::timeout, db.data(), [db, logSnapshot]()
+                         { db->createSnapshotAsync("scheduled", db.data(), logSnapshot); });
+        snapshotTimer.start(snapshotMinutes * 60 * 1000);
+    }
+
     // Create windows using shared pointers
     QSharedPointer<LoginWindow> loginWindow(new LoginWindow(db.data()));
     QSharedPointer<RegisterWindow> registerWindow(new RegisterWindow(db.data()));
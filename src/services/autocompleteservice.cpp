@@ -0,0 +1,174 @@
+#include "services/autocompleteservice.h"
+#include "utils/tracer.h"
+#include <QCoreApplication>
+#include <QDebug>
+#include <QPointer>
+#include <QRegularExpression>
+#include <QSqlError>
+#include <QSqlQuery>
+#include <QThreadPool>
+#include <atomic>
+
+namespace
+{
+    // A title is what students usually type, a past query is a strong hint
+    const quint32 kTitleWeight = 4;
+    const quint32 kDepartmentWeight = 2;
+    const quint32 kSkillWeight = 1;
+    const quint32 kHistoryWeight = 3;
+    const int kHistoryLimit = 5000;
+
+    std::atomic_int autocompleteConnectionCounter{0};
+
+    // "Library Assistant" is also reachable by typing "assistant"
+    void addWithWordStarts(std::vector<CompletionTrie::Entry> &entries, const QString &text, quint32 weight)
+    {
+        const QString display = text.simplified();
+        if (display.isEmpty())
+        {
+            return;
+        }
+        entries.push_back({display, display, weight});
+        for (int i = display.indexOf(' '); i >= 0; i = display.indexOf(' ', i + 1))
+        {
+            entries.push_back({display.mid(i + 1), display, weight});
+        }
+    }
+}
+
+AutocompleteService::AutocompleteService(Database *db, QObject *parent)
+    : QObject(parent), database(db), building(false), rebuildPending(false), queriesSinceRebuild(0)
+{
+    connect(database, &Database::jobsChanged, this, &AutocompleteService::rebuildAsync);
+}
+
+std::shared_ptr<const CompletionTrie> AutocompleteService::currentTrie() const
+{
+    return std::atomic_load(&trie);
+}
+
+QStringList AutocompleteService::suggest(const QString &prefix, int limit) const
+{
+    const auto current = currentTrie();
+    return current ? current->complete(prefix, limit) : QStringList();
+}
+
+void AutocompleteService::recordQuery(const QString &text)
+{
+    if (database->recordSearchQuery(text) && ++queriesSinceRebuild >= kHistoryRebuildEvery)
+    {
+        rebuildAsync();
+    }
+}
+
+std::vector<CompletionTrie::Entry> AutocompleteService::collectEntries(const QSqlDatabase &db)
+{
+    TRACE_SCOPE("db", "AutocompleteService::collectEntries");
+    std::vector<CompletionTrie::Entry> entries;
+    QSqlQuery query(db);
+    query.setForwardOnly(true);
+
+    if (!query.exec("SELECT title, department, skills FROM jobs"))
+    {
+        qDebug() << "Error reading jobs for autocomplete:" << query.lastError().text();
+        return entries;
+    }
+    static const QRegularExpression skillSeparator("[,;\\n]");
+    while (query.next())
+    {
+        addWithWordStarts(entries, query.value(0).toString(), kTitleWeight);
+        addWithWordStarts(entries, query.value(1).toString(), kDepartmentWeight);
+        for (const QString &skill : query.value(2).toString().split(skillSeparator, Qt::SkipEmptyParts))
+        {
+            const QString trimmed = skill.simplified();
+            if (!trimmed.isEmpty())
+            {
+                entries.push_back({trimmed, trimmed, kSkillWeight});
+            }
+        }
+    }
+
+    query.prepare("SELECT query, uses FROM search_history ORDER BY uses DESC LIMIT ?");
+    query.addBindValue(kHistoryLimit);
+    if (!query.exec())
+    {
+        qDebug() << "Error reading search history:" << query.lastError().text();
+        return entries;
+    }
+    while (query.next())
+    {
+        const QString text = query.value(0).toString();
+        entries.push_back({text, text, kHistoryWeight * query.value(1).toUInt()});
+    }
+    return entries;
+}
+
+void AutocompleteService::publish(std::shared_ptr<const CompletionTrie> built)
+{
+    const int entries = built->size();
+    std::atomic_store(&trie, std::move(built));
+    emit rebuilt(entries);
+}
+
+void AutocompleteService::rebuildNow()
+{
+    TRACE_SCOPE("db", "AutocompleteService::rebuildNow");
+    queriesSinceRebuild = 0;
+    publish(std::make_shared<const CompletionTrie>(CompletionTrie::build(collectEntries(database->connection()))));
+}
+
+void AutocompleteService::rebuildAsync()
+{
+    if (building)
+    {
+        rebuildPending = true;
+        return;
+    }
+    const QString databasePath = database->databasePath();
+    if (databasePath.isEmpty() || databasePath == ":memory:")
+    {
+        rebuildNow(); // a private connection would not see this database
+        return;
+    }
+
+    building = true;
+    rebuildPending = false;
+    queriesSinceRebuild = 0;
+    QPointer<AutocompleteService> guard(this);
+    QThreadPool::globalInstance()->start([guard, databasePath]()
+                                         {
+        std::shared_ptr<const CompletionTrie> built;
+        const QString connection = QString("autocomplete-%1").arg(++autocompleteConnectionCounter);
+        {
+            QSqlDatabase source = QSqlDatabase::addDatabase("QSQLITE", connection);
+            source.setDatabaseName(databasePath);
+            source.setConnectOptions("QSQLITE_OPEN_READONLY;QSQLITE_BUSY_TIMEOUT=5000");
+            if (source.open())
+            {
+                built = std::make_shared<const CompletionTrie>(CompletionTrie::build(collectEntries(source)));
+                source.close();
+            }
+            else
+            {
+                qDebug() << "Error opening autocomplete connection:" << source.lastError().text();
+            }
+        }
+        QSqlDatabase::removeDatabase(connection);
+
+        // guard is only dereferenced back on the thread that owns the service
+        QMetaObject::invokeMethod(QCoreApplication::instance(), [guard, built]()
+                                  {
+            if (!guard)
+            {
+                return;
+            }
+            guard->building = false;
+            if (built)
+            {
+                guard->publish(built);
+            }
+            if (guard->rebuildPending)
+            {
+                guard->rebuildAsync();
+            } }, Qt::QueuedConnection); });
+}
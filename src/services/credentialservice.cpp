@@ -0,0 +1,318 @@
+#include "services/credentialservice.h"
+#include "utils/passwordkdf.h"
+#include "utils/tracer.h"
+#include <QCryptographicHash>
+#include <QElapsedTimer>
+#include <QMessageAuthenticationCode>
+#include <QMutexLocker>
+#include <QPointer>
+#include <QSettings>
+#include <QThread>
+#include <cctype>
+
+namespace
+{
+    constexpr int kSaltBytes = 16;
+    constexpr int kKeyBytes = 32;
+    constexpr int kMinLogN = 10;
+    // scrypt holds 128 * r * 2^logN bytes: 64 MiB at logN=16 with r=8
+    constexpr int kMaxLogN = 16;
+    // Ceilings for cost parameters read back from stored hashes, so a
+    // tampered row cannot make one login allocate more than that or spin for minutes
+    constexpr int kMaxR = 8;
+    constexpr int kMaxP = 4;
+    constexpr int kMaxKeyBytes = 64;
+
+    bool parseScryptHash(const QString &stored, KdfParams &params, QByteArray &salt, QByteArray &key)
+    {
+        // "$scrypt$ln=14,r=8,p=1$<salt>$<hash>" splits into 5 parts
+        const QStringList parts = stored.split('$');
+        if (parts.size() != 5 || parts.at(1) != "scrypt")
+        {
+            return false;
+        }
+
+        for (const QString &pair : parts.at(2).split(','))
+        {
+            const QString name = pair.section('=', 0, 0);
+            bool ok = false;
+            const int value = pair.section('=', 1, 1).toInt(&ok);
+            if (!ok)
+                return false;
+            if (name == "ln")
+                params.logN = value;
+            else if (name == "r")
+                params.r = value;
+            else if (name == "p")
+                params.p = value;
+        }
+        if (params.logN < kMinLogN || params.logN > kMaxLogN || params.r < 1 || params.r > kMaxR ||
+            params.p < 1 || params.p > kMaxP)
+        {
+            return false;
+        }
+
+        salt = QByteArray::fromBase64(parts.at(3).toLatin1());
+        key = QByteArray::fromBase64(parts.at(4).toLatin1());
+        return !salt.isEmpty() && !key.isEmpty() && key.size() <= kMaxKeyBytes;
+    }
+}
+
+CredentialService::CredentialService(QObject *parent)
+    : QObject(parent), kdfParams(configuredParams()), processKey(PasswordKdf::randomSalt(32))
+{
+    // Half the cores, at most four: each in-flight hash holds a 16 MiB buffer
+    setMaxConcurrentHashes(qBound(1, QThread::idealThreadCount() / 2, 4));
+    pool.setExpiryTimeout(30000);
+}
+
+CredentialService::~CredentialService()
+{
+    pool.waitForDone();
+}
+
+void CredentialService::setMaxConcurrentHashes(int count)
+{
+    pool.setMaxThreadCount(qMax(1, count));
+}
+
+QString CredentialService::hashPassword(const QString &password, const KdfParams &params)
+{
+    TRACE_SCOPE("auth", "CredentialService::hashPassword");
+    const QByteArray salt = PasswordKdf::randomSalt(kSaltBytes);
+    const QByteArray key = PasswordKdf::scrypt(password.toUtf8(), salt,
+                                               params.logN, params.r, params.p, kKeyBytes);
+    return QString("$scrypt$ln=%1,r=%2,p=%3$")
+               .arg(params.logN)
+               .arg(params.r)
+               .arg(params.p) +
+           QString::fromLatin1(salt.toBase64(QByteArray::OmitTrailingEquals)) + "$" +
+           QString::fromLatin1(key.toBase64(QByteArray::OmitTrailingEquals));
+}
+
+bool CredentialService::isLegacyHash(const QString &stored)
+{
+    if (stored.size() != 64)
+    {
+        return false;
+    }
+    for (const QChar c : stored)
+    {
+        if (!std::isxdigit(static_cast<unsigned char>(c.toLatin1())))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool CredentialService::verifyPassword(const QString &password, const QString &stored,
+                                       const KdfParams &current, bool *needsRehash)
+{
+    TRACE_SCOPE("auth", "CredentialService::verifyPassword");
+    if (needsRehash)
+    {
+        *needsRehash = false;
+    }
+
+    if (stored.isEmpty())
+    {
+        // Unknown account: burn the same work as a real check
+        PasswordKdf::scrypt(password.toUtf8(), PasswordKdf::randomSalt(kSaltBytes),
+                            current.logN, current.r, current.p, kKeyBytes);
+        return false;
+    }
+
+    if (isLegacyHash(stored))
+    {
+        // Unsalted SHA-256 rows from before the scrypt migration
+        const QByteArray digest = QCryptographicHash::hash(password.toUtf8(), QCryptographicHash::Sha256).toHex();
+        const bool ok = PasswordKdf::constantTimeEquals(digest, stored.toLatin1().toLower());
+        if (ok && needsRehash)
+        {
+            *needsRehash = true;
+        }
+        return ok;
+    }
+
+    KdfParams params;
+    QByteArray salt;
+    QByteArray expected;
+    if (!parseScryptHash(stored, params, salt, expected))
+    {
+        return false;
+    }
+
+    const QByteArray derived = PasswordKdf::scrypt(password.toUtf8(), salt,
+                                                   params.logN, params.r, params.p, expected.size());
+    const bool ok = PasswordKdf::constantTimeEquals(derived, expected);
+    if (ok && needsRehash)
+    {
+        *needsRehash = (params != current);
+    }
+    return ok;
+}
+
+bool CredentialService::verifyBlocking(const QString &email, const QString &password,
+                                       const QString &stored, QString *rehash)
+{
+    if (!stored.isEmpty() && cacheLookup(email, password, stored))
+    {
+        return true;
+    }
+
+    bool needsRehash = false;
+    const KdfParams current = kdfParams;
+    const bool ok = verifyPassword(password, stored, current, &needsRehash);
+    if (ok)
+    {
+        QString upgraded;
+        if (needsRehash)
+        {
+            upgraded = hashPassword(password, current);
+            if (rehash)
+            {
+                *rehash = upgraded;
+            }
+        }
+        cacheInsert(email, password, upgraded.isEmpty() ? stored : upgraded);
+    }
+    return ok;
+}
+
+void CredentialService::hashAsync(const QString &password, QObject *context,
+                                  std::function<void(const QString &hash)> done)
+{
+    const KdfParams current = kdfParams;
+    QPointer<QObject> guard(context);
+    pool.start([this, password, current, guard, done]()
+               {
+        const QString hash = hashPassword(password, current);
+        QMetaObject::invokeMethod(this, [guard, done, hash]()
+                                  {
+            if (guard)
+            {
+                done(hash);
+            } }, Qt::QueuedConnection); });
+}
+
+void CredentialService::verifyAsync(const QString &email, const QString &password, const QString &stored,
+                                    QObject *context, std::function<void(bool ok, const QString &rehash)> done)
+{
+    QPointer<QObject> guard(context);
+    if (!stored.isEmpty() && cacheLookup(email, password, stored))
+    {
+        // Cache hit: still deliver asynchronously so callers see one code path
+        QMetaObject::invokeMethod(this, [guard, done]()
+                                  {
+            if (guard)
+            {
+                done(true, QString());
+            } }, Qt::QueuedConnection);
+        return;
+    }
+
+    pool.start([this, email, password, stored, guard, done]()
+               {
+        QString rehash;
+        const bool ok = verifyBlocking(email, password, stored, &rehash);
+        QMetaObject::invokeMethod(this, [guard, done, ok, rehash]()
+                                  {
+            if (guard)
+            {
+                done(ok, rehash);
+            } }, Qt::QueuedConnection); });
+}
+
+void CredentialService::forgetLogin(const QString &email)
+{
+    QMutexLocker locker(&cacheMutex);
+    auto it = loginCache.find(email);
+    if (it != loginCache.end())
+    {
+        cacheOrder.erase(it->second);
+        loginCache.erase(it);
+    }
+}
+
+QByteArray CredentialService::passwordTag(const QString &password) const
+{
+    return QMessageAuthenticationCode::hash(password.toUtf8(), processKey, QCryptographicHash::Sha256);
+}
+
+bool CredentialService::cacheLookup(const QString &email, const QString &password, const QString &stored)
+{
+    const QByteArray tag = passwordTag(password);
+    QMutexLocker locker(&cacheMutex);
+    auto it = loginCache.find(email);
+    if (it == loginCache.end() || it->first.storedHash != stored ||
+        !PasswordKdf::constantTimeEquals(it->first.passwordTag, tag))
+    {
+        return false;
+    }
+    cacheOrder.splice(cacheOrder.begin(), cacheOrder, it->second);
+    return true;
+}
+
+void CredentialService::cacheInsert(const QString &email, const QString &password, const QString &stored)
+{
+    const QByteArray tag = passwordTag(password);
+    QMutexLocker locker(&cacheMutex);
+    auto it = loginCache.find(email);
+    if (it != loginCache.end())
+    {
+        cacheOrder.erase(it->second);
+        loginCache.erase(it);
+    }
+
+    cacheOrder.push_front(email);
+    loginCache.insert(email, {CachedLogin{stored, tag}, cacheOrder.begin()});
+
+    while (static_cast<int>(cacheOrder.size()) > kLoginCacheSize)
+    {
+        loginCache.remove(cacheOrder.back());
+        cacheOrder.pop_back();
+    }
+}
+
+KdfParams CredentialService::calibrate(int targetMs, const KdfParams &base, QStringList *report)
+{
+    KdfParams best = base;
+    best.logN = kMinLogN;
+
+    for (int logN = kMinLogN; logN <= kMaxLogN; ++logN)
+    {
+        KdfParams probe = base;
+        probe.logN = logN;
+
+        QElapsedTimer timer;
+        timer.start();
+        hashPassword(QStringLiteral("calibration-password"), probe);
+        const qint64 elapsed = timer.elapsed();
+
+        if (report)
+        {
+            *report << QString("logN=%1 %2 ms").arg(logN).arg(elapsed);
+        }
+        if (elapsed > targetMs)
+        {
+            break;
+        }
+        best = probe;
+    }
+    return best;
+}
+
+KdfParams CredentialService::configuredParams()
+{
+    QSettings settings("BMCC", "CampusHire");
+    KdfParams params;
+    params.logN = qBound(kMinLogN, settings.value("security/kdf_log_n", params.logN).toInt(), kMaxLogN);
+    return params;
+}
+
+void CredentialService::saveConfiguredParams(const KdfParams &params)
+{
+    QSettings settings("BMCC", "CampusHire");
+    settings.setValue("security/kdf_log_n", params.logN);
+}
@@ -0,0 +1,317 @@
+#include "services/draftautosaver.h"
+#include "utils/tracer.h"
+#include <QCoreApplication>
+#include <QDebug>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QPointer>
+#include <QSqlError>
+#include <QThreadPool>
+#include <QTimer>
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <utility>
+
+// Writes waiting for one draft. pending collects new changes while the
+// writer task holds the batch it is committing in inFlight.
+struct DraftWriteQueue
+{
+    QString databasePath;
+    int userId = 0;
+    int jobId = 0;
+
+    QMutex mutex;
+    QHash<QString, QString> pending;
+    bool pendingClear = false;
+    QHash<QString, QString> inFlight;
+    bool inFlightClear = false;
+    bool running = false;
+    int failures = 0; // consecutive failed batches, for the retry backoff
+    QPointer<DraftAutosaver> listener; // last autosaver that queued a write
+};
+
+namespace
+{
+    std::atomic_int draftConnectionCounter{0};
+    // Failed writes are retried after 1 s, doubling up to a minute
+    constexpr int kRetryBaseMs = 1000;
+    constexpr int kRetryMaxMs = 60000;
+
+    QMutex registryMutex;
+    QHash<QString, std::weak_ptr<DraftWriteQueue>> registry;
+
+    // Autosavers of the same draft share its queue so writes stay ordered
+    std::shared_ptr<DraftWriteQueue> queueFor(const QString &databasePath, int userId, int jobId)
+    {
+        const QString key = QString("%1|%2|%3").arg(databasePath).arg(userId).arg(jobId);
+        QMutexLocker locker(&registryMutex);
+        std::shared_ptr<DraftWriteQueue> queue = registry.value(key).lock();
+        if (!queue)
+        {
+            for (auto it = registry.begin(); it != registry.end();)
+            {
+                it = it.value().expired() ? registry.erase(it) : std::next(it);
+            }
+            queue = std::make_shared<DraftWriteQueue>();
+            queue->databasePath = databasePath;
+            queue->userId = userId;
+            queue->jobId = jobId;
+            registry.insert(key, queue);
+        }
+        return queue;
+    }
+
+    // Newer changes win; a clear drops everything queued before it
+    void mergeInto(QHash<QString, QString> &target, bool &targetClear,
+                   const QHash<QString, QString> &fields, bool clear)
+    {
+        if (clear)
+        {
+            target.clear();
+            targetClear = true;
+        }
+        for (auto it = fields.constBegin(); it != fields.constEnd(); ++it)
+        {
+            target.insert(it.key(), it.value());
+        }
+    }
+
+    void notify(const QPointer<DraftAutosaver> &listener, bool ok)
+    {
+        // listener is only dereferenced back on the thread that owns it
+        QMetaObject::invokeMethod(QCoreApplication::instance(), [listener, ok]()
+                                  {
+            if (!listener)
+            {
+                return;
+            }
+            if (ok)
+            {
+                emit listener->saved(QDateTime::currentDateTime());
+            }
+            else
+            {
+                emit listener->saveFailed();
+            } }, Qt::QueuedConnection);
+    }
+
+    void drain(std::shared_ptr<DraftWriteQueue> queue);
+
+    // Starts a writer task unless one is running or nothing is queued
+    void startDrain(const std::shared_ptr<DraftWriteQueue> &queue)
+    {
+        {
+            QMutexLocker locker(&queue->mutex);
+            if (queue->running || (queue->pending.isEmpty() && !queue->pendingClear))
+            {
+                return;
+            }
+            queue->running = true;
+        }
+        QThreadPool::globalInstance()->start([queue]()
+                                             { drain(queue); });
+    }
+
+    // Re-arms the writer after a failure, so the last edits are saved even
+    // if the user stops typing; the timer runs on the application thread
+    void scheduleRetry(const std::shared_ptr<DraftWriteQueue> &queue, int failures)
+    {
+        const int delay = std::min(kRetryMaxMs, kRetryBaseMs << std::min(failures - 1, 6));
+        QMetaObject::invokeMethod(QCoreApplication::instance(), [queue, delay]()
+                                  {
+            QTimer::singleShot(delay, QCoreApplication::instance(), [queue]()
+                               { startDrain(queue); }); }, Qt::QueuedConnection);
+    }
+
+    // Commits batches until the queue is empty. On failure the batch goes
+    // back under newer changes, the task stops and a retry is scheduled.
+    void drain(std::shared_ptr<DraftWriteQueue> queue)
+    {
+        const QString connection = QString("drafts-%1").arg(++draftConnectionCounter);
+        {
+            QSqlDatabase target = QSqlDatabase::addDatabase("QSQLITE", connection);
+            target.setDatabaseName(queue->databasePath);
+            target.setConnectOptions("QSQLITE_BUSY_TIMEOUT=5000");
+            const bool opened = target.open();
+            if (!opened)
+            {
+                qDebug() << "Error opening draft connection:" << target.lastError().text();
+            }
+
+            for (;;)
+            {
+                QPointer<DraftAutosaver> listener;
+                {
+                    QMutexLocker locker(&queue->mutex);
+                    if (queue->pending.isEmpty() && !queue->pendingClear)
+                    {
+                        queue->running = false;
+                        break;
+                    }
+                    queue->inFlight.swap(queue->pending);
+                    queue->inFlightClear = queue->pendingClear;
+                    queue->pendingClear = false;
+                    listener = queue->listener;
+                }
+
+                const bool ok = opened && Database::writeApplicationDraft(target, queue->userId, queue->jobId,
+                                                                          queue->inFlight, queue->inFlightClear);
+                int failures = 0;
+                {
+                    QMutexLocker locker(&queue->mutex);
+                    failures = ok ? 0 : queue->failures + 1;
+                    queue->failures = failures;
+                    if (!ok)
+                    {
+                        QHash<QString, QString> newer;
+                        newer.swap(queue->pending);
+                        bool newerClear = queue->pendingClear;
+                        queue->pending.swap(queue->inFlight);
+                        queue->pendingClear = queue->inFlightClear;
+                        mergeInto(queue->pending, queue->pendingClear, newer, newerClear);
+                        queue->running = false;
+                    }
+                    queue->inFlight.clear();
+                    queue->inFlightClear = false;
+                }
+                notify(listener, ok);
+                if (!ok)
+                {
+                    scheduleRetry(queue, failures);
+                    break;
+                }
+            }
+            target.close();
+        }
+        QSqlDatabase::removeDatabase(connection);
+    }
+}
+
+DraftAutosaver::DraftAutosaver(Database *db, int userId, int jobId, QObject *parent)
+    : QObject(parent), database(db), userId(userId), jobId(jobId)
+{
+    const QString databasePath = database->databasePath();
+    if (!databasePath.isEmpty() && databasePath != ":memory:")
+    {
+        queue = queueFor(databasePath, userId, jobId);
+    }
+    debounce.setSingleShot(true);
+    connect(&debounce, &QTimer::timeout, this, &DraftAutosaver::flush);
+}
+
+void DraftAutosaver::addField(const QString &name, std::function<QString()> reader)
+{
+    readers.insert(name, std::move(reader));
+}
+
+QHash<QString, QString> DraftAutosaver::restore()
+{
+    TRACE_SCOPE("ui", "DraftAutosaver::restore");
+    // Queued writes are taken before reading so a batch committed in
+    // between is seen either way
+    QHash<QString, QString> inFlight;
+    QHash<QString, QString> pending;
+    bool inFlightClear = false;
+    bool pendingClear = false;
+    if (queue)
+    {
+        QMutexLocker locker(&queue->mutex);
+        inFlight = queue->inFlight;
+        inFlightClear = queue->inFlightClear;
+        pending = queue->pending;
+        pendingClear = queue->pendingClear;
+    }
+
+    QHash<QString, QString> fields = database->getApplicationDraft(userId, jobId);
+    bool cleared = false;
+    mergeInto(fields, cleared, inFlight, inFlightClear);
+    mergeInto(fields, cleared, pending, pendingClear);
+    for (auto it = fields.begin(); it != fields.end();)
+    {
+        it = it.value().isEmpty() ? fields.erase(it) : std::next(it);
+    }
+    lastQueued = fields;
+    return fields;
+}
+
+void DraftAutosaver::markChanged(const QString &name)
+{
+    if (!firstChange.isValid())
+    {
+        firstChange.start();
+    }
+    changed.insert(name);
+    // Keep pushing the save back while typing, but not past kMaxDelayMs
+    const qint64 left = kMaxDelayMs - firstChange.elapsed();
+    debounce.start(static_cast<int>(qBound<qint64>(0, left, kDebounceMs)));
+}
+
+void DraftAutosaver::flush()
+{
+    debounce.stop();
+    firstChange.invalidate();
+    QHash<QString, QString> fields;
+    for (const QString &name : std::as_const(changed))
+    {
+        const auto reader = readers.constFind(name);
+        if (reader == readers.constEnd())
+        {
+            continue;
+        }
+        const QString value = (*reader)();
+        if (value != lastQueued.value(name))
+        {
+            fields.insert(name, value);
+            lastQueued.insert(name, value);
+        }
+    }
+    changed.clear();
+    if (!fields.isEmpty())
+    {
+        enqueue(fields, false);
+    }
+}
+
+void DraftAutosaver::discard()
+{
+    debounce.stop();
+    firstChange.invalidate();
+    changed.clear();
+    lastQueued.clear();
+    enqueue({}, true);
+}
+
+void DraftAutosaver::enqueue(const QHash<QString, QString> &fields, bool clear)
+{
+    if (!queue)
+    {
+        // A private connection would not see an in-memory database
+        if (database->saveApplicationDraft(userId, jobId, fields, clear))
+        {
+            emit saved(QDateTime::currentDateTime());
+        }
+        else
+        {
+            emit saveFailed();
+        }
+        return;
+    }
+
+    {
+        QMutexLocker locker(&queue->mutex);
+        mergeInto(queue->pending, queue->pendingClear, fields, clear);
+        queue->listener = this;
+    }
+    startDrain(queue);
+}
+
+bool DraftAutosaver::isSaving() const
+{
+    if (!queue)
+    {
+        return false;
+    }
+    QMutexLocker locker(&queue->mutex);
+    return queue->running || !queue->pending.isEmpty() || queue->pendingClear;
+}
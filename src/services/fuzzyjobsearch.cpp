@@ -0,0 +1,119 @@
+#include "services/fuzzyjobsearch.h"
+#include "utils/tracer.h"
+#include <QSet>
+
+FuzzyJobSearch::FuzzyJobSearch(Database *db, QObject *parent)
+    : QObject(parent), database(db), built(false), indexedVersion(-1)
+{
+    connect(database, &Database::jobsChanged, this, &FuzzyJobSearch::refresh);
+}
+
+QStringList FuzzyJobSearch::searchableFields(const Job &job)
+{
+    return {job.getTitle(), job.getDepartment(), job.getSkills()};
+}
+
+void FuzzyJobSearch::rebuild()
+{
+    TRACE_SCOPE("db", "FuzzyJobSearch::rebuild");
+    // Read before the scan, so a write racing it is fetched again later
+    indexedVersion = database->jobsTableVersion();
+    index.clear();
+    jobs.clear();
+    database->forEachJob([this](const Job &job)
+                         {
+        index.upsert(job.getId(), searchableFields(job));
+        jobs.insert(job.getId(), job);
+        return true; });
+    built = true;
+}
+
+void FuzzyJobSearch::refresh()
+{
+    if (!built)
+    {
+        return; // nothing to keep in sync until the first search
+    }
+
+    TRACE_SCOPE("db", "FuzzyJobSearch::refresh");
+    const qint64 current = database->jobsTableVersion();
+    if (current >= 0 && current == indexedVersion)
+    {
+        return;
+    }
+    // A replaced database file can start over at a lower version
+    if (current < 0 || indexedVersion < 0 || current < indexedVersion)
+    {
+        rebuild();
+        return;
+    }
+
+    const std::vector<int> changed = database->changedJobIds(indexedVersion);
+    if (changed.size() > static_cast<size_t>(jobs.size() / 2))
+    {
+        rescan(); // one pass beats a lookup per row
+    }
+    else
+    {
+        for (int jobId : changed)
+        {
+            const Job job = database->getJobById(jobId);
+            if (job.getId() == jobId)
+                updateJob(job);
+            else
+                removeJob(jobId);
+        }
+    }
+    indexedVersion = current;
+}
+
+void FuzzyJobSearch::rescan()
+{
+    TRACE_SCOPE("db", "FuzzyJobSearch::rescan");
+    QSet<int> seen;
+    database->forEachJob([this, &seen](const Job &job)
+                         {
+        seen.insert(job.getId());
+        updateJob(job);
+        return true; });
+
+    const QList<int> indexed = jobs.keys();
+    for (int jobId : indexed)
+    {
+        if (!seen.contains(jobId))
+        {
+            removeJob(jobId);
+        }
+    }
+}
+
+void FuzzyJobSearch::updateJob(const Job &job)
+{
+    auto it = jobs.find(job.getId());
+    if (it == jobs.end() || searchableFields(it.value()) != searchableFields(job))
+    {
+        index.upsert(job.getId(), searchableFields(job));
+    }
+    jobs.insert(job.getId(), job);
+}
+
+void FuzzyJobSearch::removeJob(int jobId)
+{
+    index.remove(jobId);
+    jobs.remove(jobId);
+}
+
+std::vector<FuzzyJobSearch::Result> FuzzyJobSearch::search(const QString &query, int limit)
+{
+    if (!built)
+    {
+        rebuild();
+    }
+
+    std::vector<Result> results;
+    for (const TrigramIndex::Match &match : index.search(query, limit))
+    {
+        results.push_back({jobs.value(match.id), match.distance});
+    }
+    return results;
+}
@@ -0,0 +1,208 @@
+#include "services/interviewpractice.h"
+#include "utils/tracer.h"
+#include <QDebug>
+#include <QRandomGenerator>
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+InterviewPractice::InterviewPractice(Database *db, const QuestionBank *bank)
+    : database(db), questionBank(bank), currentUserId(-1)
+{
+}
+
+InterviewPractice::~InterviewPractice()
+{
+    flush();
+}
+
+void InterviewPractice::setUser(int userId, const QString &major)
+{
+    currentMajor = major;
+    if (userId == currentUserId)
+    {
+        return;
+    }
+
+    flush();
+    topics.clear();
+    asked.clear();
+    pending = PendingQuestion();
+    currentUserId = userId;
+    if (userId < 0 || !database)
+    {
+        return;
+    }
+
+    for (const TopicMastery &mastery : database->getInterviewMastery(userId))
+    {
+        TopicState &state = topics[mastery.topic];
+        state.ability = mastery.ability;
+        state.attempts = mastery.attempts;
+    }
+}
+
+double InterviewPractice::difficultyParameter(int level)
+{
+    // easy, medium and hard sit one logit apart around 0
+    return level - 1.0;
+}
+
+double InterviewPractice::probabilityCorrect(double ability, double difficulty)
+{
+    return 1.0 / (1.0 + std::exp(difficulty - ability));
+}
+
+double InterviewPractice::ability(const QString &topic) const
+{
+    return topics.value(QuestionBankFormat::normalizeTag(topic)).ability;
+}
+
+double InterviewPractice::expectedScore(const QString &topic) const
+{
+    return probabilityCorrect(ability(topic), difficultyParameter(1));
+}
+
+qint64 InterviewPractice::pickUnasked(const QString &topic, int level)
+{
+    const int count = questionBank->count(currentMajor, topic, level);
+    if (count == 0)
+    {
+        return -1;
+    }
+    // Random starting point, then a bounded walk past questions already asked
+    const int start = static_cast<int>(QRandomGenerator::global()->bounded(quint32(count)));
+    const int limit = std::min(count, kScanLimit);
+    for (int i = 0; i < limit; ++i)
+    {
+        const qint64 id = questionBank->questionId(currentMajor, topic, level, (start + i) % count);
+        if (id >= 0 && !asked.contains(quint32(id)))
+        {
+            return id;
+        }
+    }
+    return -1;
+}
+
+bool InterviewPractice::nextQuestion(const QString &topic, Question &question)
+{
+    TRACE_SCOPE("ui", "InterviewPractice::nextQuestion");
+    pending = PendingQuestion();
+    if (!questionBank || !questionBank->isOpen())
+    {
+        return false;
+    }
+
+    const QString key = QuestionBankFormat::normalizeTag(topic);
+    const double current = topics.value(key).ability;
+
+    // p * (1 - p) peaks where difficulty equals ability, so the most
+    // informative level is simply the nearest one
+    std::array<int, QuestionBankFormat::kDifficultyLevels> levels;
+    for (int level = 0; level < QuestionBankFormat::kDifficultyLevels; ++level)
+    {
+        levels[level] = level;
+    }
+    std::sort(levels.begin(), levels.end(), [current](int a, int b)
+              { return std::abs(difficultyParameter(a) - current) < std::abs(difficultyParameter(b) - current); });
+
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        for (int level : levels)
+        {
+            const qint64 id = pickUnasked(key, level);
+            if (id < 0)
+            {
+                continue;
+            }
+            asked.insert(quint32(id));
+            pending.valid = true;
+            pending.topic = key;
+            pending.id = quint32(id);
+            pending.difficulty = level;
+            question = questionBank->question(quint32(id));
+            return true;
+        }
+        // Every question of the topic has been asked; start over
+        asked.clear();
+    }
+    return false;
+}
+
+void InterviewPractice::recordAnswer(bool correct)
+{
+    if (!pending.valid)
+    {
+        return;
+    }
+    pending.valid = false;
+
+    TopicState &state = topics[pending.topic];
+    const double p = probabilityCorrect(state.ability, difficultyParameter(pending.difficulty));
+    // One Newton step on the log-likelihood. The information gathered so far
+    // (about 0.25 per answer, plus a unit prior) damps later corrections.
+    const double information = 1.0 + 0.25 * state.attempts;
+    state.ability = std::clamp(state.ability + ((correct ? 1.0 : 0.0) - p) / information, -kMaxAbility, kMaxAbility);
+    ++state.attempts;
+    state.dirty = true;
+
+    if (currentUserId < 0)
+    {
+        return;
+    }
+
+    InterviewAttempt attempt;
+    attempt.userId = currentUserId;
+    attempt.topic = pending.topic;
+    attempt.questionId = pending.id;
+    attempt.difficulty = pending.difficulty;
+    attempt.correct = correct;
+    attempt.ability = state.ability;
+    attempt.answeredAt = QDateTime::currentDateTimeUtc();
+    pendingAttempts.push_back(attempt);
+
+    if (static_cast<int>(pendingAttempts.size()) >= kBatchSize)
+    {
+        flush();
+    }
+}
+
+bool InterviewPractice::flush()
+{
+    if (!database || currentUserId < 0 || pendingAttempts.empty())
+    {
+        return true;
+    }
+    TRACE_SCOPE("db", "InterviewPractice::flush");
+
+    std::vector<TopicMastery> mastery;
+    for (auto it = topics.cbegin(); it != topics.cend(); ++it)
+    {
+        if (it->dirty)
+        {
+            mastery.push_back({it.key(), it->ability, it->attempts});
+        }
+    }
+
+    // Outside a transaction the attempts would autocommit one by one and
+    // the retry would insert them again
+    if (!database->beginTransaction())
+    {
+        qDebug() << "Cannot start a transaction for" << pendingAttempts.size() << "interview attempt(s); will retry";
+        return false;
+    }
+    if (!database->addInterviewAttempts(pendingAttempts) || !database->saveInterviewMastery(currentUserId, mastery) ||
+        !database->commitTransaction())
+    {
+        database->rollbackTransaction();
+        qDebug() << "Failed to save" << pendingAttempts.size() << "interview attempt(s); will retry";
+        return false;
+    }
+
+    pendingAttempts.clear();
+    for (auto it = topics.begin(); it != topics.end(); ++it)
+    {
+        it->dirty = false;
+    }
+    return true;
+}
@@ -0,0 +1,400 @@
+#include "services/interviewscheduler.h"
+#include "utils/tracer.h"
+#include <algorithm>
+#include <climits>
+#include <deque>
+
+InterviewScheduler::InterviewScheduler(int interviewMinutes, int rooms, int supervisorCapacity)
+    : windowSlots(qBound(1, (interviewMinutes + Availability::kSlotMinutes - 1) / Availability::kSlotMinutes,
+                         Availability::kSlotsPerDay)),
+      windowCount(Availability::kSlotsPerDay / windowSlots), rooms(qMax(1, rooms)),
+      supervisorCapacity(qMax(1, supervisorCapacity)), built(false), booked(0)
+{
+}
+
+int InterviewScheduler::addSupervisor(const QString &name, const Availability &calendar)
+{
+    built = false;
+    auto it = supervisorIndex.constFind(name);
+    if (it != supervisorIndex.constEnd())
+    {
+        calendars[*it] = calendar;
+        return *it;
+    }
+    const int index = supervisorNames.size();
+    supervisorNames << name;
+    supervisorIndex.insert(name, index);
+    calendars.push_back(calendar);
+    return index;
+}
+
+bool InterviewScheduler::addApplicant(int applicationId, const QString &supervisor, const Availability &availability)
+{
+    auto it = supervisorIndex.constFind(supervisor);
+    if (it == supervisorIndex.constEnd() || applicantIndex.contains(applicationId))
+    {
+        return false;
+    }
+    built = false;
+    applicantIndex.insert(applicationId, applicantCount());
+    applicants.push_back({applicationId, *it, availability});
+    return true;
+}
+
+int InterviewScheduler::load(Database *db)
+{
+    TRACE_SCOPE("db", "InterviewScheduler::load");
+    const QHash<QString, Availability> supervisorCalendars = db->getSupervisorCalendars();
+    for (auto it = supervisorCalendars.cbegin(); it != supervisorCalendars.cend(); ++it)
+    {
+        addSupervisor(it.key(), it.value());
+    }
+
+    const QHash<int, QString> jobSupervisors = db->getJobSupervisors();
+    int added = 0;
+    for (const ApplicantAvailability &applicant : db->getApplicantAvailability(-1))
+    {
+        if (addApplicant(applicant.applicationId, jobSupervisors.value(applicant.jobId), applicant.availability))
+        {
+            ++added;
+        }
+    }
+    return added;
+}
+
+bool InterviewScheduler::book(int applicationId, int day, int startMinute)
+{
+    if (!built)
+    {
+        build();
+    }
+    auto it = applicantIndex.constFind(applicationId);
+    const int offset = startMinute - Availability::kFirstMinute;
+    const int windowMinutes = windowSlots * Availability::kSlotMinutes;
+    if (it == applicantIndex.constEnd() || day < 0 || day >= Availability::kDays || offset < 0 ||
+        offset % windowMinutes != 0 || offset / windowMinutes >= windowCount)
+    {
+        return false;
+    }
+    const Applicant &applicant = applicants[*it];
+    const int window = offset / windowMinutes;
+    const int supervisorNode = supervisorNodes[(applicant.supervisor * Availability::kDays + day) * windowCount + window];
+    if (applicant.cancelled || supervisorNode < 0 || edges[applicant.sourceEdge].capacity == 0)
+    {
+        return false;
+    }
+
+    // Push one unit along source -> applicant -> supervisorNode -> window -> sink if every arc has room
+    std::vector<int> path = {applicant.sourceEdge};
+    const int hops[3][2] = {{2 + *it, supervisorNode},
+                            {supervisorNode, windowNode(day, window)},
+                            {windowNode(day, window), Sink}};
+    for (const auto &hop : hops)
+    {
+        int arc = -1;
+        for (int e : graph[hop[0]])
+        {
+            if (e % 2 == 0 && edges[e].to == hop[1] && edges[e].capacity > 0)
+            {
+                arc = e;
+                break;
+            }
+        }
+        if (arc < 0)
+        {
+            return false;
+        }
+        path.push_back(arc);
+    }
+    for (int e : path)
+    {
+        edges[e].capacity -= 1;
+        edges[e ^ 1].capacity += 1;
+    }
+    ++booked;
+    return true;
+}
+
+quint64 InterviewScheduler::windowMask(int window) const
+{
+    const quint64 width = windowSlots >= 64 ? ~quint64(0) : (quint64(1) << windowSlots) - 1;
+    return width << (window * windowSlots);
+}
+
+int InterviewScheduler::addEdge(int from, int to, int capacity)
+{
+    const int index = static_cast<int>(edges.size());
+    edges.push_back({to, capacity});
+    edges.push_back({from, 0});
+    graph[from].push_back(index);
+    graph[to].push_back(index + 1);
+    return index;
+}
+
+void InterviewScheduler::build()
+{
+    TRACE_SCOPE("db", "InterviewScheduler::build");
+    const int windowNodes = Availability::kDays * windowCount;
+    edges.clear();
+    graph.assign(2 + applicantCount() + windowNodes, std::vector<int>());
+    nodeSupervisor.assign(graph.size(), -1);
+    nodeWindow.assign(graph.size(), -1);
+
+    for (int day = 0; day < Availability::kDays; ++day)
+    {
+        for (int window = 0; window < windowCount; ++window)
+        {
+            const int node = windowNode(day, window);
+            nodeWindow[node] = day * windowCount + window;
+            addEdge(node, Sink, rooms);
+        }
+    }
+
+    // A (supervisor, window) node only where the supervisor is free for the whole window
+    supervisorNodes.assign(calendars.size() * Availability::kDays * windowCount, -1);
+    for (size_t supervisor = 0; supervisor < calendars.size(); ++supervisor)
+    {
+        for (int day = 0; day < Availability::kDays; ++day)
+        {
+            const quint64 free = calendars[supervisor].day(day);
+            for (int window = 0; window < windowCount; ++window)
+            {
+                if ((free & windowMask(window)) != windowMask(window))
+                    continue;
+                const int node = static_cast<int>(graph.size());
+                graph.emplace_back();
+                nodeSupervisor.push_back(static_cast<int>(supervisor));
+                nodeWindow.push_back(day * windowCount + window);
+                supervisorNodes[(supervisor * Availability::kDays + day) * windowCount + window] = node;
+                addEdge(node, windowNode(day, window), supervisorCapacity);
+            }
+        }
+    }
+
+    for (int a = 0; a < applicantCount(); ++a)
+    {
+        Applicant &applicant = applicants[a];
+        const int node = 2 + a;
+        applicant.sourceEdge = addEdge(Source, node, applicant.cancelled ? 0 : 1);
+        for (int day = 0; day < Availability::kDays; ++day)
+        {
+            const quint64 free = applicant.availability.day(day);
+            const int *row = supervisorNodes.data() + (applicant.supervisor * Availability::kDays + day) * windowCount;
+            for (int window = 0; window < windowCount; ++window)
+            {
+                if (row[window] >= 0 && (free & windowMask(window)) == windowMask(window))
+                    addEdge(node, row[window], 1);
+            }
+        }
+    }
+
+    level.assign(graph.size(), -1);
+    nextArc.assign(graph.size(), 0);
+    booked = 0;
+    built = true;
+}
+
+bool InterviewScheduler::bfs()
+{
+    std::fill(level.begin(), level.end(), -1);
+    std::deque<int> queue;
+    level[Source] = 0;
+    queue.push_back(Source);
+    while (!queue.empty())
+    {
+        const int node = queue.front();
+        queue.pop_front();
+        for (int e : graph[node])
+        {
+            const Edge &edge = edges[e];
+            if (edge.capacity > 0 && level[edge.to] < 0)
+            {
+                level[edge.to] = level[node] + 1;
+                queue.push_back(edge.to);
+            }
+        }
+    }
+    return level[Sink] >= 0;
+}
+
+int InterviewScheduler::dfs(int node, int pushed)
+{
+    if (node == Sink)
+    {
+        return pushed;
+    }
+    for (size_t &i = nextArc[node]; i < graph[node].size(); ++i)
+    {
+        const int e = graph[node][i];
+        Edge &edge = edges[e];
+        if (edge.capacity <= 0 || level[edge.to] != level[node] + 1)
+        {
+            continue;
+        }
+        const int sent = dfs(edge.to, std::min(pushed, edge.capacity));
+        if (sent > 0)
+        {
+            edge.capacity -= sent;
+            edges[e ^ 1].capacity += sent;
+            return sent;
+        }
+    }
+    return 0;
+}
+
+int InterviewScheduler::solve()
+{
+    TRACE_SCOPE("db", "InterviewScheduler::solve");
+    if (!built)
+    {
+        build();
+    }
+    while (bfs())
+    {
+        std::fill(nextArc.begin(), nextArc.end(), 0);
+        while (const int sent = dfs(Source, INT_MAX))
+        {
+            booked += sent;
+        }
+    }
+    return booked;
+}
+
+void InterviewScheduler::unbook(int applicant)
+{
+    const int sourceEdge = applicants[applicant].sourceEdge;
+    if (edges[sourceEdge ^ 1].capacity == 0)
+    {
+        return; // not booked
+    }
+
+    // Walk the one unit of flow source -> applicant -> (supervisor, window) -> window -> sink
+    std::vector<int> path = {sourceEdge};
+    int node = 2 + applicant;
+    while (node != Sink)
+    {
+        const int previous = node;
+        for (int e : graph[node])
+        {
+            // Forward arcs have even indices; flow shows up as reverse capacity
+            if (e % 2 == 0 && edges[e ^ 1].capacity > 0)
+            {
+                path.push_back(e);
+                node = edges[e].to;
+                break;
+            }
+        }
+        if (node == previous)
+        {
+            return; // no flow path; nothing to undo
+        }
+    }
+    for (int e : path)
+    {
+        edges[e].capacity += 1;
+        edges[e ^ 1].capacity -= 1;
+    }
+    --booked;
+}
+
+bool InterviewScheduler::cancelApplicant(int applicationId)
+{
+    TRACE_SCOPE("db", "InterviewScheduler::cancelApplicant");
+    auto it = applicantIndex.constFind(applicationId);
+    if (it == applicantIndex.constEnd() || applicants[*it].cancelled)
+    {
+        return false;
+    }
+    applicants[*it].cancelled = true;
+    if (!built)
+    {
+        return true;
+    }
+
+    unbook(*it);
+    edges[applicants[*it].sourceEdge].capacity = 0;
+    solve();
+    return true;
+}
+
+bool InterviewScheduler::cancelSupervisorTime(const QString &supervisor, const Availability &blocked)
+{
+    TRACE_SCOPE("db", "InterviewScheduler::cancelSupervisorTime");
+    auto it = supervisorIndex.constFind(supervisor);
+    if (it == supervisorIndex.constEnd())
+    {
+        return false;
+    }
+    const int index = *it;
+    Availability &calendar = calendars[index];
+    for (int day = 0; day < Availability::kDays; ++day)
+    {
+        calendar.setDay(day, calendar.day(day) & ~blocked.day(day));
+    }
+    if (!built)
+    {
+        return true;
+    }
+
+    for (int day = 0; day < Availability::kDays; ++day)
+    {
+        for (int window = 0; window < windowCount; ++window)
+        {
+            const int node = supervisorNodes[(index * Availability::kDays + day) * windowCount + window];
+            if (node < 0 || !(blocked.day(day) & windowMask(window)))
+                continue;
+
+            // Odd arcs here are the reverses of applicant -> node arcs
+            for (int e : graph[node])
+            {
+                if (e % 2 == 1 && edges[e].capacity > 0)
+                    unbook(edges[e].to - 2);
+            }
+            for (int e : graph[node])
+            {
+                edges[e].capacity = 0;
+                edges[e ^ 1].capacity = 0;
+            }
+            supervisorNodes[(index * Availability::kDays + day) * windowCount + window] = -1;
+        }
+    }
+    solve();
+    return true;
+}
+
+std::vector<ScheduledInterview> InterviewScheduler::schedule() const
+{
+    std::vector<ScheduledInterview> interviews;
+    if (!built)
+    {
+        return interviews;
+    }
+    interviews.reserve(booked);
+    std::vector<int> roomsUsed(Availability::kDays * windowCount, 0);
+    for (int a = 0; a < applicantCount(); ++a)
+    {
+        const Applicant &applicant = applicants[a];
+        if (applicant.cancelled || edges[applicant.sourceEdge ^ 1].capacity == 0)
+        {
+            continue;
+        }
+        for (int e : graph[2 + a])
+        {
+            if (e % 2 != 0 || edges[e ^ 1].capacity == 0)
+                continue;
+            const int node = edges[e].to;
+            const int slot = nodeWindow[node];
+            const int window = slot % windowCount;
+            ScheduledInterview interview;
+            interview.applicationId = applicant.applicationId;
+            interview.supervisor = supervisorNames.at(nodeSupervisor[node]);
+            interview.day = slot / windowCount;
+            interview.startMinute = Availability::kFirstMinute + window * windowSlots * Availability::kSlotMinutes;
+            interview.endMinute = interview.startMinute + windowSlots * Availability::kSlotMinutes;
+            interview.room = ++roomsUsed[slot];
+            interviews.push_back(interview);
+            break;
+        }
+    }
+    return interviews;
+}
@@ -0,0 +1,357 @@
+#include "services/jobanalytics.h"
+#include "utils/tracer.h"
+#include <QDebug>
+#include <QSqlDatabase>
+#include <QSqlError>
+#include <QSqlQuery>
+#include <QVariant>
+
+namespace
+{
+    const QString kWeekNow = QStringLiteral("strftime('%Y-W%W', 'now')");
+
+    // Adds (sign "+") or removes (sign "-") one jobs row, OLD or NEW, from
+    // both rollup_jobs dimensions, carrying the job's application count along
+    QString rollupJobsDelta(const QString &row, const QString &sign)
+    {
+        const QString applications =
+            QString("COALESCE((SELECT applications FROM rollup_job_activity WHERE job_id = %1.id), 0)").arg(row);
+        const std::pair<QString, QString> dimensions[] = {
+            {"category", QString("COALESCE(%1.category, '')").arg(row)},
+            {"department", QString("%1.department").arg(row)}};
+
+        QString sql;
+        for (const auto &dimension : dimensions)
+        {
+            sql += QString("INSERT INTO rollup_jobs (dimension, key, status, jobs, positions, applications) "
+                           "VALUES ('%1', %2, %3.status, %4 1, %4 %3.positions_available, %4 %5) "
+                           "ON CONFLICT(dimension, key, status) DO UPDATE SET jobs = jobs + excluded.jobs, "
+                           "positions = positions + excluded.positions, "
+                           "applications = applications + excluded.applications;")
+                       .arg(dimension.first, dimension.second, row, sign, applications);
+        }
+        return sql;
+    }
+
+    // Adds delta applications to the rollup_jobs rows of one job
+    QString rollupApplicationsDelta(const QString &jobIdExpr, int delta)
+    {
+        QString sql;
+        const std::pair<QString, QString> dimensions[] = {
+            {"category", "COALESCE(category, '')"},
+            {"department", "department"}};
+        for (const auto &dimension : dimensions)
+        {
+            sql += QString("INSERT INTO rollup_jobs (dimension, key, status, jobs, positions, applications) "
+                           "SELECT '%1', %2, status, 0, 0, %3 FROM jobs WHERE id = %4 "
+                           "ON CONFLICT(dimension, key, status) DO UPDATE SET "
+                           "applications = applications + excluded.applications;")
+                       .arg(dimension.first, dimension.second)
+                       .arg(delta)
+                       .arg(jobIdExpr);
+        }
+        return sql;
+    }
+
+    QString weeklyDelta(const QString &metric, const QString &value, const QString &condition = "1")
+    {
+        return QString("INSERT INTO rollup_weekly (week, metric, value) SELECT %1, '%2', %3 WHERE %4 "
+                       "ON CONFLICT(week, metric) DO UPDATE SET value = value + excluded.value;")
+            .arg(kWeekNow, metric, value, condition);
+    }
+
+    bool execAll(QSqlQuery &query, const QStringList &statements)
+    {
+        for (const QString &sql : statements)
+        {
+            if (!query.exec(sql))
+            {
+                qDebug() << "Analytics schema error:" << query.lastError().text();
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+bool JobAnalytics::install(const QSqlDatabase &db)
+{
+    TRACE_SCOPE("db", "JobAnalytics::install");
+    QSqlQuery query(db);
+    query.exec("SELECT 1 FROM sqlite_master WHERE type = 'table' AND name = 'rollup_jobs'");
+    const bool fresh = !query.next();
+
+    const QString filled = "NEW.positions_available <= 0 AND OLD.positions_available > 0";
+    const QStringList schema = {
+        "CREATE TABLE IF NOT EXISTS rollup_jobs ("
+        "dimension TEXT NOT NULL, key TEXT NOT NULL, status INTEGER NOT NULL,"
+        "jobs INTEGER DEFAULT 0, positions INTEGER DEFAULT 0, applications INTEGER DEFAULT 0,"
+        "PRIMARY KEY (dimension, key, status))",
+
+        "CREATE TABLE IF NOT EXISTS rollup_job_activity ("
+        "job_id INTEGER PRIMARY KEY,"
+        "applications INTEGER DEFAULT 0, interests INTEGER DEFAULT 0, converted INTEGER DEFAULT 0,"
+        "opened_at TEXT, filled_at TEXT)",
+        "CREATE INDEX IF NOT EXISTS idx_rollup_job_activity_apps ON rollup_job_activity(applications)",
+
+        "CREATE TABLE IF NOT EXISTS rollup_weekly ("
+        "week TEXT NOT NULL, metric TEXT NOT NULL, value INTEGER DEFAULT 0,"
+        "PRIMARY KEY (week, metric))",
+
+        // Supports the conversion checks in the application trigger
+        "CREATE INDEX IF NOT EXISTS idx_job_interests_user_job ON job_interests(user_id, job_id)",
+        "CREATE INDEX IF NOT EXISTS idx_job_applications_user_job ON job_applications(user_id, job_id)",
+
+        "CREATE TRIGGER IF NOT EXISTS trg_rollup_jobs_insert AFTER INSERT ON jobs BEGIN "
+        "INSERT OR IGNORE INTO rollup_job_activity (job_id, opened_at) "
+        "VALUES (NEW.id, CASE WHEN NEW.status = 0 THEN datetime('now') END);" +
+            rollupJobsDelta("NEW", "+") +
+            weeklyDelta("jobs_opened", "1", "NEW.status = 0") +
+            " END",
+
+        "CREATE TRIGGER IF NOT EXISTS trg_rollup_jobs_update "
+        "AFTER UPDATE OF status, category, department, positions_available ON jobs BEGIN "
+        "INSERT OR IGNORE INTO rollup_job_activity (job_id) VALUES (NEW.id);" +
+            rollupJobsDelta("OLD", "-") + rollupJobsDelta("NEW", "+") +
+            weeklyDelta("jobs_opened", "1", "NEW.status = 0 AND OLD.status <> 0") +
+            "UPDATE rollup_job_activity SET opened_at = datetime('now') "
+            "WHERE job_id = NEW.id AND NEW.status = 0 AND OLD.status <> 0 AND opened_at IS NULL;" +
+            weeklyDelta("jobs_filled", "1", filled) +
+            // Time to fill is only known for jobs whose opening was seen
+            "INSERT INTO rollup_weekly (week, metric, value) "
+            "SELECT " + kWeekNow + ", m.metric, CASE m.metric WHEN 'fill_samples' THEN 1 "
+            "ELSE CAST(strftime('%s', 'now') - strftime('%s', a.opened_at) AS INTEGER) END "
+            "FROM rollup_job_activity a, (SELECT 'fill_samples' AS metric UNION ALL SELECT 'fill_seconds') m "
+            "WHERE a.job_id = NEW.id AND a.filled_at IS NULL AND a.opened_at IS NOT NULL AND " + filled + " "
+            "ON CONFLICT(week, metric) DO UPDATE SET value = value + excluded.value;"
+            "UPDATE rollup_job_activity SET filled_at = datetime('now') "
+            "WHERE job_id = NEW.id AND filled_at IS NULL AND " + filled + ";"
+            " END",
+
+        "CREATE TRIGGER IF NOT EXISTS trg_rollup_jobs_delete AFTER DELETE ON jobs BEGIN " +
+            rollupJobsDelta("OLD", "-") +
+            "DELETE FROM rollup_job_activity WHERE job_id = OLD.id; END",
+
+        "CREATE TRIGGER IF NOT EXISTS trg_rollup_applications_insert AFTER INSERT ON job_applications BEGIN "
+        "INSERT INTO rollup_job_activity (job_id, applications, converted) SELECT NEW.job_id, 1, "
+        "EXISTS (SELECT 1 FROM job_interests WHERE user_id = NEW.user_id AND job_id = NEW.job_id) "
+        "AND NOT EXISTS (SELECT 1 FROM job_applications WHERE user_id = NEW.user_id "
+        "AND job_id = NEW.job_id AND id <> NEW.id) "
+        "WHERE EXISTS (SELECT 1 FROM jobs WHERE id = NEW.job_id) "
+        "ON CONFLICT(job_id) DO UPDATE SET applications = applications + 1, "
+        "converted = converted + excluded.converted;" +
+            rollupApplicationsDelta("NEW.job_id", 1) +
+            weeklyDelta("applications", "1") +
+            " END",
+
+        "CREATE TRIGGER IF NOT EXISTS trg_rollup_applications_delete AFTER DELETE ON job_applications BEGIN "
+        "UPDATE rollup_job_activity SET applications = applications - 1 WHERE job_id = OLD.job_id;" +
+            rollupApplicationsDelta("OLD.job_id", -1) +
+            " END",
+
+        "CREATE TRIGGER IF NOT EXISTS trg_rollup_interests_insert AFTER INSERT ON job_interests BEGIN "
+        "INSERT INTO rollup_job_activity (job_id, interests) SELECT NEW.job_id, 1 "
+        "WHERE EXISTS (SELECT 1 FROM jobs WHERE id = NEW.job_id) "
+        "ON CONFLICT(job_id) DO UPDATE SET interests = interests + 1;" +
+            weeklyDelta("interests", "1") +
+            " END",
+
+        "CREATE TRIGGER IF NOT EXISTS trg_rollup_interests_delete AFTER DELETE ON job_interests BEGIN "
+        "UPDATE rollup_job_activity SET interests = interests - 1 WHERE job_id = OLD.job_id; END",
+    };
+
+    if (!execAll(query, schema))
+    {
+        return false;
+    }
+    return fresh ? rebuild(db) : true;
+}
+
+bool JobAnalytics::rebuild(const QSqlDatabase &db)
+{
+    TRACE_SCOPE("db", "JobAnalytics::rebuild");
+    QSqlDatabase connection = db;
+    if (!connection.transaction())
+    {
+        qDebug() << "Error starting rollup rebuild:" << connection.lastError().text();
+        return false;
+    }
+
+    QSqlQuery query(db);
+    const QStringList statements = {
+        "DELETE FROM rollup_jobs",
+        "DELETE FROM rollup_job_activity",
+        "DELETE FROM rollup_weekly",
+
+        "INSERT INTO rollup_job_activity (job_id, applications, interests, converted) "
+        "SELECT j.id, "
+        "(SELECT COUNT(*) FROM job_applications a WHERE a.job_id = j.id), "
+        "(SELECT COUNT(*) FROM job_interests i WHERE i.job_id = j.id), "
+        "(SELECT COUNT(DISTINCT a.user_id) FROM job_applications a WHERE a.job_id = j.id AND EXISTS "
+        "(SELECT 1 FROM job_interests i WHERE i.job_id = a.job_id AND i.user_id = a.user_id)) "
+        "FROM jobs j",
+
+        "INSERT INTO rollup_jobs (dimension, key, status, jobs, positions, applications) "
+        "SELECT 'category', COALESCE(j.category, ''), j.status, COUNT(*), SUM(j.positions_available), "
+        "SUM(a.applications) FROM jobs j JOIN rollup_job_activity a ON a.job_id = j.id GROUP BY 2, 3",
+
+        "INSERT INTO rollup_jobs (dimension, key, status, jobs, positions, applications) "
+        "SELECT 'department', j.department, j.status, COUNT(*), SUM(j.positions_available), "
+        "SUM(a.applications) FROM jobs j JOIN rollup_job_activity a ON a.job_id = j.id GROUP BY 2, 3",
+
+        "INSERT INTO rollup_weekly (week, metric, value) "
+        "SELECT strftime('%Y-W%W', applied_date), 'applications', COUNT(*) FROM job_applications "
+        "WHERE applied_date IS NOT NULL GROUP BY 1",
+
+        "INSERT INTO rollup_weekly (week, metric, value) "
+        "SELECT strftime('%Y-W%W', date), 'interests', COUNT(*) FROM job_interests "
+        "WHERE date IS NOT NULL GROUP BY 1",
+    };
+
+    if (!execAll(query, statements))
+    {
+        connection.rollback();
+        return false;
+    }
+    return connection.commit();
+}
+
+QMap<QString, int> JobAnalytics::jobCountsBy(const QSqlDatabase &db, const QString &dimension, int status)
+{
+    QMap<QString, int> counts;
+    QSqlQuery query(db);
+    query.prepare(QString("SELECT key, SUM(jobs) FROM rollup_jobs WHERE dimension = ?%1 "
+                          "GROUP BY key HAVING SUM(jobs) > 0")
+                      .arg(status >= 0 ? " AND status = ?" : ""));
+    query.addBindValue(dimension);
+    if (status >= 0)
+    {
+        query.addBindValue(status);
+    }
+
+    if (query.exec())
+    {
+        while (query.next())
+        {
+            counts.insert(query.value(0).toString(), query.value(1).toInt());
+        }
+    }
+    return counts;
+}
+
+QMap<QString, int> JobAnalytics::openPositionsBy(const QSqlDatabase &db, const QString &dimension)
+{
+    QMap<QString, int> positions;
+    QSqlQuery query(db);
+    // Open (0) and Closing Soon (1) still take applications
+    query.prepare("SELECT key, SUM(positions) FROM rollup_jobs WHERE dimension = ? AND status IN (0, 1) "
+                  "GROUP BY key HAVING SUM(jobs) > 0");
+    query.addBindValue(dimension);
+
+    if (query.exec())
+    {
+        while (query.next())
+        {
+            positions.insert(query.value(0).toString(), query.value(1).toInt());
+        }
+    }
+    return positions;
+}
+
+JobBoardSummary JobAnalytics::summary(const QSqlDatabase &db)
+{
+    TRACE_SCOPE("db", "JobAnalytics::summary");
+    JobBoardSummary result;
+    QSqlQuery query(db);
+
+    if (query.exec("SELECT SUM(jobs), SUM(positions), SUM(applications) FROM rollup_jobs "
+                   "WHERE dimension = 'category' AND status IN (0, 1)") &&
+        query.next())
+    {
+        result.openJobs = query.value(0).toInt();
+        result.openPositions = query.value(1).toInt();
+        result.openApplications = query.value(2).toInt();
+    }
+
+    if (query.exec("SELECT SUM(applications), SUM(interests), SUM(converted) FROM rollup_job_activity") &&
+        query.next())
+    {
+        result.totalApplications = query.value(0).toInt();
+        result.totalInterests = query.value(1).toInt();
+        result.convertedInterests = query.value(2).toInt();
+    }
+
+    if (query.exec("SELECT metric, SUM(value) FROM rollup_weekly "
+                   "WHERE metric IN ('jobs_filled', 'fill_samples', 'fill_seconds') GROUP BY metric"))
+    {
+        qint64 samples = 0;
+        qint64 seconds = 0;
+        while (query.next())
+        {
+            const QString metric = query.value(0).toString();
+            if (metric == "jobs_filled")
+                result.jobsFilled = query.value(1).toInt();
+            else if (metric == "fill_samples")
+                samples = query.value(1).toLongLong();
+            else
+                seconds = query.value(1).toLongLong();
+        }
+        if (samples > 0)
+        {
+            result.averageDaysToFill = double(seconds) / samples / 86400.0;
+        }
+    }
+    return result;
+}
+
+std::vector<std::pair<QString, int>> JobAnalytics::weekly(const QSqlDatabase &db, const QString &metric, int weeks)
+{
+    std::vector<std::pair<QString, int>> series;
+    QSqlQuery query(db);
+    query.prepare("SELECT week, value FROM rollup_weekly WHERE metric = ? ORDER BY week DESC LIMIT ?");
+    query.addBindValue(metric);
+    query.addBindValue(weeks);
+
+    if (query.exec())
+    {
+        while (query.next())
+        {
+            series.emplace_back(query.value(0).toString(), query.value(1).toInt());
+        }
+    }
+    return series;
+}
+
+std::vector<JobActivity> JobAnalytics::topJobsByApplications(const QSqlDatabase &db, int limit)
+{
+    std::vector<JobActivity> top;
+    QSqlQuery query(db);
+    query.prepare("SELECT a.job_id, j.title, a.applications, a.interests FROM rollup_job_activity a "
+                  "JOIN jobs j ON j.id = a.job_id WHERE a.applications > 0 "
+                  "ORDER BY a.applications DESC LIMIT ?");
+    query.addBindValue(limit);
+
+    if (query.exec())
+    {
+        while (query.next())
+        {
+            JobActivity activity;
+            activity.jobId = query.value(0).toInt();
+            activity.title = query.value(1).toString();
+            activity.applications = query.value(2).toInt();
+            activity.interests = query.value(3).toInt();
+            top.push_back(activity);
+        }
+    }
+    return top;
+}
+
+QString JobAnalytics::currentWeek(const QSqlDatabase &db)
+{
+    QSqlQuery query(db);
+    if (query.exec(QString("SELECT %1").arg(kWeekNow)) && query.next())
+    {
+        return query.value(0).toString();
+    }
+    return QString();
+}
@@ -0,0 +1,248 @@
+#include "services/jobstatusscheduler.h"
+#include "utils/tracer.h"
+#include <QDateTime>
+#include <QDebug>
+
+namespace
+{
+    constexpr qint64 kSecondsPerDay = 24 * 60 * 60;
+    // Re-check at least daily so a changed system clock is picked up
+    constexpr qint64 kMaxSleepMs = kSecondsPerDay * 1000;
+
+    // The wheel payload carries the job id and the generation it was filed
+    // under; timers left over from before a reschedule are ignored
+    quint64 packPayload(int jobId, quint32 generation)
+    {
+        return (quint64(generation) << 32) | quint32(jobId);
+    }
+
+    QDate parseDate(const QString &text)
+    {
+        const QString trimmed = text.trimmed();
+        for (const char *format : {"yyyy-MM-dd", "MM/dd/yyyy", "M/d/yyyy", "MMMM d, yyyy", "MMM d, yyyy"})
+        {
+            const QDate date = QDate::fromString(trimmed, format);
+            if (date.isValid())
+            {
+                return date;
+            }
+        }
+        return QDate();
+    }
+}
+
+JobStatusScheduler::JobStatusScheduler(Database *db, QObject *parent)
+    : QObject(parent), database(db), wheel(QDateTime::currentSecsSinceEpoch()),
+      generationCounter(0), closingSoonDays(3)
+{
+    timer.setSingleShot(true);
+    timer.setTimerType(Qt::PreciseTimer);
+    connect(&timer, &QTimer::timeout, this, &JobStatusScheduler::onTimer);
+}
+
+qint64 JobStatusScheduler::parseDeadline(const QString &text)
+{
+    const QDateTime exact = QDateTime::fromString(text.trimmed(), Qt::ISODate);
+    if (exact.isValid() && text.contains('T'))
+    {
+        return exact.toSecsSinceEpoch();
+    }
+    const QDate date = parseDate(text);
+    return date.isValid() ? date.addDays(1).startOfDay().toSecsSinceEpoch() : -1;
+}
+
+qint64 JobStatusScheduler::parseOpenDate(const QString &text)
+{
+    const QDateTime exact = QDateTime::fromString(text.trimmed(), Qt::ISODate);
+    if (exact.isValid() && text.contains('T'))
+    {
+        return exact.toSecsSinceEpoch();
+    }
+    const QDate date = parseDate(text);
+    return date.isValid() ? date.startOfDay().toSecsSinceEpoch() : -1;
+}
+
+JobStatus JobStatusScheduler::statusAt(const TrackedJob &job, qint64 when) const
+{
+    if (job.status == JobStatus::Closed)
+    {
+        return JobStatus::Closed;
+    }
+    if (job.status == JobStatus::Upcoming && (job.opensAt < 0 || when < job.opensAt))
+    {
+        return JobStatus::Upcoming;
+    }
+    if (job.closesAt < 0)
+    {
+        // No usable deadline: an opened job keeps whatever open state it had
+        return job.status == JobStatus::Upcoming ? JobStatus::Open : job.status;
+    }
+    if (when >= job.closesAt)
+    {
+        return JobStatus::Closed;
+    }
+    if (when >= job.closesAt - closingSoonDays * kSecondsPerDay)
+    {
+        return JobStatus::ClosingSoon;
+    }
+    return JobStatus::Open;
+}
+
+qint64 JobStatusScheduler::nextChangeAfter(const TrackedJob &job, qint64 now) const
+{
+    // Status only changes at one of these instants; take the first that matters
+    const JobStatus current = statusAt(job, now);
+    qint64 best = -1;
+    for (qint64 instant : {job.opensAt, job.closesAt - closingSoonDays * kSecondsPerDay, job.closesAt})
+    {
+        if (instant > now && (best < 0 || instant < best) && statusAt(job, instant) != current)
+        {
+            best = instant;
+        }
+    }
+    return best;
+}
+
+void JobStatusScheduler::track(const Job &job, qint64 now, std::vector<JobStatusChange> &changes)
+{
+    TrackedJob &tracked = jobs[job.getId()];
+    tracked.status = job.getStatus();
+    tracked.opensAt = parseOpenDate(job.getOpenDate());
+    tracked.closesAt = parseDeadline(job.getDeadline());
+    tracked.generation = ++generationCounter;
+
+    // Rows whose transition already passed (app was not running) catch up now
+    const JobStatus due = statusAt(tracked, now);
+    if (due != tracked.status)
+    {
+        changes.push_back({job.getId(), tracked.status, due});
+    }
+}
+
+void JobStatusScheduler::fileNext(int jobId, qint64 now)
+{
+    auto it = jobs.find(jobId);
+    if (it == jobs.end())
+    {
+        return;
+    }
+
+    const qint64 next = nextChangeAfter(it.value(), now);
+    if (next < 0 || !wheel.insert(next, packPayload(jobId, it->generation)))
+    {
+        // Closed for good, or nothing scheduled within the wheel's range
+        jobs.erase(it);
+    }
+}
+
+void JobStatusScheduler::start()
+{
+    TRACE_SCOPE("db", "JobStatusScheduler::start");
+    const qint64 now = QDateTime::currentSecsSinceEpoch();
+    std::vector<JobStatusChange> changes;
+
+    // The only full read of the catalog; everything after is timer driven
+    database->forEachJob([this, now, &changes](const Job &job)
+                         {
+        if (job.getStatus() != JobStatus::Closed)
+        {
+            track(job, now, changes);
+        }
+        return true; });
+
+    apply(changes);
+    const QList<int> ids = jobs.keys();
+    for (int jobId : ids)
+    {
+        fileNext(jobId, now);
+    }
+    armTimer();
+}
+
+void JobStatusScheduler::reschedule(int jobId)
+{
+    const Job job = database->getJobById(jobId);
+    if (job.getId() < 0)
+    {
+        jobs.remove(jobId);
+        return;
+    }
+
+    const qint64 now = QDateTime::currentSecsSinceEpoch();
+    std::vector<JobStatusChange> changes;
+    track(job, now, changes);
+    apply(changes);
+    fileNext(jobId, now);
+    armTimer();
+}
+
+void JobStatusScheduler::onTimer()
+{
+    TRACE_SCOPE("db", "JobStatusScheduler::onTimer");
+    const qint64 now = QDateTime::currentSecsSinceEpoch();
+    std::vector<TimerWheel::Timer> due;
+    wheel.advance(now, due);
+
+    std::vector<JobStatusChange> changes;
+    std::vector<int> refile;
+    for (const TimerWheel::Timer &fired : due)
+    {
+        const int jobId = static_cast<int>(quint32(fired.payload));
+        auto it = jobs.find(jobId);
+        if (it == jobs.end() || it->generation != quint32(fired.payload >> 32))
+        {
+            continue;
+        }
+
+        const JobStatus next = statusAt(it.value(), now);
+        if (next != it->status)
+        {
+            changes.push_back({jobId, it->status, next});
+        }
+        refile.push_back(jobId);
+    }
+
+    apply(changes);
+    for (int jobId : refile)
+    {
+        fileNext(jobId, now);
+    }
+    armTimer();
+}
+
+void JobStatusScheduler::apply(const std::vector<JobStatusChange> &changes)
+{
+    if (changes.empty())
+    {
+        return;
+    }
+
+    if (database->applyJobStatusChanges(changes) < 0)
+    {
+        qDebug() << "Job status scheduler: failed to apply" << changes.size() << "transition(s)";
+        return;
+    }
+
+    for (const JobStatusChange &change : changes)
+    {
+        auto it = jobs.find(change.jobId);
+        if (it != jobs.end())
+        {
+            it->status = change.to;
+        }
+        emit jobStatusChanged(change.jobId, change.to);
+    }
+}
+
+void JobStatusScheduler::armTimer()
+{
+    const qint64 wake = wheel.nextWakeTick();
+    if (wake < 0)
+    {
+        timer.stop();
+        return;
+    }
+
+    const qint64 delayMs = qBound<qint64>(0, wake * 1000 - QDateTime::currentMSecsSinceEpoch(), kMaxSleepMs);
+    timer.start(static_cast<int>(delayMs));
+}
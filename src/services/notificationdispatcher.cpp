@@ -0,0 +1,69 @@
+#include "services/notificationdispatcher.h"
+#include "utils/tracer.h"
+#include <QDebug>
+
+NotificationDispatcher::NotificationDispatcher(Database *db, std::unique_ptr<NotificationSink> notificationSink,
+                                               QObject *parent)
+    : QObject(parent), database(db), sink(std::move(notificationSink))
+{
+}
+
+void NotificationDispatcher::onJobStatusChanged(int jobId, JobStatus status)
+{
+    if (status == JobStatus::Open)
+    {
+        dispatchJobOpened(jobId);
+    }
+}
+
+int NotificationDispatcher::dispatchJobOpened(int jobId)
+{
+    TRACE_SCOPE("db", "NotificationDispatcher::dispatchJobOpened");
+    const Job job = database->getJobById(jobId);
+    if (job.getId() < 0)
+    {
+        return -1;
+    }
+
+    const QString subject = QString("Now hiring: %1").arg(job.getTitle());
+    int sent = 0;
+    int lastInterestId = 0;
+
+    for (;;)
+    {
+        std::vector<Notification> batch = database->getPendingNotifications(jobId, lastInterestId, kBatchSize);
+        if (batch.empty())
+        {
+            break;
+        }
+        lastInterestId = batch.back().interestId;
+
+        for (Notification &notification : batch)
+        {
+            notification.subject = subject;
+            notification.body = QString("Hi %1,\n\n%2 (%3) is now accepting applications. "
+                                        "Apply from the On-Campus Jobs page.\n")
+                                    .arg(notification.recipientName, job.getTitle(), job.getDepartment());
+        }
+
+        database->beginTransaction();
+        if (!sink->deliver(batch) || !database->markInterestsNotified(batch) || !database->commitTransaction())
+        {
+            database->rollbackTransaction();
+            qDebug() << "Notification batch for job" << jobId << "failed on sink" << sink->name();
+            return sent > 0 ? sent : -1;
+        }
+        sent += static_cast<int>(batch.size());
+
+        if (static_cast<int>(batch.size()) < kBatchSize)
+        {
+            break;
+        }
+    }
+
+    if (sent > 0)
+    {
+        emit notificationsSent(jobId, sent);
+    }
+    return sent;
+}
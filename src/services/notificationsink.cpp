@@ -0,0 +1,56 @@
+#include "services/notificationsink.h"
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+
+bool OutboxTableSink::deliver(const std::vector<Notification> &batch)
+{
+    return database->addOutboxNotifications(batch);
+}
+
+FileSpoolSink::FileSpoolSink(const QString &directory)
+    : spoolDirectory(directory), sequence(0)
+{
+    QDir().mkpath(spoolDirectory);
+}
+
+bool FileSpoolSink::deliver(const std::vector<Notification> &batch)
+{
+    if (batch.empty())
+    {
+        return true;
+    }
+
+    const QString fileName = QString("job%1-%2-%3.jsonl")
+                                 .arg(batch.front().jobId)
+                                 .arg(QDateTime::currentMSecsSinceEpoch())
+                                 .arg(++sequence);
+    QSaveFile file(QDir(spoolDirectory).filePath(fileName));
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        qDebug() << "Cannot open spool file" << file.fileName() << ":" << file.errorString();
+        return false;
+    }
+
+    for (const Notification &notification : batch)
+    {
+        QJsonObject line;
+        line["user_id"] = notification.userId;
+        line["job_id"] = notification.jobId;
+        line["to"] = notification.recipient;
+        line["subject"] = notification.subject;
+        line["body"] = notification.body;
+        file.write(QJsonDocument(line).toJson(QJsonDocument::Compact));
+        file.write("\n");
+    }
+
+    if (!file.commit())
+    {
+        qDebug() << "Cannot write spool file" << file.fileName() << ":" << file.errorString();
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,49 @@
+#include "services/schedulematcher.h"
+#include "utils/tracer.h"
+#include <algorithm>
+
+ScheduleMatcher::ScheduleMatcher(Database *db)
+    : database(db)
+{
+}
+
+Availability ScheduleMatcher::shiftGrid(const Job &job)
+{
+    return Availability::parse(job.getSchedule());
+}
+
+std::vector<ShiftMatch> ScheduleMatcher::matchJob(int jobId, const Availability &shift)
+{
+    TRACE_SCOPE("db", "ScheduleMatcher::matchJob");
+    const Availability grid = shift.isEmpty() ? shiftGrid(database->getJobById(jobId)) : shift;
+    return rank(grid, database->getApplicantAvailability(jobId));
+}
+
+std::vector<ShiftMatch> ScheduleMatcher::rank(const Availability &shift,
+                                              const std::vector<ApplicantAvailability> &applicants)
+{
+    std::vector<ShiftMatch> matches;
+    matches.reserve(applicants.size());
+    // Without a shift grid every applicant fits; rank by hours offered instead
+    const bool anyTime = shift.isEmpty();
+    for (const ApplicantAvailability &applicant : applicants)
+    {
+        ShiftMatch match;
+        match.applicationId = applicant.applicationId;
+        match.userId = applicant.userId;
+        match.overlapSlots = anyTime ? applicant.availability.slotCount()
+                                     : applicant.availability.overlapSlots(shift);
+        match.coverage = applicant.availability.coverage(shift);
+        match.coversShift = applicant.availability.covers(shift);
+        matches.push_back(match);
+    }
+
+    std::sort(matches.begin(), matches.end(), [](const ShiftMatch &a, const ShiftMatch &b)
+              {
+        if (a.coversShift != b.coversShift)
+            return a.coversShift;
+        if (a.overlapSlots != b.overlapSlots)
+            return a.overlapSlots > b.overlapSlots;
+        return a.applicationId < b.applicationId; });
+    return matches;
+}
@@ -1,18 +1,24 @@
 #include "interviewwidget.h"
+#include "thememanager.h"
 #include <QMessageBox>
 #include <QHBoxLayout>
 #include <QStackedWidget>
+#include <QDebug>
 
 // Constructor: Initialize the interview widget
-InterviewWidget::InterviewWidget(const QString &degree, QWidget *parent)
-    : QWidget(parent)
+InterviewWidget::InterviewWidget(Database *db, const QString &degree, QWidget *parent)
+    : QWidget(parent), degree(degree)
 {
     // Initialize data
     currentMode = "";         // Not set yet - user will choose
+    adaptiveQuiz = false;
+    quizLength = 0;
     currentQuestionIndex = 0; // Start at first question
     score = 0;                // No points yet
 
     setupQuestions(); // Create all the questions
+    practice = std::make_unique<InterviewPractice>(db, &questionBank);
+    practice->setUser(-1, degree);
 
     // Create main layout
     mainLayout = new QVBoxLayout(this);
@@ -71,6 +77,40 @@ void InterviewWidget::setupQuestions()
     technicalQuestions.append({"What does this code output? for(int i=0; i<3; i++) print(i);",
                                "0 1 2",
                                {"1 2 3", "0 1 2", "0 1 2 3", "1 2"}});
+
+    // A compiled bank replaces the built-in questions above when present
+    if (!questionBank.open(QuestionBank::defaultPath()))
+    {
+        qDebug() << "No question bank at" << QuestionBank::defaultPath() << "- using built-in questions";
+    }
+}
+
+void InterviewWidget::setDegree(const QString &degree)
+{
+    this->degree = degree;
+    practice->setUser(practice->userId(), degree);
+}
+
+void InterviewWidget::setUserId(int userId)
+{
+    practice->setUser(userId, degree);
+}
+
+void InterviewWidget::prepareQuiz(const QString &topic, QVector<Question> &questions)
+{
+    currentTopic = topic;
+    const int available = questionBank.count(degree, topic);
+    adaptiveQuiz = available > 0;
+    if (adaptiveQuiz)
+    {
+        // Filled one question at a time, each chosen after the previous answer
+        questions.clear();
+        quizLength = qMin(kQuizLength, available);
+    }
+    else
+    {
+        quizLength = questions.size();
+    }
 }
 
 // === LANDING SCREEN SETUP ===
@@ -85,12 +125,12 @@ void InterviewWidget::setupLandingUI()
     // STEP 1: Add title
     QLabel *titleLabel = new QLabel("Interview Preparation");
     titleLabel->setAlignment(Qt::AlignCenter);
-    titleLabel->setStyleSheet("font-size: 28px; font-weight: bold; color: #000000;");
+    ThemeManager::setRole(titleLabel, StyleRole::Title);
     layout->addWidget(titleLabel);
 
     QLabel *subtitleLabel = new QLabel("Choose a question type to get started");
     subtitleLabel->setAlignment(Qt::AlignCenter);
-    subtitleLabel->setStyleSheet("font-size: 14px; color: #666666;");
+    ThemeManager::setRole(subtitleLabel, StyleRole::Subtitle);
     layout->addWidget(subtitleLabel);
 
     layout->addSpacing(20);
@@ -108,38 +148,26 @@ void InterviewWidget::setupLandingUI()
 
     QLabel *behaviorTitle = new QLabel("Behavior Questions");
     behaviorTitle->setAlignment(Qt::AlignCenter);
-    behaviorTitle->setStyleSheet("font-size: 16px; font-weight: bold; color: #000000;");
+    ThemeManager::setRole(behaviorTitle, StyleRole::SectionTitle);
     behaviorVLayout->addWidget(behaviorTitle);
 
     behaviorVLayout->addSpacing(6);
 
     QLabel *behaviorDesc = new QLabel("Learn about workplace\nconflict and teamwork");
     behaviorDesc->setAlignment(Qt::AlignCenter);
-    behaviorDesc->setStyleSheet("font-size: 11px; color: #666666; line-height: 1.3;");
+    ThemeManager::setRole(behaviorDesc, StyleRole::Caption);
     behaviorVLayout->addWidget(behaviorDesc);
 
     behaviorVLayout->addStretch();
 
     behaviorWidget->setMinimumSize(200, 150);
-    behaviorWidget->setStyleSheet(
-        "QWidget {"
-        "  background-color: #f5f5f5;"
-        "}");
+    ThemeManager::setRole(behaviorWidget, StyleRole::MutedCard);
 
     QPushButton *behaviorBlock = new QPushButton();
     behaviorBlock->setLayout(behaviorVLayout);
     behaviorBlock->setMinimumHeight(150);
     behaviorBlock->setMinimumWidth(200);
-    behaviorBlock->setStyleSheet(
-        "QPushButton {"
-        "  background-color: #f5f5f5;"
-        "  border: 2px solid #999999;"
-        "  border-radius: 8px;"
-        "  padding: 0px;"
-        "}"
-        "QPushButton:hover {"
-        "  background-color: #eeeeee;"
-        "}");
+    ThemeManager::setRole(behaviorBlock, StyleRole::MutedCard);
     connect(behaviorBlock, &QPushButton::clicked, this, &InterviewWidget::startBehaviorQuestions);
     blocksLayout->addWidget(behaviorBlock);
 
@@ -152,38 +180,26 @@ void InterviewWidget::setupLandingUI()
 
     QLabel *technicalTitle = new QLabel("Technical Questions");
     technicalTitle->setAlignment(Qt::AlignCenter);
-    technicalTitle->setStyleSheet("font-size: 16px; font-weight: bold; color: #000000;");
+    ThemeManager::setRole(technicalTitle, StyleRole::SectionTitle);
     technicalVLayout->addWidget(technicalTitle);
 
     technicalVLayout->addSpacing(6);
 
     QLabel *technicalDesc = new QLabel("Learn about coding\nconcepts and logic");
     technicalDesc->setAlignment(Qt::AlignCenter);
-    technicalDesc->setStyleSheet("font-size: 11px; color: #666666; line-height: 1.3;");
+    ThemeManager::setRole(technicalDesc, StyleRole::Caption);
     technicalVLayout->addWidget(technicalDesc);
 
     technicalVLayout->addStretch();
 
     technicalWidget->setMinimumSize(200, 150);
-    technicalWidget->setStyleSheet(
-        "QWidget {"
-        "  background-color: #ffffff;"
-        "}");
+    ThemeManager::setRole(technicalWidget, StyleRole::Card);
 
     QPushButton *technicalBlock = new QPushButton();
     technicalBlock->setLayout(technicalVLayout);
     technicalBlock->setMinimumHeight(150);
     technicalBlock->setMinimumWidth(200);
-    technicalBlock->setStyleSheet(
-        "QPushButton {"
-        "  background-color: #ffffff;"
-        "  border: 2px solid #999999;"
-        "  border-radius: 8px;"
-        "  padding: 0px;"
-        "}"
-        "QPushButton:hover {"
-        "  background-color: #f9f9f9;"
-        "}");
+    ThemeManager::setRole(technicalBlock, StyleRole::Card);
     connect(technicalBlock, &QPushButton::clicked, this, &InterviewWidget::startTechnicalQuestions);
     blocksLayout->addWidget(technicalBlock);
 
@@ -203,7 +219,7 @@ void InterviewWidget::setupQuestionUI()
     // STEP 1: Add title showing which question type
     QLabel *titleLabel = new QLabel("Interview Question");
     titleLabel->setAlignment(Qt::AlignCenter);
-    titleLabel->setStyleSheet("font-size: 22px; font-weight: bold; color: #000000;");
+    ThemeManager::setRole(titleLabel, StyleRole::Heading);
     layout->addWidget(titleLabel);
 
     layout->addSpacing(10);
@@ -211,7 +227,7 @@ void InterviewWidget::setupQuestionUI()
     // STEP 2: Add the question text
     questionLabel = new QLabel();
     questionLabel->setWordWrap(true);
-    questionLabel->setStyleSheet("font-size: 16px; color: #333333; line-height: 1.6;");
+    ThemeManager::setRole(questionLabel, StyleRole::Body);
     layout->addWidget(questionLabel);
 
     layout->addSpacing(20);
@@ -221,23 +237,7 @@ void InterviewWidget::setupQuestionUI()
     {
         QPushButton *answerBtn = new QPushButton();
         answerBtn->setMinimumHeight(50);
-        answerBtn->setStyleSheet(
-            "QPushButton {"
-            "  background-color: #ffffff;"
-            "  color: #000000;"
-            "  border: 2px solid #cccccc;"
-            "  border-radius: 5px;"
-            "  font-size: 14px;"
-            "  padding: 10px;"
-            "  text-align: left;"
-            "}"
-            "QPushButton:hover {"
-            "  background-color: #f0f0f0;"
-            "  border: 2px solid #999999;"
-            "}"
-            "QPushButton:pressed {"
-            "  background-color: #e0e0e0;"
-            "}");
+        ThemeManager::setRole(answerBtn, StyleRole::Choice);
         connect(answerBtn, &QPushButton::clicked, this, &InterviewWidget::checkAnswer);
         answerButtons.append(answerBtn);
         layout->addWidget(answerBtn);
@@ -249,7 +249,7 @@ void InterviewWidget::setupQuestionUI()
     feedbackLabel = new QLabel();
     feedbackLabel->setWordWrap(true);
     feedbackLabel->setAlignment(Qt::AlignCenter);
-    feedbackLabel->setStyleSheet("font-size: 14px; font-weight: bold; color: #000000;");
+    ThemeManager::setRole(feedbackLabel, StyleRole::Emphasis);
     layout->addWidget(feedbackLabel);
 
     layout->addSpacing(15);
@@ -259,40 +259,14 @@ void InterviewWidget::setupQuestionUI()
 
     backButton = new QPushButton("Back to Menu");
     backButton->setMinimumHeight(40);
-    backButton->setStyleSheet(
-        "QPushButton {"
-        "  background-color: #e0e0e0;"
-        "  color: #000000;"
-        "  border: 1px solid #999999;"
-        "  border-radius: 5px;"
-        "  font-size: 14px;"
-        "}"
-        "QPushButton:hover {"
-        "  background-color: #d0d0d0;"
-        "}");
+    ThemeManager::setRole(backButton, StyleRole::Secondary);
     connect(backButton, &QPushButton::clicked, this, &InterviewWidget::backToLanding);
     buttonLayout->addWidget(backButton);
 
     nextButton = new QPushButton("Next Question");
     nextButton->setMinimumHeight(40);
     nextButton->setEnabled(false);
-    nextButton->setStyleSheet(
-        "QPushButton {"
-        "  background-color: #ffffff;"
-        "  color: #000000;"
-        "  border: 2px solid #cccccc;"
-        "  border-radius: 5px;"
-        "  font-size: 14px;"
-        "  font-weight: bold;"
-        "}"
-        "QPushButton:hover:!disabled {"
-        "  background-color: #f0f0f0;"
-        "  border: 2px solid #999999;"
-        "}"
-        "QPushButton:disabled {"
-        "  background-color: #f5f5f5;"
-        "  color: #999999;"
-        "}");
+    ThemeManager::setRole(nextButton, StyleRole::Primary);
     connect(nextButton, &QPushButton::clicked, this, &InterviewWidget::nextQuestion);
     buttonLayout->addWidget(nextButton);
 
@@ -304,6 +278,7 @@ void InterviewWidget::setupQuestionUI()
 void InterviewWidget::startBehaviorQuestions()
 {
     currentMode = "Behavior Questions";
+    prepareQuiz("behavior", behaviorQuestions);
     currentQuestionIndex = 0;
     score = 0;
 
@@ -320,6 +295,7 @@ void InterviewWidget::startBehaviorQuestions()
 void InterviewWidget::startTechnicalQuestions()
 {
     currentMode = "Technical Questions";
+    prepareQuiz("technical", technicalQuestions);
     currentQuestionIndex = 0;
     score = 0;
 
@@ -367,18 +343,22 @@ void InterviewWidget::checkAnswer()
     }
 
     // STEP 6: Check if answer is correct
-    if (studentAnswer == q.correctAnswer)
+    const bool correct = studentAnswer == q.correctAnswer;
+    if (adaptiveQuiz)
+        practice->recordAnswer(correct);
+
+    if (correct)
     {
         // Correct answer!
         feedbackLabel->setText("✓ Correct!");
-        feedbackLabel->setStyleSheet("color: green; font-weight: bold; font-size: 14px;");
+        ThemeManager::setRole(feedbackLabel, StyleRole::Success);
         score = score + 1;
     }
     else
     {
         // Wrong answer
         feedbackLabel->setText("✗ Wrong. Correct answer: " + q.correctAnswer);
-        feedbackLabel->setStyleSheet("color: red; font-weight: bold; font-size: 14px;");
+        ThemeManager::setRole(feedbackLabel, StyleRole::Error);
     }
 
     // STEP 7: Enable next button
@@ -391,6 +371,14 @@ void InterviewWidget::nextQuestion()
     // STEP 1: Get the question list
     QVector<Question> &questions = getCurrentQuestions();
 
+    // Adaptive quizzes pick the next question only now, after the last answer
+    Question picked;
+    if (adaptiveQuiz && currentQuestionIndex == questions.size() && questions.size() < quizLength &&
+        practice->nextQuestion(currentTopic, picked))
+    {
+        questions.append(picked);
+    }
+
     // STEP 2: Check if we finished all questions
     if (currentQuestionIndex >= questions.size())
     {
@@ -403,7 +391,7 @@ void InterviewWidget::nextQuestion()
 
     // STEP 4: Show question text
     int questionNumber = currentQuestionIndex + 1;
-    int totalQuestions = questions.size();
+    int totalQuestions = quizLength;
     questionLabel->setText("Question " + QString::number(questionNumber) + " of " + QString::number(totalQuestions) + ": " + q.text);
 
     // STEP 5: Fill in answer buttons
@@ -445,6 +433,12 @@ void InterviewWidget::showFinalResult()
     QString message = "Interview Complete!\n\n";
     message += "Your Score: " + QString::number(score) + " / " + QString::number(total);
     message += " (" + QString::number(percent, 'f', 1) + "%)";
+    if (adaptiveQuiz)
+    {
+        practice->flush();
+        message += "\n\nEstimated " + currentTopic + " mastery: " +
+                   QString::number(practice->expectedScore(currentTopic) * 100.0, 'f', 0) + "%";
+    }
 
     // STEP 4: Show popup
     QMessageBox::information(this, "Interview Results", message);
@@ -2,12 +2,37 @@
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QScrollArea>
+#include "services/jobanalytics.h"
+#include "ui/thememanager.h"
 
 LandingPage::LandingPage(Database *db, int userId, QWidget *parent)
     : QWidget(parent), database(db), currentUserId(userId)
 {
     setupUI();
-    setupStyles();
+    refreshMetrics();
+}
+
+void LandingPage::setUserId(int userId)
+{
+    currentUserId = userId;
+    refreshMetrics();
+}
+
+void LandingPage::refreshMetrics()
+{
+    const JobBoardSummary summary = JobAnalytics::summary(database->connection());
+    int applicationsThisWeek = 0;
+    const auto week = JobAnalytics::weekly(database->connection(), "applications", 1);
+    if (!week.empty() && week.front().first == JobAnalytics::currentWeek(database->connection()))
+    {
+        applicationsThisWeek = week.front().second;
+    }
+
+    metricsLabel->setText(QString("%1 open positions across %2 jobs  •  %3 applications this week  •  %4 applicants per position")
+                              .arg(summary.openPositions)
+                              .arg(summary.openJobs)
+                              .arg(applicationsThisWeek)
+                              .arg(summary.applicantsPerOpenPosition(), 0, 'f', 1));
 }
 
 void LandingPage::setupUI()
@@ -30,15 +55,21 @@ void LandingPage::setupUI()
     // TITLE
     titleLabel = new QLabel("Campus Hire", this);
     titleLabel->setAlignment(Qt::AlignCenter);
-    titleLabel->setStyleSheet("font-size: 32px; font-weight: bold; color: #000000;");
+    ThemeManager::setRole(titleLabel, StyleRole::Title);
     mainLayout->addWidget(titleLabel);
 
     // SUBTITLE
     subtitleLabel = new QLabel("Streamline on-campus employment journey — from discovery to on-board", this);
     subtitleLabel->setAlignment(Qt::AlignCenter);
-    subtitleLabel->setStyleSheet("font-size: 14px; color: #666666;");
+    ThemeManager::setRole(subtitleLabel, StyleRole::Subtitle);
     mainLayout->addWidget(subtitleLabel);
 
+    // LIVE METRICS - filled in by refreshMetrics()
+    metricsLabel = new QLabel(this);
+    metricsLabel->setAlignment(Qt::AlignCenter);
+    ThemeManager::setRole(metricsLabel, StyleRole::Body);
+    mainLayout->addWidget(metricsLabel);
+
     // Gap before feature boxes
     mainLayout->addSpacing(30);
 
@@ -50,24 +81,21 @@ void LandingPage::setupUI()
     // Feature 1 - Jobs Box (clickable)
     auto jobsBtn = createFeatureBox(
         "💼 On-Campus Jobs",
-        "Find the perfect position.\nFilter by eligibility.",
-        "#ffffff");
+        "Find the perfect position.\nFilter by eligibility.");
     connect(jobsBtn, &QPushButton::clicked, this, &LandingPage::jobsBoxClicked);
     featuresLayout->addWidget(jobsBtn);
 
     // Feature 2 - Onboarding Box (clickable)
     auto onboardingBtn = createFeatureBox(
         "📋 Smart On-boarding",
-        "Manage application process.\nTrack paperwork seamlessly.",
-        "#ffffff");
+        "Manage application process.\nTrack paperwork seamlessly.");
     connect(onboardingBtn, &QPushButton::clicked, this, &LandingPage::onboardingBoxClicked);
     featuresLayout->addWidget(onboardingBtn);
 
     // Feature 3 - Interview Box (clickable)
     auto interviewBtn = createFeatureBox(
         "🎯 Interview Prep",
-        "Prepare for success\nto land your dream campus job.",
-        "#ffffff");
+        "Prepare for success\nto land your dream campus job.");
     connect(interviewBtn, &QPushButton::clicked, this, &LandingPage::interviewBoxClicked);
     featuresLayout->addWidget(interviewBtn);
 
@@ -80,37 +108,13 @@ void LandingPage::setupUI()
 
     getStartedBtn = new QPushButton("Complete Profile", this);
     getStartedBtn->setMinimumSize(150, 40);
-    getStartedBtn->setStyleSheet(
-        "QPushButton {"
-        "  background-color: #ffffff;"
-        "  color: #000000;"
-        "  font-size: 14px;"
-        "  font-weight: bold;"
-        "  border: 2px solid #cccccc;"
-        "  border-radius: 5px;"
-        "}"
-        "QPushButton:hover {"
-        "  background-color: #f0f0f0;"
-        "  border: 2px solid #999999;"
-        "}");
+    ThemeManager::setRole(getStartedBtn, StyleRole::Primary);
     getStartedBtn->setCursor(Qt::PointingHandCursor);
     connect(getStartedBtn, &QPushButton::clicked, this, &LandingPage::startSurvey);
 
     skipBtn = new QPushButton("Browse Jobs", this);
     skipBtn->setMinimumSize(150, 40);
-    skipBtn->setStyleSheet(
-        "QPushButton {"
-        "  background-color: #f5f5f5;"
-        "  color: #000000;"
-        "  font-size: 14px;"
-        "  font-weight: bold;"
-        "  border: 2px solid #cccccc;"
-        "  border-radius: 5px;"
-        "}"
-        "QPushButton:hover {"
-        "  background-color: #eeeeee;"
-        "  border: 2px solid #999999;"
-        "}");
+    ThemeManager::setRole(skipBtn, StyleRole::Secondary);
     skipBtn->setCursor(Qt::PointingHandCursor);
     connect(skipBtn, &QPushButton::clicked, this, &LandingPage::skipToJobs);
 
@@ -131,7 +135,7 @@ void LandingPage::setupUI()
 }
 
 // Helper function to create feature boxes - keeps code clean and simple
-QPushButton *LandingPage::createFeatureBox(const QString &title, const QString &description, const QString &bgColor)
+QPushButton *LandingPage::createFeatureBox(const QString &title, const QString &description)
 {
     // Create the content widget that goes inside the button
     QWidget *contentWidget = new QWidget();
@@ -143,13 +147,13 @@ QPushButton *LandingPage::createFeatureBox(const QString &title, const QString &
     // Title label
     QLabel *titleLabel = new QLabel(title);
     titleLabel->setAlignment(Qt::AlignCenter);
-    titleLabel->setStyleSheet("font-size: 15px; font-weight: bold; color: #000000;");
+    ThemeManager::setRole(titleLabel, StyleRole::SectionTitle);
     contentLayout->addWidget(titleLabel);
 
     // Description label
     QLabel *descLabel = new QLabel(description);
     descLabel->setAlignment(Qt::AlignCenter);
-    descLabel->setStyleSheet("font-size: 11px; color: #666666; line-height: 1.5;");
+    ThemeManager::setRole(descLabel, StyleRole::Caption);
     contentLayout->addWidget(descLabel);
 
     // Create the clickable button
@@ -158,53 +162,8 @@ QPushButton *LandingPage::createFeatureBox(const QString &title, const QString &
     button->setMinimumSize(250, 130); // Slightly smaller for better proportions
     button->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Fixed);
 
-    // Determine hover color based on background
-    QString hoverColor = (bgColor == "#ffffff") ? "#f5f5f5" : "#eeeeee";
-
-    button->setStyleSheet(
-        QString("QPushButton {"
-                "  background-color: %1;"
-                "  border: 2px solid #cccccc;"
-                "  border-radius: 8px;"
-                "  padding: 0px;"
-                "}"
-                "QPushButton:hover {"
-                "  background-color: %2;"
-                "  border: 2px solid #999999;"
-                "}")
-            .arg(bgColor, hoverColor));
+    ThemeManager::setRole(button, StyleRole::Card);
     button->setCursor(Qt::PointingHandCursor);
 
     return button;
 }
-
-void LandingPage::setupStyles()
-{
-    setStyleSheet(
-        // Page background
-        "QWidget {"
-        "    background-color: #ffffff;"
-        "    font-family: 'Segoe UI', Arial, sans-serif;"
-        "}"
-
-        // Scroll area
-        "QScrollArea {"
-        "    border: none;"
-        "    background-color: #ffffff;"
-        "}"
-
-        // Scrollbar
-        "QScrollBar:vertical {"
-        "    background: #f5f5f5;"
-        "    width: 10px;"
-        "}"
-
-        "QScrollBar::handle:vertical {"
-        "    background: #cccccc;"
-        "    border-radius: 5px;"
-        "}"
-
-        "QScrollBar::handle:vertical:hover {"
-        "    background: #999999;"
-        "}");
-}
\ No newline at end of file
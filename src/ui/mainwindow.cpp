@@ -1,18 +1,18 @@
 #include "ui/mainwindow.h"
 #include <QVBoxLayout>
 #include <QMessageBox>
-#include <QGraphicsOpacityEffect>
-#include <QPropertyAnimation>
 #include <QApplication>
 #include <QScreen>
 #include <QToolButton>
 #include <QMenu>
+#include "ui/thememanager.h"
+#include "utils/tracer.h"
 
 MainWindow::MainWindow(Database *db, const QString &username, QWidget *parent)
     : QMainWindow(parent), database(db)
 {
+    TRACE_SCOPE("ui", "MainWindow::MainWindow");
     setupUI();
-    setupStyles();
     loadUserData(username);
 
     setWindowTitle("BMCC Campus Jobs Portal");
@@ -68,6 +68,7 @@ void MainWindow::setupUI()
 
     // Create stacked widget
     stackedWidget = new QStackedWidget(centralWidget);
+    pageTransition = new PageTransition(stackedWidget);
 
     // Create pages
     landingPage = new LandingPage(database, -1, this); // userId set later
@@ -75,7 +76,7 @@ void MainWindow::setupUI()
     applicationPage = new MyApplicationPage(database, this);
     onboardingPage = new OnboardingPage(false, this);            // Simple onboarding page
     onCampusJobsPage = new OnCampusJobsPage(database, -1, this); // userId set later
-    interviewWidget = new InterviewWidget(currentUser.getMajor(), this);
+    interviewWidget = new InterviewWidget(database, currentUser.getMajor(), this);
     accountPage = new MyAccountPage(database, this);
 
     stackedWidget->addWidget(landingPage);
@@ -97,8 +98,7 @@ void MainWindow::setupUI()
     connect(onboardingPage, &OnboardingPage::backButtonClicked, this, &MainWindow::switchToHome);
     connect(onboardingPage, &OnboardingPage::viewApplicationClicked, [this]()
             {
-        applyFadeTransition(applicationPage);
-        stackedWidget->setCurrentWidget(applicationPage); });
+        pageTransition->switchTo(applicationPage); });
 
     // Set layout
     auto layout = new QVBoxLayout(centralWidget);
@@ -119,106 +119,40 @@ void MainWindow::setupUI()
     switchToHome();
 }
 
-void MainWindow::setupStyles()
-{
-    // Modern gradient background and styling
-    setStyleSheet(
-        "QMainWindow {"
-        "   background: qlineargradient(x1:0, y1:0, x2:1, y2:1,"
-        "       stop:0 #f5f7fa, stop:1 #e8eef5);"
-        "}"
-        "QWidget {"
-        "   font-family: 'Segoe UI', Arial, sans-serif;"
-        "}"
-        "QToolBar { "
-        "   background: qlineargradient(x1:0, y1:0, x2:0, y2:1,"
-        "       stop:0 #2196F3, stop:1 #1976D2);"
-        "   spacing: 12px; "
-        "   padding: 10px 16px; "
-        "   border-bottom: 2px solid #1565C0;"
-        "}"
-        "QToolBar QToolButton { "
-        "   color: white; "
-        "   background-color: transparent; "
-        "   padding: 8px 18px; "
-        "   border: none; "
-        "   border-radius: 6px;"
-        "   font-size: 15px;"
-        "   font-weight: 600;"
-        "}"
-        "QToolBar QToolButton:hover { "
-        "   background-color: rgba(255, 255, 255, 0.2); "
-        "}"
-        "QToolBar QToolButton:pressed { "
-        "   background-color: rgba(255, 255, 255, 0.3); "
-        "}"
-        "QToolButton::menu-indicator { width: 10px; height: 10px; }"
-        "QMenu {"
-        "   background: white;"
-        "   border: 1px solid #BDBDBD;"
-        "   border-radius: 6px;"
-        "   padding: 4px 0;"
-        "   font-family: 'Segoe UI', Arial, sans-serif;"
-        "}"
-        "QMenu::item {"
-        "   padding: 10px 30px 10px 20px;"
-        "   font-size: 14px;"
-        "   color: #424242;"
-        "}"
-        "QMenu::item:selected {"
-        "   background: #E3F2FD;"
-        "   color: #1976D2;"
-        "}");
-}
-
-void MainWindow::applyFadeTransition(QWidget *widget)
-{
-    // Smooth fade-in effect
-    QGraphicsOpacityEffect *effect = new QGraphicsOpacityEffect(widget);
-    widget->setGraphicsEffect(effect);
-
-    QPropertyAnimation *animation = new QPropertyAnimation(effect, "opacity");
-    animation->setDuration(300);
-    animation->setStartValue(0.0);
-    animation->setEndValue(1.0);
-    animation->setEasingCurve(QEasingCurve::InOutQuad);
-    animation->start(QPropertyAnimation::DeleteWhenStopped);
-}
-
 void MainWindow::switchToHome()
 {
-    applyFadeTransition(landingPage);
-    stackedWidget->setCurrentWidget(landingPage);
+    TRACE_SCOPE("ui", "MainWindow::switchToHome");
+    pageTransition->switchTo(landingPage);
 }
 
 void MainWindow::switchToOnCampusJobs()
 {
-    applyFadeTransition(onCampusJobsPage);
-    stackedWidget->setCurrentWidget(onCampusJobsPage);
+    TRACE_SCOPE("ui", "MainWindow::switchToOnCampusJobs");
+    pageTransition->switchTo(onCampusJobsPage);
 }
 
 void MainWindow::switchToProfile()
 {
-    applyFadeTransition(profilePage);
-    stackedWidget->setCurrentWidget(profilePage);
+    TRACE_SCOPE("ui", "MainWindow::switchToProfile");
+    pageTransition->switchTo(profilePage);
 }
 
 void MainWindow::switchToAccount()
 {
-    applyFadeTransition(accountPage);
-    stackedWidget->setCurrentWidget(accountPage);
+    TRACE_SCOPE("ui", "MainWindow::switchToAccount");
+    pageTransition->switchTo(accountPage);
 }
 
 void MainWindow::switchToOnboarding()
 {
-    applyFadeTransition(onboardingPage);
-    stackedWidget->setCurrentWidget(onboardingPage);
+    TRACE_SCOPE("ui", "MainWindow::switchToOnboarding");
+    pageTransition->switchTo(onboardingPage);
 }
 
 void MainWindow::switchToInterview()
 {
-    applyFadeTransition(interviewWidget);
-    stackedWidget->setCurrentWidget(interviewWidget);
+    TRACE_SCOPE("ui", "MainWindow::switchToInterview");
+    pageTransition->switchTo(interviewWidget);
 }
 
 void MainWindow::handleLogout()
@@ -232,35 +166,19 @@ void MainWindow::handleLogout()
     msgBox.setStandardButtons(QMessageBox::Yes | QMessageBox::No);
     msgBox.setDefaultButton(QMessageBox::No);
 
-    // Style the message box
-    msgBox.setStyleSheet(
-        "QMessageBox {"
-        "   background: white;"
-        "   font-family: 'Segoe UI', Arial, sans-serif;"
-        "}"
-        "QLabel { font-size: 14px; color: #424242; }"
-        "QPushButton {"
-        "   background: qlineargradient(x1:0, y1:0, x2:0, y2:1, stop:0 #2196F3, stop:1 #1976D2);"
-        "   color: white;"
-        "   border: none;"
-        "   border-radius: 6px;"
-        "   padding: 8px 20px;"
-        "   font-size: 14px;"
-        "   font-weight: 600;"
-        "   min-width: 80px;"
-        "}"
-        "QPushButton:hover {"
-        "   background: qlineargradient(x1:0, y1:0, x2:0, y2:1, stop:0 #1976D2, stop:1 #0D47A1);"
-        "}");
+    ThemeManager::setRole(&msgBox, StyleRole::Confirm);
 
     if (msgBox.exec() == QMessageBox::Yes)
     {
+        database->clearUserCache();
         close();
     }
 }
 
 void MainWindow::loadUserData(const QString &email)
 {
+    TRACE_SCOPE("ui", "MainWindow::loadUserData");
+    // One users read per login; the pages below share the cached snapshot
     currentUser = database->getUserData(email);
     int uid = currentUser.getId();
 
@@ -270,12 +188,11 @@ void MainWindow::loadUserData(const QString &email)
     applicationPage->setUserId(uid);
     accountPage->setUserId(uid);
 
-    // Update onCampusJobsPage with new userId
-    delete onCampusJobsPage;
-    onCampusJobsPage = new OnCampusJobsPage(database, uid, this);
-    stackedWidget->insertWidget(1, onCampusJobsPage);
+    onCampusJobsPage->setUserId(uid);
 
-    // Optionally refresh interviewWidget if needed
+    // Draw interview questions for the student's major
+    interviewWidget->setDegree(currentUser.getMajor());
+    interviewWidget->setUserId(uid);
 }
 
 void MainWindow::checkAndShowLandingPage()
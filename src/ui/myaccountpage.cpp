@@ -1,4 +1,5 @@
 #include "ui/myaccountpage.h"
+#include "ui/thememanager.h"
 #include <QMessageBox>
 
 MyAccountPage::MyAccountPage(Database *db, QWidget *parent)
@@ -22,7 +23,7 @@ void MyAccountPage::setupUI()
     // Title
     auto *title = new QLabel("My Account", this);
     title->setAlignment(Qt::AlignCenter);
-    title->setStyleSheet("font-size: 22px; font-weight: bold;");
+    ThemeManager::setRole(title, StyleRole::Title);
     mainLayout->addWidget(title);
 
     // Section 1: Login Information
@@ -131,9 +132,11 @@ void MyAccountPage::loadAccountData()
 {
     if (!database || currentUserId < 0)
         return;
-    User user = database->getUserDataById(currentUserId);
-    usernameEdit->setText(user.getEmail());
-    emailEdit->setText(user.getEmail());
+    QSharedPointer<const User> user = database->userSnapshot(currentUserId);
+    if (!user)
+        return;
+    usernameEdit->setText(user->getEmail());
+    emailEdit->setText(user->getEmail());
     // TODO: Load notifications from DB when fields are available
 }
 
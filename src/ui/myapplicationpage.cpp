@@ -1,26 +1,15 @@
 #include "ui/myapplicationpage.h"
+#include "ui/thememanager.h"
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QHeaderView>
 #include <QMessageBox>
 #include <QFileInfo>
-#include <QGraphicsOpacityEffect>
-#include <QPropertyAnimation>
 
 MyApplicationPage::MyApplicationPage(Database *db, QWidget *parent)
     : QWidget(parent), database(db), currentUserId(-1)
 {
     setupUI();
-    setupStyles();
-
-    // Fade-in
-    auto *effect = new QGraphicsOpacityEffect(this);
-    setGraphicsEffect(effect);
-    auto *anim = new QPropertyAnimation(effect, "opacity");
-    anim->setDuration(350);
-    anim->setStartValue(0.0);
-    anim->setEndValue(1.0);
-    anim->start(QPropertyAnimation::DeleteWhenStopped);
 }
 
 void MyApplicationPage::setupUI()
@@ -41,9 +30,9 @@ void MyApplicationPage::setupUI()
     {
         lbl->setAlignment(Qt::AlignCenter);
     }
-    pendingDocsLabel->setStyleSheet("background:#FFF9C4; padding:15px; border-radius:8px; font-weight:bold; border:2px solid #FBC02D;");
-    completedDocsLabel->setStyleSheet("background:#C8E6C9; padding:15px; border-radius:8px; font-weight:bold; border:2px solid #43A047;");
-    processingDocsLabel->setStyleSheet("background:#BBDEFB; padding:15px; border-radius:8px; font-weight:bold; border:2px solid #1976D2;");
+    ThemeManager::setRole(pendingDocsLabel, StyleRole::StatusPending);
+    ThemeManager::setRole(completedDocsLabel, StyleRole::StatusCompleted);
+    ThemeManager::setRole(processingDocsLabel, StyleRole::StatusProcessing);
 
     statusLayout->addWidget(pendingDocsLabel);
     statusLayout->addWidget(completedDocsLabel);
@@ -76,21 +65,6 @@ void MyApplicationPage::setupUI()
     connect(onboardingButton, &QPushButton::clicked, this, &MyApplicationPage::showOnboardingStatus);
 }
 
-void MyApplicationPage::setupStyles()
-{
-    setStyleSheet(
-        "QWidget { background: qlineargradient(x1:0,y1:0,x2:0,y2:1, stop:0 #ffffff, stop:1 #f8f9fa);"
-        " font-family: 'Segoe UI', Arial, sans-serif; }"
-        "QGroupBox { font-weight: 600; font-size: 14px; border: 2px solid #BDBDBD; border-radius: 10px;"
-        " margin-top: 14px; padding-top: 12px; background: white; }"
-        "QGroupBox::title { left: 15px; padding: 0 8px; color: #1976D2; background: white; }"
-        "QPushButton { background: qlineargradient(x1:0,y1:0,x2:0,y2:1, stop:0 #2196F3, stop:1 #1976D2); color:white;"
-        " padding: 12px 24px; border-radius: 8px; font-weight: 600; font-size: 14px; border: none; min-height: 40px; }"
-        "QPushButton:hover { background: qlineargradient(x1:0,y1:0,x2:0,y2:1, stop:0 #1976D2, stop:1 #0D47A1); }"
-        "QTableWidget { border: 1px solid #E0E0E0; border-radius: 8px; gridline-color: #F5F5F5; background: white; }"
-        "QHeaderView::section { background-color: #F5F5F5; padding: 10px; border: none; font-weight: bold; color: #424242; }");
-}
-
 void MyApplicationPage::setUserId(int userId)
 {
     currentUserId = userId;
@@ -4,24 +4,11 @@
 #include <QMessageBox>
 #include <QScrollArea>
 #include <QScrollBar>
-#include <QSqlQuery>
-#include <QGraphicsOpacityEffect>
-#include <QPropertyAnimation>
 
 MyProfilePage::MyProfilePage(Database *db, QWidget *parent)
     : QWidget(parent), database(db), currentUserId(-1)
 {
     setupUI();
-    setupStyles();
-
-    // Smooth fade-in when shown
-    auto *effect = new QGraphicsOpacityEffect(this);
-    setGraphicsEffect(effect);
-    auto *anim = new QPropertyAnimation(effect, "opacity");
-    anim->setDuration(350);
-    anim->setStartValue(0.0);
-    anim->setEndValue(1.0);
-    anim->start(QPropertyAnimation::DeleteWhenStopped);
 }
 
 void MyProfilePage::setUserId(int userId)
@@ -164,77 +151,51 @@ void MyProfilePage::setupUI()
             { loadUser(); });
 }
 
-void MyProfilePage::setupStyles()
-{
-    setStyleSheet(
-        "QWidget {"
-        "  background: qlineargradient(x1:0, y1:0, x2:0, y2:1, stop:0 #ffffff, stop:1 #f8f9fa);"
-        "  font-family: 'Segoe UI', Arial, sans-serif;"
-        "}"
-        "QGroupBox { font-weight: 600; font-size: 14px; border: 2px solid #BDBDBD; border-radius: 10px;"
-        "  margin-top: 14px; padding-top: 12px; background: white; }"
-        "QGroupBox::title { left: 15px; padding: 0 8px; color: #1976D2; background: white; }"
-        "QLineEdit, QDateEdit, QComboBox { padding: 12px; border: 2px solid #E0E0E0; border-radius: 8px; background: white; font-size: 14px; }"
-        "QLineEdit:focus, QDateEdit:focus, QComboBox:focus { border: 2px solid #2196F3; background: #f8fcff; }"
-        "QTextEdit { padding: 8px; border: 2px solid #E0E0E0; border-radius: 8px; background: white; font-size: 14px; }"
-        "QTextEdit:focus { border: 2px solid #2196F3; background: #f8fcff; }"
-        "QPushButton { background: qlineargradient(x1:0,y1:0,x2:0,y2:1, stop:0 #2196F3, stop:1 #1976D2); color:white;"
-        "  padding: 12px 24px; border-radius: 8px; font-weight: 600; font-size: 14px; border: none; min-height: 40px; }"
-        "QPushButton:hover { background: qlineargradient(x1:0,y1:0,x2:0,y2:1, stop:0 #1976D2, stop:1 #0D47A1); }");
-}
-
 void MyProfilePage::loadUser()
 {
     if (!database || currentUserId < 0)
         return;
 
-    User user = database->getUserDataById(currentUserId);
+    // Shared snapshot from the session cache; no extra query per page
+    QSharedPointer<const User> user = database->userSnapshot(currentUserId);
+    if (!user)
+        return;
+
     // Personal
-    fullNameEdit->setText(user.getFullName());
-    emplidEdit->setText(user.getEmplid());
-    emailEdit->setText(user.getEmail());
+    fullNameEdit->setText(user->getFullName());
+    emplidEdit->setText(user->getEmplid());
+    emailEdit->setText(user->getEmail());
 
     // Academic
-    int majorIndex = majorCombo->findText(user.getMajor(), Qt::MatchFixedString);
+    int majorIndex = majorCombo->findText(user->getMajor(), Qt::MatchFixedString);
     if (majorIndex >= 0)
         majorCombo->setCurrentIndex(majorIndex);
-    gpaEdit->setText(user.getGpa());
-    QDate parsed = QDate::fromString(user.getGradDate(), "yyyy-MM-dd");
+    QDate parsed = QDate::fromString(user->getGradDate(), "yyyy-MM-dd");
     if (!parsed.isValid())
-        parsed = QDate::fromString(user.getGradDate(), "MM/yyyy");
+        parsed = QDate::fromString(user->getGradDate(), "MM/yyyy");
     if (parsed.isValid())
         gradDateEdit->setDate(parsed);
 
-    // Load profile data from survey
-    QSqlQuery query;
-    query.prepare("SELECT is_international_student, resume_path, transcript_path, "
-                  "parsed_gpa, parsed_courses, major FROM users WHERE id = ?");
-    query.addBindValue(currentUserId);
-
-    if (query.exec() && query.next())
+    // Profile data from survey
+    bool isInternational = user->getIsInternationalStudent();
+    QString resumePath = user->getResumePath();
+    QString transcriptPath = user->getTranscriptPath();
+    QString parsedCourses = user->getParsedCourses();
+
+    // International and Work Study status
+    intlYesRadio->setChecked(isInternational);
+    intlNoRadio->setChecked(!isInternational);
+    resumePathEdit->setText(resumePath.isEmpty() ? "No resume uploaded" : resumePath);
+    transcriptPathEdit->setText(transcriptPath.isEmpty() ? "No transcript uploaded" : transcriptPath);
+    gpaEdit->setText(user->getParsedGPA());
+    coursesEdit->setPlainText(parsedCourses);
+    degreeEdit->setText(user->getMajor());
+
+    // Parse credits from courses if available
+    if (!parsedCourses.isEmpty())
     {
-        bool isInternational = query.value(0).toBool();
-        QString resumePath = query.value(1).toString();
-        QString transcriptPath = query.value(2).toString();
-        QString parsedGPA = query.value(3).toString();
-        QString parsedCourses = query.value(4).toString();
-        QString major = query.value(5).toString();
-
-        // International and Work Study status
-        intlYesRadio->setChecked(isInternational);
-        intlNoRadio->setChecked(!isInternational);
-        resumePathEdit->setText(resumePath.isEmpty() ? "No resume uploaded" : resumePath);
-        transcriptPathEdit->setText(transcriptPath.isEmpty() ? "No transcript uploaded" : transcriptPath);
-        gpaEdit->setText(parsedGPA);
-        coursesEdit->setPlainText(parsedCourses);
-        degreeEdit->setText(major);
-
-        // Parse credits from courses if available
-        if (!parsedCourses.isEmpty())
-        {
-            int courseCount = parsedCourses.split(",").count();
-            creditsTakenEdit->setText(QString::number(courseCount * 3));
-        }
+        int courseCount = parsedCourses.split(",").count();
+        creditsTakenEdit->setText(QString::number(courseCount * 3));
     }
 }
 
@@ -255,13 +216,7 @@ void MyProfilePage::handleSaveProfile()
     database->updateInternationalStatus(currentUserId, isInternational);
 
     // Update basic info
-    QSqlQuery query;
-    query.prepare("UPDATE users SET full_name = ?, parsed_gpa = ? WHERE id = ?");
-    query.addBindValue(fullName);
-    query.addBindValue(gpa);
-    query.addBindValue(currentUserId);
-
-    if (query.exec())
+    if (database->updateNameAndParsedGpa(currentUserId, fullName, gpa))
     {
         QMessageBox::information(this, "Profile Updated",
                                  "Your profile information has been saved successfully!");
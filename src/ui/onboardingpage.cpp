@@ -1,4 +1,5 @@
 #include "onboardingpage.h"
+#include "thememanager.h"
 #include <QMessageBox>
 
 // Constructor
@@ -19,13 +20,13 @@ void OnboardingPage::setupUI()
 
     // Title
     titleLabel = new QLabel("Student Onboarding", this);
-    titleLabel->setStyleSheet("font-size: 24px; font-weight: bold;");
+    ThemeManager::setRole(titleLabel, StyleRole::Title);
     titleLabel->setAlignment(Qt::AlignCenter);
     mainLayout->addWidget(titleLabel);
 
     // Student type label
     studentTypeLabel = new QLabel(this);
-    studentTypeLabel->setStyleSheet("font-size: 16px;");
+    ThemeManager::setRole(studentTypeLabel, StyleRole::Subtitle);
     studentTypeLabel->setAlignment(Qt::AlignCenter);
     mainLayout->addWidget(studentTypeLabel);
 
@@ -49,7 +50,7 @@ void OnboardingPage::setupUI()
 
     // Documents section
     QLabel *docTitle = new QLabel("Required Documents:", this);
-    docTitle->setStyleSheet("font-size: 16px; font-weight: bold;");
+    ThemeManager::setRole(docTitle, StyleRole::SectionTitle);
     mainLayout->addWidget(docTitle);
 
     documentList = new QListWidget(this);
@@ -60,7 +61,7 @@ void OnboardingPage::setupUI()
 
     // Steps section
     QLabel *stepsTitle = new QLabel("Onboarding Steps:", this);
-    stepsTitle->setStyleSheet("font-size: 16px; font-weight: bold;");
+    ThemeManager::setRole(stepsTitle, StyleRole::SectionTitle);
     mainLayout->addWidget(stepsTitle);
 
     stepsList = new QListWidget(this);
@@ -1,22 +1,87 @@
 #include "ui/oncampusjobspage.h"
+#include "ui/thememanager.h"
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QGroupBox>
 #include <QMessageBox>
 #include <QFormLayout>
-#include <QGraphicsOpacityEffect>
-#include <QPropertyAnimation>
 #include <QTextBrowser>
+#include <QScrollBar>
+#include <QSignalBlocker>
+#include <algorithm>
+#include <iterator>
+#include "services/jobstatusscheduler.h"
+#include "utils/tracer.h"
 
 // JobApplicationDialog Implementation
 JobApplicationDialog::JobApplicationDialog(Database *db, int userId, const Job &job, QWidget *parent)
-    : QDialog(parent), database(db), userId(userId), currentJob(job)
+    : QDialog(parent), database(db), userId(userId), currentJob(job), closeAfterSave(false)
 {
     setupUI();
+    setupDraft();
     setWindowTitle("Apply for " + job.getTitle());
     setMinimumSize(600, 700);
 }
 
+void JobApplicationDialog::setupDraft()
+{
+    autosaver = new DraftAutosaver(database, userId, currentJob.getId(), this);
+    autosaver->addField("resume_path", [this]()
+                        { return resumePathEdit->text(); });
+    autosaver->addField("cover_letter_path", [this]()
+                        { return coverLetterPathEdit->text(); });
+    autosaver->addField("why_interested", [this]()
+                        { return whyInterestedEdit->toPlainText(); });
+    autosaver->addField("availability", [this]()
+                        { return availabilityEdit->toPlainText(); });
+    autosaver->addField("references", [this]()
+                        { return referencesEdit->toPlainText(); });
+
+    // Restored before connecting, so filling the editors queues nothing
+    const QHash<QString, QString> draft = autosaver->restore();
+    if (!draft.isEmpty())
+    {
+        resumePathEdit->setText(draft.value("resume_path"));
+        coverLetterPathEdit->setText(draft.value("cover_letter_path"));
+        whyInterestedEdit->setPlainText(draft.value("why_interested"));
+        availabilityEdit->setPlainText(draft.value("availability"));
+        referencesEdit->setPlainText(draft.value("references"));
+        draftStatus->setText("Restored your saved draft");
+    }
+
+    connect(resumePathEdit, &QLineEdit::textChanged, this, [this]()
+            { autosaver->markChanged("resume_path"); });
+    connect(coverLetterPathEdit, &QLineEdit::textChanged, this, [this]()
+            { autosaver->markChanged("cover_letter_path"); });
+    connect(whyInterestedEdit, &QTextEdit::textChanged, this, [this]()
+            { autosaver->markChanged("why_interested"); });
+    connect(availabilityEdit, &QTextEdit::textChanged, this, [this]()
+            { autosaver->markChanged("availability"); });
+    connect(referencesEdit, &QTextEdit::textChanged, this, [this]()
+            { autosaver->markChanged("references"); });
+    connect(autosaver, &DraftAutosaver::saved, this, [this](const QDateTime &when)
+            {
+        draftStatus->setText("Draft saved " + when.toString("h:mm AP"));
+        if (closeAfterSave && !autosaver->isSaving())
+        {
+            finishSaveDraft(true);
+        } });
+    connect(autosaver, &DraftAutosaver::saveFailed, this, [this]()
+            {
+        draftStatus->setText("Draft could not be saved; it will be retried");
+        if (closeAfterSave)
+        {
+            finishSaveDraft(false);
+        } });
+}
+
+void JobApplicationDialog::done(int result)
+{
+    closeAfterSave = false;
+    autosaver->flush();
+    QDialog::done(result);
+}
+
 void JobApplicationDialog::setupUI()
 {
     auto layout = new QVBoxLayout(this);
@@ -60,6 +125,12 @@ void JobApplicationDialog::setupUI()
     availabilityEdit->setPlaceholderText("e.g., Monday-Friday 2pm-6pm, flexible on weekends");
     availabilityEdit->setMaximumHeight(80);
     layout->addWidget(availabilityEdit);
+    // Shows how the text will be matched against shifts
+    availabilityPreview = new QLabel(this);
+    availabilityPreview->setWordWrap(true);
+    ThemeManager::setRole(availabilityPreview, StyleRole::Hint);
+    layout->addWidget(availabilityPreview);
+    connect(availabilityEdit, &QTextEdit::textChanged, this, &JobApplicationDialog::updateAvailabilityPreview);
 
     // References
     layout->addWidget(new QLabel("References (2 required):"));
@@ -74,16 +145,32 @@ void JobApplicationDialog::setupUI()
 
     // Buttons
     auto btnLayout = new QHBoxLayout();
-    auto saveBtn = new QPushButton("Save Draft", this);
+    saveBtn = new QPushButton("Save Draft", this);
     connect(saveBtn, &QPushButton::clicked, this, &JobApplicationDialog::saveDraft);
     auto submitBtn = new QPushButton("Submit Application", this);
     connect(submitBtn, &QPushButton::clicked, this, &JobApplicationDialog::submitApplication);
+    draftStatus = new QLabel(this);
+    ThemeManager::setRole(draftStatus, StyleRole::Hint);
     btnLayout->addWidget(saveBtn);
+    btnLayout->addWidget(draftStatus);
     btnLayout->addStretch();
     btnLayout->addWidget(submitBtn);
     layout->addLayout(btnLayout);
 }
 
+void JobApplicationDialog::updateAvailabilityPreview()
+{
+    const QString text = availabilityEdit->toPlainText().trimmed();
+    bool ok = false;
+    const Availability availability = Availability::parse(text, &ok);
+    if (text.isEmpty())
+        availabilityPreview->clear();
+    else if (!ok || availability.isEmpty())
+        availabilityPreview->setText("Add days and times, e.g. \"Tue/Thu 9am-1pm\", so employers can match your hours");
+    else
+        availabilityPreview->setText("Read as: " + availability.toString());
+}
+
 void JobApplicationDialog::browseResume()
 {
     QString file = QFileDialog::getOpenFileName(this, "Select Resume", "", "PDF Files (*.pdf);;All Files (*)");
@@ -131,6 +218,7 @@ void JobApplicationDialog::submitApplication()
 
     if (success)
     {
+        autosaver->discard();
         QMessageBox::information(this, "Application Submitted",
                                  "Your application has been submitted successfully! You will receive an email confirmation shortly.");
         accept();
@@ -143,8 +231,32 @@ void JobApplicationDialog::submitApplication()
 
 void JobApplicationDialog::saveDraft()
 {
+    // The dialog closes once every queued change is on disk (see
+    // setupDraft); writes to an in-memory database finish inside flush()
+    closeAfterSave = true;
+    saveBtn->setEnabled(false);
+    draftStatus->setText("Saving draft...");
+    autosaver->flush();
+    if (closeAfterSave && !autosaver->isSaving())
+    {
+        finishSaveDraft(true);
+    }
+}
+
+void JobApplicationDialog::finishSaveDraft(bool ok)
+{
+    closeAfterSave = false;
+    saveBtn->setEnabled(true);
+    if (!ok)
+    {
+        QMessageBox::warning(this, "Draft Not Saved",
+                             "Your application draft could not be saved. It will be retried in the background; "
+                             "keep this window open or try again.");
+        return;
+    }
     QMessageBox::information(this, "Draft Saved", "Your application draft has been saved. You can continue later.");
-    accept();
+    // Accepted means submitted to the caller; a saved draft just closes
+    reject();
 }
 
 // ExpressInterestDialog Implementation
@@ -175,7 +287,7 @@ void ExpressInterestDialog::setupUI()
     auto btnLayout = new QHBoxLayout();
     auto cancelBtn = new QPushButton("Cancel", this);
     auto submitBtn = new QPushButton("Submit Interest", this);
-    submitBtn->setStyleSheet("background: qlineargradient(x1:0,y1:0,x2:0,y2:1, stop:0 #2196F3, stop:1 #1976D2); color:white; padding:10px; border-radius:6px; font-weight:600;");
+    ThemeManager::setRole(submitBtn, StyleRole::Primary);
     connect(cancelBtn, &QPushButton::clicked, this, &ExpressInterestDialog::reject);
     connect(submitBtn, &QPushButton::clicked, this, &ExpressInterestDialog::submitInterest);
     btnLayout->addStretch();
@@ -193,7 +305,7 @@ void ExpressInterestDialog::submitInterest()
         return;
     }
 
-    bool success = database->expressInterest(userId, currentJob.getId(), message);
+    bool success = database->expressInterest(userId, currentJob.getId(), message, notifyCheckbox->isChecked());
     if (success)
     {
         QMessageBox::information(this, "Interest Recorded",
@@ -208,18 +320,32 @@ void ExpressInterestDialog::submitInterest()
 
 // OnCampusJobsPage Implementation
 OnCampusJobsPage::OnCampusJobsPage(Database *db, int userId, QWidget *parent)
-    : QWidget(parent), database(db), currentUserId(userId)
+    : QWidget(parent), database(db), currentUserId(userId), jobsExhausted(false), haveOpenJobsSnapshot(false),
+      catalogPosition(0), pagingCatalog(false), fuzzySearch(new FuzzyJobSearch(db, this)), autocomplete(new AutocompleteService(db, this))
 {
+    TRACE_SCOPE("ui", "OnCampusJobsPage::OnCampusJobsPage");
     setupUI();
-    setupStyles();
 
     // Get user's saved jobs for bookmarking feature
     savedJobIds = database->getSavedJobs(userId);
 
+    // Statuses change as deadlines pass; reload so the list stays accurate
+    connect(database, &Database::jobsChanged, this, &OnCampusJobsPage::loadJobs);
+
+    // Suggestions are built off the UI thread; the box works without them meanwhile
+    autocomplete->rebuildAsync();
+
     // Load jobs with the selected filter (defaults to "All Students")
     loadJobs();
 }
 
+void OnCampusJobsPage::setUserId(int userId)
+{
+    currentUserId = userId;
+    savedJobIds = database->getSavedJobs(userId);
+    clearFilters();
+}
+
 void OnCampusJobsPage::setupUI()
 {
     auto mainLayout = new QVBoxLayout(this);
@@ -229,13 +355,13 @@ void OnCampusJobsPage::setupUI()
     // TOP PANEL - Compact Eligibility Filter
     auto filterPanel = new QWidget();
     filterPanel->setMaximumHeight(40);
-    filterPanel->setStyleSheet("QWidget { background: #FFFFFF; border-bottom: 1px solid #E0E0E0; }");
+    ThemeManager::setRole(filterPanel, StyleRole::Toolbar);
     auto filterLayout = new QHBoxLayout(filterPanel);
     filterLayout->setContentsMargins(15, 0, 15, 0);
     filterLayout->setSpacing(12);
 
     auto filterLabel = new QLabel("Show:", this);
-    filterLabel->setStyleSheet("font-size: 12px; color: #424242; font-weight: 500;");
+    ThemeManager::setRole(filterLabel, StyleRole::Caption);
     filterLayout->addWidget(filterLabel);
 
     // Create radio buttons for eligibility
@@ -264,15 +390,38 @@ void OnCampusJobsPage::setupUI()
     leftLayout->setContentsMargins(15, 15, 15, 15);
     leftLayout->setSpacing(10);
 
+    // Search box: matches titles, departments and skills, typos included
+    searchEdit = new QLineEdit(this);
+    searchEdit->setPlaceholderText("Search jobs, departments or skills");
+    searchEdit->setClearButtonEnabled(true);
+    connect(searchEdit, &QLineEdit::textChanged, this, &OnCampusJobsPage::onSearchTextChanged);
+    leftLayout->addWidget(searchEdit);
+
+    // Completions come ranked from the trie, so the completer shows them as-is
+    suggestionModel = new QStringListModel(this);
+    searchCompleter = new QCompleter(suggestionModel, this);
+    searchCompleter->setCompletionMode(QCompleter::UnfilteredPopupCompletion);
+    searchCompleter->setCaseSensitivity(Qt::CaseInsensitive);
+    searchCompleter->setWidget(searchEdit);
+    connect(searchEdit, &QLineEdit::textEdited, this, &OnCampusJobsPage::onSearchTextEdited);
+    connect(searchEdit, &QLineEdit::returnPressed, this, &OnCampusJobsPage::onSearchSubmitted);
+    connect(searchCompleter, QOverload<const QString &>::of(&QCompleter::activated), this, [this](const QString &text)
+            {
+        searchEdit->setText(text);
+        onSearchSubmitted(); });
+
     // Results count
     resultsCountLabel = new QLabel("Showing 0 jobs");
-    resultsCountLabel->setStyleSheet("color: #757575; font-size: 12px;");
+    ThemeManager::setRole(resultsCountLabel, StyleRole::Hint);
     leftLayout->addWidget(resultsCountLabel);
 
     // Job list
     jobListWidget = new QListWidget(this);
     jobListWidget->setSpacing(8);
     connect(jobListWidget, &QListWidget::itemClicked, this, &OnCampusJobsPage::onJobCardClicked);
+    // Fetch the next page when the list is scrolled near the end
+    connect(jobListWidget->verticalScrollBar(), &QScrollBar::valueChanged,
+            this, &OnCampusJobsPage::onJobListScrolled);
     leftLayout->addWidget(jobListWidget);
 
     leftPanel->setMinimumWidth(300);
@@ -285,13 +434,13 @@ void OnCampusJobsPage::setupUI()
 
     // Job title
     jobTitleLabel = new QLabel("Select a job to view details");
-    jobTitleLabel->setStyleSheet("font-size: 18px; font-weight: 600; color: #1976D2;");
+    ThemeManager::setRole(jobTitleLabel, StyleRole::Heading);
     jobTitleLabel->setWordWrap(true);
     detailLayout->addWidget(jobTitleLabel);
 
     // Department and status
     jobDepartmentLabel = new QLabel("");
-    jobDepartmentLabel->setStyleSheet("font-size: 13px; color: #757575;");
+    ThemeManager::setRole(jobDepartmentLabel, StyleRole::Subtitle);
     detailLayout->addWidget(jobDepartmentLabel);
 
     statusBadgeLabel = new QLabel("");
@@ -300,7 +449,7 @@ void OnCampusJobsPage::setupUI()
     // Eligibility info for selected job
     eligibilityInfoLabel = new QLabel("");
     eligibilityInfoLabel->setVisible(false);
-    eligibilityInfoLabel->setStyleSheet("font-size: 12px; color: #424242; margin-top: 8px;");
+    ThemeManager::setRole(eligibilityInfoLabel, StyleRole::Body);
     eligibilityInfoLabel->setWordWrap(true);
     detailLayout->addWidget(eligibilityInfoLabel);
 
@@ -337,13 +486,13 @@ void OnCampusJobsPage::setupUI()
 
     // Onboarding Documents Box - Fixed at bottom
     QWidget *onboardingBox = new QWidget(this);
-    onboardingBox->setStyleSheet("background: #FFF9C4; border: 2px solid #F57C00; border-radius: 6px; padding: 10px;");
+    ThemeManager::setRole(onboardingBox, StyleRole::Notice);
     QVBoxLayout *onboardingLayout = new QVBoxLayout(onboardingBox);
     onboardingLayout->setSpacing(6);
     onboardingLayout->setContentsMargins(10, 10, 10, 10);
 
     QLabel *onboardingTitle = new QLabel("📋 Prepare If Hired:", this);
-    onboardingTitle->setStyleSheet("font-size: 13px; font-weight: 700; color: #E65100; padding: 0;");
+    ThemeManager::setRole(onboardingTitle, StyleRole::NoticeTitle);
     onboardingLayout->addWidget(onboardingTitle);
 
     QLabel *onboardingText = new QLabel(
@@ -352,7 +501,7 @@ void OnCampusJobsPage::setupUI()
         "• Bank Account Info<br>"
         "• W-4 Tax Form",
         this);
-    onboardingText->setStyleSheet("font-size: 11px; color: #333; line-height: 1.4; padding: 0;");
+    ThemeManager::setRole(onboardingText, StyleRole::NoticeText);
     onboardingText->setWordWrap(true);
     onboardingLayout->addWidget(onboardingText);
 
@@ -373,69 +522,109 @@ void OnCampusJobsPage::setupUI()
     mainLayout->addWidget(splitter);
 }
 
-void OnCampusJobsPage::setupStyles()
+void OnCampusJobsPage::loadJobs()
 {
-    setStyleSheet(
-        "QWidget { background: #FAFAFA; font-family: 'Segoe UI', Arial, sans-serif; }"
-        "QLineEdit { padding: 10px; border: 2px solid #E0E0E0; border-radius: 8px; background: white; font-size: 14px; }"
-        "QLineEdit:focus { border: 2px solid #2196F3; }"
-        "QComboBox, QPushButton { padding: 8px 16px; border-radius: 6px; font-size: 14px; }"
-        "QPushButton { background: #2196F3; color: white; border: none; font-weight: 600; }"
-        "QPushButton:hover { background: #1976D2; }"
-        "QListWidget { background: white; border: 1px solid #E0E0E0; border-radius: 8px; padding: 4px; }"
-        "QListWidget::item { border-left: 4px solid transparent; padding: 0px; margin: 4px; background: white; border-radius: 6px; border: 1px solid #E0E0E0; }"
-        "QListWidget::item:hover { border-left: 4px solid #2196F3; background: #F5F5F5; box-shadow: 0 2px 4px rgba(0,0,0,0.1); }"
-        "QListWidget::item:selected { border-left: 4px solid #1976D2; background: #E3F2FD; border: 1px solid #2196F3; }"
-        "QRadioButton { font-size: 12px; color: #424242; spacing: 6px; }"
-        "QRadioButton::indicator { width: 14px; height: 14px; }"
-        "QRadioButton:hover { color: #2196F3; }"
-        "QTextBrowser { background: white; border: 1px solid #E0E0E0; border-radius: 6px; padding: 12px; line-height: 1.5; }");
+    TRACE_SCOPE("ui", "OnCampusJobsPage::loadJobs");
+    // Job rows changed (or first load): forget the in-memory copy and re-query
+    openJobsSnapshot.clear();
+    haveOpenJobsSnapshot = false;
+    // A stale catalog is rewritten in the background; pages come from SQL
+    // until it is mapped, and from the catalog once the listing restarts
+    catalog.refresh(database, this, [this]()
+                    {
+        if (!pagingCatalog)
+        {
+            catalog.refresh(database);
+        } });
+    applyFilters();
 }
 
-void OnCampusJobsPage::loadJobs()
+JobSearchOptions OnCampusJobsPage::activeFilterOptions() const
 {
-    // Load all jobs from database and filter to show only open positions
-    auto allJobs = database->getJobs();
-    std::vector<Job> openJobs;
+    // Only positions still taking applications are listed
+    JobSearchOptions options;
+    options.statuses = JobFilters::kAcceptingApplications;
+    options.workStudyOnly = workStudyBtn->isChecked();
+    options.internationalOnly = intlBtn->isChecked();
+    return options;
+}
 
-    for (const auto &job : allJobs)
+void OnCampusJobsPage::showEmptyJobList()
+{
+    // Show helpful message if no jobs match the filter
+    auto item = new QListWidgetItem();
+    QString emptyMsg = "<div style='padding:40px; text-align:center; color:#757575;'>"
+                       "<div style='font-size:48px; margin-bottom:10px;'>🔍</div>"
+                       "<div style='font-size:16px; font-weight:600; margin-bottom:8px;'>No jobs found</div>"
+                       "<div style='font-size:13px;'>Try selecting a different filter option</div>"
+                       "</div>";
+    auto label = new QLabel(emptyMsg);
+    label->setAlignment(Qt::AlignCenter);
+    item->setSizeHint(QSize(0, 200));
+    jobListWidget->addItem(item);
+    jobListWidget->setItemWidget(item, label);
+}
+
+void OnCampusJobsPage::loadNextJobPage()
+{
+    TRACE_SCOPE("ui", "OnCampusJobsPage::loadNextJobPage");
+    if (jobsExhausted)
+        return;
+
+    std::vector<Job> page;
+    if (pagingCatalog)
     {
-        // Only show jobs with Open status
-        if (job.getStatus() == JobStatus::Open)
+        // Next entries of the filter's index; only these records are decoded
+        const JobSearchOptions options = activeFilterOptions();
+        const CatalogSnapshot::View view = CatalogSnapshot::viewFor(options.workStudyOnly, options.internationalOnly);
+        const int end = std::min(catalogPosition + kJobPageSize, catalog.count(view));
+        for (; catalogPosition < end; ++catalogPosition)
         {
-            openJobs.push_back(job);
+            Job job = catalog.job(catalog.recordAt(view, catalogPosition));
+            if (job.getId() >= 0)
+                page.push_back(std::move(job));
         }
+        jobsExhausted = catalogPosition >= catalog.count(view);
+    }
+    else
+    {
+        page = visitJobFilter(activeFilterOptions(), [this](const auto &filter)
+                              { return database->getJobsPage(filter, jobCursor, kJobPageSize); });
+        jobsExhausted = static_cast<int>(page.size()) < kJobPageSize;
     }
 
-    currentJobs = openJobs;
+    appendJobCards(page);
+    currentJobs.insert(currentJobs.end(), page.begin(), page.end());
+    updateResultsCount();
 
-    // Apply the currently selected eligibility filter
-    applyFilters();
+    if (jobsExhausted && allStudentsBtn->isChecked())
+    {
+        openJobsSnapshot = currentJobs;
+        haveOpenJobsSnapshot = true;
+    }
 }
 
-void OnCampusJobsPage::updateJobList(const std::vector<Job> &jobs)
+void OnCampusJobsPage::updateResultsCount()
 {
-    jobListWidget->clear();
-
-    resultsCountLabel->setText(QString("Showing %1 job%2").arg(jobs.size()).arg(jobs.size() == 1 ? "" : "s"));
+    resultsCountLabel->setText(QString("Showing %1 job%2%3")
+                                   .arg(currentJobs.size())
+                                   .arg(currentJobs.size() == 1 ? "" : "s")
+                                   .arg(jobsExhausted ? "" : " (scroll for more)"));
+}
 
-    // Show helpful message if no jobs match the filter
-    if (jobs.empty())
+void OnCampusJobsPage::onJobListScrolled(int value)
+{
+    // Prefetch once the user is within half a screen of the end
+    QScrollBar *bar = jobListWidget->verticalScrollBar();
+    if (!jobsExhausted && bar->maximum() > 0 && value >= bar->maximum() - bar->pageStep() / 2)
     {
-        auto item = new QListWidgetItem();
-        QString emptyMsg = "<div style='padding:40px; text-align:center; color:#757575;'>"
-                           "<div style='font-size:48px; margin-bottom:10px;'>🔍</div>"
-                           "<div style='font-size:16px; font-weight:600; margin-bottom:8px;'>No jobs found</div>"
-                           "<div style='font-size:13px;'>Try selecting a different filter option</div>"
-                           "</div>";
-        auto label = new QLabel(emptyMsg);
-        label->setAlignment(Qt::AlignCenter);
-        item->setSizeHint(QSize(0, 200));
-        jobListWidget->addItem(item);
-        jobListWidget->setItemWidget(item, label);
-        return;
+        loadNextJobPage();
     }
+}
 
+void OnCampusJobsPage::appendJobCards(const std::vector<Job> &jobs)
+{
+    TRACE_SCOPE("ui", "OnCampusJobsPage::appendJobCards");
     for (const auto &job : jobs)
     {
         auto item = new QListWidgetItem();
@@ -463,7 +652,7 @@ void OnCampusJobsPage::updateJobList(const std::vector<Job> &jobs)
                                "</div>")
                                .arg(job.getTitle())
                                .arg(job.getDepartment())
-                               .arg(getStatusBadge(job.getStatus(), job.getPositionsAvailable()))
+                               .arg(getStatusBadge(job.getStatus(), job.getPositionsAvailable(), job.getOpenDate()))
                                .arg(payText)
                                .arg(hoursText)
                                .arg(wsIcon)
@@ -477,19 +666,19 @@ void OnCampusJobsPage::updateJobList(const std::vector<Job> &jobs)
 
         auto label = new QLabel(cardHtml);
         label->setWordWrap(true);
-        label->setStyleSheet("padding: 8px;");
         jobListWidget->setItemWidget(item, label);
     }
 }
 
 void OnCampusJobsPage::showJobDetails(const Job &job)
 {
+    TRACE_SCOPE("ui", "OnCampusJobsPage::showJobDetails");
     selectedJob = job;
 
     // Header Section
     jobTitleLabel->setText(job.getTitle());
     jobDepartmentLabel->setText("Department: " + job.getDepartment());
-    statusBadgeLabel->setText(getStatusBadge(job.getStatus(), job.getPositionsAvailable()));
+    statusBadgeLabel->setText(getStatusBadge(job.getStatus(), job.getPositionsAvailable(), job.getOpenDate()));
 
     // Build eligibility info string
     QStringList eligibilityList;
@@ -509,17 +698,17 @@ void OnCampusJobsPage::showJobDetails(const Job &job)
     }
 
     // Update action button
-    if (job.getStatus() == JobStatus::Open)
+    if (JobFilters::statusBit(job.getStatus()) & JobFilters::kAcceptingApplications)
     {
         actionButton->setText("Apply Now");
-        actionButton->setStyleSheet("background: #4CAF50; color:white; padding:10px; border-radius:6px; font-weight:600;");
+        ThemeManager::setRole(actionButton, StyleRole::Success);
         disconnect(actionButton, &QPushButton::clicked, this, &OnCampusJobsPage::expressInterest);
         connect(actionButton, &QPushButton::clicked, this, &OnCampusJobsPage::applyForJob);
     }
     else
     {
         actionButton->setText("Express Interest");
-        actionButton->setStyleSheet("background: #2196F3; color:white; padding:10px; border-radius:6px; font-weight:600;");
+        ThemeManager::setRole(actionButton, StyleRole::Primary);
         disconnect(actionButton, &QPushButton::clicked, this, &OnCampusJobsPage::applyForJob);
         connect(actionButton, &QPushButton::clicked, this, &OnCampusJobsPage::expressInterest);
     }
@@ -617,9 +806,13 @@ void OnCampusJobsPage::showJobDetails(const Job &job)
         htmlContent += "</div>";
     }
 
-    jobDescriptionEdit->setHtml(htmlContent);
-    jobDescriptionEdit->setVisible(true);
-    jobDescriptionEdit->setMaximumHeight(400);
+    {
+        // Rich-text layout of the details document is often the slow part
+        TRACE_SCOPE("ui", "OnCampusJobsPage::showJobDetails.setHtml");
+        jobDescriptionEdit->setHtml(htmlContent);
+        jobDescriptionEdit->setVisible(true);
+        jobDescriptionEdit->setMaximumHeight(400);
+    }
 
     // Hide the old individual labels since we're using the comprehensive HTML
     requirementsLabel->setVisible(false);
@@ -652,7 +845,7 @@ bool OnCampusJobsPage::isInternationalEligible(const Job &job) const
     return job.isInternationalEligible();
 }
 
-QString OnCampusJobsPage::getStatusBadge(JobStatus status, int positions)
+QString OnCampusJobsPage::getStatusBadge(JobStatus status, int positions, const QString &openDate)
 {
     switch (status)
     {
@@ -665,7 +858,13 @@ QString OnCampusJobsPage::getStatusBadge(JobStatus status, int positions)
     case JobStatus::Closed:
         return "<span style='background:#9E9E9E; color:white; padding:4px 12px; border-radius:12px; font-size:12px; font-weight:600;'>✕ CLOSED</span>";
     case JobStatus::Upcoming:
-        return "<span style='background:#2196F3; color:white; padding:4px 12px; border-radius:12px; font-size:12px; font-weight:600;'>🕐 OPENING SPRING 2025</span>";
+    {
+        qint64 opensAt = JobStatusScheduler::parseOpenDate(openDate);
+        QString when = opensAt < 0 ? QString("SOON")
+                                   : QDateTime::fromSecsSinceEpoch(opensAt).toString("MMM d, yyyy").toUpper();
+        return QString("<span style='background:#2196F3; color:white; padding:4px 12px; border-radius:12px; font-size:12px; font-weight:600;'>🕐 OPENING %1</span>")
+            .arg(when);
+    }
     default:
         return "";
     }
@@ -673,6 +872,7 @@ QString OnCampusJobsPage::getStatusBadge(JobStatus status, int positions)
 
 void OnCampusJobsPage::onJobCardClicked(QListWidgetItem *item)
 {
+    TRACE_SCOPE("ui", "OnCampusJobsPage::onJobCardClicked");
     int jobId = item->data(Qt::UserRole).toInt();
     Job job = database->getJobById(jobId);
     showJobDetails(job);
@@ -684,6 +884,24 @@ void OnCampusJobsPage::onSearchTextChanged(const QString &text)
     applyFilters();
 }
 
+void OnCampusJobsPage::onSearchTextEdited(const QString &text)
+{
+    // Typed by the user (not set programmatically): refresh the popup
+    const QStringList suggestions = autocomplete->suggest(text);
+    suggestionModel->setStringList(suggestions);
+    if (suggestions.isEmpty() || text.trimmed().isEmpty())
+    {
+        searchCompleter->popup()->hide();
+        return;
+    }
+    searchCompleter->complete();
+}
+
+void OnCampusJobsPage::onSearchSubmitted()
+{
+    autocomplete->recordQuery(searchEdit->text());
+}
+
 void OnCampusJobsPage::onFilterChanged()
 {
     applyFilters();
@@ -691,46 +909,70 @@ void OnCampusJobsPage::onFilterChanged()
 
 void OnCampusJobsPage::applyFilters()
 {
-    std::vector<Job> filtered;
+    TRACE_SCOPE("ui", "OnCampusJobsPage::applyFilters");
+    currentJobs.clear();
+    jobCursor = JobCursor();
+    catalogPosition = 0;
+    pagingCatalog = catalog.isOpen();
+    jobsExhausted = false;
+    jobListWidget->clear();
 
-    // Filter jobs based on the selected radio button
-    if (workStudyBtn->isChecked())
+    const QString searchText = searchEdit->text().trimmed();
+    if (!searchText.isEmpty())
     {
-        // Work Study Only - show jobs eligible for work study students
-        for (const auto &job : currentJobs)
-        {
-            if (job.isWorkStudyEligible())
-            {
-                filtered.push_back(job);
-            }
-        }
+        showFuzzyResults(searchText);
     }
-    else if (intlBtn->isChecked())
+    else if (haveOpenJobsSnapshot)
     {
-        // International Available - show jobs open to international students
-        for (const auto &job : currentJobs)
-        {
-            if (isInternationalEligible(job))
-            {
-                filtered.push_back(job);
-            }
-        }
+        // Same fused predicate the SQL was built from, run over the snapshot
+        visitJobFilter(activeFilterOptions(), [this](const auto &filter)
+                       {
+            std::copy_if(openJobsSnapshot.begin(), openJobsSnapshot.end(),
+                         std::back_inserter(currentJobs), filter);
+            return 0; });
+        jobsExhausted = true;
+        appendJobCards(currentJobs);
+        updateResultsCount();
     }
     else
     {
-        // All Students - show all available jobs (default filter)
-        filtered = currentJobs;
+        // Otherwise the filter runs in SQL and paging restarts
+        loadNextJobPage();
     }
 
-    // Update the display with filtered results
-    updateJobList(filtered);
+    if (currentJobs.empty())
+    {
+        showEmptyJobList();
+    }
+}
+
+void OnCampusJobsPage::showFuzzyResults(const QString &text)
+{
+    TRACE_SCOPE("ui", "OnCampusJobsPage::showFuzzyResults");
+    // Index ranks, the eligibility filter decides; ranking order is kept
+    const auto results = fuzzySearch->search(text, kFuzzyResultLimit);
+    visitJobFilter(activeFilterOptions(), [this, &results](const auto &filter)
+                   {
+        for (const auto &result : results)
+        {
+            if (filter(result.job))
+                currentJobs.push_back(result.job);
+        }
+        return 0; });
+    jobsExhausted = true;
+    appendJobCards(currentJobs);
+    updateResultsCount();
 }
 
 void OnCampusJobsPage::clearFilters()
 {
     // Reset to default "All Students" filter
     allStudentsBtn->setChecked(true);
-    loadJobs();
+    {
+        const QSignalBlocker blocker(searchEdit);
+        searchEdit->clear();
+    }
+    applyFilters();
 }
 void OnCampusJobsPage::applyForJob()
 {
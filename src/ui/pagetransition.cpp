@@ -0,0 +1,87 @@
+#include "ui/pagetransition.h"
+#include <QEvent>
+#include <QLayout>
+#include <QPainter>
+#include "utils/tracer.h"
+
+PageTransition::PageTransition(QStackedWidget *stack)
+    : QWidget(stack), stack(stack), progress(1.0)
+{
+    // Clicks go straight to the page underneath while fading
+    setAttribute(Qt::WA_TransparentForMouseEvents);
+    setAttribute(Qt::WA_OpaquePaintEvent);
+    hide();
+
+    animation.setDuration(300);
+    animation.setStartValue(0.0);
+    animation.setEndValue(1.0);
+    animation.setEasingCurve(QEasingCurve::InOutQuad);
+    connect(&animation, &QVariantAnimation::valueChanged, this, [this](const QVariant &value)
+            {
+        progress = value.toReal();
+        update(); });
+    connect(&animation, &QVariantAnimation::finished, this, &PageTransition::finish);
+
+    stack->installEventFilter(this);
+}
+
+void PageTransition::switchTo(QWidget *page)
+{
+    TRACE_SCOPE("ui", "PageTransition::switchTo");
+    if (isRunning())
+    {
+        animation.stop();
+        finish();
+    }
+
+    QWidget *current = stack->currentWidget();
+    if (!stack->isVisible() || !current || current == page || stack->size().isEmpty())
+    {
+        stack->setCurrentWidget(page);
+        return;
+    }
+
+    outgoing = current->grab();
+    stack->setCurrentWidget(page);
+    // The stack lays the page out on its next LayoutRequest; size it and run
+    // its layout now so the first frame shows the page as it will settle
+    page->setGeometry(stack->contentsRect());
+    if (QLayout *layout = page->layout())
+    {
+        layout->activate();
+    }
+    incoming = page->grab();
+
+    progress = 0.0;
+    setGeometry(stack->rect());
+    raise();
+    show();
+    animation.start();
+}
+
+void PageTransition::finish()
+{
+    hide();
+    outgoing = QPixmap();
+    incoming = QPixmap();
+    progress = 1.0;
+}
+
+void PageTransition::paintEvent(QPaintEvent *)
+{
+    QPainter painter(this);
+    painter.drawPixmap(0, 0, outgoing);
+    painter.setOpacity(progress);
+    painter.drawPixmap(0, 0, incoming);
+}
+
+bool PageTransition::eventFilter(QObject *watched, QEvent *event)
+{
+    // The snapshots no longer match a resized stack; show the page as is
+    if (watched == stack && event->type() == QEvent::Resize && isRunning())
+    {
+        animation.stop();
+        finish();
+    }
+    return QWidget::eventFilter(watched, event);
+}
@@ -1,4 +1,5 @@
 #include "ui/studentsurveydialog.h"
+#include "ui/thememanager.h"
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QFormLayout>
@@ -42,7 +43,7 @@ void StudentSurveyDialog::setupUI()
 
     // Title
     titleLabel = new QLabel("Complete Your Profile", this);
-    titleLabel->setStyleSheet("font-size: 26px; font-weight: 600; color: #1976D2;");
+    ThemeManager::setRole(titleLabel, StyleRole::Title);
     titleLabel->setAlignment(Qt::AlignCenter);
     mainLayout->addWidget(titleLabel);
 
@@ -52,7 +53,7 @@ void StudentSurveyDialog::setupUI()
         "Upload your resume and transcript to auto-fill future applications and verify eligibility.",
         this);
     descriptionLabel->setWordWrap(true);
-    descriptionLabel->setStyleSheet("font-size: 14px; color: #616161; line-height: 1.5;");
+    ThemeManager::setRole(descriptionLabel, StyleRole::Subtitle);
     descriptionLabel->setAlignment(Qt::AlignCenter);
     mainLayout->addWidget(descriptionLabel);
 
@@ -64,7 +65,7 @@ void StudentSurveyDialog::setupUI()
     internationalLayout->setSpacing(15);
 
     auto questionLabel = new QLabel("Are you an international student?", this);
-    questionLabel->setStyleSheet("font-size: 15px; font-weight: 600; color: #333;");
+    ThemeManager::setRole(questionLabel, StyleRole::SectionTitle);
     internationalLayout->addWidget(questionLabel);
 
     // Radio buttons in horizontal layout
@@ -72,14 +73,10 @@ void StudentSurveyDialog::setupUI()
     radioLayout->setSpacing(30);
 
     internationalYesBtn = new QRadioButton("Yes", this);
-    internationalYesBtn->setStyleSheet(
-        "QRadioButton { font-size: 16px; font-weight: 500; padding: 10px; }"
-        "QRadioButton::indicator { width: 24px; height: 24px; }");
+    ThemeManager::setRole(internationalYesBtn, StyleRole::Choice);
 
     internationalNoBtn = new QRadioButton("No", this);
-    internationalNoBtn->setStyleSheet(
-        "QRadioButton { font-size: 16px; font-weight: 500; padding: 10px; }"
-        "QRadioButton::indicator { width: 24px; height: 24px; }");
+    ThemeManager::setRole(internationalNoBtn, StyleRole::Choice);
     internationalNoBtn->setChecked(true); // Default to No
 
     radioLayout->addWidget(internationalYesBtn);
@@ -93,7 +90,7 @@ void StudentSurveyDialog::setupUI()
         "through visa/work authorization requirements.",
         this);
     internationalHelpLabel->setWordWrap(true);
-    internationalHelpLabel->setStyleSheet("font-size: 12px; color: #757575; margin-top: 8px;");
+    ThemeManager::setRole(internationalHelpLabel, StyleRole::Hint);
     internationalLayout->addWidget(internationalHelpLabel);
 
     mainLayout->addWidget(internationalGroup);
@@ -115,13 +112,13 @@ void StudentSurveyDialog::setupUI()
     resumeLayout->addLayout(resumeRowLayout);
 
     resumeStatusLabel = new QLabel("", this);
-    resumeStatusLabel->setStyleSheet("font-size: 12px; color: #4CAF50;");
+    ThemeManager::setRole(resumeStatusLabel, StyleRole::Success);
     resumeLayout->addWidget(resumeStatusLabel);
 
     auto resumeHelpLabel = new QLabel(
         "📄 We'll extract your contact info and experience to pre-fill applications.",
         this);
-    resumeHelpLabel->setStyleSheet("font-size: 12px; color: #757575;");
+    ThemeManager::setRole(resumeHelpLabel, StyleRole::Hint);
     resumeLayout->addWidget(resumeHelpLabel);
 
     mainLayout->addWidget(resumeGroup);
@@ -143,13 +140,13 @@ void StudentSurveyDialog::setupUI()
     transcriptLayout->addLayout(transcriptRowLayout);
 
     transcriptStatusLabel = new QLabel("", this);
-    transcriptStatusLabel->setStyleSheet("font-size: 12px; color: #4CAF50;");
+    ThemeManager::setRole(transcriptStatusLabel, StyleRole::Success);
     transcriptLayout->addWidget(transcriptStatusLabel);
 
     auto transcriptHelpLabel = new QLabel(
         "📊 We'll automatically verify your GPA and coursework for job eligibility.",
         this);
-    transcriptHelpLabel->setStyleSheet("font-size: 12px; color: #757575;");
+    ThemeManager::setRole(transcriptHelpLabel, StyleRole::Hint);
     transcriptLayout->addWidget(transcriptHelpLabel);
 
     mainLayout->addWidget(transcriptGroup);
@@ -192,100 +189,6 @@ void StudentSurveyDialog::setupUI()
 
 void StudentSurveyDialog::setupStyles()
 {
-    setStyleSheet(
-        "QDialog {"
-        "    background: #FAFAFA;"
-        "    font-family: 'Segoe UI', Arial, sans-serif;"
-        "}"
-        "QGroupBox {"
-        "    font-size: 15px;"
-        "    font-weight: 600;"
-        "    color: #424242;"
-        "    border: 2px solid #E0E0E0;"
-        "    border-radius: 8px;"
-        "    margin-top: 10px;"
-        "    padding-top: 15px;"
-        "    background: white;"
-        "}"
-        "QGroupBox::title {"
-        "    subcontrol-origin: margin;"
-        "    left: 10px;"
-        "    padding: 0 5px;"
-        "}"
-        "QLineEdit {"
-        "    padding: 8px;"
-        "    border: 2px solid #E0E0E0;"
-        "    border-radius: 6px;"
-        "    background: white;"
-        "    font-size: 14px;"
-        "}"
-        "QLineEdit:focus {"
-        "    border: 2px solid #2196F3;"
-        "}"
-        "QPushButton {"
-        "    background: qlineargradient(x1:0, y1:0, x2:0, y2:1, "
-        "        stop:0 #2196F3, stop:1 #1976D2);"
-        "    color: white;"
-        "    border: none;"
-        "    border-radius: 6px;"
-        "    font-size: 14px;"
-        "    font-weight: 600;"
-        "    padding: 10px 20px;"
-        "}"
-        "QPushButton:hover {"
-        "    background: qlineargradient(x1:0, y1:0, x2:0, y2:1, "
-        "        stop:0 #1976D2, stop:1 #1565C0);"
-        "}"
-        "QPushButton#skipBtn {"
-        "    background: transparent;"
-        "    color: #757575;"
-        "    border: 2px solid #BDBDBD;"
-        "}"
-        "QPushButton#skipBtn:hover {"
-        "    background: #F5F5F5;"
-        "    border: 2px solid #9E9E9E;"
-        "}"
-        "QTextEdit {"
-        "    border: 2px solid #E0E0E0;"
-        "    border-radius: 6px;"
-        "    background: white;"
-        "    font-size: 13px;"
-        "    padding: 10px;"
-        "}"
-        "QCheckBox {"
-        "    spacing: 12px;"
-        "    font-size: 14px;"
-        "}"
-        "QCheckBox::indicator {"
-        "    width: 22px;"
-        "    height: 22px;"
-        "}"
-        "QScrollArea {"
-        "    border: none;"
-        "    background: transparent;"
-        "}"
-        "QScrollBar:vertical {"
-        "    border: none;"
-        "    background: #F5F5F5;"
-        "    width: 14px;"
-        "    margin: 0px;"
-        "}"
-        "QScrollBar::handle:vertical {"
-        "    background: #BDBDBD;"
-        "    min-height: 30px;"
-        "    border-radius: 7px;"
-        "    margin: 2px;"
-        "}"
-        "QScrollBar::handle:vertical:hover {"
-        "    background: #9E9E9E;"
-        "}"
-        "QScrollBar::add-line:vertical, QScrollBar::sub-line:vertical {"
-        "    height: 0px;"
-        "}"
-        "QScrollBar::add-page:vertical, QScrollBar::sub-page:vertical {"
-        "    background: none;"
-        "}");
-
     skipBtn->setObjectName("skipBtn");
 }
 
@@ -0,0 +1,129 @@
+#include "ui/thememanager.h"
+#include <QDebug>
+#include <QFile>
+#include <QFont>
+#include <QPalette>
+#include <QStyle>
+#include "utils/tracer.h"
+
+namespace
+{
+    const char *kRoleProperty = "role";
+}
+
+bool ThemeManager::install(QApplication &app, const QString &styleSheetPath)
+{
+    TRACE_SCOPE("ui", "ThemeManager::install");
+
+    // The font and base colours every page shared in its own sheet
+    QFont font = app.font();
+    font.setFamilies({"Segoe UI", "Arial", "sans-serif"});
+    app.setFont(font);
+
+    QPalette palette = app.palette();
+    palette.setColor(QPalette::Window, QColor("#f5f7fa"));
+    palette.setColor(QPalette::Base, Qt::white);
+    palette.setColor(QPalette::WindowText, QColor("#424242"));
+    palette.setColor(QPalette::Text, QColor("#333333"));
+    palette.setColor(QPalette::Highlight, QColor("#2196F3"));
+    palette.setColor(QPalette::HighlightedText, Qt::white);
+    palette.setColor(QPalette::Link, QColor("#2196F3"));
+    app.setPalette(palette);
+
+    QFile file(styleSheetPath);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+        qDebug() << "Error opening style sheet" << styleSheetPath << ":" << file.errorString();
+        return false;
+    }
+    app.setStyleSheet(QString::fromUtf8(file.readAll()));
+    return true;
+}
+
+void ThemeManager::setRole(QWidget *widget, StyleRole role)
+{
+    if (!widget || ThemeManager::role(widget) == role)
+    {
+        return;
+    }
+    widget->setProperty(kRoleProperty, role == StyleRole::None ? QVariant() : QVariant(QString(roleName(role))));
+
+    // Property selectors are only re-evaluated on polish
+    if (widget->testAttribute(Qt::WA_WState_Polished))
+    {
+        widget->style()->unpolish(widget);
+        widget->style()->polish(widget);
+        widget->update();
+    }
+}
+
+StyleRole ThemeManager::role(const QWidget *widget)
+{
+    const QString name = widget->property(kRoleProperty).toString();
+    for (int i = static_cast<int>(StyleRole::Title); i <= static_cast<int>(StyleRole::Confirm); ++i)
+    {
+        if (name == QLatin1String(roleName(static_cast<StyleRole>(i))))
+        {
+            return static_cast<StyleRole>(i);
+        }
+    }
+    return StyleRole::None;
+}
+
+const char *ThemeManager::roleName(StyleRole role)
+{
+    switch (role)
+    {
+    case StyleRole::None:
+        return "";
+    case StyleRole::Title:
+        return "title";
+    case StyleRole::Heading:
+        return "heading";
+    case StyleRole::Subtitle:
+        return "subtitle";
+    case StyleRole::SectionTitle:
+        return "section-title";
+    case StyleRole::Body:
+        return "body";
+    case StyleRole::Emphasis:
+        return "emphasis";
+    case StyleRole::Caption:
+        return "caption";
+    case StyleRole::Hint:
+        return "hint";
+    case StyleRole::Success:
+        return "success";
+    case StyleRole::Error:
+        return "error";
+    case StyleRole::Card:
+        return "card";
+    case StyleRole::MutedCard:
+        return "muted-card";
+    case StyleRole::Notice:
+        return "notice";
+    case StyleRole::NoticeTitle:
+        return "notice-title";
+    case StyleRole::NoticeText:
+        return "notice-text";
+    case StyleRole::Toolbar:
+        return "toolbar";
+    case StyleRole::Primary:
+        return "primary";
+    case StyleRole::Secondary:
+        return "secondary";
+    case StyleRole::Link:
+        return "link";
+    case StyleRole::Choice:
+        return "choice";
+    case StyleRole::StatusPending:
+        return "status-pending";
+    case StyleRole::StatusCompleted:
+        return "status-completed";
+    case StyleRole::StatusProcessing:
+        return "status-processing";
+    case StyleRole::Confirm:
+        return "confirm";
+    }
+    return "";
+}
@@ -0,0 +1,572 @@
+#include "utils/availability.h"
+#include <QHash>
+#include <QStringList>
+#include <QtAlgorithms>
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+    const quint8 kAllDays = 0x7f;
+    const char *const kDayNames[Availability::kDays] = {"Mon", "Tue", "Wed", "Thu", "Fri", "Sat", "Sun"};
+    // Block boundaries in minutes since midnight
+    const int kBlockStart[Availability::kBlocksPerDay + 1] = {6 * 60, 12 * 60, 17 * 60, 22 * 60};
+
+    enum class TokenType
+    {
+        Word,
+        Number,
+        Dash,
+        Comma,
+        Stop // ';' or a line break: nothing carries over it
+    };
+
+    struct Token
+    {
+        TokenType type;
+        QString text;       // lowercased, dots removed
+        bool upper = false; // timetable capitals ("MWF", "TTh")
+    };
+
+    std::vector<Token> tokenize(const QString &text)
+    {
+        std::vector<Token> tokens;
+        int i = 0;
+        while (i < text.size())
+        {
+            const QChar c = text.at(i);
+            if (c.isLetter())
+            {
+                QString word;
+                bool upper = true;
+                while (i < text.size() && (text.at(i).isLetter() || text.at(i) == '.'))
+                {
+                    const QChar letter = text.at(i);
+                    if (letter.isLetter())
+                    {
+                        // Lowercase only as the second letter of Th, Tu, Sa, Su
+                        const QChar previous = word.isEmpty() ? QChar() : text.at(i - 1);
+                        const bool pairTail = (previous == 'T' && (letter == 'h' || letter == 'u')) ||
+                                              (previous == 'S' && (letter == 'a' || letter == 'u'));
+                        upper = upper && (letter.isUpper() || pairTail);
+                        word += letter.toLower();
+                    }
+                    ++i;
+                }
+                tokens.push_back({TokenType::Word, word, upper});
+            }
+            else if (c.isDigit())
+            {
+                const int start = i;
+                while (i < text.size() && (text.at(i).isDigit() || text.at(i) == ':'))
+                {
+                    ++i;
+                }
+                tokens.push_back({TokenType::Number, text.mid(start, i - start)});
+            }
+            else
+            {
+                if (c == '-' || c == QChar(0x2013) || c == QChar(0x2014))
+                    tokens.push_back({TokenType::Dash, QString()});
+                else if (c == ',')
+                    tokens.push_back({TokenType::Comma, QString()});
+                else if (c == ';' || c == '\n')
+                    tokens.push_back({TokenType::Stop, QString()});
+                ++i;
+            }
+        }
+        return tokens;
+    }
+
+    // Day bits for one word, 0 if it is not a day
+    quint8 dayMask(const Token &token)
+    {
+        static const QHash<QString, quint8> names = {
+            {"monday", 0x01}, {"mondays", 0x01}, {"mon", 0x01},
+            {"tuesday", 0x02}, {"tuesdays", 0x02}, {"tue", 0x02}, {"tues", 0x02},
+            {"wednesday", 0x04}, {"wednesdays", 0x04}, {"wed", 0x04},
+            {"thursday", 0x08}, {"thursdays", 0x08}, {"thu", 0x08}, {"thur", 0x08}, {"thurs", 0x08},
+            {"friday", 0x10}, {"fridays", 0x10}, {"fri", 0x10},
+            {"saturday", 0x20}, {"saturdays", 0x20}, {"sat", 0x20},
+            {"sunday", 0x40}, {"sundays", 0x40}, {"sun", 0x40},
+            {"weekday", 0x1f}, {"weekdays", 0x1f},
+            {"weekend", 0x60}, {"weekends", 0x60},
+            {"daily", kAllDays}, {"everyday", kAllDays}};
+        if (token.type != TokenType::Word)
+        {
+            return 0;
+        }
+        const quint8 named = names.value(token.text, 0);
+        if (named || !token.upper || token.text.size() < 2)
+        {
+            return named;
+        }
+
+        // Timetable letters in capitals: MWF, TTh, TR, MTWRF, SaSu
+        quint8 mask = 0;
+        const QString &s = token.text;
+        for (int i = 0; i < s.size(); ++i)
+        {
+            const QString pair = s.mid(i, 2);
+            if (pair == "th" || pair == "tu" || pair == "sa" || pair == "su")
+            {
+                mask |= pair == "tu" ? 0x02 : pair == "th" ? 0x08 : pair == "sa" ? 0x20 : 0x40;
+                ++i;
+                continue;
+            }
+            switch (s.at(i).unicode())
+            {
+            case 'm': mask |= 0x01; break;
+            case 't': mask |= 0x02; break;
+            case 'w': mask |= 0x04; break;
+            case 'r': mask |= 0x08; break;
+            case 'f': mask |= 0x10; break;
+            default: return 0;
+            }
+        }
+        return mask;
+    }
+
+    quint8 dayRange(quint8 from, quint8 to)
+    {
+        // Both are single days here; the range may wrap past Sunday
+        const int first = qCountTrailingZeroBits(from);
+        const int last = qCountTrailingZeroBits(to);
+        quint8 mask = 0;
+        for (int day = first;; day = (day + 1) % Availability::kDays)
+        {
+            mask |= quint8(1u << day);
+            if (day == last)
+                break;
+        }
+        return mask;
+    }
+
+    bool isSingleDay(quint8 mask)
+    {
+        return mask && !(mask & (mask - 1));
+    }
+
+    enum Meridiem
+    {
+        NoMeridiem,
+        Am,
+        Pm
+    };
+
+    struct TimeAtom
+    {
+        int hour = -1;
+        int minute = 0;
+        Meridiem meridiem = NoMeridiem;
+    };
+
+    // A number ("9", "11:30", "14:00") or noon/midnight, with an optional am/pm
+    bool readTime(const std::vector<Token> &tokens, size_t &i, TimeAtom &atom)
+    {
+        if (i >= tokens.size())
+            return false;
+        const Token &token = tokens[i];
+        if (token.type == TokenType::Word && (token.text == "noon" || token.text == "midnight"))
+        {
+            atom.hour = token.text == "noon" ? 12 : 0;
+            atom.minute = 0;
+            atom.meridiem = token.text == "noon" ? Pm : Am;
+            ++i;
+            return true;
+        }
+        if (token.type != TokenType::Number)
+            return false;
+
+        const QStringList parts = token.text.split(':');
+        bool ok = false;
+        atom.hour = parts.value(0).toInt(&ok);
+        atom.minute = parts.size() > 1 ? parts.at(1).toInt() : 0;
+        if (!ok || atom.hour > 24 || atom.minute > 59)
+            return false;
+        ++i;
+
+        atom.meridiem = NoMeridiem;
+        if (i < tokens.size() && tokens[i].type == TokenType::Word)
+        {
+            const QString &word = tokens[i].text;
+            if (word == "am" || word == "a")
+            {
+                atom.meridiem = Am;
+                ++i;
+            }
+            else if (word == "pm" || word == "p")
+            {
+                atom.meridiem = Pm;
+                ++i;
+            }
+        }
+        return true;
+    }
+
+    int toMinutes(const TimeAtom &atom, Meridiem meridiem)
+    {
+        int hour = atom.hour;
+        if (hour <= 12 && meridiem == Am && hour == 12)
+            hour = 0;
+        else if (hour < 12 && meridiem == Pm)
+            hour += 12;
+        return hour * 60 + atom.minute;
+    }
+
+    // Fills in missing am/pm the way people write shifts: "2-6pm", "10-2pm",
+    // "9-5" (9am-5pm) and "1-4" (afternoon)
+    bool resolveRange(const TimeAtom &from, const TimeAtom &to, int &start, int &end)
+    {
+        const bool twentyFour = from.hour > 12 || to.hour > 12 || from.hour == 0;
+        if (twentyFour)
+        {
+            start = toMinutes(from, NoMeridiem);
+            end = toMinutes(to, NoMeridiem);
+        }
+        else
+        {
+            Meridiem first = from.meridiem;
+            if (first == NoMeridiem)
+            {
+                if (to.meridiem != NoMeridiem && toMinutes(from, to.meridiem) < toMinutes(to, to.meridiem))
+                    first = to.meridiem;
+                else if (to.meridiem == Pm)
+                    first = Am;
+                else
+                    first = (from.hour == 12 || from.hour <= 6) ? Pm : Am;
+            }
+            start = toMinutes(from, first);
+
+            if (to.meridiem != NoMeridiem)
+            {
+                end = toMinutes(to, to.meridiem);
+            }
+            else
+            {
+                end = toMinutes(to, Am);
+                if (end <= start)
+                    end = toMinutes(to, Pm);
+            }
+        }
+        if (end == 0)
+            end = 24 * 60; // "until midnight"
+        return end > start;
+    }
+
+    struct Clause
+    {
+        quint8 days = 0;
+        quint8 excludedDays = 0;
+        bool negate = false;      // after "except", "not", "but"
+        bool wholeDay = false;    // "flexible", "anytime", "all day"
+        std::vector<std::pair<int, int>> ranges;
+        quint8 blocks = 0;
+
+        bool hasTimes() const { return !ranges.empty() || blocks; }
+        bool isEmpty() const { return !days && !excludedDays && !wholeDay && !hasTimes(); }
+    };
+}
+
+Availability Availability::parse(const QString &text, bool *ok)
+{
+    static const QHash<QString, int> blockWords = {
+        {"morning", Morning}, {"mornings", Morning},
+        {"afternoon", Afternoon}, {"afternoons", Afternoon},
+        {"evening", Evening}, {"evenings", Evening}, {"night", Evening}, {"nights", Evening}};
+    static const QStringList wholeDayWords = {"flexible", "anytime", "whenever", "open"};
+    static const QStringList rangeWords = {"to", "through", "thru", "until", "till", "til"};
+
+    Availability result;
+    bool recognized = false;
+    quint8 lastDays = 0;
+    Clause clause;
+
+    auto closeClause = [&]()
+    {
+        if (clause.isEmpty())
+            return;
+        quint8 days = clause.days ? clause.days : (lastDays ? lastDays : kAllDays);
+        days &= quint8(~clause.excludedDays);
+        lastDays = clause.days ? clause.days : lastDays;
+
+        Availability slots;
+        for (const auto &range : clause.ranges)
+            slots.addRange(0, range.first, range.second);
+        for (int block = 0; block < kBlocksPerDay; ++block)
+        {
+            if (clause.blocks & (1u << block))
+                slots.addBlock(0, Block(block));
+        }
+        quint64 daySlots = slots.day(0);
+        if (clause.wholeDay || !clause.hasTimes())
+            daySlots = ~quint64(0);
+        for (int day = 0; day < kDays; ++day)
+        {
+            if (days & (1u << day))
+                result.days[day] |= daySlots;
+        }
+        clause = Clause();
+    };
+
+    const std::vector<Token> tokens = tokenize(text);
+    QString previousWord;
+    for (size_t i = 0; i < tokens.size();)
+    {
+        const Token &token = tokens[i];
+
+        if (token.type == TokenType::Stop)
+        {
+            closeClause();
+            lastDays = 0;
+            ++i;
+            continue;
+        }
+        if (token.type == TokenType::Comma)
+        {
+            // "Mon, Wed 9-12" keeps gathering days; "Mon 9-11, Wed 2-4" starts over
+            if (clause.hasTimes() || clause.wholeDay)
+                closeClause();
+            ++i;
+            continue;
+        }
+
+        quint8 days = dayMask(token);
+        if (days)
+        {
+            size_t next = i + 1;
+            // "Monday-Friday", "Mon to Thu"
+            if (isSingleDay(days) && next + 1 < tokens.size() &&
+                (tokens[next].type == TokenType::Dash || rangeWords.contains(tokens[next].text)))
+            {
+                const quint8 to = dayMask(tokens[next + 1]);
+                if (isSingleDay(to))
+                {
+                    days = dayRange(days, to);
+                    next += 2;
+                }
+            }
+            recognized = true;
+            if (clause.negate)
+            {
+                clause.excludedDays |= days;
+            }
+            else
+            {
+                // "Tuesday mornings and Thursday afternoons" is two clauses
+                if (clause.days && clause.hasTimes())
+                    closeClause();
+                clause.days |= days;
+            }
+            previousWord.clear();
+            i = next;
+            continue;
+        }
+
+        TimeAtom from;
+        size_t next = i;
+        if (readTime(tokens, next, from))
+        {
+            TimeAtom to;
+            size_t afterRange = next;
+            const bool hasRange = afterRange < tokens.size() &&
+                                  (tokens[afterRange].type == TokenType::Dash ||
+                                   rangeWords.contains(tokens[afterRange].text));
+            int start = -1;
+            int end = -1;
+            if (hasRange && readTime(tokens, ++afterRange, to) && resolveRange(from, to, start, end))
+            {
+                next = afterRange;
+            }
+            else if (previousWord == "after" || previousWord == "from")
+            {
+                start = toMinutes(from, from.meridiem != NoMeridiem ? from.meridiem
+                                                                      : (from.hour <= 6 ? Pm : Am));
+                end = kLastMinute;
+            }
+            else if (previousWord == "before" || previousWord == "until" || previousWord == "till")
+            {
+                start = kFirstMinute;
+                end = toMinutes(from, from.meridiem != NoMeridiem ? from.meridiem
+                                                                    : (from.hour <= 9 ? Pm : Am));
+            }
+            if (start >= 0 && end > start)
+            {
+                clause.ranges.push_back({start, end});
+                clause.negate = false;
+                recognized = true;
+            }
+            previousWord.clear();
+            i = next;
+            continue;
+        }
+
+        if (token.type == TokenType::Word)
+        {
+            if (blockWords.contains(token.text))
+            {
+                clause.blocks |= quint8(1u << blockWords.value(token.text));
+                clause.negate = false;
+                recognized = true;
+            }
+            else if (wholeDayWords.contains(token.text) ||
+                     (token.text == "day" && (previousWord == "any" || previousWord == "all")))
+            {
+                clause.wholeDay = true;
+                recognized = true;
+            }
+            else if (token.text == "except" || token.text == "not" || token.text == "but" || token.text == "no")
+            {
+                clause.negate = true;
+            }
+            previousWord = token.text;
+        }
+        ++i;
+    }
+    closeClause();
+
+    if (ok)
+        *ok = recognized;
+    return result;
+}
+
+QString Availability::toString() const
+{
+    auto clock = [](int minutes)
+    { return QString("%1:%2").arg(minutes / 60, 2, 10, QChar('0')).arg(minutes % 60, 2, 10, QChar('0')); };
+
+    QStringList parts;
+    for (int day = 0; day < kDays; ++day)
+    {
+        QStringList ranges;
+        quint64 slots = days[day];
+        int slot = 0;
+        while (slots)
+        {
+            const int skip = qCountTrailingZeroBits(slots);
+            slot += skip;
+            slots = skip < 64 ? slots >> skip : 0;
+            const int run = qCountTrailingZeroBits(~slots);
+            ranges << clock(kFirstMinute + slot * kSlotMinutes) + "-" +
+                          clock(kFirstMinute + (slot + run) * kSlotMinutes);
+            slot += run;
+            slots = run < 64 ? slots >> run : 0;
+        }
+        if (!ranges.isEmpty())
+        {
+            parts << QString::fromLatin1(kDayNames[day]) + " " + ranges.join(", ");
+        }
+    }
+    return parts.join("; ");
+}
+
+void Availability::addRange(int day, int startMinute, int endMinute)
+{
+    if (day < 0 || day >= kDays)
+        return;
+    const int first = (std::max(startMinute, kFirstMinute) - kFirstMinute) / kSlotMinutes;
+    const int last = (std::min(endMinute, kLastMinute) - kFirstMinute + kSlotMinutes - 1) / kSlotMinutes;
+    if (last <= first)
+        return;
+    const quint64 upper = last >= 64 ? ~quint64(0) : (quint64(1) << last) - 1;
+    const quint64 lower = (quint64(1) << first) - 1;
+    days[day] |= upper & ~lower;
+}
+
+void Availability::addBlock(int day, Block block)
+{
+    addRange(day, kBlockStart[block], kBlockStart[block + 1]);
+}
+
+Availability Availability::block(int day, Block block)
+{
+    Availability availability;
+    availability.addBlock(day, block);
+    return availability;
+}
+
+bool Availability::isEmpty() const
+{
+    for (quint64 slots : days)
+    {
+        if (slots)
+            return false;
+    }
+    return true;
+}
+
+int Availability::slotCount() const
+{
+    int count = 0;
+    for (quint64 slots : days)
+        count += qPopulationCount(slots);
+    return count;
+}
+
+int Availability::overlapSlots(const Availability &other) const
+{
+    int count = 0;
+    for (int day = 0; day < kDays; ++day)
+        count += qPopulationCount(days[day] & other.days[day]);
+    return count;
+}
+
+bool Availability::overlaps(const Availability &other) const
+{
+    for (int day = 0; day < kDays; ++day)
+    {
+        if (days[day] & other.days[day])
+            return true;
+    }
+    return false;
+}
+
+bool Availability::covers(const Availability &shift) const
+{
+    for (int day = 0; day < kDays; ++day)
+    {
+        if (shift.days[day] & ~days[day])
+            return false;
+    }
+    return true;
+}
+
+double Availability::coverage(const Availability &shift) const
+{
+    const int needed = shift.slotCount();
+    return needed == 0 ? 1.0 : double(overlapSlots(shift)) / needed;
+}
+
+Availability Availability::intersected(const Availability &other) const
+{
+    Availability result;
+    for (int day = 0; day < kDays; ++day)
+        result.days[day] = days[day] & other.days[day];
+    return result;
+}
+
+Availability &Availability::operator|=(const Availability &other)
+{
+    for (int day = 0; day < kDays; ++day)
+        days[day] |= other.days[day];
+    return *this;
+}
+
+quint32 Availability::blockMask() const
+{
+    // Slot masks of the three blocks; bit 0 of a day is 06:00
+    static const quint64 kBlockSlots[kBlocksPerDay] = {
+        (quint64(1) << 24) - 1,                            // 06:00-12:00
+        ((quint64(1) << 44) - 1) & ~((quint64(1) << 24) - 1), // 12:00-17:00
+        ~((quint64(1) << 44) - 1)};                        // 17:00-22:00
+    quint32 mask = 0;
+    for (int day = 0; day < kDays; ++day)
+    {
+        for (int block = 0; block < kBlocksPerDay; ++block)
+        {
+            if (days[day] & kBlockSlots[block])
+                mask |= 1u << (day * kBlocksPerDay + block);
+        }
+    }
+    return mask;
+}
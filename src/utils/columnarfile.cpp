@@ -0,0 +1,497 @@
+#include "utils/columnarfile.h"
+#include <QDataStream>
+#include <QDebug>
+#include <QtEndian>
+#include <cstring>
+
+namespace
+{
+    const char kMagic[8] = {'C', 'H', 'C', 'O', 'L', '1', '\0', '\0'};
+    const quint32 kFormatVersion = 1;
+    const int kMaxDictionaryEntries = 65536;
+    const int kCompressionLevel = 6;
+
+    void putVarint(QByteArray &out, quint64 value)
+    {
+        while (value >= 0x80)
+        {
+            out.append(char(value | 0x80));
+            value >>= 7;
+        }
+        out.append(char(value));
+    }
+
+    bool getVarint(const char *&p, const char *end, quint64 &value)
+    {
+        value = 0;
+        for (int shift = 0; p < end && shift < 64; shift += 7)
+        {
+            const quint8 byte = quint8(*p++);
+            value |= quint64(byte & 0x7f) << shift;
+            if (!(byte & 0x80))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    quint64 zigzag(qint64 value)
+    {
+        return (quint64(value) << 1) ^ quint64(value >> 63);
+    }
+
+    qint64 unzigzag(quint64 value)
+    {
+        return qint64(value >> 1) ^ -qint64(value & 1);
+    }
+
+    bool isNullAt(const char *bitmap, qint64 row)
+    {
+        return bitmap[row / 8] & (1 << (row % 8));
+    }
+
+    // Orders two values of the same column type for min/max statistics
+    bool lessThan(Columnar::Type type, const QVariant &a, const QVariant &b)
+    {
+        switch (type)
+        {
+        case Columnar::Type::Integer:
+            return a.toLongLong() < b.toLongLong();
+        case Columnar::Type::Real:
+            return a.toDouble() < b.toDouble();
+        case Columnar::Type::Text:
+            return a.toString() < b.toString();
+        }
+        return false;
+    }
+}
+
+ColumnarWriter::ColumnarWriter(const QString &path, const QStringList &columnNames,
+                               const std::vector<Columnar::Type> &columnTypes, int rowGroupSize)
+    : file(path), names(columnNames), groupSize(qMax(1, rowGroupSize)),
+      bufferedRows(0), rowsWritten(0), finished(false)
+{
+    columns.resize(columnTypes.size());
+    for (size_t i = 0; i < columnTypes.size(); ++i)
+    {
+        columns[i].type = columnTypes[i];
+    }
+}
+
+bool ColumnarWriter::open()
+{
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        qDebug() << "Cannot open export file" << file.fileName() << ":" << file.errorString();
+        return false;
+    }
+    return file.write(kMagic, sizeof(kMagic)) == qint64(sizeof(kMagic));
+}
+
+bool ColumnarWriter::addRow(const std::vector<QVariant> &values)
+{
+    if (finished || values.size() != columns.size())
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < columns.size(); ++i)
+    {
+        appendValue(columns[i], values[i]);
+    }
+    ++bufferedRows;
+
+    return bufferedRows < groupSize || flushRowGroup();
+}
+
+void ColumnarWriter::appendValue(ColumnBuffer &column, const QVariant &value)
+{
+    if (bufferedRows % 8 == 0)
+    {
+        column.nulls.append('\0');
+    }
+
+    QVariant typed;
+    bool ok = !value.isNull();
+    if (ok)
+    {
+        switch (column.type)
+        {
+        case Columnar::Type::Integer:
+            typed = value.toLongLong(&ok);
+            break;
+        case Columnar::Type::Real:
+            typed = value.toDouble(&ok);
+            break;
+        case Columnar::Type::Text:
+            typed = value.toString();
+            break;
+        }
+    }
+
+    if (!ok)
+    {
+        column.nulls[bufferedRows / 8] = char(column.nulls[bufferedRows / 8] | (1 << (bufferedRows % 8)));
+        ++column.nullCount;
+        return;
+    }
+
+    if (!column.min.isValid() || lessThan(column.type, typed, column.min))
+    {
+        column.min = typed;
+    }
+    if (!column.max.isValid() || lessThan(column.type, column.max, typed))
+    {
+        column.max = typed;
+    }
+
+    switch (column.type)
+    {
+    case Columnar::Type::Integer:
+    {
+        const qint64 number = typed.toLongLong();
+        putVarint(column.plain, zigzag(number - column.previous));
+        column.previous = number;
+        break;
+    }
+    case Columnar::Type::Real:
+    {
+        char bytes[sizeof(double)];
+        qToLittleEndian(typed.toDouble(), bytes);
+        column.plain.append(bytes, sizeof(bytes));
+        break;
+    }
+    case Columnar::Type::Text:
+    {
+        const QString text = typed.toString();
+        const QByteArray utf8 = text.toUtf8();
+        putVarint(column.plain, quint64(utf8.size()));
+        column.plain.append(utf8);
+
+        if (column.dictionaryUsable)
+        {
+            auto it = column.dictionary.constFind(text);
+            if (it == column.dictionary.constEnd())
+            {
+                if (column.dictionary.size() >= kMaxDictionaryEntries)
+                {
+                    // Too many distinct values; plain encoding will win
+                    column.dictionaryUsable = false;
+                    column.dictionary.clear();
+                    column.dictionaryValues.clear();
+                    column.dictionaryIndices.clear();
+                    break;
+                }
+                it = column.dictionary.insert(text, quint32(column.dictionary.size()));
+                putVarint(column.dictionaryValues, quint64(utf8.size()));
+                column.dictionaryValues.append(utf8);
+            }
+            putVarint(column.dictionaryIndices, it.value());
+        }
+        break;
+    }
+    }
+}
+
+bool ColumnarWriter::flushRowGroup()
+{
+    if (bufferedRows == 0)
+    {
+        return true;
+    }
+
+    Columnar::RowGroup group;
+    group.rowCount = bufferedRows;
+    for (ColumnBuffer &column : columns)
+    {
+        Columnar::ColumnChunk chunk;
+        QByteArray body = column.nulls;
+        if (column.type == Columnar::Type::Integer)
+        {
+            chunk.encoding = Columnar::Encoding::Delta;
+            body.append(column.plain);
+        }
+        else if (column.type == Columnar::Type::Text && column.dictionaryUsable &&
+                 column.dictionaryValues.size() + column.dictionaryIndices.size() < column.plain.size())
+        {
+            chunk.encoding = Columnar::Encoding::Dictionary;
+            putVarint(body, quint64(column.dictionary.size()));
+            body.append(column.dictionaryValues);
+            body.append(column.dictionaryIndices);
+        }
+        else
+        {
+            body.append(column.plain);
+        }
+
+        const QByteArray compressed = qCompress(body, kCompressionLevel);
+        chunk.offset = file.pos();
+        chunk.compressedSize = quint32(compressed.size());
+        chunk.nullCount = column.nullCount;
+        chunk.min = column.min;
+        chunk.max = column.max;
+        if (file.write(compressed) != compressed.size())
+        {
+            qDebug() << "Error writing export file:" << file.errorString();
+            return false;
+        }
+
+        group.columns.push_back(chunk);
+        resetColumn(column);
+    }
+
+    rowGroups.push_back(std::move(group));
+    rowsWritten += bufferedRows;
+    bufferedRows = 0;
+    return true;
+}
+
+void ColumnarWriter::resetColumn(ColumnBuffer &column)
+{
+    column.nulls.clear();
+    column.plain.clear();
+    column.previous = 0;
+    column.nullCount = 0;
+    column.min = QVariant();
+    column.max = QVariant();
+    column.dictionaryUsable = true;
+    column.dictionary.clear();
+    column.dictionaryValues.clear();
+    column.dictionaryIndices.clear();
+}
+
+bool ColumnarWriter::finish()
+{
+    if (finished || !flushRowGroup())
+    {
+        return false;
+    }
+    finished = true;
+
+    QByteArray footer;
+    QDataStream stream(&footer, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_6_0);
+    stream << kFormatVersion << names;
+    for (const ColumnBuffer &column : columns)
+    {
+        stream << quint8(column.type);
+    }
+    stream << quint32(rowGroups.size());
+    for (const Columnar::RowGroup &group : rowGroups)
+    {
+        stream << group.rowCount;
+        for (const Columnar::ColumnChunk &chunk : group.columns)
+        {
+            stream << chunk.offset << chunk.compressedSize << quint8(chunk.encoding)
+                   << chunk.nullCount << chunk.min << chunk.max;
+        }
+    }
+
+    char footerSize[4];
+    qToLittleEndian(quint32(footer.size()), footerSize);
+    if (file.write(footer) != footer.size() ||
+        file.write(footerSize, sizeof(footerSize)) != qint64(sizeof(footerSize)) ||
+        file.write(kMagic, sizeof(kMagic)) != qint64(sizeof(kMagic)))
+    {
+        qDebug() << "Error writing export footer:" << file.errorString();
+        return false;
+    }
+    return file.commit();
+}
+
+ColumnarReader::ColumnarReader(const QString &path)
+    : file(path), data(nullptr), size(0)
+{
+}
+
+bool ColumnarReader::open()
+{
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        qDebug() << "Cannot open" << file.fileName() << ":" << file.errorString();
+        return false;
+    }
+    size = file.size();
+    const qint64 trailerSize = sizeof(quint32) + sizeof(kMagic);
+    if (size < qint64(sizeof(kMagic)) + trailerSize || !(data = file.map(0, size)))
+    {
+        qDebug() << "Not a columnar export:" << file.fileName();
+        return false;
+    }
+    if (std::memcmp(data, kMagic, sizeof(kMagic)) != 0 ||
+        std::memcmp(data + size - sizeof(kMagic), kMagic, sizeof(kMagic)) != 0)
+    {
+        qDebug() << "Bad columnar export magic:" << file.fileName();
+        return false;
+    }
+
+    const quint32 footerSize = qFromLittleEndian<quint32>(data + size - trailerSize);
+    if (footerSize > size - trailerSize - qint64(sizeof(kMagic)))
+    {
+        return false;
+    }
+    const QByteArray footer = QByteArray::fromRawData(
+        reinterpret_cast<const char *>(data + size - trailerSize - footerSize), footerSize);
+    QDataStream stream(footer);
+    stream.setVersion(QDataStream::Qt_6_0);
+
+    quint32 version = 0;
+    stream >> version >> names;
+    if (version != kFormatVersion)
+    {
+        qDebug() << "Unsupported columnar export version" << version;
+        return false;
+    }
+    types.clear();
+    for (int i = 0; i < names.size(); ++i)
+    {
+        quint8 type = 0;
+        stream >> type;
+        types.push_back(Columnar::Type(type));
+    }
+
+    quint32 groupCount = 0;
+    stream >> groupCount;
+    groups.clear();
+    for (quint32 g = 0; g < groupCount && stream.status() == QDataStream::Ok; ++g)
+    {
+        Columnar::RowGroup group;
+        stream >> group.rowCount;
+        for (int c = 0; c < names.size(); ++c)
+        {
+            Columnar::ColumnChunk chunk;
+            quint8 encoding = 0;
+            stream >> chunk.offset >> chunk.compressedSize >> encoding >> chunk.nullCount >> chunk.min >> chunk.max;
+            chunk.encoding = Columnar::Encoding(encoding);
+            group.columns.push_back(chunk);
+        }
+        groups.push_back(std::move(group));
+    }
+    return stream.status() == QDataStream::Ok;
+}
+
+qint64 ColumnarReader::rowCount() const
+{
+    qint64 rows = 0;
+    for (const Columnar::RowGroup &group : groups)
+    {
+        rows += group.rowCount;
+    }
+    return rows;
+}
+
+bool ColumnarReader::readColumn(int rowGroup, int column, std::vector<QVariant> &values) const
+{
+    if (rowGroup < 0 || rowGroup >= int(groups.size()) || column < 0 || column >= names.size())
+    {
+        return false;
+    }
+    const Columnar::RowGroup &group = groups[rowGroup];
+    const Columnar::ColumnChunk &chunk = group.columns[column];
+    if (chunk.offset < 0 || chunk.offset + chunk.compressedSize > size)
+    {
+        return false;
+    }
+
+    const QByteArray body = qUncompress(data + chunk.offset, qsizetype(chunk.compressedSize));
+    const qint64 bitmapSize = (group.rowCount + 7) / 8;
+    if (body.size() < bitmapSize)
+    {
+        return false;
+    }
+    const char *bitmap = body.constData();
+    const char *p = bitmap + bitmapSize;
+    const char *end = body.constData() + body.size();
+
+    auto readString = [&p, end](QString &text) -> bool
+    {
+        quint64 length = 0;
+        if (!getVarint(p, end, length) || length > quint64(end - p))
+        {
+            return false;
+        }
+        text = QString::fromUtf8(p, qsizetype(length));
+        p += length;
+        return true;
+    };
+
+    QStringList dictionary;
+    if (chunk.encoding == Columnar::Encoding::Dictionary)
+    {
+        quint64 entries = 0;
+        if (!getVarint(p, end, entries))
+        {
+            return false;
+        }
+        for (quint64 i = 0; i < entries; ++i)
+        {
+            QString text;
+            if (!readString(text))
+            {
+                return false;
+            }
+            dictionary.append(text);
+        }
+    }
+
+    values.clear();
+    values.reserve(group.rowCount);
+    qint64 previous = 0;
+    for (qint64 row = 0; row < group.rowCount; ++row)
+    {
+        if (isNullAt(bitmap, row))
+        {
+            values.emplace_back();
+            continue;
+        }
+
+        switch (types[column])
+        {
+        case Columnar::Type::Integer:
+        {
+            quint64 delta = 0;
+            if (!getVarint(p, end, delta))
+            {
+                return false;
+            }
+            previous += unzigzag(delta);
+            values.emplace_back(previous);
+            break;
+        }
+        case Columnar::Type::Real:
+        {
+            if (end - p < qint64(sizeof(double)))
+            {
+                return false;
+            }
+            values.emplace_back(qFromLittleEndian<double>(p));
+            p += sizeof(double);
+            break;
+        }
+        case Columnar::Type::Text:
+        {
+            if (chunk.encoding == Columnar::Encoding::Dictionary)
+            {
+                quint64 index = 0;
+                if (!getVarint(p, end, index) || index >= quint64(dictionary.size()))
+                {
+                    return false;
+                }
+                values.emplace_back(dictionary.at(qsizetype(index)));
+            }
+            else
+            {
+                QString text;
+                if (!readString(text))
+                {
+                    return false;
+                }
+                values.emplace_back(text);
+            }
+            break;
+        }
+        }
+    }
+    return true;
+}
@@ -0,0 +1,219 @@
+#include "utils/completiontrie.h"
+#include <algorithm>
+
+namespace
+{
+    // Longer keys are cut; labels and displays are stored with 16-bit lengths
+    const int kMaxKeyLength = 128;
+}
+
+QString CompletionTrie::normalize(const QString &text)
+{
+    return text.simplified().toLower().left(kMaxKeyLength);
+}
+
+CompletionTrie CompletionTrie::build(std::vector<Entry> entries, int topK)
+{
+    CompletionTrie trie;
+    trie.topK = std::max(1, std::min(topK, 255));
+
+    for (Entry &entry : entries)
+    {
+        entry.key = normalize(entry.key);
+        entry.display = entry.display.left(kMaxKeyLength);
+    }
+    entries.erase(std::remove_if(entries.begin(), entries.end(), [](const Entry &entry)
+                                 { return entry.key.isEmpty(); }),
+                  entries.end());
+    std::sort(entries.begin(), entries.end(), [](const Entry &a, const Entry &b)
+              { return a.key < b.key || (a.key == b.key && a.weight > b.weight); });
+
+    // Merge duplicate keys; the first of each run is the heaviest
+    std::vector<quint32> keyOffsets;
+    std::vector<int> keyLengths;
+    for (size_t i = 0; i < entries.size(); ++i)
+    {
+        if (i > 0 && entries[i].key == entries[i - 1].key)
+        {
+            trie.weights.back() += entries[i].weight;
+            continue;
+        }
+        keyOffsets.push_back(static_cast<quint32>(trie.keyPool.size()));
+        keyLengths.push_back(entries[i].key.size());
+        trie.keyPool += entries[i].key;
+        trie.displayOffsets.push_back(static_cast<quint32>(trie.displayPool.size()));
+        trie.displayLengths.push_back(static_cast<quint16>(entries[i].display.size()));
+        trie.displayPool += entries[i].display;
+        trie.weights.push_back(entries[i].weight);
+    }
+
+    trie.nodes.emplace_back();
+    trie.buildNode(0, 0, static_cast<int>(keyOffsets.size()), 0, keyOffsets, keyLengths);
+    trie.nodes.shrink_to_fit();
+    trie.topEntries.shrink_to_fit();
+    trie.keyPool.squeeze();
+    trie.displayPool.squeeze();
+    return trie;
+}
+
+quint32 CompletionTrie::buildNode(quint32 node, int lo, int hi, int depth, const std::vector<quint32> &keyOffsets,
+                                  const std::vector<int> &keyLengths)
+{
+    const QChar *pool = keyPool.constData();
+    std::vector<quint32> collected;
+
+    // Keys are sorted, so one that ends here comes first
+    int i = lo;
+    if (i < hi && keyLengths[i] == depth)
+    {
+        collected.push_back(static_cast<quint32>(i));
+        ++i;
+    }
+
+    std::vector<std::pair<int, int>> groups;
+    while (i < hi)
+    {
+        const QChar c = pool[keyOffsets[i] + depth];
+        int end = i + 1;
+        while (end < hi && pool[keyOffsets[end] + depth] == c)
+        {
+            ++end;
+        }
+        groups.emplace_back(i, end);
+        i = end;
+    }
+
+    const quint32 firstChild = static_cast<quint32>(nodes.size());
+    nodes.resize(nodes.size() + groups.size());
+    nodes[node].firstChild = firstChild;
+    nodes[node].childCount = static_cast<quint16>(groups.size());
+
+    for (size_t g = 0; g < groups.size(); ++g)
+    {
+        const int first = groups[g].first;
+        const int last = groups[g].second - 1;
+        // The group shares the prefix of its first and last key
+        int common = depth + 1;
+        const int shortest = std::min(keyLengths[first], keyLengths[last]);
+        while (common < shortest && pool[keyOffsets[first] + common] == pool[keyOffsets[last] + common])
+        {
+            ++common;
+        }
+
+        const quint32 child = firstChild + static_cast<quint32>(g);
+        nodes[child].labelOffset = keyOffsets[first] + depth;
+        nodes[child].labelLength = static_cast<quint16>(common - depth);
+        buildNode(child, groups[g].first, groups[g].second, common, keyOffsets, keyLengths);
+
+        const Node &built = nodes[child];
+        collected.insert(collected.end(), topEntries.begin() + built.topOffset,
+                         topEntries.begin() + built.topOffset + built.topCount);
+    }
+
+    // Heaviest first; several keys (e.g. "assistant" and "library assistant")
+    // may suggest the same display, which is kept once
+    std::stable_sort(collected.begin(), collected.end(), [this](quint32 a, quint32 b)
+                     { return weights[a] > weights[b]; });
+    const QChar *displays = displayPool.constData();
+    auto sameDisplay = [&](quint32 a, quint32 b)
+    {
+        return displayLengths[a] == displayLengths[b] &&
+               std::equal(displays + displayOffsets[a], displays + displayOffsets[a] + displayLengths[a],
+                          displays + displayOffsets[b]);
+    };
+
+    nodes[node].topOffset = static_cast<quint32>(topEntries.size());
+    int kept = 0;
+    for (quint32 entry : collected)
+    {
+        if (kept == topK)
+        {
+            break;
+        }
+        const auto keptBegin = topEntries.end() - kept;
+        if (std::none_of(keptBegin, topEntries.end(), [&](quint32 other)
+                         { return sameDisplay(entry, other); }))
+        {
+            topEntries.push_back(entry);
+            ++kept;
+        }
+    }
+    nodes[node].topCount = static_cast<quint8>(kept);
+    return node;
+}
+
+int CompletionTrie::findChild(const Node &node, QChar c) const
+{
+    const QChar *pool = keyPool.constData();
+    int lo = static_cast<int>(node.firstChild);
+    int hi = lo + node.childCount;
+    while (lo < hi)
+    {
+        const int mid = (lo + hi) / 2;
+        const QChar first = pool[nodes[mid].labelOffset];
+        if (first == c)
+        {
+            return mid;
+        }
+        if (first < c)
+        {
+            lo = mid + 1;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+    return -1;
+}
+
+QStringList CompletionTrie::complete(const QString &prefix, int limit) const
+{
+    QStringList suggestions;
+    if (nodes.empty() || limit <= 0)
+    {
+        return suggestions;
+    }
+
+    const QString key = normalize(prefix);
+    const QChar *pool = keyPool.constData();
+    int node = 0;
+    int position = 0;
+    while (position < key.size())
+    {
+        const int child = findChild(nodes[node], key.at(position));
+        if (child < 0)
+        {
+            return suggestions;
+        }
+        // The prefix may end part-way along the edge
+        const Node &edge = nodes[child];
+        const int length = std::min<int>(edge.labelLength, key.size() - position);
+        for (int j = 0; j < length; ++j)
+        {
+            if (pool[edge.labelOffset + j] != key.at(position + j))
+            {
+                return suggestions;
+            }
+        }
+        position += length;
+        node = child;
+    }
+
+    const Node &found = nodes[node];
+    const int count = std::min<int>(found.topCount, limit);
+    for (int i = 0; i < count; ++i)
+    {
+        const quint32 entry = topEntries[found.topOffset + i];
+        suggestions << displayPool.mid(displayOffsets[entry], displayLengths[entry]);
+    }
+    return suggestions;
+}
+
+qint64 CompletionTrie::memoryBytes() const
+{
+    return qint64(keyPool.capacity() + displayPool.capacity()) * qint64(sizeof(QChar)) +
+           qint64(nodes.capacity() * sizeof(Node)) + qint64(topEntries.capacity() * sizeof(quint32)) +
+           qint64(weights.capacity() * sizeof(quint32)) + qint64(displayOffsets.capacity() * sizeof(quint32)) +
+           qint64(displayLengths.capacity() * sizeof(quint16));
+}
@@ -0,0 +1,60 @@
+#include "utils/csvreader.h"
+
+bool readCsvRecord(QTextStream &in, QStringList &fields)
+{
+    fields.clear();
+    if (in.atEnd())
+    {
+        return false;
+    }
+
+    QString field;
+    bool inQuotes = false;
+    QString line = in.readLine();
+    while (true)
+    {
+        for (int i = 0; i < line.size(); ++i)
+        {
+            const QChar c = line.at(i);
+            if (inQuotes)
+            {
+                if (c == '"' && i + 1 < line.size() && line.at(i + 1) == '"')
+                {
+                    field += '"';
+                    ++i;
+                }
+                else if (c == '"')
+                {
+                    inQuotes = false;
+                }
+                else
+                {
+                    field += c;
+                }
+            }
+            else if (c == '"')
+            {
+                inQuotes = true;
+            }
+            else if (c == ',')
+            {
+                fields << field;
+                field.clear();
+            }
+            else
+            {
+                field += c;
+            }
+        }
+
+        if (inQuotes && !in.atEnd())
+        {
+            field += '\n';
+            line = in.readLine();
+            continue;
+        }
+        break;
+    }
+    fields << field;
+    return true;
+}
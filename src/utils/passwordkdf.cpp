@@ -0,0 +1,197 @@
+#include "utils/passwordkdf.h"
+#include <QCryptographicHash>
+#include <QMessageAuthenticationCode>
+#include <QRandomGenerator>
+#include <QtEndian>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+    inline uint32_t rotl(uint32_t value, int shift)
+    {
+        return (value << shift) | (value >> (32 - shift));
+    }
+
+    // Salsa20/8 core applied in place to a 64-byte block (16 words)
+    void salsa20_8(uint32_t block[16])
+    {
+        uint32_t x[16];
+        std::memcpy(x, block, sizeof(x));
+        for (int i = 0; i < 8; i += 2)
+        {
+            x[4] ^= rotl(x[0] + x[12], 7);
+            x[8] ^= rotl(x[4] + x[0], 9);
+            x[12] ^= rotl(x[8] + x[4], 13);
+            x[0] ^= rotl(x[12] + x[8], 18);
+            x[9] ^= rotl(x[5] + x[1], 7);
+            x[13] ^= rotl(x[9] + x[5], 9);
+            x[1] ^= rotl(x[13] + x[9], 13);
+            x[5] ^= rotl(x[1] + x[13], 18);
+            x[14] ^= rotl(x[10] + x[6], 7);
+            x[2] ^= rotl(x[14] + x[10], 9);
+            x[6] ^= rotl(x[2] + x[14], 13);
+            x[10] ^= rotl(x[6] + x[2], 18);
+            x[3] ^= rotl(x[15] + x[11], 7);
+            x[7] ^= rotl(x[3] + x[15], 9);
+            x[11] ^= rotl(x[7] + x[3], 13);
+            x[15] ^= rotl(x[11] + x[7], 18);
+
+            x[1] ^= rotl(x[0] + x[3], 7);
+            x[2] ^= rotl(x[1] + x[0], 9);
+            x[3] ^= rotl(x[2] + x[1], 13);
+            x[0] ^= rotl(x[3] + x[2], 18);
+            x[6] ^= rotl(x[5] + x[4], 7);
+            x[7] ^= rotl(x[6] + x[5], 9);
+            x[4] ^= rotl(x[7] + x[6], 13);
+            x[5] ^= rotl(x[4] + x[7], 18);
+            x[11] ^= rotl(x[10] + x[9], 7);
+            x[8] ^= rotl(x[11] + x[10], 9);
+            x[9] ^= rotl(x[8] + x[11], 13);
+            x[10] ^= rotl(x[9] + x[8], 18);
+            x[12] ^= rotl(x[15] + x[14], 7);
+            x[13] ^= rotl(x[12] + x[15], 9);
+            x[14] ^= rotl(x[13] + x[12], 13);
+            x[15] ^= rotl(x[14] + x[13], 18);
+        }
+        for (int i = 0; i < 16; ++i)
+        {
+            block[i] += x[i];
+        }
+    }
+
+    // scryptBlockMix: in is 2r 64-byte blocks, result written to out
+    void blockMix(const uint32_t *in, uint32_t *out, int r)
+    {
+        uint32_t x[16];
+        std::memcpy(x, in + (2 * r - 1) * 16, sizeof(x));
+        for (int i = 0; i < 2 * r; ++i)
+        {
+            for (int k = 0; k < 16; ++k)
+            {
+                x[k] ^= in[i * 16 + k];
+            }
+            salsa20_8(x);
+            // Even blocks go to the first half, odd blocks to the second
+            std::memcpy(out + ((i / 2) + (i % 2) * r) * 16, x, sizeof(x));
+        }
+    }
+
+    // scryptROMix over one 128*r byte block (as little-endian words)
+    void roMix(uint32_t *block, int r, uint64_t n, std::vector<uint32_t> &v)
+    {
+        const size_t words = static_cast<size_t>(32) * r;
+        std::vector<uint32_t> x(block, block + words);
+        std::vector<uint32_t> y(words);
+
+        for (uint64_t i = 0; i < n; ++i)
+        {
+            std::memcpy(v.data() + i * words, x.data(), words * sizeof(uint32_t));
+            blockMix(x.data(), y.data(), r);
+            x.swap(y);
+        }
+        for (uint64_t i = 0; i < n; ++i)
+        {
+            // Integerify: first word of the last 64-byte block
+            const uint64_t j = x[(2 * r - 1) * 16] & (n - 1);
+            const uint32_t *vj = v.data() + j * words;
+            for (size_t k = 0; k < words; ++k)
+            {
+                x[k] ^= vj[k];
+            }
+            blockMix(x.data(), y.data(), r);
+            x.swap(y);
+        }
+        std::memcpy(block, x.data(), words * sizeof(uint32_t));
+    }
+}
+
+QByteArray PasswordKdf::pbkdf2Sha256(const QByteArray &password, const QByteArray &salt,
+                                     int iterations, int keyLength)
+{
+    QByteArray derived;
+    derived.reserve(keyLength);
+    QMessageAuthenticationCode mac(QCryptographicHash::Sha256, password);
+
+    for (quint32 blockIndex = 1; derived.size() < keyLength; ++blockIndex)
+    {
+        char counter[4];
+        qToBigEndian(blockIndex, counter);
+
+        mac.reset();
+        mac.addData(salt);
+        mac.addData(QByteArrayView(counter, 4));
+        QByteArray u = mac.result();
+        QByteArray t = u;
+        for (int i = 1; i < iterations; ++i)
+        {
+            mac.reset();
+            mac.addData(u);
+            u = mac.result();
+            for (int k = 0; k < t.size(); ++k)
+            {
+                t[k] = static_cast<char>(t[k] ^ u[k]);
+            }
+        }
+        derived.append(t);
+    }
+    derived.truncate(keyLength);
+    return derived;
+}
+
+QByteArray PasswordKdf::scrypt(const QByteArray &password, const QByteArray &salt,
+                               int logN, int r, int p, int keyLength)
+{
+    if (logN < 1 || logN > 24 || r < 1 || r > 32 || p < 1 || p > 16 || keyLength < 1)
+    {
+        return QByteArray();
+    }
+
+    const uint64_t n = uint64_t(1) << logN;
+    const int blockBytes = 128 * r;
+    QByteArray b = pbkdf2Sha256(password, salt, 1, p * blockBytes);
+
+    std::vector<uint32_t> words(static_cast<size_t>(32) * r);
+    std::vector<uint32_t> v(static_cast<size_t>(32) * r * n);
+    for (int i = 0; i < p; ++i)
+    {
+        uchar *chunk = reinterpret_cast<uchar *>(b.data()) + i * blockBytes;
+        for (size_t k = 0; k < words.size(); ++k)
+        {
+            words[k] = qFromLittleEndian<quint32>(chunk + 4 * k);
+        }
+        roMix(words.data(), r, n, v);
+        for (size_t k = 0; k < words.size(); ++k)
+        {
+            qToLittleEndian<quint32>(words[k], chunk + 4 * k);
+        }
+    }
+
+    return pbkdf2Sha256(password, b, 1, keyLength);
+}
+
+QByteArray PasswordKdf::randomSalt(int length)
+{
+    QByteArray salt(length, Qt::Uninitialized);
+    QRandomGenerator *generator = QRandomGenerator::system();
+    for (int i = 0; i < length; ++i)
+    {
+        salt[i] = static_cast<char>(generator->bounded(256));
+    }
+    return salt;
+}
+
+bool PasswordKdf::constantTimeEquals(const QByteArray &a, const QByteArray &b)
+{
+    if (a.size() != b.size())
+    {
+        return false;
+    }
+    unsigned char diff = 0;
+    for (int i = 0; i < a.size(); ++i)
+    {
+        diff |= static_cast<unsigned char>(a[i] ^ b[i]);
+    }
+    return diff == 0;
+}
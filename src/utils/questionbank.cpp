@@ -0,0 +1,643 @@
+#include "utils/questionbank.h"
+#include "utils/csvreader.h"
+#include <QCoreApplication>
+#include <QDebug>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QSet>
+#include <QtEndian>
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <map>
+
+namespace
+{
+    const char kMagic[8] = {'C', 'H', 'Q', 'B', 'A', 'N', 'K', '1'};
+    const quint32 kFormatVersion = 1;
+
+    // Record sizes; every section stays 4-byte aligned
+    const quint32 kHeaderSize = 68;
+    const quint32 kStringRefSize = 8;  // u32 offset, u32 length
+    const quint32 kQuestionSize = 20;  // text ref, u32 first option, u8 count, u8 correct,
+                                       // u8 difficulty, u8 reserved, u16 major, u16 mode
+    const quint32 kBucketSize = 20;    // u16 major, u16 mode, u32 first id, u32 level ends[3]
+    const int kMaxOptions = 16;
+
+    quint32 u32(const uchar *p)
+    {
+        return qFromLittleEndian<quint32>(p);
+    }
+
+    quint16 u16(const uchar *p)
+    {
+        return qFromLittleEndian<quint16>(p);
+    }
+
+    void putU32(QByteArray &out, quint32 value)
+    {
+        uchar bytes[4];
+        qToLittleEndian(value, bytes);
+        out.append(reinterpret_cast<const char *>(bytes), 4);
+    }
+
+    void putU16(QByteArray &out, quint16 value)
+    {
+        uchar bytes[2];
+        qToLittleEndian(value, bytes);
+        out.append(reinterpret_cast<const char *>(bytes), 2);
+    }
+
+    // Deduplicated UTF-8 pool; identical options are stored once
+    class StringPool
+    {
+    public:
+        void addRef(QByteArray &out, const QString &text)
+        {
+            const QByteArray utf8 = text.toUtf8();
+            auto it = offsets.constFind(utf8);
+            quint32 offset;
+            if (it != offsets.constEnd())
+            {
+                offset = *it;
+            }
+            else
+            {
+                offset = static_cast<quint32>(pool.size());
+                pool += utf8;
+                offsets.insert(utf8, offset);
+            }
+            putU32(out, offset);
+            putU32(out, static_cast<quint32>(utf8.size()));
+        }
+
+        QByteArray pool;
+
+    private:
+        QHash<QByteArray, quint32> offsets;
+    };
+
+    bool fail(QString *error, const QString &message)
+    {
+        if (error)
+        {
+            *error = message;
+        }
+        return false;
+    }
+}
+
+int QuestionBankFormat::difficultyLevel(const QString &name)
+{
+    const QString level = name.trimmed().toLower();
+    if (level.isEmpty() || level == "easy" || level == "1")
+        return 0;
+    if (level == "medium" || level == "2")
+        return 1;
+    if (level == "hard" || level == "3")
+        return 2;
+    return -1;
+}
+
+QString QuestionBankFormat::normalizeTag(const QString &tag)
+{
+    const QString normalized = tag.simplified().toLower();
+    return normalized == "*" ? QString() : normalized;
+}
+
+bool QuestionBankWriter::addQuestion(const QString &major, const QString &mode, int difficulty,
+                                     const Question &question, QString *error)
+{
+    const QString normalizedMode = QuestionBankFormat::normalizeTag(mode);
+    if (normalizedMode.isEmpty())
+        return fail(error, "missing mode");
+    if (difficulty < 0 || difficulty >= QuestionBankFormat::kDifficultyLevels)
+        return fail(error, "bad difficulty");
+    if (question.text.trimmed().isEmpty())
+        return fail(error, "empty question text");
+    if (question.options.size() < 2 || question.options.size() > kMaxOptions)
+        return fail(error, QString("needs 2-%1 options").arg(kMaxOptions));
+    if (!question.options.contains(question.correctAnswer))
+        return fail(error, "answer is not one of the options");
+
+    questions.push_back({QuestionBankFormat::normalizeTag(major), normalizedMode, difficulty, question});
+    return true;
+}
+
+int QuestionBankWriter::addJson(const QByteArray &json, QString *error)
+{
+    QJsonParseError parseError;
+    const QJsonDocument document = QJsonDocument::fromJson(json, &parseError);
+    if (document.isNull())
+    {
+        fail(error, parseError.errorString());
+        return -1;
+    }
+    const QJsonArray items = document.isArray() ? document.array() : document.object().value("questions").toArray();
+
+    int added = 0;
+    for (int i = 0; i < items.size(); ++i)
+    {
+        const QJsonObject item = items.at(i).toObject();
+        const QJsonValue difficultyValue = item.value("difficulty");
+        const int difficulty = difficultyValue.isDouble() ? difficultyValue.toInt() - 1
+                                                          : QuestionBankFormat::difficultyLevel(difficultyValue.toString());
+
+        Question question;
+        question.text = item.value("text").toString();
+        question.correctAnswer = item.value("answer").toString();
+        for (const QJsonValue &option : item.value("options").toArray())
+        {
+            question.options.append(option.toString());
+        }
+
+        QString reason;
+        if (!addQuestion(item.value("major").toString(), item.value("mode").toString(), difficulty, question, &reason))
+        {
+            fail(error, QString("question %1: %2").arg(i + 1).arg(reason));
+            return -1;
+        }
+        ++added;
+    }
+    return added;
+}
+
+int QuestionBankWriter::addCsv(QTextStream &in, QString *error)
+{
+    QStringList header;
+    if (!readCsvRecord(in, header))
+    {
+        fail(error, "empty input");
+        return -1;
+    }
+    QHash<QString, int> columnIndex;
+    for (int i = 0; i < header.size(); ++i)
+    {
+        columnIndex.insert(header.at(i).trimmed().toLower(), i);
+    }
+    for (const char *required : {"mode", "question", "answer", "options"})
+    {
+        if (!columnIndex.contains(required))
+        {
+            fail(error, QString("no %1 column").arg(required));
+            return -1;
+        }
+    }
+
+    QStringList fields;
+    int lineNumber = 1;
+    int added = 0;
+    while (readCsvRecord(in, fields))
+    {
+        ++lineNumber;
+        auto field = [&](const char *name)
+        { return fields.value(columnIndex.value(name, -1)).trimmed(); };
+
+        Question question;
+        question.text = field("question");
+        question.correctAnswer = field("answer");
+        for (const QString &option : field("options").split('|', Qt::SkipEmptyParts))
+        {
+            question.options.append(option.trimmed());
+        }
+
+        QString reason;
+        if (!addQuestion(field("major"), field("mode"), QuestionBankFormat::difficultyLevel(field("difficulty")),
+                         question, &reason))
+        {
+            fail(error, QString("line %1: %2").arg(lineNumber).arg(reason));
+            return -1;
+        }
+        ++added;
+    }
+    return added;
+}
+
+int QuestionBankWriter::bucketCount() const
+{
+    QSet<QString> majors;
+    QSet<QString> modes;
+    QSet<QPair<QString, QString>> pairs;
+    for (const Entry &entry : questions)
+    {
+        majors.insert(entry.major);
+        modes.insert(entry.mode);
+        pairs.insert({entry.major, entry.mode});
+    }
+    // General questions open a bucket for every major with that mode
+    for (const Entry &entry : questions)
+    {
+        if (entry.major.isEmpty())
+        {
+            for (const QString &major : majors)
+            {
+                pairs.insert({major, entry.mode});
+            }
+        }
+    }
+    return pairs.size();
+}
+
+bool QuestionBankWriter::write(const QString &path, QString *error) const
+{
+    QStringList majors;
+    QStringList modes;
+    for (const Entry &entry : questions)
+    {
+        if (!majors.contains(entry.major))
+            majors << entry.major;
+        if (!modes.contains(entry.mode))
+            modes << entry.mode;
+    }
+    std::sort(majors.begin(), majors.end());
+    std::sort(modes.begin(), modes.end());
+    if (majors.size() > 0xffff || modes.size() > 0xffff)
+        return fail(error, "too many majors or modes");
+
+    // (major, mode) -> question ids per difficulty level
+    std::map<std::pair<int, int>, std::array<std::vector<quint32>, QuestionBankFormat::kDifficultyLevels>> buckets;
+    for (size_t id = 0; id < questions.size(); ++id)
+    {
+        const Entry &entry = questions[id];
+        const int mode = modes.indexOf(entry.mode);
+        if (entry.major.isEmpty())
+        {
+            for (int major = 0; major < majors.size(); ++major)
+            {
+                buckets[{major, mode}][entry.difficulty].push_back(static_cast<quint32>(id));
+            }
+        }
+        else
+        {
+            buckets[{majors.indexOf(entry.major), mode}][entry.difficulty].push_back(static_cast<quint32>(id));
+        }
+    }
+
+    StringPool strings;
+    QByteArray questionSection;
+    QByteArray optionSection;
+    quint32 optionCount = 0;
+    for (const Entry &entry : questions)
+    {
+        const Question &question = entry.question;
+        strings.addRef(questionSection, question.text);
+        putU32(questionSection, optionCount);
+        questionSection.append(char(question.options.size()));
+        questionSection.append(char(question.options.indexOf(question.correctAnswer)));
+        questionSection.append(char(entry.difficulty));
+        questionSection.append(char(0));
+        putU16(questionSection, static_cast<quint16>(majors.indexOf(entry.major)));
+        putU16(questionSection, static_cast<quint16>(modes.indexOf(entry.mode)));
+        for (const QString &option : question.options)
+        {
+            strings.addRef(optionSection, option);
+        }
+        optionCount += static_cast<quint32>(question.options.size());
+    }
+
+    QByteArray majorSection;
+    for (const QString &major : majors)
+        strings.addRef(majorSection, major);
+    QByteArray modeSection;
+    for (const QString &mode : modes)
+        strings.addRef(modeSection, mode);
+
+    QByteArray bucketSection;
+    QByteArray idSection;
+    quint32 idCount = 0;
+    for (const auto &bucket : buckets)
+    {
+        putU16(bucketSection, static_cast<quint16>(bucket.first.first));
+        putU16(bucketSection, static_cast<quint16>(bucket.first.second));
+        putU32(bucketSection, idCount);
+        quint32 levelEnd = 0;
+        for (const std::vector<quint32> &level : bucket.second)
+        {
+            for (quint32 id : level)
+                putU32(idSection, id);
+            levelEnd += static_cast<quint32>(level.size());
+            putU32(bucketSection, levelEnd);
+        }
+        idCount += levelEnd;
+    }
+
+    const qint64 totalSize = qint64(kHeaderSize) + questionSection.size() + optionSection.size() +
+                             majorSection.size() + modeSection.size() + bucketSection.size() +
+                             idSection.size() + strings.pool.size();
+    if (totalSize > qint64(0xffffffffu))
+        return fail(error, "question bank exceeds 4 GiB");
+
+    QByteArray header(kMagic, sizeof(kMagic));
+    putU32(header, kFormatVersion);
+    putU32(header, static_cast<quint32>(questions.size()));
+    putU32(header, optionCount);
+    putU32(header, static_cast<quint32>(majors.size()));
+    putU32(header, static_cast<quint32>(modes.size()));
+    putU32(header, static_cast<quint32>(buckets.size()));
+    putU32(header, idCount);
+    putU32(header, static_cast<quint32>(strings.pool.size()));
+    quint32 offset = kHeaderSize;
+    for (const QByteArray *section : {&questionSection, &optionSection, &majorSection, &modeSection,
+                                      &bucketSection, &idSection, &strings.pool})
+    {
+        putU32(header, offset);
+        offset += static_cast<quint32>(section->size());
+    }
+
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly))
+        return fail(error, file.errorString());
+    for (const QByteArray *section : {&header, &questionSection, &optionSection, &majorSection, &modeSection,
+                                      &bucketSection, &idSection, &strings.pool})
+    {
+        if (file.write(*section) != section->size())
+            return fail(error, file.errorString());
+    }
+    if (!file.commit())
+        return fail(error, file.errorString());
+    return true;
+}
+
+QuestionBank::QuestionBank()
+    : data(nullptr), fileSize(0), questionCount(0), optionCount(0), majorCount(0), modeCount(0), bucketCount(0),
+      idCount(0), stringBytes(0), questionsOffset(0), optionsOffset(0), majorsOffset(0), modesOffset(0),
+      bucketsOffset(0), idsOffset(0), stringsOffset(0)
+{
+}
+
+QString QuestionBank::defaultPath()
+{
+    const QString fromEnvironment = qEnvironmentVariable("CAMPUS_QUESTION_BANK");
+    if (!fromEnvironment.isEmpty())
+    {
+        return fromEnvironment;
+    }
+    return QCoreApplication::applicationDirPath() + "/questions.qbank";
+}
+
+bool QuestionBank::open(const QString &path)
+{
+    close();
+    file.setFileName(path);
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        qDebug() << "Cannot open question bank" << path << ":" << file.errorString();
+        return false;
+    }
+    fileSize = file.size();
+    const uchar *mapped = fileSize >= kHeaderSize ? file.map(0, fileSize) : nullptr;
+    if (!mapped || std::memcmp(mapped, kMagic, sizeof(kMagic)) != 0)
+    {
+        qDebug() << "Not a question bank:" << path;
+        close();
+        return false;
+    }
+    if (u32(mapped + 8) != kFormatVersion)
+    {
+        qDebug() << "Unsupported question bank version" << u32(mapped + 8);
+        close();
+        return false;
+    }
+
+    questionCount = u32(mapped + 12);
+    optionCount = u32(mapped + 16);
+    majorCount = u32(mapped + 20);
+    modeCount = u32(mapped + 24);
+    bucketCount = u32(mapped + 28);
+    idCount = u32(mapped + 32);
+    stringBytes = u32(mapped + 36);
+    questionsOffset = u32(mapped + 40);
+    optionsOffset = u32(mapped + 44);
+    majorsOffset = u32(mapped + 48);
+    modesOffset = u32(mapped + 52);
+    bucketsOffset = u32(mapped + 56);
+    idsOffset = u32(mapped + 60);
+    stringsOffset = u32(mapped + 64);
+
+    // Section bounds are checked once here; records are read without parsing
+    auto fits = [this](quint32 offset, quint32 count, quint32 recordSize)
+    { return quint64(offset) + quint64(count) * recordSize <= quint64(fileSize); };
+    if (!fits(questionsOffset, questionCount, kQuestionSize) || !fits(optionsOffset, optionCount, kStringRefSize) ||
+        !fits(majorsOffset, majorCount, kStringRefSize) || !fits(modesOffset, modeCount, kStringRefSize) ||
+        !fits(bucketsOffset, bucketCount, kBucketSize) || !fits(idsOffset, idCount, 4) ||
+        !fits(stringsOffset, stringBytes, 1))
+    {
+        qDebug() << "Truncated question bank:" << path;
+        close();
+        return false;
+    }
+    data = mapped;
+    return true;
+}
+
+void QuestionBank::close()
+{
+    if (file.isOpen())
+    {
+        file.close(); // also unmaps
+    }
+    data = nullptr;
+    fileSize = 0;
+    questionCount = optionCount = majorCount = modeCount = bucketCount = idCount = stringBytes = 0;
+}
+
+bool QuestionBank::readString(const uchar *ref, QString &text) const
+{
+    const quint32 offset = u32(ref);
+    const quint32 length = u32(ref + 4);
+    if (quint64(offset) + length > stringBytes)
+    {
+        return false;
+    }
+    text = QString::fromUtf8(reinterpret_cast<const char *>(data + stringsOffset + offset), length);
+    return true;
+}
+
+QStringList QuestionBank::majors() const
+{
+    QStringList names;
+    QString name;
+    for (quint32 i = 0; i < majorCount; ++i)
+    {
+        if (readString(data + majorsOffset + i * kStringRefSize, name) && !name.isEmpty())
+            names << name;
+    }
+    return names;
+}
+
+QStringList QuestionBank::modes() const
+{
+    QStringList names;
+    QString name;
+    for (quint32 i = 0; i < modeCount; ++i)
+    {
+        if (readString(data + modesOffset + i * kStringRefSize, name))
+            names << name;
+    }
+    return names;
+}
+
+int QuestionBank::findTag(quint32 tableOffset, quint32 tagCount, const QString &tag) const
+{
+    const QByteArray wanted = QuestionBankFormat::normalizeTag(tag).toUtf8();
+    for (quint32 i = 0; i < tagCount; ++i)
+    {
+        const uchar *ref = data + tableOffset + i * kStringRefSize;
+        const quint32 offset = u32(ref);
+        const quint32 length = u32(ref + 4);
+        if (length == quint32(wanted.size()) && quint64(offset) + length <= stringBytes &&
+            std::memcmp(data + stringsOffset + offset, wanted.constData(), length) == 0)
+        {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+QuestionBank::Range QuestionBank::findRange(const QString &major, const QString &mode, int difficulty) const
+{
+    Range range;
+    if (!data || difficulty >= QuestionBankFormat::kDifficultyLevels)
+    {
+        return range;
+    }
+    const int modeId = findTag(modesOffset, modeCount, mode);
+    if (modeId < 0)
+    {
+        return range;
+    }
+
+    int majorId = findTag(majorsOffset, majorCount, major);
+    const int generalId = findTag(majorsOffset, majorCount, QString());
+    for (int attempt = 0; attempt < 2; ++attempt, majorId = generalId)
+    {
+        if (majorId < 0)
+        {
+            continue;
+        }
+        // Buckets are sorted by (major, mode)
+        const quint32 key = (quint32(majorId) << 16) | quint32(modeId);
+        quint32 lo = 0;
+        quint32 hi = bucketCount;
+        while (lo < hi)
+        {
+            const quint32 mid = lo + (hi - lo) / 2;
+            const uchar *bucket = data + bucketsOffset + mid * kBucketSize;
+            const quint32 midKey = (quint32(u16(bucket)) << 16) | u16(bucket + 2);
+            if (midKey < key)
+            {
+                lo = mid + 1;
+            }
+            else
+            {
+                hi = mid;
+            }
+        }
+        if (lo == bucketCount)
+        {
+            continue;
+        }
+        const uchar *bucket = data + bucketsOffset + lo * kBucketSize;
+        if (u16(bucket) != majorId || u16(bucket + 2) != modeId)
+        {
+            continue;
+        }
+
+        const quint32 first = u32(bucket + 4);
+        const uchar *levelEnds = bucket + 8;
+        const quint32 begin = difficulty > 0 ? u32(levelEnds + (difficulty - 1) * 4) : 0;
+        const quint32 end = difficulty >= 0 ? u32(levelEnds + difficulty * 4)
+                                            : u32(levelEnds + (QuestionBankFormat::kDifficultyLevels - 1) * 4);
+        if (begin > end || quint64(first) + end > idCount)
+        {
+            return range;
+        }
+        range.first = first + begin;
+        range.count = end - begin;
+        return range;
+    }
+    return range;
+}
+
+int QuestionBank::count(const QString &major, const QString &mode, int difficulty) const
+{
+    return static_cast<int>(findRange(major, mode, difficulty).count);
+}
+
+QVector<Question> QuestionBank::sample(const QString &major, const QString &mode, int n, int difficulty,
+                                       QRandomGenerator *random) const
+{
+    QVector<Question> picked;
+    const Range range = findRange(major, mode, difficulty);
+    const quint32 wanted = std::min<quint32>(range.count, static_cast<quint32>(std::max(n, 0)));
+    if (wanted == 0)
+    {
+        return picked;
+    }
+
+    // Floyd's algorithm: wanted distinct positions in O(wanted), then shuffle
+    QSet<quint32> chosen;
+    std::vector<quint32> positions;
+    positions.reserve(wanted);
+    for (quint32 j = range.count - wanted; j < range.count; ++j)
+    {
+        const quint32 t = random->bounded(j + 1);
+        const quint32 position = chosen.contains(t) ? j : t;
+        chosen.insert(position);
+        positions.push_back(position);
+    }
+    for (quint32 i = wanted - 1; i > 0; --i)
+    {
+        std::swap(positions[i], positions[random->bounded(i + 1)]);
+    }
+
+    picked.reserve(static_cast<int>(wanted));
+    for (quint32 position : positions)
+    {
+        picked.append(question(u32(data + idsOffset + (range.first + position) * 4)));
+    }
+    return picked;
+}
+
+qint64 QuestionBank::questionId(const QString &major, const QString &mode, int difficulty, int index) const
+{
+    const Range range = findRange(major, mode, difficulty);
+    if (index < 0 || quint32(index) >= range.count)
+    {
+        return -1;
+    }
+    return u32(data + idsOffset + (range.first + quint32(index)) * 4);
+}
+
+Question QuestionBank::question(quint32 id) const
+{
+    Question result;
+    if (!data || id >= questionCount)
+    {
+        return result;
+    }
+    const uchar *record = data + questionsOffset + id * kQuestionSize;
+    readString(record, result.text);
+    const quint32 firstOption = u32(record + 8);
+    const quint32 options = record[12];
+    const quint32 correct = record[13];
+    if (quint64(firstOption) + options > optionCount)
+    {
+        return result;
+    }
+    result.options.reserve(static_cast<int>(options));
+    QString option;
+    for (quint32 i = 0; i < options; ++i)
+    {
+        readString(data + optionsOffset + (firstOption + i) * kStringRefSize, option);
+        result.options.append(option);
+    }
+    if (correct < options)
+    {
+        result.correctAnswer = result.options.at(static_cast<int>(correct));
+    }
+    return result;
+}
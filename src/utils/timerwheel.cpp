@@ -0,0 +1,143 @@
+#include "utils/timerwheel.h"
+#include <QtAlgorithms>
+
+TimerWheel::TimerWheel(qint64 startTick)
+    : current(startTick), count(0)
+{
+    occupied.fill(0);
+}
+
+int TimerWheel::slotIndex(qint64 tick, int level) const
+{
+    return static_cast<int>((tick >> (kSlotBits * level)) & (kSlots - 1));
+}
+
+bool TimerWheel::insert(qint64 expiry, quint64 payload)
+{
+    const qint64 top = kSlotBits * (kLevels - 1);
+    if ((expiry >> top) - (current >> top) >= kSlots)
+    {
+        return false;
+    }
+    place(Timer{expiry, payload});
+    ++count;
+    return true;
+}
+
+void TimerWheel::place(const Timer &timer)
+{
+    if (timer.expiry <= current)
+    {
+        overdue.push_back(timer);
+        return;
+    }
+
+    // Lowest level whose slot for this expiry is less than a full turn away
+    for (int level = 0; level < kLevels; ++level)
+    {
+        const int shift = kSlotBits * level;
+        if ((timer.expiry >> shift) - (current >> shift) < kSlots)
+        {
+            const int slot = slotIndex(timer.expiry, level);
+            slots[level][slot].push_back(timer);
+            occupied[level] |= quint64(1) << slot;
+            return;
+        }
+    }
+}
+
+void TimerWheel::cascade(int level)
+{
+    const int slot = slotIndex(current, level);
+    if (!(occupied[level] & (quint64(1) << slot)))
+    {
+        return;
+    }
+
+    std::vector<Timer> timers;
+    timers.swap(slots[level][slot]);
+    occupied[level] &= ~(quint64(1) << slot);
+    for (const Timer &timer : timers)
+    {
+        place(timer);
+    }
+}
+
+qint64 TimerWheel::nextWakeTick() const
+{
+    if (!overdue.empty())
+    {
+        return current;
+    }
+
+    qint64 best = -1;
+    for (int level = 0; level < kLevels; ++level)
+    {
+        if (!occupied[level])
+        {
+            continue;
+        }
+
+        const int shift = kSlotBits * level;
+        const int index = slotIndex(current, level);
+        // Slots after the current one in this turn of the level
+        const quint64 ahead = index == kSlots - 1 ? 0 : occupied[level] & ~((quint64(2) << index) - 1);
+
+        qint64 candidate;
+        if (ahead)
+        {
+            const int slot = qCountTrailingZeroBits(ahead);
+            candidate = ((current >> shift) + (slot - index)) << shift;
+        }
+        else
+        {
+            // Only slots that wrapped into the next turn: wake at the turn boundary
+            candidate = ((current >> (shift + kSlotBits)) + 1) << (shift + kSlotBits);
+        }
+
+        if (best < 0 || candidate < best)
+        {
+            best = candidate;
+        }
+    }
+    return best;
+}
+
+void TimerWheel::advance(qint64 tick, std::vector<Timer> &due)
+{
+    const auto before = due.size();
+    due.insert(due.end(), overdue.begin(), overdue.end());
+    overdue.clear();
+
+    while (current < tick)
+    {
+        const qint64 next = nextWakeTick();
+        if (next < 0 || next > tick)
+        {
+            // Nothing is filed before tick, so the slots can be skipped
+            current = tick;
+            break;
+        }
+
+        current = next;
+        for (int level = kLevels - 1; level > 0; --level)
+        {
+            if ((current & ((qint64(1) << (kSlotBits * level)) - 1)) == 0)
+            {
+                cascade(level);
+            }
+        }
+
+        const int slot = slotIndex(current, 0);
+        if (occupied[0] & (quint64(1) << slot))
+        {
+            due.insert(due.end(), slots[0][slot].begin(), slots[0][slot].end());
+            slots[0][slot].clear();
+            occupied[0] &= ~(quint64(1) << slot);
+        }
+        due.insert(due.end(), overdue.begin(), overdue.end());
+        overdue.clear();
+    }
+
+    count -= static_cast<int>(due.size() - before);
+}
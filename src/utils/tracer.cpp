@@ -0,0 +1,225 @@
+#include "utils/tracer.h"
+#include <QCoreApplication>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSaveFile>
+#include <QThread>
+#include <memory>
+#include <vector>
+
+std::atomic<bool> Tracer::enabledFlag{false};
+
+namespace
+{
+    // Hard cap per thread so a forgotten trace session cannot eat all memory
+    constexpr size_t kMaxEventsPerThread = 1 << 20;
+
+    struct TraceEvent
+    {
+        const char *category;
+        const char *name;
+        qint64 startUs;
+        qint64 durationUs;
+    };
+
+    // Each thread appends to its own buffer; the mutex is only contended
+    // while a dump or clear is running.
+    struct ThreadBuffer
+    {
+        QMutex mutex;
+        quint64 threadId = 0;
+        QString threadName;
+        std::vector<TraceEvent> events;
+        quint64 dropped = 0;
+    };
+
+    QMutex registryMutex;
+    std::vector<std::shared_ptr<ThreadBuffer>> registry;
+
+    const QElapsedTimer &traceClock()
+    {
+        static const QElapsedTimer clock = []()
+        {
+            QElapsedTimer timer;
+            timer.start();
+            return timer;
+        }();
+        return clock;
+    }
+
+    ThreadBuffer &localBuffer()
+    {
+        thread_local std::shared_ptr<ThreadBuffer> buffer = []()
+        {
+            auto created = std::make_shared<ThreadBuffer>();
+            QThread *thread = QThread::currentThread();
+            created->threadId = static_cast<quint64>(reinterpret_cast<quintptr>(QThread::currentThreadId()));
+            created->threadName = thread->objectName();
+            if (created->threadName.isEmpty())
+            {
+                bool isMain = QCoreApplication::instance() &&
+                              thread == QCoreApplication::instance()->thread();
+                created->threadName = isMain ? QStringLiteral("main")
+                                             : QStringLiteral("thread-%1").arg(created->threadId);
+            }
+            created->events.reserve(4096);
+
+            QMutexLocker locker(&registryMutex);
+            registry.push_back(created);
+            return created;
+        }();
+        return *buffer;
+    }
+
+    QByteArray jsonEscape(const char *text)
+    {
+        QByteArray out;
+        for (const char *p = text; *p; ++p)
+        {
+            const char c = *p;
+            if (c == '"' || c == '\\')
+            {
+                out += '\\';
+                out += c;
+            }
+            else if (static_cast<unsigned char>(c) < 0x20)
+            {
+                out += ' ';
+            }
+            else
+            {
+                out += c;
+            }
+        }
+        return out;
+    }
+}
+
+Tracer &Tracer::instance()
+{
+    static Tracer tracer;
+    return tracer;
+}
+
+void Tracer::setEnabled(bool enabled)
+{
+    traceClock(); // start the clock before the first span
+    enabledFlag.store(enabled, std::memory_order_relaxed);
+}
+
+bool Tracer::enableFromEnvironment()
+{
+    const QString path = qEnvironmentVariable("CAMPUS_TRACE");
+    if (path.isEmpty())
+    {
+        return false;
+    }
+    tracePath = path;
+    setEnabled(true);
+    qDebug() << "Tracing enabled, writing to" << tracePath;
+    return true;
+}
+
+qint64 Tracer::nowMicros()
+{
+    return traceClock().nsecsElapsed() / 1000;
+}
+
+void Tracer::record(const char *category, const char *name, qint64 startUs, qint64 durationUs)
+{
+    ThreadBuffer &buffer = localBuffer();
+    QMutexLocker locker(&buffer.mutex);
+    if (buffer.events.size() >= kMaxEventsPerThread)
+    {
+        ++buffer.dropped;
+        return;
+    }
+    buffer.events.push_back({category, name, startUs, durationUs});
+}
+
+bool Tracer::writeChromeTrace(const QString &path) const
+{
+    if (path.isEmpty())
+    {
+        return false;
+    }
+
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        qDebug() << "Error opening trace file:" << file.errorString();
+        return false;
+    }
+
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    {
+        QMutexLocker locker(&registryMutex);
+        buffers = registry;
+    }
+
+    const qint64 pid = QCoreApplication::applicationPid();
+    bool first = true;
+    auto separator = [&first]() -> QByteArray
+    {
+        if (first)
+        {
+            first = false;
+            return QByteArray("\n");
+        }
+        return QByteArray(",\n");
+    };
+
+    file.write("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+    quint64 dropped = 0;
+    for (const auto &buffer : buffers)
+    {
+        QMutexLocker locker(&buffer->mutex);
+        dropped += buffer->dropped;
+
+        QByteArray meta = separator();
+        meta += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" + QByteArray::number(pid) +
+                ",\"tid\":" + QByteArray::number(buffer->threadId) +
+                ",\"args\":{\"name\":\"" + jsonEscape(buffer->threadName.toUtf8().constData()) + "\"}}";
+        file.write(meta);
+
+        QByteArray chunk;
+        chunk.reserve(64 * 1024);
+        for (const TraceEvent &event : buffer->events)
+        {
+            chunk += separator();
+            chunk += "{\"name\":\"" + jsonEscape(event.name) +
+                     "\",\"cat\":\"" + jsonEscape(event.category) +
+                     "\",\"ph\":\"X\",\"ts\":" + QByteArray::number(event.startUs) +
+                     ",\"dur\":" + QByteArray::number(event.durationUs) +
+                     ",\"pid\":" + QByteArray::number(pid) +
+                     ",\"tid\":" + QByteArray::number(buffer->threadId) + "}";
+            if (chunk.size() > 60 * 1024)
+            {
+                file.write(chunk);
+                chunk.clear();
+            }
+        }
+        file.write(chunk);
+    }
+    file.write("\n]}\n");
+
+    if (dropped > 0)
+    {
+        qDebug() << "Trace buffers were full," << dropped << "events dropped";
+    }
+    return file.commit();
+}
+
+void Tracer::clear()
+{
+    QMutexLocker locker(&registryMutex);
+    for (const auto &buffer : registry)
+    {
+        QMutexLocker bufferLocker(&buffer->mutex);
+        buffer->events.clear();
+        buffer->dropped = 0;
+    }
+}
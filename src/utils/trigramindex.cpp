@@ -0,0 +1,346 @@
+#include "utils/trigramindex.h"
+#include <algorithm>
+
+namespace
+{
+    // Candidates verified with edit distance per requested result
+    const int kCandidatesPerResult = 8;
+    // Longer words fall back to a heap-allocated DP row
+    const int kStackWordLength = 48;
+}
+
+QStringList TrigramIndex::words(const QString &text)
+{
+    QString folded = text.toLower();
+    for (QChar &c : folded)
+    {
+        if (!c.isLetterOrNumber())
+        {
+            c = QLatin1Char(' ');
+        }
+    }
+    return folded.split(QLatin1Char(' '), Qt::SkipEmptyParts);
+}
+
+void TrigramIndex::appendTrigrams(const QString &word, std::vector<quint64> &out)
+{
+    const QString padded = QStringLiteral("  ") + word + QLatin1Char(' ');
+    for (int i = 0; i + 2 < padded.size(); ++i)
+    {
+        out.push_back((quint64(padded.at(i).unicode()) << 32) |
+                      (quint64(padded.at(i + 1).unicode()) << 16) |
+                      quint64(padded.at(i + 2).unicode()));
+    }
+}
+
+int TrigramIndex::editBudget(int length)
+{
+    return length <= 2 ? 0 : (length <= 5 ? 1 : 2);
+}
+
+int TrigramIndex::boundedDistance(const QString &a, const QString &b, int bound, bool prefixOfB)
+{
+    const int lengthGap = prefixOfB ? a.size() - b.size() : qAbs(a.size() - b.size());
+    if (lengthGap > bound)
+    {
+        return bound + 1;
+    }
+
+    // Two-row DP, on the stack for ordinary words; give up once a whole row
+    // exceeds the bound
+    int stackRows[2][kStackWordLength + 1];
+    std::vector<int> heapRows;
+    int *previous = stackRows[0];
+    int *current = stackRows[1];
+    if (b.size() > kStackWordLength)
+    {
+        heapRows.resize(2 * (b.size() + 1));
+        previous = heapRows.data();
+        current = previous + b.size() + 1;
+    }
+
+    for (int j = 0; j <= b.size(); ++j)
+    {
+        previous[j] = j;
+    }
+    for (int i = 1; i <= a.size(); ++i)
+    {
+        current[0] = i;
+        int rowMin = current[0];
+        const QChar ca = a.at(i - 1);
+        for (int j = 1; j <= b.size(); ++j)
+        {
+            const int substitution = previous[j - 1] + (ca == b.at(j - 1) ? 0 : 1);
+            current[j] = std::min({previous[j] + 1, current[j - 1] + 1, substitution});
+            rowMin = std::min(rowMin, current[j]);
+        }
+        if (rowMin > bound)
+        {
+            return bound + 1;
+        }
+        std::swap(previous, current);
+    }
+    // As a prefix, a may end anywhere in b: take the best cell of the last row
+    const int distance = prefixOfB ? *std::min_element(previous, previous + b.size() + 1) : previous[b.size()];
+    return std::min(distance, bound + 1);
+}
+
+void TrigramIndex::upsert(int id, const QStringList &fields)
+{
+    remove(id);
+
+    Document document;
+    document.id = id;
+    for (const QString &field : fields)
+    {
+        document.words += words(field);
+    }
+    for (const QString &word : document.words)
+    {
+        appendTrigrams(word, document.trigrams);
+    }
+    std::sort(document.trigrams.begin(), document.trigrams.end());
+    document.trigrams.erase(std::unique(document.trigrams.begin(), document.trigrams.end()),
+                            document.trigrams.end());
+
+    int slot;
+    if (!freeSlots.empty())
+    {
+        slot = freeSlots.back();
+        freeSlots.pop_back();
+    }
+    else
+    {
+        slot = static_cast<int>(documents.size());
+        documents.emplace_back();
+        overlapBySlot.push_back(0);
+    }
+
+    for (quint64 trigram : document.trigrams)
+    {
+        std::vector<int> &list = postingLists[trigram];
+        list.insert(std::lower_bound(list.begin(), list.end(), slot), slot);
+    }
+    postings += static_cast<qint64>(document.trigrams.size());
+    documents[slot] = std::move(document);
+    slotById.insert(id, slot);
+}
+
+void TrigramIndex::remove(int id)
+{
+    auto it = slotById.find(id);
+    if (it == slotById.end())
+    {
+        return;
+    }
+    const int slot = it.value();
+    slotById.erase(it);
+
+    Document &document = documents[slot];
+    for (quint64 trigram : document.trigrams)
+    {
+        auto posting = postingLists.find(trigram);
+        if (posting == postingLists.end())
+        {
+            continue;
+        }
+        std::vector<int> &list = posting.value();
+        auto at = std::lower_bound(list.begin(), list.end(), slot);
+        if (at != list.end() && *at == slot)
+        {
+            list.erase(at);
+        }
+        if (list.empty())
+        {
+            postingLists.erase(posting);
+        }
+    }
+    postings -= static_cast<qint64>(document.trigrams.size());
+    document = Document();
+    freeSlots.push_back(slot);
+}
+
+void TrigramIndex::clear()
+{
+    documents.clear();
+    freeSlots.clear();
+    slotById.clear();
+    postingLists.clear();
+    postings = 0;
+    overlapBySlot.clear();
+    touchedSlots.clear();
+}
+
+std::vector<TrigramIndex::Match> TrigramIndex::search(const QString &query, int limit) const
+{
+    std::vector<Match> matches;
+    const QStringList queryWords = words(query);
+    if (queryWords.isEmpty() || limit <= 0)
+    {
+        return matches;
+    }
+
+    std::vector<quint64> queryTrigrams;
+    int totalBudget = 0;
+    for (const QString &word : queryWords)
+    {
+        appendTrigrams(word, queryTrigrams);
+        totalBudget += editBudget(word.size());
+    }
+    std::sort(queryTrigrams.begin(), queryTrigrams.end());
+    queryTrigrams.erase(std::unique(queryTrigrams.begin(), queryTrigrams.end()), queryTrigrams.end());
+
+    // Candidate generation: every edit can destroy at most three trigrams,
+    // and a word still being typed lacks its closing " x " trigram
+    const int minOverlap =
+        std::max(1, static_cast<int>(queryTrigrams.size()) - 3 * totalBudget - static_cast<int>(queryWords.size()));
+
+    std::vector<const std::vector<int> *> lists;
+    for (quint64 trigram : queryTrigrams)
+    {
+        auto posting = postingLists.constFind(trigram);
+        if (posting != postingLists.constEnd())
+        {
+            lists.push_back(&posting.value());
+        }
+    }
+    std::sort(lists.begin(), lists.end(), [](const std::vector<int> *a, const std::vector<int> *b)
+              { return a->size() < b->size(); });
+
+    // A document reaching minOverlap must appear in one of the shortest
+    // lists.size() - minOverlap + 1 lists; the longer ones only add counts
+    // to documents found there, by binary search when that is cheaper
+    const int seedLists = static_cast<int>(lists.size()) - minOverlap + 1;
+    touchedSlots.clear();
+    for (int i = 0; i < static_cast<int>(lists.size()); ++i)
+    {
+        const std::vector<int> &list = *lists[i];
+        if (i < seedLists)
+        {
+            for (int slot : list)
+            {
+                if (overlapBySlot[slot]++ == 0)
+                {
+                    touchedSlots.push_back(slot);
+                }
+            }
+        }
+        else if (touchedSlots.size() * 16 < list.size())
+        {
+            for (int slot : touchedSlots)
+            {
+                overlapBySlot[slot] += std::binary_search(list.begin(), list.end(), slot) ? 1 : 0;
+            }
+        }
+        else
+        {
+            for (int slot : list)
+            {
+                overlapBySlot[slot] += overlapBySlot[slot] > 0 ? 1 : 0;
+            }
+        }
+    }
+
+    // Only the best-overlapping candidates are worth an edit-distance check:
+    // a histogram of overlap counts gives the cut-off level without sorting
+    const int verify = limit * kCandidatesPerResult;
+    std::vector<int> histogram(lists.size() + 1, 0);
+    for (int slot : touchedSlots)
+    {
+        ++histogram[overlapBySlot[slot]];
+    }
+    int cutoff = static_cast<int>(lists.size());
+    for (int above = histogram[cutoff]; cutoff > minOverlap && above < verify; above += histogram[--cutoff])
+    {
+    }
+
+    std::vector<Match> candidates; // id holds the slot until verified
+    std::vector<int> ties;
+    int tiesLeft = verify;
+    for (int level = cutoff + 1; level <= static_cast<int>(lists.size()); ++level)
+    {
+        tiesLeft -= histogram[level];
+    }
+    tiesLeft = std::max(tiesLeft, 0);
+    for (int slot : touchedSlots)
+    {
+        const int overlap = overlapBySlot[slot];
+        if (overlap > cutoff)
+        {
+            candidates.push_back({slot, 0, overlap});
+        }
+        else if (overlap == cutoff && overlap >= minOverlap)
+        {
+            ties.push_back(slot);
+        }
+        overlapBySlot[slot] = 0;
+    }
+    // When the cut-off level does not fit, its lowest ids go through, as in
+    // the final ordering, not whichever slots the posting lists reached first
+    if (static_cast<int>(ties.size()) > tiesLeft)
+    {
+        std::nth_element(ties.begin(), ties.begin() + tiesLeft, ties.end(), [this](int a, int b)
+                         { return documents[a].id < documents[b].id; });
+        ties.resize(tiesLeft);
+    }
+    for (int slot : ties)
+    {
+        candidates.push_back({slot, 0, cutoff});
+    }
+    // Same order as the final tie-break within an overlap level, so once
+    // limit exact matches are found no later candidate can outrank them
+    std::sort(candidates.begin(), candidates.end(), [this](const Match &a, const Match &b)
+              {
+        if (a.overlap != b.overlap)
+            return a.overlap > b.overlap;
+        return documents[a.id].id < documents[b.id].id; });
+
+    int exactMatches = 0;
+    for (Match &candidate : candidates)
+    {
+        if (exactMatches >= limit)
+        {
+            break; // the rest have a lower overlap or a higher id
+        }
+        const Document &document = documents[candidate.id];
+        int total = 0;
+        for (const QString &queryWord : queryWords)
+        {
+            const int budget = editBudget(queryWord.size());
+            int best = budget + 1;
+            for (const QString &word : document.words)
+            {
+                // A word that starts like the query counts as typed-so-far
+                best = std::min(best, boundedDistance(queryWord, word, budget, true));
+                if (best == 0)
+                {
+                    break;
+                }
+            }
+            if (best > budget)
+            {
+                total = -1;
+                break;
+            }
+            total += best;
+        }
+        if (total >= 0)
+        {
+            exactMatches += total == 0 ? 1 : 0;
+            matches.push_back({document.id, total, candidate.overlap});
+        }
+    }
+
+    std::sort(matches.begin(), matches.end(), [](const Match &a, const Match &b)
+              {
+        if (a.distance != b.distance)
+            return a.distance < b.distance;
+        if (a.overlap != b.overlap)
+            return a.overlap > b.overlap;
+        return a.id < b.id; });
+    if (static_cast<int>(matches.size()) > limit)
+    {
+        matches.resize(limit);
+    }
+    return matches;
+}
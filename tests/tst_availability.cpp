@@ -0,0 +1,90 @@
+#include <QtTest>
+#include "utils/availability.h"
+
+// Availability::parse on the free-form answers applicants actually type
+class TestAvailability : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void parse_data();
+    void parse();
+    void rejectsText();
+    void anytimeCoversEveryBlock();
+};
+
+void TestAvailability::parse_data()
+{
+    QTest::addColumn<QString>("text");
+    QTest::addColumn<QString>("expected");
+
+    const QString everyDay13to16 = "Mon 13:00-16:00; Tue 13:00-16:00; Wed 13:00-16:00; Thu 13:00-16:00; "
+                                   "Fri 13:00-16:00; Sat 13:00-16:00; Sun 13:00-16:00";
+
+    QTest::newRow("day list") << "Tue/Thu mornings" << "Tue 06:00-12:00; Thu 06:00-12:00";
+    QTest::newRow("letter days, am/pm carried") << "MWF 9-11:30am; Sat noon-4"
+                                                << "Mon 09:00-11:30; Wed 09:00-11:30; Fri 09:00-11:30; Sat 12:00-16:00";
+    QTest::newRow("TTh") << "TTh 1-3" << "Tue 13:00-15:00; Thu 13:00-15:00";
+    QTest::newRow("bare small hours are afternoon") << "1-4" << everyDay13to16;
+    QTest::newRow("morning into pm") << "10-2pm"
+                                     << "Mon 10:00-14:00; Tue 10:00-14:00; Wed 10:00-14:00; Thu 10:00-14:00; "
+                                        "Fri 10:00-14:00; Sat 10:00-14:00; Sun 10:00-14:00";
+    QTest::newRow("end before start is pm") << "Mon 9-9" << "Mon 09:00-21:00";
+    QTest::newRow("day range wraps the week") << "Fri-Mon 8am-noon"
+                                              << "Mon 08:00-12:00; Fri 08:00-12:00; Sat 08:00-12:00; Sun 08:00-12:00";
+    QTest::newRow("except") << "Weekdays except Wednesday, 9am-1pm"
+                            << "Mon 09:00-13:00; Tue 09:00-13:00; Thu 09:00-13:00; Fri 09:00-13:00";
+    QTest::newRow("per-day times") << "Mon 9-11, Wed 2-4" << "Mon 09:00-11:00; Wed 14:00-16:00";
+    QTest::newRow("blocks per day") << "Tuesday mornings and Thursday afternoons"
+                                    << "Tue 06:00-12:00; Thu 12:00-17:00";
+    QTest::newRow("after") << "after 3"
+                           << "Mon 15:00-22:00; Tue 15:00-22:00; Wed 15:00-22:00; Thu 15:00-22:00; "
+                              "Fri 15:00-22:00; Sat 15:00-22:00; Sun 15:00-22:00";
+    QTest::newRow("before") << "before 10"
+                            << "Mon 06:00-10:00; Tue 06:00-10:00; Wed 06:00-10:00; Thu 06:00-10:00; "
+                               "Fri 06:00-10:00; Sat 06:00-10:00; Sun 06:00-10:00";
+    QTest::newRow("clipped to 06:00") << "5am-7am"
+                                      << "Mon 06:00-07:00; Tue 06:00-07:00; Wed 06:00-07:00; Thu 06:00-07:00; "
+                                         "Fri 06:00-07:00; Sat 06:00-07:00; Sun 06:00-07:00";
+    QTest::newRow("clipped to 22:00") << "Sat 18:00-24:00" << "Sat 18:00-22:00";
+    QTest::newRow("half past the grid end") << "Sat 20:00-23:30" << "Sat 20:00-22:00";
+    QTest::newRow("rounded out to slots") << "mon 9:07-10:01" << "Mon 09:00-10:15";
+}
+
+void TestAvailability::parse()
+{
+    QFETCH(QString, text);
+    QFETCH(QString, expected);
+
+    bool ok = false;
+    const Availability availability = Availability::parse(text, &ok);
+    QVERIFY(ok);
+    QCOMPARE(availability.toString(), expected);
+}
+
+void TestAvailability::rejectsText()
+{
+    bool ok = true;
+    QVERIFY(Availability::parse("nothing here", &ok).isEmpty());
+    QVERIFY(!ok);
+
+    ok = true;
+    QVERIFY(Availability::parse("", &ok).isEmpty());
+    QVERIFY(!ok);
+}
+
+void TestAvailability::anytimeCoversEveryBlock()
+{
+    bool ok = false;
+    const Availability availability = Availability::parse("anytime", &ok);
+    QVERIFY(ok);
+    QCOMPARE(availability.slotCount(), Availability::kDays * Availability::kSlotsPerDay);
+    QCOMPARE(availability.blockMask(), quint32(0x1fffff));
+
+    const Availability weekends = Availability::parse("Monday-Friday 2pm-6pm, flexible on weekends", &ok);
+    QVERIFY(ok);
+    QCOMPARE(weekends.slotCount(), 5 * 16 + 2 * Availability::kSlotsPerDay);
+}
+
+QTEST_GUILESS_MAIN(TestAvailability)
+#include "tst_availability.moc"
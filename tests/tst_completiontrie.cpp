@@ -0,0 +1,62 @@
+#include <QtTest>
+#include "utils/completiontrie.h"
+
+class TestCompletionTrie : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void complete_data();
+    void complete();
+
+private:
+    CompletionTrie trie;
+};
+
+void TestCompletionTrie::initTestCase()
+{
+    // Duplicate keys keep the heavier entry, keys are normalized, and
+    // several keys may suggest the same display text
+    trie = CompletionTrie::build({{"Library Assistant", "Library Assistant", 30},
+                                  {"library assistant", "library assistant", 5},
+                                  {"Lab Technician", "Lab Technician", 10},
+                                  {"Library", "Library", 20},
+                                  {"  Math   Tutor", "Math Tutor", 15},
+                                  {"assistant", "Library Assistant", 30},
+                                  {"Math", "Math", 1},
+                                  {"mathematics dept", "Mathematics Dept", 7},
+                                  {"", "", 0},
+                                  {"tutor", "Math Tutor", 15}},
+                                 4);
+    QCOMPARE(trie.size(), 8);
+}
+
+void TestCompletionTrie::complete_data()
+{
+    QTest::addColumn<QString>("prefix");
+    QTest::addColumn<QStringList>("expected");
+
+    // The root only keeps topK entries
+    QTest::newRow("empty") << "" << QStringList{"Library Assistant", "Library", "Math Tutor", "Lab Technician"};
+    QTest::newRow("shared edge") << "l" << QStringList{"Library Assistant", "Library", "Lab Technician"};
+    QTest::newRow("case and trailing space") << "LIBRARY " << QStringList{"Library Assistant", "Library"};
+    QTest::newRow("inside a label") << "library a" << QStringList{"Library Assistant"};
+    QTest::newRow("split edge") << "la" << QStringList{"Lab Technician"};
+    QTest::newRow("by weight") << "m" << QStringList{"Math Tutor", "Mathematics Dept", "Math"};
+    QTest::newRow("collapsed spaces") << "math t" << QStringList{"Math Tutor"};
+    QTest::newRow("second key") << "a" << QStringList{"Library Assistant"};
+    QTest::newRow("no match") << "x" << QStringList{};
+    QTest::newRow("past a leaf") << "library assistantx" << QStringList{};
+}
+
+void TestCompletionTrie::complete()
+{
+    QFETCH(QString, prefix);
+    QFETCH(QStringList, expected);
+
+    QCOMPARE(trie.complete(prefix, 8), expected);
+}
+
+QTEST_GUILESS_MAIN(TestCompletionTrie)
+#include "tst_completiontrie.moc"
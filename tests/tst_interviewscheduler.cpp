@@ -0,0 +1,86 @@
+#include <QtTest>
+#include "services/interviewscheduler.h"
+
+class TestInterviewScheduler : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void maxFlowBeatsFirstFit();
+    void cancellationsRebook();
+};
+
+namespace
+{
+    Availability monday(int startMinute, int endMinute)
+    {
+        Availability availability;
+        availability.addRange(0, startMinute, endMinute);
+        return availability;
+    }
+
+    // applicationId -> start minute of its booking
+    QMap<int, int> starts(const InterviewScheduler &scheduler)
+    {
+        QMap<int, int> result;
+        for (const ScheduledInterview &interview : scheduler.schedule())
+        {
+            result.insert(interview.applicationId, interview.startMinute);
+        }
+        return result;
+    }
+}
+
+void TestInterviewScheduler::maxFlowBeatsFirstFit()
+{
+    // Applicant 1 is added first and would take 9:00 in a first-fit
+    // pass, leaving applicant 2 (9:00-9:30 only) without a window
+    InterviewScheduler scheduler(30, 1, 1);
+    scheduler.addSupervisor("Dr. Lee", monday(9 * 60, 10 * 60));
+    QVERIFY(scheduler.addApplicant(1, "Dr. Lee", monday(9 * 60, 10 * 60)));
+    QVERIFY(scheduler.addApplicant(2, "Dr. Lee", monday(9 * 60, 9 * 60 + 30)));
+    QVERIFY(!scheduler.addApplicant(3, "Nobody", monday(9 * 60, 10 * 60)));
+
+    QCOMPARE(scheduler.solve(), 2);
+    QCOMPARE(starts(scheduler), (QMap<int, int>{{1, 570}, {2, 540}}));
+    for (const ScheduledInterview &interview : scheduler.schedule())
+    {
+        QCOMPARE(interview.supervisor, QString("Dr. Lee"));
+        QCOMPARE(interview.day, 0);
+        QCOMPARE(interview.endMinute, interview.startMinute + 30);
+        QCOMPARE(interview.room, 1);
+    }
+}
+
+void TestInterviewScheduler::cancellationsRebook()
+{
+    InterviewScheduler scheduler(30, 1, 1);
+    scheduler.addSupervisor("Dr. Lee", monday(9 * 60, 10 * 60));
+    QVERIFY(scheduler.addApplicant(1, "Dr. Lee", monday(9 * 60, 10 * 60)));
+    QVERIFY(scheduler.addApplicant(2, "Dr. Lee", monday(9 * 60, 9 * 60 + 30)));
+    QCOMPARE(scheduler.solve(), 2);
+
+    // Two windows, three applicants: someone waits
+    QVERIFY(scheduler.addApplicant(4, "Dr. Lee", monday(9 * 60, 10 * 60)));
+    QCOMPARE(scheduler.solve(), 2);
+
+    // Cancelling 2 leaves both windows to 1 and 4
+    QVERIFY(scheduler.cancelApplicant(2));
+    QCOMPARE(scheduler.solve(), 2);
+    QMap<int, int> booked = starts(scheduler);
+    QCOMPARE(booked.keys(), (QList<int>{1, 4}));
+    QCOMPARE(booked[1] + booked[4], 540 + 570);
+
+    // Losing 9:00 leaves one booking, at 9:30
+    QVERIFY(scheduler.cancelSupervisorTime("Dr. Lee", monday(9 * 60, 9 * 60 + 30)));
+    QCOMPARE(scheduler.solve(), 1);
+    QCOMPARE(scheduler.bookedCount(), 1);
+    booked = starts(scheduler);
+    QCOMPARE(booked.size(), 1);
+    QCOMPARE(booked.first(), 570);
+
+    QVERIFY(!scheduler.cancelSupervisorTime("Nobody", monday(9 * 60, 10 * 60)));
+}
+
+QTEST_GUILESS_MAIN(TestInterviewScheduler)
+#include "tst_interviewscheduler.moc"
@@ -0,0 +1,93 @@
+#include <QtTest>
+#include "models/jobfilter.h"
+
+class TestJobFilter : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void singleStatus();
+    void statusSet();
+    void emptyStatusMatchesNothing();
+    void keywordIsEscaped();
+    void fallbackAgreesWithSql();
+};
+
+namespace
+{
+    Job makeJob(JobStatus status, const QString &title = "Library Assistant", bool workStudy = false)
+    {
+        return Job(1, title, "Student Services", "Academic Support", "Shelving and front desk", 15.0, 17.0, 12, 2, status,
+                   workStudy, false, "2026-12-01");
+    }
+}
+
+void TestJobFilter::singleStatus()
+{
+    using namespace JobFilters;
+    const auto filter = makeJobFilter(Status{statusBit(JobStatus::Open)});
+    QCOMPARE(filter.whereClause(), QString("status = ?"));
+    QCOMPARE(filter.bindValues(), QVariantList{static_cast<int>(JobStatus::Open)});
+    QVERIFY(filter(makeJob(JobStatus::Open)));
+    QVERIFY(!filter(makeJob(JobStatus::ClosingSoon)));
+}
+
+void TestJobFilter::statusSet()
+{
+    using namespace JobFilters;
+    const auto filter = makeJobFilter(Status{kAcceptingApplications}, WorkStudy{});
+    QCOMPARE(filter.whereClause(), QString("status IN (?, ?) AND work_study_eligible = 1"));
+    QCOMPARE(filter.bindValues(),
+             (QVariantList{static_cast<int>(JobStatus::Open), static_cast<int>(JobStatus::ClosingSoon)}));
+    QVERIFY(filter(makeJob(JobStatus::Open, "Tutor", true)));
+    QVERIFY(filter(makeJob(JobStatus::ClosingSoon, "Tutor", true)));
+    QVERIFY(!filter(makeJob(JobStatus::ClosingSoon, "Tutor", false)));
+    QVERIFY(!filter(makeJob(JobStatus::Closed, "Tutor", true)));
+    QVERIFY(!filter(makeJob(JobStatus::Upcoming, "Tutor", true)));
+}
+
+void TestJobFilter::emptyStatusMatchesNothing()
+{
+    const auto filter = makeJobFilter(JobFilters::Status{0});
+    QCOMPARE(filter.whereClause(), QString("0"));
+    QVERIFY(filter.bindValues().isEmpty());
+    QVERIFY(!filter(makeJob(JobStatus::Open)));
+
+    QCOMPARE(makeJobFilter().whereClause(), QString("1"));
+}
+
+void TestJobFilter::keywordIsEscaped()
+{
+    const auto filter = makeJobFilter(JobFilters::Keyword{"50%_off\\"});
+    const QVariantList binds = filter.bindValues();
+    QCOMPARE(binds.size(), 3);
+    QCOMPARE(binds.first().toString(), QString("%50\\%\\_off\\\\%"));
+    QVERIFY(filter(makeJob(JobStatus::Open, "Save 50%_off\\ today")));
+    QVERIFY(!filter(makeJob(JobStatus::Open, "Save 50 off")));
+}
+
+void TestJobFilter::fallbackAgreesWithSql()
+{
+    // Status plus keyword has no exact instantiation, so it takes the Optional<> path
+    JobSearchOptions options;
+    options.statuses = JobFilters::kAcceptingApplications;
+    options.keyword = "library";
+
+    const QString where = visitJobFilter(options, [](const auto &filter) { return filter.whereClause(); });
+    QVERIFY(where.startsWith("status IN (?, ?) AND (title LIKE ?"));
+    const int binds = visitJobFilter(options, [](const auto &filter) { return filter.bindValues().size(); });
+    QCOMPARE(binds, where.count('?'));
+
+    const auto matches = [&options](const Job &job)
+    { return visitJobFilter(options, [&job](const auto &filter) { return filter(job); }); };
+    QVERIFY(matches(makeJob(JobStatus::ClosingSoon)));
+    QVERIFY(!matches(makeJob(JobStatus::Closed)));
+    QVERIFY(!matches(makeJob(JobStatus::Open, "Math Tutor")));
+
+    // No options at all filters nothing
+    const QString all = visitJobFilter(JobSearchOptions{}, [](const auto &filter) { return filter.whereClause(); });
+    QCOMPARE(all, QString("1"));
+}
+
+QTEST_GUILESS_MAIN(TestJobFilter)
+#include "tst_jobfilter.moc"
@@ -0,0 +1,131 @@
+#include <QtTest>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QTemporaryDir>
+#include "database/database.h"
+#include "database/jobresultcache.h"
+
+class TestJobResultCache : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void versionChangeDropsEntries();
+    void keyNormalizesKeyword();
+    void importInvalidates();
+    void writeOnAnotherConnectionInvalidates();
+};
+
+namespace
+{
+    Job makeJob(int id, const QString &title)
+    {
+        return Job(id, title, "Facilities", "Campus Operations", "Keeps the greenhouse running", 16.0, 18.0, 10, 1,
+                   JobStatus::Open, false, true, "2026-12-01");
+    }
+
+    int importOne(Database &db, const QString &title)
+    {
+        bool sent = false;
+        return db.importJobs([&](Job &job)
+                             {
+                                 if (sent)
+                                     return false;
+                                 job = makeJob(-1, title);
+                                 sent = true;
+                                 return true;
+                             });
+    }
+
+    JobSearchOptions keywordSearch(const QString &keyword)
+    {
+        JobSearchOptions options;
+        options.keyword = keyword;
+        return options;
+    }
+}
+
+void TestJobResultCache::versionChangeDropsEntries()
+{
+    JobResultCache cache;
+    const QString key = JobResultCache::keyFor(keywordSearch("greenhouse"), 10);
+    cache.insert(key, 1, {makeJob(7, "Greenhouse Aide"), makeJob(8, "Greenhouse Lead")});
+
+    std::vector<Job> jobs;
+    QVERIFY(cache.lookup(key, 1, jobs));
+    QCOMPARE(jobs.size(), size_t(2));
+    QCOMPARE(jobs[1].getTitle(), QString("Greenhouse Lead"));
+
+    QVERIFY(!cache.lookup(key, 2, jobs));
+    const JobResultCache::Stats stats = cache.stats();
+    QCOMPARE(stats.hits, quint64(1));
+    QCOMPARE(stats.misses, quint64(1));
+    QCOMPARE(stats.invalidations, quint64(1));
+    QCOMPARE(stats.entries, 0);
+    QCOMPARE(stats.pooledJobs, 0);
+}
+
+void TestJobResultCache::keyNormalizesKeyword()
+{
+    QCOMPARE(JobResultCache::keyFor(keywordSearch("Greenhouse"), 10),
+             JobResultCache::keyFor(keywordSearch("greenhouse"), 10));
+    QVERIFY(JobResultCache::keyFor(keywordSearch("greenhouse"), 10) !=
+            JobResultCache::keyFor(keywordSearch("greenhouse"), 20));
+
+    JobSearchOptions open = keywordSearch("greenhouse");
+    open.statuses = JobFilters::statusBit(JobStatus::Open);
+    JobSearchOptions accepting = keywordSearch("greenhouse");
+    accepting.statuses = JobFilters::kAcceptingApplications;
+    QVERIFY(JobResultCache::keyFor(open, 10) != JobResultCache::keyFor(accepting, 10));
+}
+
+void TestJobResultCache::importInvalidates()
+{
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    Database db(directory.filePath("cache.db"), "tst_cache_import");
+    QVERIFY(db.connectToDatabase());
+
+    const JobSearchOptions options = keywordSearch("greenhouse");
+    QVERIFY(db.searchJobs(options).empty());
+    QVERIFY(db.searchJobs(options).empty());
+    QCOMPARE(db.searchCacheStats().hits, quint64(1));
+
+    QCOMPARE(importOne(db, "Greenhouse Aide"), 1);
+    const std::vector<Job> jobs = db.searchJobs(options);
+    QCOMPARE(jobs.size(), size_t(1));
+    QCOMPARE(jobs[0].getTitle(), QString("Greenhouse Aide"));
+    QCOMPARE(db.searchCacheStats().invalidations, quint64(1));
+}
+
+void TestJobResultCache::writeOnAnotherConnectionInvalidates()
+{
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    const QString path = directory.filePath("cache.db");
+    Database db(path, "tst_cache_writer");
+    QVERIFY(db.connectToDatabase());
+    QCOMPARE(importOne(db, "Greenhouse Aide"), 1);
+
+    JobSearchOptions options = keywordSearch("greenhouse");
+    options.statuses = JobFilters::kAcceptingApplications;
+    QCOMPARE(db.searchJobs(options).size(), size_t(1));
+
+    // The version triggers see writes from any connection, not just db's
+    {
+        QSqlDatabase other = QSqlDatabase::addDatabase("QSQLITE", "tst_cache_other");
+        other.setDatabaseName(path);
+        QVERIFY(other.open());
+        QSqlQuery query(other);
+        QVERIFY(query.exec(QString("UPDATE jobs SET status = %1 WHERE title = 'Greenhouse Aide'")
+                               .arg(static_cast<int>(JobStatus::Closed))));
+        other.close();
+    }
+    QSqlDatabase::removeDatabase("tst_cache_other");
+
+    QVERIFY(db.searchJobs(options).empty());
+    QCOMPARE(db.searchCacheStats().invalidations, quint64(1));
+}
+
+QTEST_GUILESS_MAIN(TestJobResultCache)
+#include "tst_jobresultcache.moc"
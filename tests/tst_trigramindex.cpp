@@ -0,0 +1,77 @@
+#include <QtTest>
+#include "utils/trigramindex.h"
+
+class TestTrigramIndex : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void typos();
+    void upsertAndRemove();
+    void tiesBreakByLowestId();
+};
+
+namespace
+{
+    QList<int> ids(const std::vector<TrigramIndex::Match> &matches)
+    {
+        QList<int> out;
+        for (const TrigramIndex::Match &match : matches)
+            out << match.id;
+        return out;
+    }
+}
+
+void TestTrigramIndex::typos()
+{
+    TrigramIndex index;
+    index.upsert(1, {"Library Assistant", "Library"});
+    index.upsert(2, {"Math Tutor", "Mathematics"});
+    index.upsert(3, {"IT Help Desk", "Information Technology"});
+    QCOMPARE(index.size(), 3);
+
+    std::vector<TrigramIndex::Match> matches = index.search("libary", 5);
+    QCOMPARE(ids(matches), QList<int>{1});
+    QCOMPARE(matches[0].distance, 1);
+
+    matches = index.search("tutr", 5);
+    QCOMPARE(ids(matches), QList<int>{2});
+    QCOMPARE(matches[0].distance, 1);
+
+    matches = index.search("math", 5);
+    QCOMPARE(ids(matches), QList<int>{2});
+    QCOMPARE(matches[0].distance, 0);
+
+    QVERIFY(index.search("xyz", 5).empty());
+}
+
+void TestTrigramIndex::upsertAndRemove()
+{
+    TrigramIndex index;
+    index.upsert(1, {"Library Assistant", "Library"});
+    index.upsert(2, {"Math Tutor", "Mathematics"});
+
+    index.upsert(2, {"Physics Tutor", "Science"});
+    QCOMPARE(index.size(), 2);
+    QVERIFY(index.search("math", 5).empty());
+    QCOMPARE(ids(index.search("physcs", 5)), QList<int>{2});
+
+    index.remove(1);
+    QVERIFY(!index.contains(1));
+    QVERIFY(index.search("lib", 5).empty());
+}
+
+void TestTrigramIndex::tiesBreakByLowestId()
+{
+    // Identical documents in reverse id order: every one ties, and the
+    // truncated result must not depend on slot order
+    TrigramIndex index;
+    for (int id = 500; id >= 1; --id)
+        index.upsert(id, {"Lab Assistant", "Library"});
+
+    QCOMPARE(ids(index.search("lab assistant", 5)), (QList<int>{1, 2, 3, 4, 5}));
+    QCOMPARE(ids(index.search("lab asistant", 3)), (QList<int>{1, 2, 3}));
+}
+
+QTEST_GUILESS_MAIN(TestTrigramIndex)
+#include "tst_trigramindex.moc"
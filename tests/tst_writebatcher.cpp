@@ -0,0 +1,136 @@
+#include <QtTest>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QTemporaryDir>
+#include "database/database.h"
+#include "database/writebatcher.h"
+
+class TestWriteBatcher : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+    void cleanup();
+    void failedWriteKeepsTheRest();
+    void maxBatchFlushes();
+    void beginTransactionFlushesFirst();
+
+private:
+    QTemporaryDir directory;
+    QSqlDatabase db;
+};
+
+namespace
+{
+    const char *const kConnection = "tst_writebatcher";
+
+    int countRows(const QString &path, const QString &sql)
+    {
+        int rows = -1;
+        {
+            QSqlDatabase reader = QSqlDatabase::addDatabase("QSQLITE", "tst_writebatcher_reader");
+            reader.setDatabaseName(path);
+            if (reader.open())
+            {
+                QSqlQuery query(reader);
+                if (query.exec(sql) && query.next())
+                    rows = query.value(0).toInt();
+            }
+            reader.close();
+        }
+        QSqlDatabase::removeDatabase("tst_writebatcher_reader");
+        return rows;
+    }
+
+    WriteBatcher::Write insertValue(const QSqlDatabase &db, int value)
+    {
+        return [db, value]()
+        {
+            QSqlQuery query(db);
+            query.prepare("INSERT INTO items (value) VALUES (?)");
+            query.addBindValue(value);
+            return query.exec();
+        };
+    }
+}
+
+void TestWriteBatcher::init()
+{
+    QVERIFY(directory.isValid());
+    db = QSqlDatabase::addDatabase("QSQLITE", kConnection);
+    db.setDatabaseName(directory.filePath("batch.db"));
+    QVERIFY(db.open());
+    QSqlQuery query(db);
+    QVERIFY(query.exec("CREATE TABLE IF NOT EXISTS items (value INTEGER UNIQUE)"));
+    QVERIFY(query.exec("DELETE FROM items"));
+}
+
+void TestWriteBatcher::cleanup()
+{
+    db.close();
+    db = QSqlDatabase();
+    QSqlDatabase::removeDatabase(kConnection);
+}
+
+void TestWriteBatcher::failedWriteKeepsTheRest()
+{
+    WriteBatcher batcher(kConnection);
+    QList<bool> results;
+    const auto record = [&results](bool committed) { results << committed; };
+    batcher.enqueue(insertValue(db, 1), record);
+    batcher.enqueue(insertValue(db, 1), record); // violates UNIQUE
+    batcher.enqueue(insertValue(db, 2), record);
+    QVERIFY(batcher.hasPending());
+    QVERIFY(results.isEmpty());
+
+    QVERIFY(!batcher.flush());
+    QCOMPARE(results, (QList<bool>{true, false, true}));
+    QCOMPARE(countRows(db.databaseName(), "SELECT COUNT(*) FROM items"), 2);
+
+    const WriteBatcher::Stats stats = batcher.stats();
+    QCOMPARE(stats.writes, quint64(3));
+    QCOMPARE(stats.batches, quint64(1));
+    QCOMPARE(stats.failedWrites, quint64(1));
+}
+
+void TestWriteBatcher::maxBatchFlushes()
+{
+    WriteBatcher batcher(kConnection);
+    batcher.setMaxBatch(2);
+    batcher.enqueue(insertValue(db, 1));
+    QVERIFY(batcher.hasPending());
+    batcher.enqueue(insertValue(db, 2));
+    QVERIFY(!batcher.hasPending());
+    QCOMPARE(countRows(db.databaseName(), "SELECT COUNT(*) FROM items"), 2);
+}
+
+void TestWriteBatcher::beginTransactionFlushesFirst()
+{
+    // The queued save must commit on its own, not join (and roll back
+    // with) the caller's transaction
+    const QString path = directory.filePath("campus.db");
+    Database database(path, "tst_writebatcher_database");
+    QVERIFY(database.connectToDatabase());
+
+    int callbacks = 0;
+    bool saved = false;
+    database.saveJob(1, 1, [&](bool committed)
+                     {
+                         ++callbacks;
+                         saved = committed;
+                     });
+    QCOMPARE(callbacks, 0);
+
+    QVERIFY(database.beginTransaction());
+    QCOMPARE(callbacks, 1);
+    QVERIFY(saved);
+    QVERIFY(database.rollbackTransaction());
+
+    QCOMPARE(countRows(path, "SELECT COUNT(*) FROM saved_jobs WHERE user_id = 1 AND job_id = 1"), 1);
+    QVERIFY(database.isJobSaved(1, 1));
+    QCOMPARE(database.writeBatchStats().batches, quint64(1));
+}
+
+QTEST_GUILESS_MAIN(TestWriteBatcher)
+#include "tst_writebatcher.moc"